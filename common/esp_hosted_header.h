@@ -35,7 +35,31 @@ struct esp_payload_header {
 #define FLAG_WAKEUP_PKT                           (1 << 1)
 #define FLAG_POWER_SAVE_STARTED                   (1 << 2)
 #define FLAG_POWER_SAVE_STOPPED                   (1 << 3)
+/* Another packet follows this one in the same transport buffer */
+#define FLAG_AGGR_NEXT_PKT                        (1 << 4)
+/* CRC32 trailer follows the payload, see esp_hosted_crc32.h */
+#define FLAG_CRC32                                (1 << 5)
+/* Header carries slave Rx buffer token count (SDIO), see H_HDR_*_TX_CREDIT */
+#define FLAG_TX_CREDIT                            (1 << 6)
+
+/* Alignment of packets that follow each other in a transport buffer */
+#define H_AGGR_PKT_ALIGN(x)                       (((x) + 3) & ~3)
+
+/* 12 bit token count in reserved2 (low 6 bits) and reserved3 (high 6 bits).
+ * reserved3 is shared with hci_pkt_type/priv_pkt_type, so only for other
+ * interface types */
+#define H_HDR_TX_CREDIT_MASK                      0xFFF
+#define H_HDR_CAN_CARRY_TX_CREDIT(h)              \
+	((h)->if_type != ESP_HCI_IF && (h)->if_type != ESP_PRIV_IF)
+#define H_HDR_SET_TX_CREDIT(h, c) do {            \
+	(h)->reserved2 = (c) & 0x3F;                  \
+	(h)->reserved3 = ((c) >> 6) & 0x3F;           \
+	(h)->flags |= FLAG_TX_CREDIT;                 \
+} while (0)
+#define H_HDR_GET_TX_CREDIT(h)                    \
+	((h)->reserved2 | (((h)->reserved3 & 0x3F) << 6))
 
 #define H_ESP_PAYLOAD_HEADER_OFFSET sizeof(struct esp_payload_header)
+#define H_ESP_PAYLOAD_CRC32_LEN     4
 
 #endif
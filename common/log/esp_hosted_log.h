@@ -21,9 +21,9 @@
 #define ESP_PRIV_HEXDUMP(tag1, tag2, buff, buf_len, display_len, curr_level)  \
   if ( LOG_LOCAL_LEVEL >= curr_level) {                                       \
     int len_to_print = 0;                                                     \
-    len_to_print = display_len<buf_len? display_len: buf_len;                 \
+    len_to_print = (display_len)<(buf_len)? (display_len): (buf_len);         \
     ESP_LOG_LEVEL_LOCAL(curr_level, tag1, "%s: buf_len[%d], print_len[%d]",   \
-        tag2, (int)buf_len, (int)len_to_print);                               \
+        tag2, (int)(buf_len), (int)len_to_print);                             \
     ESP_LOG_BUFFER_HEXDUMP(tag2, buff, len_to_print, curr_level);             \
   }
 
@@ -8647,6 +8647,96 @@ void   rpc__event__sta_itwt_probe__free_unpacked
   assert(message->base.descriptor == &rpc__event__sta_itwt_probe__descriptor);
   protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
 }
+void   rpc__req__batch__init
+                     (RpcReqBatch         *message)
+{
+  static const RpcReqBatch init_value = RPC__REQ__BATCH__INIT;
+  *message = init_value;
+}
+size_t rpc__req__batch__get_packed_size
+                     (const RpcReqBatch *message)
+{
+  assert(message->base.descriptor == &rpc__req__batch__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t rpc__req__batch__pack
+                     (const RpcReqBatch *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &rpc__req__batch__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t rpc__req__batch__pack_to_buffer
+                     (const RpcReqBatch *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &rpc__req__batch__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+RpcReqBatch *
+       rpc__req__batch__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (RpcReqBatch *)
+     protobuf_c_message_unpack (&rpc__req__batch__descriptor,
+                                allocator, len, data);
+}
+void   rpc__req__batch__free_unpacked
+                     (RpcReqBatch *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &rpc__req__batch__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
+void   rpc__resp__batch__init
+                     (RpcRespBatch         *message)
+{
+  static const RpcRespBatch init_value = RPC__RESP__BATCH__INIT;
+  *message = init_value;
+}
+size_t rpc__resp__batch__get_packed_size
+                     (const RpcRespBatch *message)
+{
+  assert(message->base.descriptor == &rpc__resp__batch__descriptor);
+  return protobuf_c_message_get_packed_size ((const ProtobufCMessage*)(message));
+}
+size_t rpc__resp__batch__pack
+                     (const RpcRespBatch *message,
+                      uint8_t       *out)
+{
+  assert(message->base.descriptor == &rpc__resp__batch__descriptor);
+  return protobuf_c_message_pack ((const ProtobufCMessage*)message, out);
+}
+size_t rpc__resp__batch__pack_to_buffer
+                     (const RpcRespBatch *message,
+                      ProtobufCBuffer *buffer)
+{
+  assert(message->base.descriptor == &rpc__resp__batch__descriptor);
+  return protobuf_c_message_pack_to_buffer ((const ProtobufCMessage*)message, buffer);
+}
+RpcRespBatch *
+       rpc__resp__batch__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data)
+{
+  return (RpcRespBatch *)
+     protobuf_c_message_unpack (&rpc__resp__batch__descriptor,
+                                allocator, len, data);
+}
+void   rpc__resp__batch__free_unpacked
+                     (RpcRespBatch *message,
+                      ProtobufCAllocator *allocator)
+{
+  if(!message)
+    return;
+  assert(message->base.descriptor == &rpc__resp__batch__descriptor);
+  protobuf_c_message_free_unpacked ((ProtobufCMessage*)message, allocator);
+}
 void   rpc__init
                      (Rpc         *message)
 {
@@ -13264,7 +13354,7 @@ const ProtobufCMessageDescriptor rpc__resp__otabegin__descriptor =
   (ProtobufCMessageInit) rpc__resp__otabegin__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor rpc__req__otawrite__field_descriptors[1] =
+static const ProtobufCFieldDescriptor rpc__req__otawrite__field_descriptors[2] =
 {
   {
     "ota_data",
@@ -13278,14 +13368,27 @@ static const ProtobufCFieldDescriptor rpc__req__otawrite__field_descriptors[1] =
     0,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "seq_num",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcReqOTAWrite, seq_num),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
 };
 static const unsigned rpc__req__otawrite__field_indices_by_name[] = {
   0,   /* field[0] = ota_data */
+  1,   /* field[1] = seq_num */
 };
 static const ProtobufCIntRange rpc__req__otawrite__number_ranges[1 + 1] =
 {
   { 1, 0 },
-  { 0, 1 }
+  { 0, 2 }
 };
 const ProtobufCMessageDescriptor rpc__req__otawrite__descriptor =
 {
@@ -13295,14 +13398,14 @@ const ProtobufCMessageDescriptor rpc__req__otawrite__descriptor =
   "RpcReqOTAWrite",
   "",
   sizeof(RpcReqOTAWrite),
-  1,
+  2,
   rpc__req__otawrite__field_descriptors,
   rpc__req__otawrite__field_indices_by_name,
   1,  rpc__req__otawrite__number_ranges,
   (ProtobufCMessageInit) rpc__req__otawrite__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor rpc__resp__otawrite__field_descriptors[1] =
+static const ProtobufCFieldDescriptor rpc__resp__otawrite__field_descriptors[2] =
 {
   {
     "resp",
@@ -13316,14 +13419,27 @@ static const ProtobufCFieldDescriptor rpc__resp__otawrite__field_descriptors[1]
     0,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "written_seq_num",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcRespOTAWrite, written_seq_num),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
 };
 static const unsigned rpc__resp__otawrite__field_indices_by_name[] = {
   0,   /* field[0] = resp */
+  1,   /* field[1] = written_seq_num */
 };
 static const ProtobufCIntRange rpc__resp__otawrite__number_ranges[1 + 1] =
 {
   { 1, 0 },
-  { 0, 1 }
+  { 0, 2 }
 };
 const ProtobufCMessageDescriptor rpc__resp__otawrite__descriptor =
 {
@@ -13333,7 +13449,7 @@ const ProtobufCMessageDescriptor rpc__resp__otawrite__descriptor =
   "RpcRespOTAWrite",
   "",
   sizeof(RpcRespOTAWrite),
-  1,
+  2,
   rpc__resp__otawrite__field_descriptors,
   rpc__resp__otawrite__field_indices_by_name,
   1,  rpc__resp__otawrite__number_ranges,
@@ -14404,7 +14520,7 @@ const ProtobufCMessageDescriptor rpc__resp__wifi_scan_get_ap_num__descriptor =
   (ProtobufCMessageInit) rpc__resp__wifi_scan_get_ap_num__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor rpc__req__wifi_scan_get_ap_records__field_descriptors[1] =
+static const ProtobufCFieldDescriptor rpc__req__wifi_scan_get_ap_records__field_descriptors[2] =
 {
   {
     "number",
@@ -14418,14 +14534,27 @@ static const ProtobufCFieldDescriptor rpc__req__wifi_scan_get_ap_records__field_
     0,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "packed",
+    2,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(RpcReqWifiScanGetApRecords, packed),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
 };
 static const unsigned rpc__req__wifi_scan_get_ap_records__field_indices_by_name[] = {
   0,   /* field[0] = number */
+  1,   /* field[1] = packed */
 };
 static const ProtobufCIntRange rpc__req__wifi_scan_get_ap_records__number_ranges[1 + 1] =
 {
   { 1, 0 },
-  { 0, 1 }
+  { 0, 2 }
 };
 const ProtobufCMessageDescriptor rpc__req__wifi_scan_get_ap_records__descriptor =
 {
@@ -14435,14 +14564,14 @@ const ProtobufCMessageDescriptor rpc__req__wifi_scan_get_ap_records__descriptor
   "RpcReqWifiScanGetApRecords",
   "",
   sizeof(RpcReqWifiScanGetApRecords),
-  1,
+  2,
   rpc__req__wifi_scan_get_ap_records__field_descriptors,
   rpc__req__wifi_scan_get_ap_records__field_indices_by_name,
   1,  rpc__req__wifi_scan_get_ap_records__number_ranges,
   (ProtobufCMessageInit) rpc__req__wifi_scan_get_ap_records__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor rpc__resp__wifi_scan_get_ap_records__field_descriptors[3] =
+static const ProtobufCFieldDescriptor rpc__resp__wifi_scan_get_ap_records__field_descriptors[5] =
 {
   {
     "resp",
@@ -14480,16 +14609,42 @@ static const ProtobufCFieldDescriptor rpc__resp__wifi_scan_get_ap_records__field
     0,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "packed_records",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BYTES,
+    0,   /* quantifier_offset */
+    offsetof(RpcRespWifiScanGetApRecords, packed_records),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "packed_rec_len",
+    5,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcRespWifiScanGetApRecords, packed_rec_len),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
 };
 static const unsigned rpc__resp__wifi_scan_get_ap_records__field_indices_by_name[] = {
   2,   /* field[2] = ap_records */
   1,   /* field[1] = number */
+  4,   /* field[4] = packed_rec_len */
+  3,   /* field[3] = packed_records */
   0,   /* field[0] = resp */
 };
 static const ProtobufCIntRange rpc__resp__wifi_scan_get_ap_records__number_ranges[1 + 1] =
 {
   { 1, 0 },
-  { 0, 3 }
+  { 0, 5 }
 };
 const ProtobufCMessageDescriptor rpc__resp__wifi_scan_get_ap_records__descriptor =
 {
@@ -14499,7 +14654,7 @@ const ProtobufCMessageDescriptor rpc__resp__wifi_scan_get_ap_records__descriptor
   "RpcRespWifiScanGetApRecords",
   "",
   sizeof(RpcRespWifiScanGetApRecords),
-  3,
+  5,
   rpc__resp__wifi_scan_get_ap_records__field_descriptors,
   rpc__resp__wifi_scan_get_ap_records__field_indices_by_name,
   1,  rpc__resp__wifi_scan_get_ap_records__number_ranges,
@@ -15807,9 +15962,29 @@ const ProtobufCMessageDescriptor rpc__resp__wifi_get_country__descriptor =
   (ProtobufCMessageInit) rpc__resp__wifi_get_country__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-#define rpc__req__wifi_ap_get_sta_list__field_descriptors NULL
-#define rpc__req__wifi_ap_get_sta_list__field_indices_by_name NULL
-#define rpc__req__wifi_ap_get_sta_list__number_ranges NULL
+static const ProtobufCFieldDescriptor rpc__req__wifi_ap_get_sta_list__field_descriptors[1] =
+{
+  {
+    "packed",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BOOL,
+    0,   /* quantifier_offset */
+    offsetof(RpcReqWifiApGetStaList, packed),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__req__wifi_ap_get_sta_list__field_indices_by_name[] = {
+  0,   /* field[0] = packed */
+};
+static const ProtobufCIntRange rpc__req__wifi_ap_get_sta_list__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
 const ProtobufCMessageDescriptor rpc__req__wifi_ap_get_sta_list__descriptor =
 {
   PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
@@ -15818,14 +15993,14 @@ const ProtobufCMessageDescriptor rpc__req__wifi_ap_get_sta_list__descriptor =
   "RpcReqWifiApGetStaList",
   "",
   sizeof(RpcReqWifiApGetStaList),
-  0,
+  1,
   rpc__req__wifi_ap_get_sta_list__field_descriptors,
   rpc__req__wifi_ap_get_sta_list__field_indices_by_name,
-  0,  rpc__req__wifi_ap_get_sta_list__number_ranges,
+  1,  rpc__req__wifi_ap_get_sta_list__number_ranges,
   (ProtobufCMessageInit) rpc__req__wifi_ap_get_sta_list__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor rpc__resp__wifi_ap_get_sta_list__field_descriptors[2] =
+static const ProtobufCFieldDescriptor rpc__resp__wifi_ap_get_sta_list__field_descriptors[4] =
 {
   {
     "resp",
@@ -15851,15 +16026,41 @@ static const ProtobufCFieldDescriptor rpc__resp__wifi_ap_get_sta_list__field_des
     0,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "packed_sta",
+    3,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_BYTES,
+    0,   /* quantifier_offset */
+    offsetof(RpcRespWifiApGetStaList, packed_sta),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "packed_rec_len",
+    4,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_UINT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcRespWifiApGetStaList, packed_rec_len),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
 };
 static const unsigned rpc__resp__wifi_ap_get_sta_list__field_indices_by_name[] = {
+  3,   /* field[3] = packed_rec_len */
+  2,   /* field[2] = packed_sta */
   0,   /* field[0] = resp */
   1,   /* field[1] = sta_list */
 };
 static const ProtobufCIntRange rpc__resp__wifi_ap_get_sta_list__number_ranges[1 + 1] =
 {
   { 1, 0 },
-  { 0, 2 }
+  { 0, 4 }
 };
 const ProtobufCMessageDescriptor rpc__resp__wifi_ap_get_sta_list__descriptor =
 {
@@ -15869,7 +16070,7 @@ const ProtobufCMessageDescriptor rpc__resp__wifi_ap_get_sta_list__descriptor =
   "RpcRespWifiApGetStaList",
   "",
   sizeof(RpcRespWifiApGetStaList),
-  2,
+  4,
   rpc__resp__wifi_ap_get_sta_list__field_descriptors,
   rpc__resp__wifi_ap_get_sta_list__field_indices_by_name,
   1,  rpc__resp__wifi_ap_get_sta_list__number_ranges,
@@ -18951,7 +19152,96 @@ const ProtobufCMessageDescriptor rpc__event__sta_itwt_probe__descriptor =
   (ProtobufCMessageInit) rpc__event__sta_itwt_probe__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
-static const ProtobufCFieldDescriptor rpc__field_descriptors[148] =
+static const ProtobufCFieldDescriptor rpc__req__batch__field_descriptors[1] =
+{
+  {
+    "reqs",
+    1,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(RpcReqBatch, n_reqs),
+    offsetof(RpcReqBatch, reqs),
+    &rpc__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__req__batch__field_indices_by_name[] = {
+  0,   /* field[0] = reqs */
+};
+static const ProtobufCIntRange rpc__req__batch__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 1 }
+};
+const ProtobufCMessageDescriptor rpc__req__batch__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "Rpc_Req_Batch",
+  "RpcReqBatch",
+  "RpcReqBatch",
+  "",
+  sizeof(RpcReqBatch),
+  1,
+  rpc__req__batch__field_descriptors,
+  rpc__req__batch__field_indices_by_name,
+  1,  rpc__req__batch__number_ranges,
+  (ProtobufCMessageInit) rpc__req__batch__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor rpc__resp__batch__field_descriptors[2] =
+{
+  {
+    "resp",
+    1,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_INT32,
+    0,   /* quantifier_offset */
+    offsetof(RpcRespBatch, resp),
+    NULL,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+  {
+    "resps",
+    2,
+    PROTOBUF_C_LABEL_REPEATED,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(RpcRespBatch, n_resps),
+    offsetof(RpcRespBatch, resps),
+    &rpc__descriptor,
+    NULL,
+    0,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
+};
+static const unsigned rpc__resp__batch__field_indices_by_name[] = {
+  0,   /* field[0] = resp */
+  1,   /* field[1] = resps */
+};
+static const ProtobufCIntRange rpc__resp__batch__number_ranges[1 + 1] =
+{
+  { 1, 0 },
+  { 0, 2 }
+};
+const ProtobufCMessageDescriptor rpc__resp__batch__descriptor =
+{
+  PROTOBUF_C__MESSAGE_DESCRIPTOR_MAGIC,
+  "Rpc_Resp_Batch",
+  "RpcRespBatch",
+  "RpcRespBatch",
+  "",
+  sizeof(RpcRespBatch),
+  2,
+  rpc__resp__batch__field_descriptors,
+  rpc__resp__batch__field_indices_by_name,
+  1,  rpc__resp__batch__number_ranges,
+  (ProtobufCMessageInit) rpc__resp__batch__init,
+  NULL,NULL,NULL    /* reserved[123] */
+};
+static const ProtobufCFieldDescriptor rpc__field_descriptors[150] =
 {
   {
     "msg_type",
@@ -19781,6 +20071,18 @@ static const ProtobufCFieldDescriptor rpc__field_descriptors[148] =
     0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "req_batch",
+    361,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Rpc, payload_case),
+    offsetof(Rpc, req_batch),
+    &rpc__req__batch__descriptor,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
   {
     "resp_get_mac_address",
     513,
@@ -20573,6 +20875,18 @@ static const ProtobufCFieldDescriptor rpc__field_descriptors[148] =
     0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
     0,NULL,NULL    /* reserved1,reserved2, etc */
   },
+  {
+    "resp_batch",
+    617,
+    PROTOBUF_C_LABEL_NONE,
+    PROTOBUF_C_TYPE_MESSAGE,
+    offsetof(Rpc, payload_case),
+    offsetof(Rpc, resp_batch),
+    &rpc__resp__batch__descriptor,
+    NULL,
+    0 | PROTOBUF_C_FIELD_FLAG_ONEOF,             /* flags */
+    0,NULL,NULL    /* reserved1,reserved2, etc */
+  },
   {
     "event_esp_init",
     769,
@@ -20731,21 +21045,22 @@ static const ProtobufCFieldDescriptor rpc__field_descriptors[148] =
   },
 };
 static const unsigned rpc__field_indices_by_name[] = {
-  137,   /* field[137] = event_ap_sta_connected */
-  138,   /* field[138] = event_ap_sta_disconnected */
-  143,   /* field[143] = event_dhcp_dns */
-  135,   /* field[135] = event_esp_init */
-  136,   /* field[136] = event_heartbeat */
-  141,   /* field[141] = event_sta_connected */
-  142,   /* field[142] = event_sta_disconnected */
-  147,   /* field[147] = event_sta_itwt_probe */
-  144,   /* field[144] = event_sta_itwt_setup */
-  146,   /* field[146] = event_sta_itwt_suspend */
-  145,   /* field[145] = event_sta_itwt_teardown */
-  140,   /* field[140] = event_sta_scan_done */
-  139,   /* field[139] = event_wifi_event_no_args */
+  139,   /* field[139] = event_ap_sta_connected */
+  140,   /* field[140] = event_ap_sta_disconnected */
+  145,   /* field[145] = event_dhcp_dns */
+  137,   /* field[137] = event_esp_init */
+  138,   /* field[138] = event_heartbeat */
+  143,   /* field[143] = event_sta_connected */
+  144,   /* field[144] = event_sta_disconnected */
+  149,   /* field[149] = event_sta_itwt_probe */
+  146,   /* field[146] = event_sta_itwt_setup */
+  148,   /* field[148] = event_sta_itwt_suspend */
+  147,   /* field[147] = event_sta_itwt_teardown */
+  142,   /* field[142] = event_sta_scan_done */
+  141,   /* field[141] = event_wifi_event_no_args */
   1,   /* field[1] = msg_id */
   0,   /* field[0] = msg_type */
+  69,   /* field[69] = req_batch */
   14,   /* field[14] = req_config_heartbeat */
   58,   /* field[58] = req_get_coprocessor_fwversion */
   61,   /* field[61] = req_get_dhcp_dns */
@@ -20812,72 +21127,73 @@ static const unsigned rpc__field_indices_by_name[] = {
   62,   /* field[62] = req_wifi_sta_twt_config */
   17,   /* field[17] = req_wifi_start */
   18,   /* field[18] = req_wifi_stop */
-  80,   /* field[80] = resp_config_heartbeat */
-  124,   /* field[124] = resp_get_coprocessor_fwversion */
-  127,   /* field[127] = resp_get_dhcp_dns */
-  69,   /* field[69] = resp_get_mac_address */
-  79,   /* field[79] = resp_get_wifi_max_tx_power */
-  71,   /* field[71] = resp_get_wifi_mode */
-  75,   /* field[75] = resp_ota_begin */
-  77,   /* field[77] = resp_ota_end */
-  76,   /* field[76] = resp_ota_write */
-  126,   /* field[126] = resp_set_dhcp_dns */
-  70,   /* field[70] = resp_set_mac_address */
-  78,   /* field[78] = resp_set_wifi_max_tx_power */
-  72,   /* field[72] = resp_set_wifi_mode */
-  107,   /* field[107] = resp_wifi_ap_get_sta_aid */
-  106,   /* field[106] = resp_wifi_ap_get_sta_list */
-  93,   /* field[93] = resp_wifi_clear_ap_list */
-  95,   /* field[95] = resp_wifi_clear_fast_connect */
-  85,   /* field[85] = resp_wifi_connect */
-  96,   /* field[96] = resp_wifi_deauth_sta */
-  82,   /* field[82] = resp_wifi_deinit */
-  86,   /* field[86] = resp_wifi_disconnect */
-  121,   /* field[121] = resp_wifi_get_band */
-  123,   /* field[123] = resp_wifi_get_bandmode */
-  101,   /* field[101] = resp_wifi_get_bandwidth */
-  119,   /* field[119] = resp_wifi_get_bandwidths */
-  103,   /* field[103] = resp_wifi_get_channel */
-  88,   /* field[88] = resp_wifi_get_config */
-  105,   /* field[105] = resp_wifi_get_country */
-  112,   /* field[112] = resp_wifi_get_country_code */
-  110,   /* field[110] = resp_wifi_get_inactive_time */
-  99,   /* field[99] = resp_wifi_get_protocol */
-  117,   /* field[117] = resp_wifi_get_protocols */
-  74,   /* field[74] = resp_wifi_get_ps */
-  81,   /* field[81] = resp_wifi_init */
-  94,   /* field[94] = resp_wifi_restore */
-  91,   /* field[91] = resp_wifi_scan_get_ap_num */
-  125,   /* field[125] = resp_wifi_scan_get_ap_record */
-  92,   /* field[92] = resp_wifi_scan_get_ap_records */
-  89,   /* field[89] = resp_wifi_scan_start */
-  90,   /* field[90] = resp_wifi_scan_stop */
-  120,   /* field[120] = resp_wifi_set_band */
-  122,   /* field[122] = resp_wifi_set_bandmode */
-  100,   /* field[100] = resp_wifi_set_bandwidth */
-  118,   /* field[118] = resp_wifi_set_bandwidths */
-  102,   /* field[102] = resp_wifi_set_channel */
-  87,   /* field[87] = resp_wifi_set_config */
-  104,   /* field[104] = resp_wifi_set_country */
-  111,   /* field[111] = resp_wifi_set_country_code */
-  109,   /* field[109] = resp_wifi_set_inactive_time */
-  98,   /* field[98] = resp_wifi_set_protocol */
-  116,   /* field[116] = resp_wifi_set_protocols */
-  73,   /* field[73] = resp_wifi_set_ps */
-  108,   /* field[108] = resp_wifi_set_storage */
-  113,   /* field[113] = resp_wifi_sta_get_aid */
-  97,   /* field[97] = resp_wifi_sta_get_ap_info */
-  114,   /* field[114] = resp_wifi_sta_get_negotiated_phymode */
-  115,   /* field[115] = resp_wifi_sta_get_rssi */
-  132,   /* field[132] = resp_wifi_sta_itwt_get_flow_id_status */
-  133,   /* field[133] = resp_wifi_sta_itwt_send_probe_req */
-  134,   /* field[134] = resp_wifi_sta_itwt_set_target_wake_time_offset */
-  129,   /* field[129] = resp_wifi_sta_itwt_setup */
-  131,   /* field[131] = resp_wifi_sta_itwt_suspend */
-  130,   /* field[130] = resp_wifi_sta_itwt_teardown */
-  128,   /* field[128] = resp_wifi_sta_twt_config */
-  83,   /* field[83] = resp_wifi_start */
-  84,   /* field[84] = resp_wifi_stop */
+  136,   /* field[136] = resp_batch */
+  81,   /* field[81] = resp_config_heartbeat */
+  125,   /* field[125] = resp_get_coprocessor_fwversion */
+  128,   /* field[128] = resp_get_dhcp_dns */
+  70,   /* field[70] = resp_get_mac_address */
+  80,   /* field[80] = resp_get_wifi_max_tx_power */
+  72,   /* field[72] = resp_get_wifi_mode */
+  76,   /* field[76] = resp_ota_begin */
+  78,   /* field[78] = resp_ota_end */
+  77,   /* field[77] = resp_ota_write */
+  127,   /* field[127] = resp_set_dhcp_dns */
+  71,   /* field[71] = resp_set_mac_address */
+  79,   /* field[79] = resp_set_wifi_max_tx_power */
+  73,   /* field[73] = resp_set_wifi_mode */
+  108,   /* field[108] = resp_wifi_ap_get_sta_aid */
+  107,   /* field[107] = resp_wifi_ap_get_sta_list */
+  94,   /* field[94] = resp_wifi_clear_ap_list */
+  96,   /* field[96] = resp_wifi_clear_fast_connect */
+  86,   /* field[86] = resp_wifi_connect */
+  97,   /* field[97] = resp_wifi_deauth_sta */
+  83,   /* field[83] = resp_wifi_deinit */
+  87,   /* field[87] = resp_wifi_disconnect */
+  122,   /* field[122] = resp_wifi_get_band */
+  124,   /* field[124] = resp_wifi_get_bandmode */
+  102,   /* field[102] = resp_wifi_get_bandwidth */
+  120,   /* field[120] = resp_wifi_get_bandwidths */
+  104,   /* field[104] = resp_wifi_get_channel */
+  89,   /* field[89] = resp_wifi_get_config */
+  106,   /* field[106] = resp_wifi_get_country */
+  113,   /* field[113] = resp_wifi_get_country_code */
+  111,   /* field[111] = resp_wifi_get_inactive_time */
+  100,   /* field[100] = resp_wifi_get_protocol */
+  118,   /* field[118] = resp_wifi_get_protocols */
+  75,   /* field[75] = resp_wifi_get_ps */
+  82,   /* field[82] = resp_wifi_init */
+  95,   /* field[95] = resp_wifi_restore */
+  92,   /* field[92] = resp_wifi_scan_get_ap_num */
+  126,   /* field[126] = resp_wifi_scan_get_ap_record */
+  93,   /* field[93] = resp_wifi_scan_get_ap_records */
+  90,   /* field[90] = resp_wifi_scan_start */
+  91,   /* field[91] = resp_wifi_scan_stop */
+  121,   /* field[121] = resp_wifi_set_band */
+  123,   /* field[123] = resp_wifi_set_bandmode */
+  101,   /* field[101] = resp_wifi_set_bandwidth */
+  119,   /* field[119] = resp_wifi_set_bandwidths */
+  103,   /* field[103] = resp_wifi_set_channel */
+  88,   /* field[88] = resp_wifi_set_config */
+  105,   /* field[105] = resp_wifi_set_country */
+  112,   /* field[112] = resp_wifi_set_country_code */
+  110,   /* field[110] = resp_wifi_set_inactive_time */
+  99,   /* field[99] = resp_wifi_set_protocol */
+  117,   /* field[117] = resp_wifi_set_protocols */
+  74,   /* field[74] = resp_wifi_set_ps */
+  109,   /* field[109] = resp_wifi_set_storage */
+  114,   /* field[114] = resp_wifi_sta_get_aid */
+  98,   /* field[98] = resp_wifi_sta_get_ap_info */
+  115,   /* field[115] = resp_wifi_sta_get_negotiated_phymode */
+  116,   /* field[116] = resp_wifi_sta_get_rssi */
+  133,   /* field[133] = resp_wifi_sta_itwt_get_flow_id_status */
+  134,   /* field[134] = resp_wifi_sta_itwt_send_probe_req */
+  135,   /* field[135] = resp_wifi_sta_itwt_set_target_wake_time_offset */
+  130,   /* field[130] = resp_wifi_sta_itwt_setup */
+  132,   /* field[132] = resp_wifi_sta_itwt_suspend */
+  131,   /* field[131] = resp_wifi_sta_itwt_teardown */
+  129,   /* field[129] = resp_wifi_sta_twt_config */
+  84,   /* field[84] = resp_wifi_start */
+  85,   /* field[85] = resp_wifi_stop */
   2,   /* field[2] = uid */
 };
 static const ProtobufCIntRange rpc__number_ranges[18 + 1] =
@@ -20891,16 +21207,16 @@ static const ProtobufCIntRange rpc__number_ranges[18 + 1] =
   { 334, 45 },
   { 338, 47 },
   { 341, 49 },
-  { 513, 69 },
-  { 526, 73 },
-  { 553, 98 },
-  { 567, 106 },
-  { 581, 109 },
-  { 590, 111 },
-  { 594, 113 },
-  { 597, 115 },
-  { 769, 135 },
-  { 0, 148 }
+  { 513, 70 },
+  { 526, 74 },
+  { 553, 99 },
+  { 567, 107 },
+  { 581, 110 },
+  { 590, 112 },
+  { 594, 114 },
+  { 597, 116 },
+  { 769, 137 },
+  { 0, 150 }
 };
 const ProtobufCMessageDescriptor rpc__descriptor =
 {
@@ -20910,7 +21226,7 @@ const ProtobufCMessageDescriptor rpc__descriptor =
   "Rpc",
   "",
   sizeof(Rpc),
-  148,
+  150,
   rpc__field_descriptors,
   rpc__field_indices_by_name,
   18,  rpc__number_ranges,
@@ -21087,7 +21403,7 @@ const ProtobufCEnumDescriptor rpc_type__descriptor =
   rpc_type__value_ranges,
   NULL,NULL,NULL,NULL   /* reserved[1234] */
 };
-static const ProtobufCEnumValue rpc_id__enum_values_by_number[206] =
+static const ProtobufCEnumValue rpc_id__enum_values_by_number[208] =
 {
   { "MsgId_Invalid", "RPC_ID__MsgId_Invalid", 0 },
   { "Req_Base", "RPC_ID__Req_Base", 256 },
@@ -21184,7 +21500,8 @@ static const ProtobufCEnumValue rpc_id__enum_values_by_number[206] =
   { "Req_WifiStaItwtGetFlowIdStatus", "RPC_ID__Req_WifiStaItwtGetFlowIdStatus", 358 },
   { "Req_WifiStaItwtSendProbeReq", "RPC_ID__Req_WifiStaItwtSendProbeReq", 359 },
   { "Req_WifiStaItwtSetTargetWakeTimeOffset", "RPC_ID__Req_WifiStaItwtSetTargetWakeTimeOffset", 360 },
-  { "Req_Max", "RPC_ID__Req_Max", 361 },
+  { "Req_Batch", "RPC_ID__Req_Batch", 361 },
+  { "Req_Max", "RPC_ID__Req_Max", 362 },
   { "Resp_Base", "RPC_ID__Resp_Base", 512 },
   { "Resp_GetMACAddress", "RPC_ID__Resp_GetMACAddress", 513 },
   { "Resp_SetMacAddress", "RPC_ID__Resp_SetMacAddress", 514 },
@@ -21279,7 +21596,8 @@ static const ProtobufCEnumValue rpc_id__enum_values_by_number[206] =
   { "Resp_WifiStaItwtGetFlowIdStatus", "RPC_ID__Resp_WifiStaItwtGetFlowIdStatus", 614 },
   { "Resp_WifiStaItwtSendProbeReq", "RPC_ID__Resp_WifiStaItwtSendProbeReq", 615 },
   { "Resp_WifiStaItwtSetTargetWakeTimeOffset", "RPC_ID__Resp_WifiStaItwtSetTargetWakeTimeOffset", 616 },
-  { "Resp_Max", "RPC_ID__Resp_Max", 617 },
+  { "Resp_Batch", "RPC_ID__Resp_Batch", 617 },
+  { "Resp_Max", "RPC_ID__Resp_Max", 618 },
   { "Event_Base", "RPC_ID__Event_Base", 768 },
   { "Event_ESPInit", "RPC_ID__Event_ESPInit", 769 },
   { "Event_Heartbeat", "RPC_ID__Event_Heartbeat", 770 },
@@ -21297,33 +21615,34 @@ static const ProtobufCEnumValue rpc_id__enum_values_by_number[206] =
   { "Event_Max", "RPC_ID__Event_Max", 782 },
 };
 static const ProtobufCIntRange rpc_id__value_ranges[] = {
-{0, 0},{256, 1},{270, 6},{297, 31},{512, 96},{526, 101},{553, 126},{768, 191},{0, 206}
-};
-static const ProtobufCEnumValueIndex rpc_id__enum_values_by_name[206] =
-{
-  { "Event_AP_StaConnected", 194 },
-  { "Event_AP_StaDisconnected", 195 },
-  { "Event_Base", 191 },
-  { "Event_DhcpDnsStatus", 200 },
-  { "Event_ESPInit", 192 },
-  { "Event_Heartbeat", 193 },
-  { "Event_Max", 205 },
-  { "Event_StaConnected", 198 },
-  { "Event_StaDisconnected", 199 },
-  { "Event_StaItwtProbe", 204 },
-  { "Event_StaItwtSetup", 201 },
-  { "Event_StaItwtSuspend", 203 },
-  { "Event_StaItwtTeardown", 202 },
-  { "Event_StaScanDone", 197 },
-  { "Event_WifiEventNoArgs", 196 },
+{0, 0},{256, 1},{270, 6},{297, 31},{512, 97},{526, 102},{553, 127},{768, 193},{0, 208}
+};
+static const ProtobufCEnumValueIndex rpc_id__enum_values_by_name[208] =
+{
+  { "Event_AP_StaConnected", 196 },
+  { "Event_AP_StaDisconnected", 197 },
+  { "Event_Base", 193 },
+  { "Event_DhcpDnsStatus", 202 },
+  { "Event_ESPInit", 194 },
+  { "Event_Heartbeat", 195 },
+  { "Event_Max", 207 },
+  { "Event_StaConnected", 200 },
+  { "Event_StaDisconnected", 201 },
+  { "Event_StaItwtProbe", 206 },
+  { "Event_StaItwtSetup", 203 },
+  { "Event_StaItwtSuspend", 205 },
+  { "Event_StaItwtTeardown", 204 },
+  { "Event_StaScanDone", 199 },
+  { "Event_WifiEventNoArgs", 198 },
   { "MsgId_Invalid", 0 },
   { "Req_Base", 1 },
+  { "Req_Batch", 95 },
   { "Req_ConfigHeartbeat", 13 },
   { "Req_GetCoprocessorFwVersion", 84 },
   { "Req_GetDhcpDnsStatus", 87 },
   { "Req_GetMACAddress", 2 },
   { "Req_GetWifiMode", 4 },
-  { "Req_Max", 95 },
+  { "Req_Max", 96 },
   { "Req_OTABegin", 8 },
   { "Req_OTAEnd", 10 },
   { "Req_OTAWrite", 9 },
@@ -21412,101 +21731,102 @@ static const ProtobufCEnumValueIndex rpc_id__enum_values_by_name[206] =
   { "Req_WifiStart", 16 },
   { "Req_WifiStatisDump", 61 },
   { "Req_WifiStop", 17 },
-  { "Resp_Base", 96 },
-  { "Resp_ConfigHeartbeat", 108 },
-  { "Resp_GetCoprocessorFwVersion", 179 },
-  { "Resp_GetDhcpDnsStatus", 182 },
-  { "Resp_GetMACAddress", 97 },
-  { "Resp_GetWifiMode", 99 },
-  { "Resp_Max", 190 },
-  { "Resp_OTABegin", 103 },
-  { "Resp_OTAEnd", 105 },
-  { "Resp_OTAWrite", 104 },
-  { "Resp_SetDhcpDnsStatus", 181 },
-  { "Resp_SetMacAddress", 98 },
-  { "Resp_SetWifiMode", 100 },
-  { "Resp_Wifi80211Tx", 146 },
-  { "Resp_WifiApGetStaAid", 141 },
-  { "Resp_WifiApGetStaList", 140 },
-  { "Resp_WifiClearApList", 121 },
-  { "Resp_WifiClearFastConnect", 123 },
-  { "Resp_WifiConfig11bRate", 161 },
-  { "Resp_WifiConfig80211TxRate", 165 },
-  { "Resp_WifiConnect", 113 },
-  { "Resp_WifiConnectionlessModuleSetWakeInterval", 162 },
-  { "Resp_WifiDeauthSta", 124 },
-  { "Resp_WifiDeinit", 110 },
-  { "Resp_WifiDisablePmfConfig", 166 },
-  { "Resp_WifiDisconnect", 114 },
-  { "Resp_WifiFtmEndSession", 159 },
-  { "Resp_WifiFtmInitiateSession", 158 },
-  { "Resp_WifiFtmRespSetOffset", 160 },
-  { "Resp_WifiGetAnt", 152 },
-  { "Resp_WifiGetAntGpio", 150 },
-  { "Resp_WifiGetBand", 176 },
-  { "Resp_WifiGetBandMode", 178 },
-  { "Resp_WifiGetBandwidth", 129 },
-  { "Resp_WifiGetBandwidths", 174 },
-  { "Resp_WifiGetChannel", 131 },
-  { "Resp_WifiGetConfig", 116 },
-  { "Resp_WifiGetCountry", 133 },
-  { "Resp_WifiGetCountryCode", 164 },
-  { "Resp_WifiGetEventMask", 145 },
-  { "Resp_WifiGetInactiveTime", 155 },
-  { "Resp_WifiGetMaxTxPower", 107 },
-  { "Resp_WifiGetPromiscuous", 135 },
-  { "Resp_WifiGetPromiscuousCtrlFilter", 139 },
-  { "Resp_WifiGetPromiscuousFilter", 137 },
-  { "Resp_WifiGetProtocol", 127 },
-  { "Resp_WifiGetProtocols", 172 },
-  { "Resp_WifiGetPs", 102 },
-  { "Resp_WifiGetTsfTime", 153 },
-  { "Resp_WifiInit", 109 },
-  { "Resp_WifiRestore", 122 },
-  { "Resp_WifiScanGetApNum", 119 },
-  { "Resp_WifiScanGetApRecord", 180 },
-  { "Resp_WifiScanGetApRecords", 120 },
-  { "Resp_WifiScanStart", 117 },
-  { "Resp_WifiScanStop", 118 },
-  { "Resp_WifiSetAnt", 151 },
-  { "Resp_WifiSetAntGpio", 149 },
-  { "Resp_WifiSetBand", 175 },
-  { "Resp_WifiSetBandMode", 177 },
-  { "Resp_WifiSetBandwidth", 128 },
-  { "Resp_WifiSetBandwidths", 173 },
-  { "Resp_WifiSetChannel", 130 },
-  { "Resp_WifiSetConfig", 115 },
-  { "Resp_WifiSetCountry", 132 },
-  { "Resp_WifiSetCountryCode", 163 },
-  { "Resp_WifiSetCsi", 148 },
-  { "Resp_WifiSetCsiConfig", 147 },
-  { "Resp_WifiSetDynamicCs", 169 },
-  { "Resp_WifiSetEventMask", 144 },
-  { "Resp_WifiSetInactiveTime", 154 },
-  { "Resp_WifiSetMaxTxPower", 106 },
-  { "Resp_WifiSetPromiscuous", 134 },
-  { "Resp_WifiSetPromiscuousCtrlFilter", 138 },
-  { "Resp_WifiSetPromiscuousFilter", 136 },
-  { "Resp_WifiSetProtocol", 126 },
-  { "Resp_WifiSetProtocols", 171 },
-  { "Resp_WifiSetPs", 101 },
-  { "Resp_WifiSetRssiThreshold", 157 },
-  { "Resp_WifiSetStorage", 142 },
-  { "Resp_WifiSetVendorIe", 143 },
-  { "Resp_WifiStaGetAid", 167 },
-  { "Resp_WifiStaGetApInfo", 125 },
-  { "Resp_WifiStaGetNegotiatedPhymode", 168 },
-  { "Resp_WifiStaGetRssi", 170 },
-  { "Resp_WifiStaItwtGetFlowIdStatus", 187 },
-  { "Resp_WifiStaItwtSendProbeReq", 188 },
-  { "Resp_WifiStaItwtSetTargetWakeTimeOffset", 189 },
-  { "Resp_WifiStaItwtSetup", 184 },
-  { "Resp_WifiStaItwtSuspend", 186 },
-  { "Resp_WifiStaItwtTeardown", 185 },
-  { "Resp_WifiStaTwtConfig", 183 },
-  { "Resp_WifiStart", 111 },
-  { "Resp_WifiStatisDump", 156 },
-  { "Resp_WifiStop", 112 },
+  { "Resp_Base", 97 },
+  { "Resp_Batch", 191 },
+  { "Resp_ConfigHeartbeat", 109 },
+  { "Resp_GetCoprocessorFwVersion", 180 },
+  { "Resp_GetDhcpDnsStatus", 183 },
+  { "Resp_GetMACAddress", 98 },
+  { "Resp_GetWifiMode", 100 },
+  { "Resp_Max", 192 },
+  { "Resp_OTABegin", 104 },
+  { "Resp_OTAEnd", 106 },
+  { "Resp_OTAWrite", 105 },
+  { "Resp_SetDhcpDnsStatus", 182 },
+  { "Resp_SetMacAddress", 99 },
+  { "Resp_SetWifiMode", 101 },
+  { "Resp_Wifi80211Tx", 147 },
+  { "Resp_WifiApGetStaAid", 142 },
+  { "Resp_WifiApGetStaList", 141 },
+  { "Resp_WifiClearApList", 122 },
+  { "Resp_WifiClearFastConnect", 124 },
+  { "Resp_WifiConfig11bRate", 162 },
+  { "Resp_WifiConfig80211TxRate", 166 },
+  { "Resp_WifiConnect", 114 },
+  { "Resp_WifiConnectionlessModuleSetWakeInterval", 163 },
+  { "Resp_WifiDeauthSta", 125 },
+  { "Resp_WifiDeinit", 111 },
+  { "Resp_WifiDisablePmfConfig", 167 },
+  { "Resp_WifiDisconnect", 115 },
+  { "Resp_WifiFtmEndSession", 160 },
+  { "Resp_WifiFtmInitiateSession", 159 },
+  { "Resp_WifiFtmRespSetOffset", 161 },
+  { "Resp_WifiGetAnt", 153 },
+  { "Resp_WifiGetAntGpio", 151 },
+  { "Resp_WifiGetBand", 177 },
+  { "Resp_WifiGetBandMode", 179 },
+  { "Resp_WifiGetBandwidth", 130 },
+  { "Resp_WifiGetBandwidths", 175 },
+  { "Resp_WifiGetChannel", 132 },
+  { "Resp_WifiGetConfig", 117 },
+  { "Resp_WifiGetCountry", 134 },
+  { "Resp_WifiGetCountryCode", 165 },
+  { "Resp_WifiGetEventMask", 146 },
+  { "Resp_WifiGetInactiveTime", 156 },
+  { "Resp_WifiGetMaxTxPower", 108 },
+  { "Resp_WifiGetPromiscuous", 136 },
+  { "Resp_WifiGetPromiscuousCtrlFilter", 140 },
+  { "Resp_WifiGetPromiscuousFilter", 138 },
+  { "Resp_WifiGetProtocol", 128 },
+  { "Resp_WifiGetProtocols", 173 },
+  { "Resp_WifiGetPs", 103 },
+  { "Resp_WifiGetTsfTime", 154 },
+  { "Resp_WifiInit", 110 },
+  { "Resp_WifiRestore", 123 },
+  { "Resp_WifiScanGetApNum", 120 },
+  { "Resp_WifiScanGetApRecord", 181 },
+  { "Resp_WifiScanGetApRecords", 121 },
+  { "Resp_WifiScanStart", 118 },
+  { "Resp_WifiScanStop", 119 },
+  { "Resp_WifiSetAnt", 152 },
+  { "Resp_WifiSetAntGpio", 150 },
+  { "Resp_WifiSetBand", 176 },
+  { "Resp_WifiSetBandMode", 178 },
+  { "Resp_WifiSetBandwidth", 129 },
+  { "Resp_WifiSetBandwidths", 174 },
+  { "Resp_WifiSetChannel", 131 },
+  { "Resp_WifiSetConfig", 116 },
+  { "Resp_WifiSetCountry", 133 },
+  { "Resp_WifiSetCountryCode", 164 },
+  { "Resp_WifiSetCsi", 149 },
+  { "Resp_WifiSetCsiConfig", 148 },
+  { "Resp_WifiSetDynamicCs", 170 },
+  { "Resp_WifiSetEventMask", 145 },
+  { "Resp_WifiSetInactiveTime", 155 },
+  { "Resp_WifiSetMaxTxPower", 107 },
+  { "Resp_WifiSetPromiscuous", 135 },
+  { "Resp_WifiSetPromiscuousCtrlFilter", 139 },
+  { "Resp_WifiSetPromiscuousFilter", 137 },
+  { "Resp_WifiSetProtocol", 127 },
+  { "Resp_WifiSetProtocols", 172 },
+  { "Resp_WifiSetPs", 102 },
+  { "Resp_WifiSetRssiThreshold", 158 },
+  { "Resp_WifiSetStorage", 143 },
+  { "Resp_WifiSetVendorIe", 144 },
+  { "Resp_WifiStaGetAid", 168 },
+  { "Resp_WifiStaGetApInfo", 126 },
+  { "Resp_WifiStaGetNegotiatedPhymode", 169 },
+  { "Resp_WifiStaGetRssi", 171 },
+  { "Resp_WifiStaItwtGetFlowIdStatus", 188 },
+  { "Resp_WifiStaItwtSendProbeReq", 189 },
+  { "Resp_WifiStaItwtSetTargetWakeTimeOffset", 190 },
+  { "Resp_WifiStaItwtSetup", 185 },
+  { "Resp_WifiStaItwtSuspend", 187 },
+  { "Resp_WifiStaItwtTeardown", 186 },
+  { "Resp_WifiStaTwtConfig", 184 },
+  { "Resp_WifiStart", 112 },
+  { "Resp_WifiStatisDump", 157 },
+  { "Resp_WifiStop", 113 },
 };
 const ProtobufCEnumDescriptor rpc_id__descriptor =
 {
@@ -21515,9 +21835,9 @@ const ProtobufCEnumDescriptor rpc_id__descriptor =
   "RpcId",
   "RpcId",
   "",
-  206,
+  208,
   rpc_id__enum_values_by_number,
-  206,
+  208,
   rpc_id__enum_values_by_name,
   8,
   rpc_id__value_ranges,
@@ -207,6 +207,8 @@ typedef struct RpcEventStaItwtSetup RpcEventStaItwtSetup;
 typedef struct RpcEventStaItwtTeardown RpcEventStaItwtTeardown;
 typedef struct RpcEventStaItwtSuspend RpcEventStaItwtSuspend;
 typedef struct RpcEventStaItwtProbe RpcEventStaItwtProbe;
+typedef struct RpcReqBatch RpcReqBatch;
+typedef struct RpcRespBatch RpcRespBatch;
 typedef struct Rpc Rpc;
 
 
@@ -649,14 +651,18 @@ typedef enum _RpcId {
    *0x168
    */
   RPC_ID__Req_WifiStaItwtSetTargetWakeTimeOffset = 360,
+  /*
+   *0x169
+   */
+  RPC_ID__Req_Batch = 361,
   /*
    * Add new control path command response before Req_Max
    * and update Req_Max 
    */
   /*
-   *0x169
+   *0x16a
    */
-  RPC_ID__Req_Max = 361,
+  RPC_ID__Req_Max = 362,
   /*
    ** Response Msgs *
    */
@@ -767,11 +773,12 @@ typedef enum _RpcId {
   RPC_ID__Resp_WifiStaItwtGetFlowIdStatus = 614,
   RPC_ID__Resp_WifiStaItwtSendProbeReq = 615,
   RPC_ID__Resp_WifiStaItwtSetTargetWakeTimeOffset = 616,
+  RPC_ID__Resp_Batch = 617,
   /*
    * Add new control path command response before Resp_Max
    * and update Resp_Max 
    */
-  RPC_ID__Resp_Max = 617,
+  RPC_ID__Resp_Max = 618,
   /*
    ** Event Msgs *
    */
@@ -2347,20 +2354,22 @@ struct  RpcReqOTAWrite
 {
   ProtobufCMessage base;
   ProtobufCBinaryData ota_data;
+  uint32_t seq_num;
 };
 #define RPC__REQ__OTAWRITE__INIT \
  { PROTOBUF_C_MESSAGE_INIT (&rpc__req__otawrite__descriptor) \
-    , {0,NULL} }
+    , {0,NULL}, 0 }
 
 
 struct  RpcRespOTAWrite
 {
   ProtobufCMessage base;
   int32_t resp;
+  uint32_t written_seq_num;
 };
 #define RPC__RESP__OTAWRITE__INIT \
  { PROTOBUF_C_MESSAGE_INIT (&rpc__resp__otawrite__descriptor) \
-    , 0 }
+    , 0, 0 }
 
 
 struct  RpcReqOTAEnd
@@ -2666,12 +2675,18 @@ struct  RpcReqWifiScanGetApRecords
 {
   ProtobufCMessage base;
   int32_t number;
+  protobuf_c_boolean packed;
 };
 #define RPC__REQ__WIFI_SCAN_GET_AP_RECORDS__INIT \
  { PROTOBUF_C_MESSAGE_INIT (&rpc__req__wifi_scan_get_ap_records__descriptor) \
-    , 0 }
+    , 0, 0 }
 
 
+/*
+ * If packed was requested and slave supports it, records come in
+ * packed_records as esp_hosted_ap_record_packed_t, each packed_rec_len
+ * bytes, and ap_records is empty 
+ */
 struct  RpcRespWifiScanGetApRecords
 {
   ProtobufCMessage base;
@@ -2679,10 +2694,12 @@ struct  RpcRespWifiScanGetApRecords
   int32_t number;
   size_t n_ap_records;
   WifiApRecord **ap_records;
+  ProtobufCBinaryData packed_records;
+  uint32_t packed_rec_len;
 };
 #define RPC__RESP__WIFI_SCAN_GET_AP_RECORDS__INIT \
  { PROTOBUF_C_MESSAGE_INIT (&rpc__resp__wifi_scan_get_ap_records__descriptor) \
-    , 0, 0, 0,NULL }
+    , 0, 0, 0,NULL, {0,NULL}, 0 }
 
 
 struct  RpcReqWifiScanGetApRecord
@@ -3033,21 +3050,28 @@ struct  RpcRespWifiGetCountry
 struct  RpcReqWifiApGetStaList
 {
   ProtobufCMessage base;
+  protobuf_c_boolean packed;
 };
 #define RPC__REQ__WIFI_AP_GET_STA_LIST__INIT \
  { PROTOBUF_C_MESSAGE_INIT (&rpc__req__wifi_ap_get_sta_list__descriptor) \
-     }
+    , 0 }
 
 
+/*
+ * Packed: sta_list is not set, packed_sta holds the connected stations
+ * as esp_hosted_sta_info_packed_t, each packed_rec_len bytes 
+ */
 struct  RpcRespWifiApGetStaList
 {
   ProtobufCMessage base;
   int32_t resp;
   WifiStaList *sta_list;
+  ProtobufCBinaryData packed_sta;
+  uint32_t packed_rec_len;
 };
 #define RPC__RESP__WIFI_AP_GET_STA_LIST__INIT \
  { PROTOBUF_C_MESSAGE_INIT (&rpc__resp__wifi_ap_get_sta_list__descriptor) \
-    , 0, NULL }
+    , 0, NULL, {0,NULL}, 0 }
 
 
 struct  RpcReqWifiApGetStaAid
@@ -3726,6 +3750,37 @@ struct  RpcEventStaItwtProbe
     , 0, 0, 0 }
 
 
+/*
+ * Requests executed in order by slave and answered together in one
+ * Rpc_Resp_Batch. uid of a sub request is its index in the batch.
+ * Batches do not nest 
+ */
+struct  RpcReqBatch
+{
+  ProtobufCMessage base;
+  size_t n_reqs;
+  Rpc **reqs;
+};
+#define RPC__REQ__BATCH__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&rpc__req__batch__descriptor) \
+    , 0,NULL }
+
+
+struct  RpcRespBatch
+{
+  ProtobufCMessage base;
+  int32_t resp;
+  /*
+   **< in order of reqs 
+   */
+  size_t n_resps;
+  Rpc **resps;
+};
+#define RPC__RESP__BATCH__INIT \
+ { PROTOBUF_C_MESSAGE_INIT (&rpc__resp__batch__descriptor) \
+    , 0, 0,NULL }
+
+
 typedef enum {
   RPC__PAYLOAD__NOT_SET = 0,
   RPC__PAYLOAD_REQ_GET_MAC_ADDRESS = 257,
@@ -3794,6 +3849,7 @@ typedef enum {
   RPC__PAYLOAD_REQ_WIFI_STA_ITWT_GET_FLOW_ID_STATUS = 358,
   RPC__PAYLOAD_REQ_WIFI_STA_ITWT_SEND_PROBE_REQ = 359,
   RPC__PAYLOAD_REQ_WIFI_STA_ITWT_SET_TARGET_WAKE_TIME_OFFSET = 360,
+  RPC__PAYLOAD_REQ_BATCH = 361,
   RPC__PAYLOAD_RESP_GET_MAC_ADDRESS = 513,
   RPC__PAYLOAD_RESP_SET_MAC_ADDRESS = 514,
   RPC__PAYLOAD_RESP_GET_WIFI_MODE = 515,
@@ -3860,6 +3916,7 @@ typedef enum {
   RPC__PAYLOAD_RESP_WIFI_STA_ITWT_GET_FLOW_ID_STATUS = 614,
   RPC__PAYLOAD_RESP_WIFI_STA_ITWT_SEND_PROBE_REQ = 615,
   RPC__PAYLOAD_RESP_WIFI_STA_ITWT_SET_TARGET_WAKE_TIME_OFFSET = 616,
+  RPC__PAYLOAD_RESP_BATCH = 617,
   RPC__PAYLOAD_EVENT_ESP_INIT = 769,
   RPC__PAYLOAD_EVENT_HEARTBEAT = 770,
   RPC__PAYLOAD_EVENT_AP_STA_CONNECTED = 771,
@@ -3962,6 +4019,7 @@ struct  Rpc
     RpcReqWifiStaItwtGetFlowIdStatus *req_wifi_sta_itwt_get_flow_id_status;
     RpcReqWifiStaItwtSendProbeReq *req_wifi_sta_itwt_send_probe_req;
     RpcReqWifiStaItwtSetTargetWakeTimeOffset *req_wifi_sta_itwt_set_target_wake_time_offset;
+    RpcReqBatch *req_batch;
     /*
      ** Responses *
      */
@@ -4031,6 +4089,7 @@ struct  Rpc
     RpcRespWifiStaItwtGetFlowIdStatus *resp_wifi_sta_itwt_get_flow_id_status;
     RpcRespWifiStaItwtSendProbeReq *resp_wifi_sta_itwt_send_probe_req;
     RpcRespWifiStaItwtSetTargetWakeTimeOffset *resp_wifi_sta_itwt_set_target_wake_time_offset;
+    RpcRespBatch *resp_batch;
     /*
      ** Notifications *
      */
@@ -7702,6 +7761,44 @@ RpcEventStaItwtProbe *
 void   rpc__event__sta_itwt_probe__free_unpacked
                      (RpcEventStaItwtProbe *message,
                       ProtobufCAllocator *allocator);
+/* RpcReqBatch methods */
+void   rpc__req__batch__init
+                     (RpcReqBatch         *message);
+size_t rpc__req__batch__get_packed_size
+                     (const RpcReqBatch   *message);
+size_t rpc__req__batch__pack
+                     (const RpcReqBatch   *message,
+                      uint8_t             *out);
+size_t rpc__req__batch__pack_to_buffer
+                     (const RpcReqBatch   *message,
+                      ProtobufCBuffer     *buffer);
+RpcReqBatch *
+       rpc__req__batch__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   rpc__req__batch__free_unpacked
+                     (RpcReqBatch *message,
+                      ProtobufCAllocator *allocator);
+/* RpcRespBatch methods */
+void   rpc__resp__batch__init
+                     (RpcRespBatch         *message);
+size_t rpc__resp__batch__get_packed_size
+                     (const RpcRespBatch   *message);
+size_t rpc__resp__batch__pack
+                     (const RpcRespBatch   *message,
+                      uint8_t             *out);
+size_t rpc__resp__batch__pack_to_buffer
+                     (const RpcRespBatch   *message,
+                      ProtobufCBuffer     *buffer);
+RpcRespBatch *
+       rpc__resp__batch__unpack
+                     (ProtobufCAllocator  *allocator,
+                      size_t               len,
+                      const uint8_t       *data);
+void   rpc__resp__batch__free_unpacked
+                     (RpcRespBatch *message,
+                      ProtobufCAllocator *allocator);
 /* Rpc methods */
 void   rpc__init
                      (Rpc         *message);
@@ -8299,6 +8396,12 @@ typedef void (*RpcEventStaItwtSuspend_Closure)
 typedef void (*RpcEventStaItwtProbe_Closure)
                  (const RpcEventStaItwtProbe *message,
                   void *closure_data);
+typedef void (*RpcReqBatch_Closure)
+                 (const RpcReqBatch *message,
+                  void *closure_data);
+typedef void (*RpcRespBatch_Closure)
+                 (const RpcRespBatch *message,
+                  void *closure_data);
 typedef void (*Rpc_Closure)
                  (const Rpc *message,
                   void *closure_data);
@@ -8506,6 +8609,8 @@ extern const ProtobufCMessageDescriptor rpc__event__sta_itwt_setup__descriptor;
 extern const ProtobufCMessageDescriptor rpc__event__sta_itwt_teardown__descriptor;
 extern const ProtobufCMessageDescriptor rpc__event__sta_itwt_suspend__descriptor;
 extern const ProtobufCMessageDescriptor rpc__event__sta_itwt_probe__descriptor;
+extern const ProtobufCMessageDescriptor rpc__req__batch__descriptor;
+extern const ProtobufCMessageDescriptor rpc__resp__batch__descriptor;
 extern const ProtobufCMessageDescriptor rpc__descriptor;
 
 PROTOBUF_C__END_DECLS
@@ -0,0 +1,162 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0-only OR Apache-2.0 */
+
+/* Per transaction bump arena for RPC protobuf messages
+ *
+ * Base buffer is bumped from the start. When full, heap chunks of at
+ * least the base size are chained and bumped the same way. Reset rewinds
+ * the base and frees the chunks.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_hosted_rpc_arena.h"
+
+#define ARENA_ALIGN           8
+#define ARENA_ALIGN_UP(x)     (((x) + (ARENA_ALIGN - 1)) & ~((size_t)ARENA_ALIGN - 1))
+
+struct esp_hosted_rpc_arena_chunk {
+	esp_hosted_rpc_arena_chunk_t *next;
+	uint32_t size;
+	uint32_t used;
+	uint64_t data[];
+};
+
+static void *arena_pb_alloc(void *allocator_data, size_t size)
+{
+	return esp_hosted_rpc_arena_calloc(allocator_data, 1, size);
+}
+
+static void arena_pb_free(void *allocator_data, void *ptr)
+{
+	if (ptr && !esp_hosted_rpc_arena_owns(allocator_data, ptr))
+		free(ptr);
+}
+
+int esp_hosted_rpc_arena_init(esp_hosted_rpc_arena_t *arena, uint32_t size)
+{
+	memset(arena, 0, sizeof(*arena));
+
+	size = ARENA_ALIGN_UP(size);
+	arena->base = malloc(size);
+	if (!arena->base)
+		return -1;
+
+	arena->size = size;
+	arena->stats.size = size;
+	arena->allocator.alloc = arena_pb_alloc;
+	arena->allocator.free = arena_pb_free;
+	arena->allocator.allocator_data = arena;
+	return 0;
+}
+
+void esp_hosted_rpc_arena_deinit(esp_hosted_rpc_arena_t *arena)
+{
+	esp_hosted_rpc_arena_reset(arena);
+	free(arena->base);
+	arena->base = NULL;
+	arena->size = 0;
+}
+
+static void *arena_spill(esp_hosted_rpc_arena_t *arena, size_t len)
+{
+	esp_hosted_rpc_arena_chunk_t *chunk = arena->chunks;
+	size_t chunk_size = 0;
+
+	if (chunk && chunk->size - chunk->used >= len) {
+		chunk->used += len;
+		arena->spilled += len;
+		return (uint8_t *)chunk->data + chunk->used - len;
+	}
+
+	chunk_size = len > arena->size ? len : arena->size;
+	chunk = malloc(sizeof(*chunk) + chunk_size);
+	if (!chunk)
+		return NULL;
+
+	chunk->size = chunk_size;
+	chunk->used = len;
+	chunk->next = arena->chunks;
+	arena->chunks = chunk;
+	arena->spilled += len;
+	return chunk->data;
+}
+
+void *esp_hosted_rpc_arena_calloc(esp_hosted_rpc_arena_t *arena, size_t num, size_t size)
+{
+	size_t len = 0;
+	void *ptr = NULL;
+
+	if (size && num > SIZE_MAX / size)
+		return NULL;
+
+	/* protobuf-c asks for zero bytes for empty repeated fields */
+	len = num * size;
+	len = ARENA_ALIGN_UP(len ? len : 1);
+
+	if (arena->size - arena->used >= len) {
+		ptr = arena->base + arena->used;
+		arena->used += len;
+	} else {
+		ptr = arena_spill(arena, len);
+		if (!ptr)
+			return NULL;
+	}
+
+	memset(ptr, 0, len);
+	return ptr;
+}
+
+char *esp_hosted_rpc_arena_strndup(esp_hosted_rpc_arena_t *arena, const char *str, size_t max_len)
+{
+	size_t len = strnlen(str, max_len);
+	char *dup = esp_hosted_rpc_arena_calloc(arena, 1, len + 1);
+
+	if (dup)
+		memcpy(dup, str, len);
+	return dup;
+}
+
+int esp_hosted_rpc_arena_owns(const esp_hosted_rpc_arena_t *arena, const void *ptr)
+{
+	const uint8_t *p = ptr;
+	const esp_hosted_rpc_arena_chunk_t *chunk = NULL;
+
+	if (p >= arena->base && p < arena->base + arena->size)
+		return 1;
+
+	for (chunk = arena->chunks; chunk; chunk = chunk->next) {
+		if (p >= (const uint8_t *)chunk->data &&
+		    p < (const uint8_t *)chunk->data + chunk->size)
+			return 1;
+	}
+	return 0;
+}
+
+int esp_hosted_rpc_arena_reset(esp_hosted_rpc_arena_t *arena)
+{
+	esp_hosted_rpc_arena_chunk_t *chunk = NULL;
+	uint32_t total = arena->used + arena->spilled;
+	int new_high = 0;
+
+	if (!total)
+		return 0;
+
+	while (arena->chunks) {
+		chunk = arena->chunks;
+		arena->chunks = chunk->next;
+		free(chunk);
+	}
+
+	arena->stats.transactions++;
+	if (arena->spilled)
+		arena->stats.overflows++;
+	if (total > arena->stats.high_water) {
+		arena->stats.high_water = total;
+		new_high = 1;
+	}
+
+	arena->used = 0;
+	arena->spilled = 0;
+	return new_high;
+}
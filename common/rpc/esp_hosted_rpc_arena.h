@@ -0,0 +1,75 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0-only OR Apache-2.0 */
+
+/* Per transaction bump arena for RPC protobuf messages
+ *
+ * All nested messages, repeated arrays, strings and bytes of one RPC
+ * message are carved out of a single buffer and dropped together by
+ * esp_hosted_rpc_arena_reset() once the transaction is done, instead of
+ * a calloc/free pair for each of them.
+ *
+ * arena->allocator can be passed to rpc__unpack()/rpc__free_unpacked().
+ * Its free is a no-op for arena memory and free() for anything else, so
+ * a message mixing arena and heap buffers is still released correctly.
+ *
+ * Requests not fitting in the base buffer spill over into heap chunks,
+ * released at the next reset. Stats tell how to size the base buffer.
+ *
+ * An arena is not locked: use one per thread.
+ */
+
+#ifndef __ESP_HOSTED_RPC_ARENA__H
+#define __ESP_HOSTED_RPC_ARENA__H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "protobuf-c/protobuf-c.h"
+
+typedef struct esp_hosted_rpc_arena_chunk esp_hosted_rpc_arena_chunk_t;
+
+typedef struct {
+	uint32_t size;          /* base buffer size */
+	uint32_t high_water;    /* max bytes used by one transaction */
+	uint32_t transactions;  /* resets done */
+	uint32_t overflows;     /* transactions which needed heap chunks */
+} esp_hosted_rpc_arena_stats_t;
+
+typedef struct {
+	ProtobufCAllocator allocator;
+	uint8_t *base;
+	uint32_t size;
+	uint32_t used;
+	uint32_t spilled;
+	esp_hosted_rpc_arena_chunk_t *chunks;
+	esp_hosted_rpc_arena_stats_t stats;
+} esp_hosted_rpc_arena_t;
+
+/**
+ * @brief  Allocate base buffer and set up allocator
+ * @retval 0 on success, -1 on no memory
+ */
+int esp_hosted_rpc_arena_init(esp_hosted_rpc_arena_t *arena, uint32_t size);
+
+void esp_hosted_rpc_arena_deinit(esp_hosted_rpc_arena_t *arena);
+
+/* Zeroed, 8 byte aligned. NULL only if spill over chunk cannot be allocated */
+void *esp_hosted_rpc_arena_calloc(esp_hosted_rpc_arena_t *arena, size_t num, size_t size);
+
+/* Copy of up to max_len chars of str, always NUL terminated */
+char *esp_hosted_rpc_arena_strndup(esp_hosted_rpc_arena_t *arena, const char *str, size_t max_len);
+
+int esp_hosted_rpc_arena_owns(const esp_hosted_rpc_arena_t *arena, const void *ptr);
+
+/**
+ * @brief  Release everything allocated since last reset
+ * @retval 1 if this transaction set a new high water mark, 0 otherwise
+ */
+int esp_hosted_rpc_arena_reset(esp_hosted_rpc_arena_t *arena);
+
+static inline void esp_hosted_rpc_arena_get_stats(const esp_hosted_rpc_arena_t *arena,
+		esp_hosted_rpc_arena_stats_t *stats)
+{
+	*stats = arena->stats;
+}
+
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0-only OR Apache-2.0 */
+
+/* Packed scan and station records
+ *
+ * Used instead of repeated wifi_ap_record / wifi_sta_info protobuf
+ * messages once negotiated (ESP_RPC_PACKED_RECORDS_SUPPORT from slave,
+ * packed = true in the request). All records of a response are sent back
+ * to back in one bytes field, so neither side builds or parses a nested
+ * message per record.
+ *
+ * Layout is fixed and little endian, independent of how wifi_ap_record_t
+ * is laid out by either IDF. Bitmasks follow esp_hosted_bitmasks.h.
+ * Fields are only ever appended: a receiver copies the part it knows of
+ * each packed_rec_len sized record.
+ */
+
+#ifndef __ESP_HOSTED_WIFI_RECORDS__H
+#define __ESP_HOSTED_WIFI_RECORDS__H
+
+#include <stdint.h>
+
+#define ESP_HOSTED_PACKED_SSID_LEN              33
+
+typedef struct {
+	uint8_t          bssid[6];
+	uint8_t          ssid[ESP_HOSTED_PACKED_SSID_LEN];
+	uint8_t          primary;
+	uint8_t          second;
+	int8_t           rssi;
+	uint8_t          authmode;
+	uint8_t          pairwise_cipher;
+	uint8_t          group_cipher;
+	uint8_t          ant;
+	uint16_t         bitmask;            /* WIFI_SCAN_AP_REC_*_BIT */
+	uint8_t          country_cc[3];
+	uint8_t          country_schan;
+	uint8_t          country_nchan;
+	int8_t           country_max_tx_power;
+	uint8_t          country_policy;
+	uint8_t          he_ap_bitmask;      /* bss color, WIFI_HE_AP_INFO_*_BIT */
+	uint8_t          he_ap_bssid_index;
+	uint8_t          bandwidth;
+	uint8_t          vht_ch_freq1;
+	uint8_t          vht_ch_freq2;
+} __attribute__((packed)) esp_hosted_ap_record_packed_t;
+
+typedef struct {
+	uint8_t          mac[6];
+	int8_t           rssi;
+	uint16_t         bitmask;            /* WIFI_STA_INFO_*_BIT */
+} __attribute__((packed)) esp_hosted_sta_info_packed_t;
+
+#endif
@@ -0,0 +1,74 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0-only OR Apache-2.0 */
+
+/* Payload checksum used by all ESP-Hosted transports
+ *
+ * The checksum is the 16-bit sum of all bytes in header and payload.
+ * Bytes are summed a 32-bit word at a time: each word is split into two
+ * 16-bit lanes holding the sum of two bytes each, and the lanes are folded
+ * before they can overflow. The result is the same as the byte-wise sum,
+ * independent of endianness.
+ */
+
+#ifndef __ESP_HOSTED_CHECKSUM__H
+#define __ESP_HOSTED_CHECKSUM__H
+
+#include <stdint.h>
+#include <string.h>
+
+/* Each word adds at most 2*0xFF to a lane, 128 words stay below 0x10000 */
+#define ESP_CHECKSUM_WORDS_PER_FOLD               128
+
+/**
+ * @brief  Add the bytes in buf to a running checksum
+ *
+ * Allows the checksum to be built up over parts of a frame, e.g. payload
+ * first and header once it is filled in, with the same result as a
+ * single compute_checksum() over the whole frame.
+ */
+static inline uint16_t compute_checksum_update(uint16_t checksum,
+		const uint8_t *buf, uint32_t len)
+{
+	uint32_t sum = checksum;
+	uint32_t lanes = 0;
+	uint32_t word = 0;
+	uint32_t words = 0;
+
+	/* leading bytes, up to word alignment */
+	while (len && ((uintptr_t)buf & 3)) {
+		sum += *buf++;
+		len--;
+	}
+
+	while (len >= 4) {
+		const uint8_t *wbuf = (const uint8_t *)__builtin_assume_aligned(buf, 4);
+
+		words = len / 4;
+		if (words > ESP_CHECKSUM_WORDS_PER_FOLD)
+			words = ESP_CHECKSUM_WORDS_PER_FOLD;
+
+		buf += words * 4;
+		len -= words * 4;
+
+		lanes = 0;
+		while (words--) {
+			memcpy(&word, wbuf, sizeof(word));
+			lanes += (word & 0x00FF00FF) + ((word >> 8) & 0x00FF00FF);
+			wbuf += 4;
+		}
+		sum += (lanes & 0xFFFF) + (lanes >> 16);
+	}
+
+	/* trailing bytes */
+	while (len--)
+		sum += *buf++;
+
+	return (uint16_t)sum;
+}
+
+static inline uint16_t compute_checksum(uint8_t *buf, uint16_t len)
+{
+	return compute_checksum_update(0, buf, len);
+}
+
+#endif
@@ -0,0 +1,48 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0-only OR Apache-2.0 */
+
+/* Optional CRC32 frame integrity
+ *
+ * Once negotiated (ESP_TRANSPORT_CRC32_SUPPORT from slave, ESP_HOST_CAP_CRC32
+ * from host), a sender sets FLAG_CRC32 in the payload header and appends the
+ * CRC32 (IEEE 802.3, little endian) of header and payload right after the
+ * payload. The 16-bit header checksum is then unused and sent as 0.
+ *
+ * header->len does not include the trailer. Receivers check every frame that
+ * carries FLAG_CRC32, so both ends can switch over independently.
+ */
+
+#ifndef __ESP_HOSTED_CRC32__H
+#define __ESP_HOSTED_CRC32__H
+
+#include <stdint.h>
+#include "esp_hosted_header.h"
+
+uint32_t esp_hosted_crc32_update(uint32_t crc, const uint8_t *buf, uint32_t len);
+
+static inline uint32_t esp_hosted_crc32(const uint8_t *buf, uint32_t len)
+{
+	return esp_hosted_crc32_update(0, buf, len);
+}
+
+/* Bytes following the payload of this frame */
+static inline uint16_t esp_frame_trailer_len(const struct esp_payload_header *h)
+{
+	return (h->flags & FLAG_CRC32) ? H_ESP_PAYLOAD_CRC32_LEN : 0;
+}
+
+/**
+ * @brief  Append CRC32 trailer to a frame
+ *
+ * Header must be final and have FLAG_CRC32 set. Buffer needs room for
+ * H_ESP_PAYLOAD_CRC32_LEN bytes after the payload.
+ */
+void esp_frame_crc32_fill(struct esp_payload_header *h);
+
+/**
+ * @brief  Check CRC32 trailer of a frame received with FLAG_CRC32
+ * @retval 0 if trailer matches, -1 otherwise
+ */
+int esp_frame_crc32_verify(const struct esp_payload_header *h);
+
+#endif
@@ -4,6 +4,9 @@
 #ifndef __ESP_HOSTED_TRANSPORT__H
 #define __ESP_HOSTED_TRANSPORT__H
 
+#include "esp_hosted_checksum.h"
+#include "esp_hosted_crc32.h"
+
 #define PRIO_Q_SERIAL                             0
 #define PRIO_Q_BT                                 1
 #define PRIO_Q_OTHERS                             2
@@ -51,17 +54,4 @@ struct esp_priv_event {
 	uint8_t		event_data[0];
 }__attribute__((packed));
 
-static inline uint16_t compute_checksum(uint8_t *buf, uint16_t len)
-{
-	uint16_t checksum = 0;
-	uint16_t i = 0;
-
-	while(i < len) {
-		checksum += buf[i];
-		i++;
-	}
-
-	return checksum;
-}
-
 #endif
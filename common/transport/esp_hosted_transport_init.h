@@ -44,10 +44,28 @@ typedef enum {
 	ESP_BT_VHCI_UART_SUPPORT = (1 << 9), // VHCI over UART
 
 	// Hosted USB interface
-	ESP_WLAN_USB_SUPPORT = (1 << 10),
+	ESP_WLAN_USB_EXT_SUPPORT = (1 << 10),
 	ESP_BT_VHCI_USB_SUPPORT = (1 << 11), // VHCI over USB
+
+	// Hosted SDIO interface
+	ESP_SDIO_RX_AGGREGATION_SUPPORT = (1 << 12), // slave can split aggregated host Tx
+
+	// any interface
+	ESP_TRANSPORT_CRC32_SUPPORT = (1 << 13), // slave can use CRC32 frame trailer
+
+	// Hosted SDIO interface
+	ESP_SDIO_TX_CREDIT_SUPPORT = (1 << 14), // slave piggybacks Rx buffer tokens in SDIO headers
+
+	// RPC
+	ESP_RPC_PACKED_RECORDS_SUPPORT = (1 << 15), // slave can send scan/station lists as packed records
 } ESP_EXTENDED_CAPABILITIES;
 
+/* Sent by host in HOST_CAPABILITIES */
+typedef enum {
+	ESP_HOST_CAP_SDIO_RX_STREAM = (1 << 0), // host can split multiple packets from one SDIO read
+	ESP_HOST_CAP_CRC32          = (1 << 1), // slave to add CRC32 trailer to frames
+} ESP_HOST_CAPABILITIES;
+
 typedef enum {
 	ESP_TEST_RAW_TP_NONE = 0,
 	ESP_TEST_RAW_TP = (1 << 0),
@@ -0,0 +1,38 @@
+/*
+* SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+*
+* SPDX-License-Identifier: Apache-2.0
+*/
+
+/* Batched Wi-Fi getters, fetched from co-processor in a single RPC
+ * round trip instead of one per call:
+ *
+ *   esp_hosted_batch_handle_t b = esp_hosted_batch_begin();
+ *   esp_hosted_batch_get_mode(b, &mode);
+ *   esp_hosted_batch_get_mac(b, WIFI_IF_STA, mac);
+ *   err = esp_hosted_batch_commit(b);
+ *
+ * Getters only queue the request, results are written at commit.
+ * Commit returns the first failure and always releases the batch.
+ * esp_hosted_batch_begin() returns NULL if transport is not up
+ */
+
+#ifndef __ESP_HOSTED_BATCH_H__
+#define __ESP_HOSTED_BATCH_H__
+
+#include "esp_err.h"
+#include "esp_wifi.h"
+
+typedef struct rpc_batch *esp_hosted_batch_handle_t;
+
+esp_hosted_batch_handle_t esp_hosted_batch_begin(void);
+esp_err_t esp_hosted_batch_get_mode(esp_hosted_batch_handle_t b, wifi_mode_t *mode);
+esp_err_t esp_hosted_batch_get_mac(esp_hosted_batch_handle_t b, wifi_interface_t ifx, uint8_t mac[6]);
+esp_err_t esp_hosted_batch_get_config(esp_hosted_batch_handle_t b, wifi_interface_t ifx, wifi_config_t *conf);
+esp_err_t esp_hosted_batch_get_country(esp_hosted_batch_handle_t b, wifi_country_t *country);
+esp_err_t esp_hosted_batch_get_bandwidth(esp_hosted_batch_handle_t b, wifi_interface_t ifx, wifi_bandwidth_t *bw);
+esp_err_t esp_hosted_batch_get_protocol(esp_hosted_batch_handle_t b, wifi_interface_t ifx, uint8_t *protocol_bitmap);
+esp_err_t esp_hosted_batch_get_max_tx_power(esp_hosted_batch_handle_t b, int8_t *power);
+esp_err_t esp_hosted_batch_commit(esp_hosted_batch_handle_t b);
+
+#endif /*__ESP_HOSTED_BATCH_H__*/
@@ -80,6 +80,16 @@ enum {
 
 #define H_MAX_SYNC_RPC_REQUESTS                      CONFIG_ESP_HOSTED_MAX_SIMULTANEOUS_SYNC_RPC_REQUESTS
 #define H_MAX_ASYNC_RPC_REQUESTS                     CONFIG_ESP_HOSTED_MAX_SIMULTANEOUS_ASYNC_RPC_REQUESTS
+#define H_RPC_ARENA_SIZE                             CONFIG_ESP_HOSTED_RPC_ARENA_SIZE
+#define H_OTA_WINDOW                                 CONFIG_ESP_HOSTED_OTA_WINDOW
+#define H_OTA_CHUNK_SIZE                             CONFIG_ESP_HOSTED_OTA_CHUNK_SIZE
+
+#if CONFIG_ESP_HOSTED_WIFI_STATE_CACHE
+  #define H_WIFI_STATE_CACHE                         1
+  #define H_WIFI_STATE_CACHE_AP_INFO_MS              CONFIG_ESP_HOSTED_WIFI_STATE_CACHE_AP_INFO_MS
+#else
+  #define H_WIFI_STATE_CACHE                         0
+#endif
 
 #undef H_TRANSPORT_IN_USE
 
@@ -149,6 +159,12 @@ enum {
   #define H_SPI_MODE                                   CONFIG_ESP_HOSTED_SPI_MODE
   #define H_SPI_FD_CLK_MHZ                           CONFIG_ESP_HOSTED_SPI_CLK_FREQ
 
+  #ifdef CONFIG_ESP_HOSTED_SPI_PIPELINE
+    #define H_SPI_PIPELINE                             1
+  #else
+    #define H_SPI_PIPELINE                             0
+  #endif
+
   /*  -------------------------- SPI Master Config end ------------------------  */
 #endif
 
@@ -195,6 +211,19 @@ enum {
 
   #define H_SDIO_CHECKSUM                              CONFIG_ESP_HOSTED_SDIO_CHECKSUM
 
+  #ifdef CONFIG_ESP_HOSTED_SDIO_TX_AGGREGATION
+    #define H_SDIO_TX_AGGREGATION                      1
+    #define H_SDIO_TX_AGGR_MAX_BUFS                    CONFIG_ESP_HOSTED_SDIO_TX_AGGREGATION_MAX_BUFS
+  #else
+    #define H_SDIO_TX_AGGREGATION                      0
+  #endif
+
+  #ifdef CONFIG_ESP_HOSTED_SDIO_TX_CREDIT
+    #define H_SDIO_TX_CREDIT                           1
+  #else
+    #define H_SDIO_TX_CREDIT                           0
+  #endif
+
   #define H_SDIO_HOST_STREAMING_MODE 1
   #define H_SDIO_ALWAYS_HOST_RX_MAX_TRANSPORT_SIZE 2
   #define H_SDIO_OPTIMIZATION_RX_NONE 3
@@ -464,6 +493,42 @@ enum {
 
 #define H_PKT_STATS                                  CONFIG_ESP_HOSTED_PKT_STATS
 
+/* Zero-copy Rx: pass the transport buffer to netif, instead of a copy */
+#ifdef CONFIG_ESP_HOSTED_WIFI_RX_ZEROCOPY
+  #define H_WIFI_RX_ZEROCOPY                         1
+#else
+  #define H_WIFI_RX_ZEROCOPY                         0
+#endif
+
+/* Zero-copy Tx: frames in esp_hosted_alloc_tx_buffer() buffers sent in place */
+#if defined(CONFIG_ESP_HOSTED_WIFI_TX_ZEROCOPY) && defined(H_USE_MEMPOOL)
+  #define H_WIFI_TX_ZEROCOPY                         1
+  #define H_WIFI_TX_ZEROCOPY_BUFS                    CONFIG_ESP_HOSTED_WIFI_TX_ZEROCOPY_BUFS
+#else
+  #define H_WIFI_TX_ZEROCOPY                         0
+  #define H_WIFI_TX_ZEROCOPY_BUFS                    0
+#endif
+
+/* CRC32 frame integrity, negotiated with slave */
+#ifdef CONFIG_ESP_HOSTED_TRANSPORT_CRC32
+  #define H_TRANSPORT_CRC32                          1
+#else
+  #define H_TRANSPORT_CRC32                          0
+#endif
+
+/* Weighted fair (deficit round robin) scheduling of priority queues */
+#ifdef CONFIG_ESP_HOSTED_PRIO_Q_WFQ
+  #define H_PRIO_Q_WFQ                               1
+  #define H_PRIO_Q_SERIAL_QUANTUM                    CONFIG_ESP_HOSTED_PRIO_Q_SERIAL_QUANTUM
+  #define H_PRIO_Q_BT_QUANTUM                        CONFIG_ESP_HOSTED_PRIO_Q_BT_QUANTUM
+  #define H_PRIO_Q_OTHERS_QUANTUM                    CONFIG_ESP_HOSTED_PRIO_Q_OTHERS_QUANTUM
+  #define H_PRIO_Q_SERIAL_MAX_WAIT_MS                CONFIG_ESP_HOSTED_PRIO_Q_SERIAL_MAX_WAIT_MS
+  #define H_PRIO_Q_BT_MAX_WAIT_MS                    CONFIG_ESP_HOSTED_PRIO_Q_BT_MAX_WAIT_MS
+  #define H_PRIO_Q_OTHERS_MAX_WAIT_MS                CONFIG_ESP_HOSTED_PRIO_Q_OTHERS_MAX_WAIT_MS
+#else
+  #define H_PRIO_Q_WFQ                               0
+#endif
+
 /* Raw Throughput Testing */
 #define H_TEST_RAW_TP     CONFIG_ESP_HOSTED_RAW_THROUGHPUT_TRANSPORT
 
@@ -16,7 +16,8 @@
  * Procedure used by APIs to do OTA update:
  * 1. Fetch and prepare OTA binary
  * 2. Call rpc_ota_begin() to start OTA
- * 3. Repeatedly call rpc_ota_write() with a continuous chunk of OTA data
+ * 3. Repeatedly call rpc_ota_write() or rpc_ota_write_async() with a
+ *    continuous chunk of OTA data
  * 4. Call rpc_ota_end()
  *
  */
@@ -37,6 +37,22 @@ esp_remote_channel_t esp_hosted_add_channel(esp_remote_channel_config_t config,
 		esp_remote_channel_tx_fn_t *tx, const esp_remote_channel_rx_fn_t rx);
 esp_err_t esp_hosted_remove_channel(esp_remote_channel_t channel);
 
+/* Release the 'buff_to_free' passed to esp_remote_channel_rx_fn_t.
+ * With CONFIG_ESP_HOSTED_WIFI_RX_ZEROCOPY, this returns the buffer to the
+ * transport mempool. Plain free() is also safe, but bypasses the mempool. */
+void esp_hosted_free_rx_buffer(void *buff_to_free);
+
+/* Buffer for an outgoing Wi-Fi frame of up to 'len' bytes, with room for
+ * the transport header in front. A frame built in it and passed to the
+ * channel tx is queued as is, without a copy.
+ * Returns NULL without CONFIG_ESP_HOSTED_WIFI_TX_ZEROCOPY, for a too large
+ * 'len' or when all such buffers are in use: use any other buffer then.
+ * Release with esp_hosted_free_tx_buffer() when done, sent or not. A frame
+ * still queued is kept until sent, so the same buffer may also be passed
+ * to tx again (it is copied in that case). */
+void *esp_hosted_alloc_tx_buffer(size_t len);
+void esp_hosted_free_tx_buffer(void *buffer);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@ extern "C" {
 #include "esp_wifi_remote.h"
 #include "esp_hosted_api_types.h"
 #include "esp_hosted_ota.h"
+#include "esp_hosted_batch.h"
 #include "esp_hosted_wifi_config.h"
 
 /* Remote WiFi API Functions - Port/Implementation Specific */
@@ -541,6 +541,59 @@ esp_err_t esp_hosted_get_coprocessor_fwversion(esp_hosted_coprocessor_fwver_t *v
 	return rpc_get_coprocessor_fwversion(ver_info);
 }
 
+int esp_hosted_set_event_rate_limit(int32_t event_id, uint32_t min_interval_ms)
+{
+	return rpc_set_event_rate_limit(event_id, min_interval_ms);
+}
+
+esp_hosted_batch_handle_t esp_hosted_batch_begin(void)
+{
+	if (!esp_hosted_transport_up)
+		return NULL;
+	return rpc_batch_begin();
+}
+
+esp_err_t esp_hosted_batch_get_mode(esp_hosted_batch_handle_t b, wifi_mode_t *mode)
+{
+	return rpc_batch_get_mode(b, mode);
+}
+
+esp_err_t esp_hosted_batch_get_mac(esp_hosted_batch_handle_t b, wifi_interface_t ifx, uint8_t mac[6])
+{
+	return rpc_batch_get_mac(b, ifx, mac);
+}
+
+esp_err_t esp_hosted_batch_get_config(esp_hosted_batch_handle_t b, wifi_interface_t ifx, wifi_config_t *conf)
+{
+	return rpc_batch_get_config(b, ifx, conf);
+}
+
+esp_err_t esp_hosted_batch_get_country(esp_hosted_batch_handle_t b, wifi_country_t *country)
+{
+	return rpc_batch_get_country(b, country);
+}
+
+esp_err_t esp_hosted_batch_get_bandwidth(esp_hosted_batch_handle_t b, wifi_interface_t ifx, wifi_bandwidth_t *bw)
+{
+	return rpc_batch_get_bandwidth(b, ifx, bw);
+}
+
+esp_err_t esp_hosted_batch_get_protocol(esp_hosted_batch_handle_t b, wifi_interface_t ifx, uint8_t *protocol_bitmap)
+{
+	return rpc_batch_get_protocol(b, ifx, protocol_bitmap);
+}
+
+esp_err_t esp_hosted_batch_get_max_tx_power(esp_hosted_batch_handle_t b, int8_t *power)
+{
+	return rpc_batch_get_max_tx_power(b, power);
+}
+
+/* No transport check, batch has to be released either way */
+esp_err_t esp_hosted_batch_commit(esp_hosted_batch_handle_t b)
+{
+	return rpc_batch_commit(b);
+}
+
 /* esp_err_t esp_wifi_remote_scan_get_ap_record(wifi_ap_record_t *ap_record)
 esp_err_t esp_wifi_remote_set_csi(_Bool en)
 esp_err_t esp_wifi_remote_set_csi_rx_cb(wifi_csi_cb_t cb, void *ctx)
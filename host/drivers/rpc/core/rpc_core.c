@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <assert.h>
 #include "rpc_core.h"
 #include "esp_hosted_rpc.h"
 #include "serial_if.h"
@@ -29,7 +30,6 @@ struct rpc_lib_context {
 typedef void (*rpc_rx_ind_t)(void);
 typedef void (*rpc_tx_ind_t)(void);
 
-static queue_handle_t rpc_rx_q = NULL;
 static queue_handle_t rpc_tx_q = NULL;
 
 static void * rpc_rx_thread_hdl;
@@ -37,40 +37,59 @@ static void * rpc_tx_thread_hdl;
 static void * rpc_tx_sem;
 static struct rpc_lib_context rpc_lib_ctxt;
 
-/* uid to link between requests and responses */
-/* uids are incrementing values from 1 onwards.
- * 0 means not a valid id */
-static uint32_t uid = 0;
+/* protobuf message being composed by tx thread / decoded by rx thread */
+static esp_hosted_rpc_arena_t rpc_tx_arena;
+static esp_hosted_rpc_arena_t rpc_rx_arena;
+
+/* rpc transaction slots
+ * Every request in flight owns one slot, from rpc_send_req() until its
+ * response, timeout or send failure.
+ * 1. The uid sent to slave carries the slot index in the low bits and a
+ *    per slot generation above it. Response is matched to its slot
+ *    directly, and late response of a recycled slot fails the uid check
+ * 2. Sync waiter blocks on the semaphore of its own slot, created once
+ *    at init. Its response is handed over through the slot, so any
+ *    number of tasks may wait at the same time
+ * 3. Async request registers callback and timeout timer in its slot
+ * 4. Slot also embeds a request, handed out by rpc_core_alloc_req(), so
+ *    the usual request path does not allocate
+ *
+ * Sync and async limits together size the pool. Request waits for a
+ * free slot, up to its response timeout, when all are in flight
+ */
+#define RPC_MAX_SLOTS              (H_MAX_SYNC_RPC_REQUESTS + H_MAX_ASYNC_RPC_REQUESTS)
 
-/* structures used to keep track of response semaphores
- * and callbacks via their uid */
-typedef struct {
-	uint32_t uid;
-	void * sem;
-} sync_rsp_t;
+#define RPC_UID_SLOT_BITS          8
+#define RPC_UID_SLOT_MASK          ((1UL << RPC_UID_SLOT_BITS) - 1)
+#define RPC_UID_GEN_MASK           (UINT32_MAX >> RPC_UID_SLOT_BITS)
+
+#if RPC_MAX_SLOTS > RPC_UID_SLOT_MASK
+#error "Too many simultaneous RPC requests configured"
+#endif
+
+#define RPC_SLOT_FREE              0
+#define RPC_SLOT_RESERVED          1 /* request handed out, not sent yet */
+#define RPC_SLOT_SYNC              2 /* sent, waiter blocked on slot sem */
+#define RPC_SLOT_ASYNC             3 /* sent, callback and timer armed */
+#define RPC_SLOT_DONE              4 /* sync response handed over */
 
 typedef struct {
 	uint32_t uid;
+	uint32_t gen;
+	uint8_t state;
+	void * sem;
+	ctrl_cmd_t *resp;
+	ctrl_cmd_t *req;
 	rpc_rsp_cb_t cb;
 	void * timer_hdl;
-} async_rsp_t;
-
-/* rpc response callbacks
- * These will be updated per rpc request received
- * 1. If application wants to use synchrounous, i.e. Wait till the response received
- *    after current rpc request is sent or timeout occurs,
- *    application will pass this callback in request as NULL.
- * 2. If application wants to use `asynchrounous`, i.e. Just send the request and
- *    unblock for next processing, application will assign function pointer in
- *    rpc request, which will be registered here.
- *    When the response comes, the this registered callback function will be called
- *    with input as response
- */
-#define MAX_SYNC_RPC_TRANSACTIONS  H_MAX_SYNC_RPC_REQUESTS
-#define MAX_ASYNC_RPC_TRANSACTIONS H_MAX_ASYNC_RPC_REQUESTS
+	ctrl_cmd_t req_buf;
+} rpc_slot_t;
 
-static sync_rsp_t sync_rsp_table[MAX_SYNC_RPC_TRANSACTIONS] = { 0 };
-static async_rsp_t async_rsp_table[MAX_ASYNC_RPC_TRANSACTIONS] = { 0 };
+static rpc_slot_t *rpc_slots;
+static void * rpc_slot_mutex;
+/* counts free slots */
+static void * rpc_slot_free_sem;
+static uint8_t rpc_slot_next;
 
 /* rpc event callbacks
  * These will be updated when user registers event callback
@@ -83,17 +102,41 @@ static async_rsp_t async_rsp_table[MAX_ASYNC_RPC_TRANSACTIONS] = { 0 };
  */
 static rpc_evt_cb_t rpc_evt_cb_table[RPC_ID__Event_Max - RPC_ID__Event_Base] = { NULL };
 
+/* Per event rate limit, set by `set_event_callback_rate_limited`.
+ * Event arriving sooner than min_interval_ms after the last one delivered
+ * is still decoded and passed to the callback, with evt_rate_limited set
+ * to the ms left of the interval. Callback delivers the latest such one
+ * once the interval ends */
+typedef struct {
+	uint32_t min_interval_ms;
+	uint32_t dropped;
+} rpc_evt_rate_t;
+
+static rpc_evt_rate_t rpc_evt_rate_table[RPC_ID__Event_Max - RPC_ID__Event_Base];
+
+/* Limit state per event kind: event id, and Wi-Fi event id for
+ * RPC_ID__Event_WifiEventNoArgs, which carries several kinds.
+ * Only touched by rpc rx thread */
+#define RPC_EVT_RATE_KINDS 16
+
+typedef struct {
+	uint16_t event;
+	int32_t wifi_event_id;
+	uint32_t last_ms;
+	uint8_t delivered;
+	uint8_t held;
+} rpc_evt_kind_t;
+
+static rpc_evt_kind_t rpc_evt_kinds[RPC_EVT_RATE_KINDS];
+static uint8_t rpc_evt_kinds_used;
+
 
 static int call_event_callback(ctrl_cmd_t *app_event);
-static int is_async_resp_callback_available(ctrl_cmd_t *app_resp);
-static int is_sync_resp_sem_available(uint32_t uid);
-static int clear_async_resp_callback(async_rsp_t *async_rsp_item);
-static int call_async_resp_callback(ctrl_cmd_t *app_resp);
-static int set_async_resp_callback(ctrl_cmd_t *app_req, rpc_rsp_cb_t resp_cb, void *timer_hdl);
-static int set_sync_resp_sem(ctrl_cmd_t *app_req);
-static int wait_for_sync_response(ctrl_cmd_t *app_req);
+static uint32_t is_event_rate_limited(ctrl_cmd_t *app_event);
+static rpc_slot_t * rpc_slot_lookup(uint32_t req_uid);
+static int rpc_slot_complete(ctrl_cmd_t *app_resp);
+static void rpc_slot_fail(uint32_t req_uid, uint16_t req_msg_id, int32_t status);
 static void rpc_async_timeout_handler(void *arg);
-static int post_sync_resp_sem(ctrl_cmd_t *app_resp);
 
 
 /* Open serial interface
@@ -165,14 +208,55 @@ int is_event_callback_registered(int event)
 	return CALLBACK_NOT_REGISTERED;
 }
 
+/* Drop all protobuf allocations of the finished message */
+static void rpc_arena_reset(esp_hosted_rpc_arena_t *arena, const char *dir)
+{
+	esp_hosted_rpc_arena_stats_t stats = {0};
+
+	if (!esp_hosted_rpc_arena_reset(arena))
+		return;
 
-static int process_rpc_tx_msg(ctrl_cmd_t *app_req)
+	esp_hosted_rpc_arena_get_stats(arena, &stats);
+	ESP_LOGD(TAG, "rpc %s arena high water %" PRIu32 "/%" PRIu32 " bytes, %" PRIu32 " of %" PRIu32 " msgs spilled to heap",
+			dir, stats.high_water, stats.size, stats.overflows, stats.transactions);
+}
+
+/* Lets rpc__pack_to_buffer() write across transport buffer fragments */
+typedef struct {
+	ProtobufCBuffer base;
+	serial_ll_tx_msg_t *msg;
+} rpc_tx_msg_buffer_t;
+
+static void rpc_tx_msg_append(ProtobufCBuffer *buffer, size_t len, const uint8_t *data)
+{
+	rpc_tx_msg_buffer_t *buf = (rpc_tx_msg_buffer_t *)buffer;
+
+	serial_ll_tx_msg_write(buf->msg, data, len);
+}
+
+static int process_rpc_tx_msg(uint32_t req_uid)
 {
 	Rpc   req = {0};
 	uint32_t  tx_len = 0;
 	uint8_t  *tx_data = NULL;
-	int       ret = SUCCESS;
+	serial_ll_tx_msg_t tx_msg = {0};
+	rpc_tx_msg_buffer_t tx_buf = { { rpc_tx_msg_append }, &tx_msg };
 	int32_t   failure_status = 0;
+	uint16_t  req_msg_id = 0;
+	rpc_slot_t *slot = NULL;
+	ctrl_cmd_t *app_req = NULL;
+
+	/* Slot is held locked until app_req is packed, so a sync waiter
+	 * timing out meanwhile cannot recycle app_req under us */
+	g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+	slot = rpc_slot_lookup(req_uid);
+	if (!slot || (slot->state != RPC_SLOT_SYNC && slot->state != RPC_SLOT_ASYNC)) {
+		g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+		ESP_LOGW(TAG, "uid %" PRIu32 " timed out before sending, dropped", req_uid);
+		return FAILURE;
+	}
+	app_req = slot->req;
+	req_msg_id = app_req->msg_id;
 
 	req.msg_type = RPC_TYPE__Req;
 
@@ -181,54 +265,47 @@ static int process_rpc_tx_msg(ctrl_cmd_t *app_req)
 
 	req.msg_id = app_req->msg_id;
 	req.uid = app_req->uid;
-	ESP_LOGI(TAG, "<-- RPC_Req  [0x%x], uid %ld", app_req->msg_id, app_req->uid);
+	ESP_LOGI(TAG, "<-- RPC_Req  [0x%x], uid %" PRIu32, app_req->msg_id, app_req->uid);
 	/* payload case is exact match to msg id in esp_hosted_config.pb-c.h */
 	req.payload_case = (Rpc__PayloadCase) app_req->msg_id;
 
-	if (compose_rpc_req(&req, app_req, &failure_status)) {
+	if (compose_rpc_req(&req, app_req, &rpc_tx_arena, &failure_status)) {
 		ESP_LOGE(TAG, "compose_rpc_req failed for [0x%x]", app_req->msg_id);
 		goto fail_req;
 	}
 
 	/* 3. Protobuf msg size */
 	tx_len = rpc__get_packed_size(&req);
-	if (!tx_len) {
-		ESP_LOGE(TAG, "Invalid tx length");
+	if (!tx_len || tx_len > UINT16_MAX) {
+		ESP_LOGE(TAG, "Invalid tx length %" PRIu32, tx_len);
 		failure_status = RPC_ERR_PROTOBUF_ENCODE;
 		goto fail_req;
 	}
 
-	/* 4. Allocate protobuf msg */
-	HOSTED_CALLOC(uint8_t, tx_data, tx_len, fail_req0);
-
-	/* 5. Assign response callback, if valid */
-	if (app_req->rpc_rsp_cb) {
+	/* 4. Get transport buffers, TLV header already written */
+	if (transport_pserial_send_begin(&tx_msg, tx_len))
+		goto fail_req0;
 
-		/* 5.1 Start timeout for response for async only
-		* For sync procedures, g_h.funcs->_h_get_semaphore takes care to
-		* handle timeout situations */
-		ESP_LOGI(TAG, "starting async resp timer for req[%u]",req.msg_id);
-		void *timer_hdl = g_h.funcs->_h_timer_start("rpc_async_timeout_timer", SEC_TO_MILLISEC(app_req->rsp_timeout_sec), H_TIMER_TYPE_ONESHOT,
-				rpc_async_timeout_handler, app_req);
-		if (!timer_hdl) {
-			ESP_LOGE(TAG, "Failed to start async resp timer");
-			goto fail_req;
-		}
+	/* 5. Pack in protobuf, straight into transport buffers.
+	 * In place if the msg fits one fragment, else chunk by chunk */
+	tx_data = serial_ll_tx_msg_reserve(&tx_msg, tx_len);
+	if (tx_data)
+		rpc__pack(&req, tx_data);
+	else
+		rpc__pack_to_buffer(&req, &tx_buf.base);
 
-		/* 5.2 set async resp callback */
-		ESP_LOGD(TAG, "setting async resp callback for req[%u]",req.msg_id);
-		ret = set_async_resp_callback(app_req, app_req->rpc_rsp_cb, timer_hdl);
-		if (ret < 0) {
-			ESP_LOGE(TAG, "could not set callback for req[%u]",req.msg_id);
-			failure_status = RPC_ERR_SET_ASYNC_CB;
-			goto fail_req;
-		}
-	}
+	/* 6. Free hook for application
+	 * Once packed, app_req is not needed anymore. Release it before
+	 * sending, as the response may complete the transaction (and
+	 * recycle app_req) before transport_pserial_send_end() returns */
+	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
+	rpc_arena_reset(&rpc_tx_arena, "tx");
+	app_req = NULL;
+	g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
 
-	/* 7. Pack in protobuf and send the request */
-	rpc__pack(&req, tx_data);
+	/* 7. Send the request */
 	ESP_LOGD(TAG, "sending rpc req[%u]",req.msg_id);
-	if (transport_pserial_send(tx_data, tx_len)) {
+	if (transport_pserial_send_end(&tx_msg)) {
 		ESP_LOGE(TAG, "Send RPC req[0x%x] failed",req.msg_id);
 		failure_status = RPC_ERR_TRANSPORT_SEND;
 		goto fail_req;
@@ -236,82 +313,32 @@ static int process_rpc_tx_msg(ctrl_cmd_t *app_req)
 
 	ESP_LOGD(TAG, "Sent RPC_Req[0x%x]",req.msg_id);
 
-
-	/* 8. Free hook for application */
-	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
-
-	/* 9. Cleanup */
-	HOSTED_FREE(tx_data);
-	RPC_FREE_BUFFS();
+	/* 8. Transport buffers are freed once sent */
 	return SUCCESS;
 fail_req0:
 	failure_status = RPC_ERR_MEMORY_FAILURE;
 fail_req:
+	ESP_LOGW(TAG, "RPC req[0x%x] uid %" PRIu32 " failed", req_msg_id, req_uid);
 
-
-	ESP_LOGW(TAG, "fail1");
-	if (app_req->rpc_rsp_cb) {
-		/* 11. In case of async procedure,
-		 * Let application know of failure using callback itself
-		 **/
-		ctrl_cmd_t *app_resp = NULL;
-
-		HOSTED_CALLOC(ctrl_cmd_t, app_resp, sizeof(ctrl_cmd_t), fail_req2);
-
-		app_resp->msg_type = RPC_TYPE__Resp;
-		app_resp->msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-		app_resp->resp_event_status = failure_status;
-
-		/* 12. In async procedure, it is important to get
-		 * some kind of acknowledgement to user when
-		 * request is already sent and success return to the caller
-		 */
-		app_req->rpc_rsp_cb(app_resp);
-	} else {
-		/* for sync procedure, put failed response into receive queue
-		 * so application is aware of transmit failure.
-		 * Prevents timeout waiting for a response that will never come
-		 * as request was never sent
-		 */
-		ESP_LOGW(TAG, "RPC Sync proc failed");
-
-		ctrl_cmd_t *app_resp = NULL;
-
-		HOSTED_CALLOC(ctrl_cmd_t, app_resp, sizeof(ctrl_cmd_t), fail_req2);
-
-		app_resp->msg_type = RPC_TYPE__Resp;
-		app_resp->msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-		app_resp->resp_event_status = failure_status;
-
-		// same as process_rpc_rx_msg() for failed condition
-		esp_queue_elem_t elem = {0};
-		elem.buf = app_resp;
-		elem.buf_len = sizeof(ctrl_cmd_t);
-
-		if (g_h.funcs->_h_queue_item(rpc_rx_q, &elem, HOSTED_BLOCK_MAX)) {
-			ESP_LOGE(TAG, "RPC Q put fail");
-		} else if (CALLBACK_AVAILABLE == is_sync_resp_sem_available(app_resp->uid)) {
-			ESP_LOGV(TAG, "trigger semaphore to react to failed message uid %ld", app_resp->uid);
-			post_sync_resp_sem(app_resp);
-		} else {
-			ESP_LOGE(TAG, "no sync resp callback to react to failed message uid %ld", app_resp->uid);
-		}
+	/* 9. Cleanup */
+	if (app_req) {
+		H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
+		rpc_arena_reset(&rpc_tx_arena, "tx");
+		g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
 	}
+	serial_ll_tx_msg_free(&tx_msg);
 
-fail_req2:
-	ESP_LOGW(TAG, "fail2");
-	/* 13. Cleanup */
-	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
-
-	HOSTED_FREE(tx_data);
-	RPC_FREE_BUFFS();
+	/* 10. Let the sync waiter or async callback know of the failure.
+	 * Prevents timeout waiting for a response that will never come
+	 * as request was never sent
+	 */
+	rpc_slot_fail(req_uid, req_msg_id, failure_status);
 	return FAILURE;
 }
 
 /* Process RPC msg (response or event) received from ESP32 */
 static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
 {
-	esp_queue_elem_t elem = {0};
 	ctrl_cmd_t *app_resp = NULL;
 	ctrl_cmd_t *app_event = NULL;
 
@@ -320,7 +347,7 @@ static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
 		return FAILURE;
 	}
 
-	/* Note: free proto_msg at the end of processing*/
+	/* Note: proto_msg is in rx arena, released by caller */
 
 	/* 2. Check if it is event msg */
 	if (proto_msg->msg_type == RPC_TYPE__Event) {
@@ -346,6 +373,11 @@ static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
 				goto free_buffers;
 			}
 
+			/* callback keeps its state in sync, even for
+			 * events application is not to see yet */
+			app_event->evt_rate_limited =
+				is_event_rate_limited(app_event);
+
 			/* callback to registered function */
 			call_event_callback(app_event);
 		} else
@@ -367,41 +399,16 @@ static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
 			goto free_buffers;
 		}
 
-		/* Is callback is available,
-		 * progress as async response */
-		if (CALLBACK_AVAILABLE ==
-			is_async_resp_callback_available(app_resp)) {
-
-			/* User registered RPC async response callback
-			 * function is available for this proto_msg,
-			 * so call to that function should be done and
-			 * return to select
-			 */
-			call_async_resp_callback(app_resp);
-		} else {
-
-			/* as RPC async response callback function is
-			 * NOT available/registered, treat this response as
-			 * synchronous response. forward this response to app
-			 * using 'esp_queue' and help of semaphore
-			 **/
-
-
-			/* User is RESPONSIBLE to free memory from
-			 * app_resp in case of async callbacks NOT provided
-			 * to free memory, please refer CLEANUP_APP_MSG macro
-			 **/
-			elem.buf = app_resp;
-			elem.buf_len = sizeof(ctrl_cmd_t);
-
-			if (g_h.funcs->_h_queue_item(rpc_rx_q, &elem, HOSTED_BLOCK_MAX)) {
-				ESP_LOGE(TAG, "RPC Q put fail");
-				goto free_buffers;
-			}
-
-			/* Call up rx ind to unblock caller */
-			if (CALLBACK_AVAILABLE == is_sync_resp_sem_available(app_resp->uid))
-				post_sync_resp_sem(app_resp);
+		/* Hand over to the sync waiter or async callback owning the uid.
+		 *
+		 * User is RESPONSIBLE to free memory from
+		 * app_resp in case of async callbacks NOT provided
+		 * to free memory, please refer CLEANUP_APP_MSG macro
+		 **/
+		if (rpc_slot_complete(app_resp)) {
+			ESP_LOGW(TAG, "No transaction for resp [0x%x] uid %" PRIu32 ", dropped",
+					app_resp->msg_id, app_resp->uid);
+			goto free_buffers;
 		}
 
 	} else {
@@ -409,15 +416,13 @@ static int process_rpc_rx_msg(Rpc * proto_msg, rpc_rx_ind_t rpc_rx_func)
 		ESP_LOGE(TAG, "Incorrect RPC Msg Type[%u]",proto_msg->msg_type);
 		goto free_buffers;
 	}
-	rpc__free_unpacked(proto_msg, NULL);
-	proto_msg = NULL;
 	return SUCCESS;
 
 	/* 5. cleanup */
 free_buffers:
-	rpc__free_unpacked(proto_msg, NULL);
-	proto_msg = NULL;
 	HOSTED_FREE(app_event);
+	if (app_resp)
+		H_FREE_PTR_WITH_FUNC(app_resp->app_free_buff_func, app_resp->app_free_buff_hdl);
 	HOSTED_FREE(app_resp);
 	return RPC_ERR_PROTOBUF_DECODE;
 }
@@ -426,8 +431,6 @@ free_buffers:
  * This is entry point for rpc messages received from ESP32 */
 static void rpc_rx_thread(void const *arg)
 {
-	uint32_t buf_len = 0;
-
 	rpc_rx_ind_t rpc_rx_func;
 	rpc_rx_func = (rpc_rx_ind_t) arg;
 
@@ -437,16 +440,16 @@ static void rpc_rx_thread(void const *arg)
 		return;
 	}
 
-	/* This queue should already be created
+	/* Slots should already be created
 	 * if NULL, exit here */
-	if (!rpc_rx_q) {
-		ESP_LOGE(TAG, "Ctrl msg rx Q is not created");
+	if (!rpc_slots) {
+		ESP_LOGE(TAG, "RPC transaction slots not created");
 		return;
 	}
 
 	/* Infinite loop to process incoming msg on serial interface */
 	while (1) {
-		uint8_t *buf = NULL;
+		serial_drv_rx_buf_t rx = {0};
 		Rpc *resp = NULL;
 
 		/* Block on read of protobuf encoded msg */
@@ -454,34 +457,32 @@ static void rpc_rx_thread(void const *arg)
 			g_h.funcs->_h_sleep(1);
 			continue;
 		}
-		buf = transport_pserial_read(&buf_len);
-
-		if (!buf_len || !buf) {
-			ESP_LOGE(TAG, "buf_len read = 0");
+		if (transport_pserial_read(&rx) || !rx.len) {
+			ESP_LOGE(TAG, "serial read failed");
 			goto free_bufs;
 		}
 
-		/* Decode protobuf */
-		resp = rpc__unpack(NULL, buf_len, buf);
+		/* Decode protobuf, straight from received buffer */
+		resp = rpc__unpack(&rpc_rx_arena.allocator, rx.len, serial_drv_rx_buf_data(&rx));
 		if (!resp) {
 			goto free_bufs;
 		}
-		/* Free the read buffer */
-		HOSTED_FREE(buf);
+		/* Unpacked msg holds own copies, free the read buffer */
+		serial_drv_rx_buf_free(&rx);
 
 		/* Send for further processing as event or response */
 		ESP_LOGV(TAG, "Before process_rpc_rx_msg");
 		process_rpc_rx_msg(resp, rpc_rx_func);
 		ESP_LOGV(TAG, "after process_rpc_rx_msg");
+
+		/* Decoded msg is released as a whole */
+		rpc_arena_reset(&rpc_rx_arena, "rx");
 		continue;
 
 		/* Failed - cleanup */
 free_bufs:
-		HOSTED_FREE(buf);
-		if (resp) {
-			rpc__free_unpacked(resp, NULL);
-			resp = NULL;
-		}
+		serial_drv_rx_buf_free(&rx);
+		rpc_arena_reset(&rpc_rx_arena, "rx");
 	}
 }
 
@@ -490,7 +491,7 @@ free_bufs:
  * Sync thread will block for response (in its own context) after submission of ctrl_msg to rpc_tx_q */
 static void rpc_tx_thread(void const *arg)
 {
-	ctrl_cmd_t *app_req = NULL;
+	uint32_t req_uid = 0;
 
 	ESP_LOGD(TAG, "Starting tx thread");
 	/* If serial interface is not available, exit */
@@ -522,14 +523,14 @@ static void rpc_tx_thread(void const *arg)
 		ESP_LOGV(TAG, "RPC TX semaphore acquired");
 
 		ESP_LOGV(TAG, "Dequeueing RPC TX Q");
-		if (g_h.funcs->_h_dequeue_item(rpc_tx_q, &app_req, HOSTED_BLOCK_MAX)) {
+		if (g_h.funcs->_h_dequeue_item(rpc_tx_q, &req_uid, HOSTED_BLOCK_MAX)) {
 			ESP_LOGE(TAG, "RPC TX Q Failed to dequeue");
 			continue;
 		}
 
-		if (app_req) {
+		if (req_uid) {
 			ESP_LOGV(TAG, "Processing RPC TX msg");
-			process_rpc_tx_msg(app_req);
+			process_rpc_tx_msg(req_uid);
 		} else {
 			ESP_LOGE(TAG, "RPC Tx Q empty or uninitialised");
 			continue;
@@ -573,210 +574,203 @@ static int cancel_rpc_threads(void)
 
 
 
-/* This function will be only invoked in synchrounous rpc response path,
- * i.e. if rpc response callbcak is not available i.e. NULL
- * This function is called after sending synchrounous rpc request to wait
- * for the response using semaphores and esp_queue
+/* Slot helpers
+ * Slot state is only changed with rpc_slot_mutex held. Timers are
+ * stopped, callbacks called and slot freed semaphore posted after
+ * dropping it
  **/
-static ctrl_cmd_t * get_response(int *read_len, ctrl_cmd_t *app_req)
+static inline uint32_t rpc_slot_uid(rpc_slot_t *slot)
 {
-	uint8_t * buf = NULL;
-	esp_queue_elem_t elem = {0};
-	int ret = 0;
-
-	/* Any problems in response, return NULL */
-	if (!read_len || !app_req) {
-		ESP_LOGE(TAG, "Invalid input parameter");
-		return NULL;
-	}
+	return (slot->gen << RPC_UID_SLOT_BITS) | (uint32_t)(slot - rpc_slots);
+}
 
+/* Returns slot serving uid, NULL if uid is stale or unknown.
+ * Call with rpc_slot_mutex held */
+static rpc_slot_t * rpc_slot_lookup(uint32_t req_uid)
+{
+	uint32_t idx = req_uid & RPC_UID_SLOT_MASK;
 
-	/* Wait for response */
-	ret = wait_for_sync_response(app_req);
-	if (ret) {
-		if ((ret == RET_FAIL_TIMEOUT) || (errno == ETIMEDOUT))
-			ESP_LOGW(TAG, "Timeout waiting for Resp for Req[0x%x]", app_req->msg_id);
-		else
-			ESP_LOGE(TAG, "ERR [%u] ret[%d] for Req[0x%x]", errno, ret, app_req->msg_id);
+	if (!rpc_slots || idx >= RPC_MAX_SLOTS)
 		return NULL;
-	}
 
-	/* Fetch response from `esp_queue` */
-	if (g_h.funcs->_h_dequeue_item(rpc_rx_q, &elem, HOSTED_BLOCK_MAX)) {
-		ESP_LOGE(TAG, "rpc Rx Q Failed to dequeue");
+	if (rpc_slots[idx].state == RPC_SLOT_FREE ||
+	    rpc_slots[idx].uid != req_uid)
 		return NULL;
-	}
 
-	if (elem.buf_len) {
+	return &rpc_slots[idx];
+}
 
-		*read_len = elem.buf_len;
-		buf = elem.buf;
-		return (ctrl_cmd_t*)buf;
+/* Slot of a request handed out by rpc_core_alloc_req(), else NULL */
+static rpc_slot_t * rpc_slot_of_req(ctrl_cmd_t *app_req)
+{
+	uintptr_t first, req;
 
-	} else {
-		ESP_LOGE(TAG, "rpc Q empty or uninitialised");
+	if (!rpc_slots)
 		return NULL;
-	}
 
-	return NULL;
-}
-
-static int clear_async_resp_callback(async_rsp_t *async_rsp_item)
-{
-	if (async_rsp_item->uid != 0) {
+	first = (uintptr_t)&rpc_slots[0].req_buf;
+	req = (uintptr_t)app_req;
 
-		if (async_rsp_item->timer_hdl) {
-			g_h.funcs->_h_timer_stop(async_rsp_item->timer_hdl);
-			async_rsp_item->timer_hdl = NULL;
-		}
+	if (req < first || req > (uintptr_t)&rpc_slots[RPC_MAX_SLOTS-1].req_buf ||
+	    (req - first) % sizeof(rpc_slot_t))
+		return NULL;
 
-		async_rsp_item->uid = 0;
-		async_rsp_item->cb = NULL;
-		return SUCCESS;
-	} else {
-		ESP_LOGW(TAG, "async_rsp_item to be cleared already has uid 0");
-	}
-	return FAILURE;
+	return &rpc_slots[(req - first) / sizeof(rpc_slot_t)];
 }
 
-/* Check and call rpc response asynchronous callback if available
- * else flag error
- *     MSG_ID_OUT_OF_ORDER - if response id is not understandable
- *     CALLBACK_NOT_REGISTERED - callback is not registered
- **/
-static int call_async_resp_callback(ctrl_cmd_t *app_resp)
+/* Wait for a free slot and reserve it
+ * timeout_sec follows _h_get_semaphore() convention */
+static rpc_slot_t * rpc_slot_acquire(int timeout_sec)
 {
+	rpc_slot_t *slot = NULL;
 	int i;
 
-	// msg_id of RPC_ID__Resp_Base now means Invalid RPC Request
-	if ((app_resp->msg_id < RPC_ID__Resp_Base) ||
-	    (app_resp->msg_id >= RPC_ID__Resp_Max)) {
-		return MSG_ID_OUT_OF_ORDER;
-	}
-
-	for (i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (async_rsp_table[i].uid == app_resp->uid) {
-			int ret = async_rsp_table[i].cb(app_resp);
+	if (!rpc_slots)
+		return NULL;
 
-			clear_async_resp_callback(&async_rsp_table[i]);
+	if (g_h.funcs->_h_get_semaphore(rpc_slot_free_sem, timeout_sec))
+		return NULL;
 
-			return ret;
-		}
+	g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+	for (i = 0; i < RPC_MAX_SLOTS; i++) {
+		slot = &rpc_slots[(rpc_slot_next + i) % RPC_MAX_SLOTS];
+		if (slot->state == RPC_SLOT_FREE)
+			break;
 	}
-
-	return CALLBACK_NOT_REGISTERED;
+	/* free_sem guarantees a free slot */
+	assert(i < RPC_MAX_SLOTS);
+	rpc_slot_next = (slot - rpc_slots + 1) % RPC_MAX_SLOTS;
+
+	/* new generation per use, uid never 0 */
+	slot->gen = (slot->gen + 1) & RPC_UID_GEN_MASK;
+	if (!slot->gen)
+		slot->gen = 1;
+	slot->uid = 0;
+	slot->state = RPC_SLOT_RESERVED;
+	slot->req = NULL;
+	slot->resp = NULL;
+	slot->cb = NULL;
+	slot->timer_hdl = NULL;
+	g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+
+	return slot;
 }
 
-
-static int post_sync_resp_sem(ctrl_cmd_t *app_resp)
+/* Mark slot free. Call with rpc_slot_mutex held.
+ * Returns request to be freed by caller, if it was not pooled */
+static ctrl_cmd_t * rpc_slot_reset(rpc_slot_t *slot)
 {
-	int i;
+	ctrl_cmd_t *heap_req = NULL;
 
-	// msg_id of RPC_ID__Resp_Base now means Invalid RPC Request
-	if ((app_resp->msg_id < RPC_ID__Resp_Base) ||
-	    (app_resp->msg_id >= RPC_ID__Resp_Max)) {
-		return MSG_ID_OUT_OF_ORDER;
-	}
+	if (slot->req && slot->req != &slot->req_buf)
+		heap_req = slot->req;
 
-	for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-		if (sync_rsp_table[i].uid == app_resp->uid) {
-			return g_h.funcs->_h_post_semaphore(sync_rsp_table[i].sem);
-		}
-	}
+	slot->state = RPC_SLOT_FREE;
+	slot->uid = 0;
+	slot->req = NULL;
+	slot->resp = NULL;
+	slot->cb = NULL;
+	slot->timer_hdl = NULL;
 
-	return CALLBACK_NOT_REGISTERED;
+	return heap_req;
 }
 
+static void rpc_slot_release(rpc_slot_t *slot)
+{
+	ctrl_cmd_t *heap_req = NULL;
+	void *timer_hdl = NULL;
+
+	g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+	timer_hdl = slot->timer_hdl;
+	heap_req = rpc_slot_reset(slot);
+	g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+
+	g_h.funcs->_h_post_semaphore(rpc_slot_free_sem);
+	if (timer_hdl)
+		g_h.funcs->_h_timer_stop(timer_hdl);
+	HOSTED_FREE(heap_req);
+}
 
-/* Check and call rpc event asynchronous callback if available
- * else flag error
- *     MSG_ID_OUT_OF_ORDER - if event id is not understandable
- *     CALLBACK_NOT_REGISTERED - callback is not registered
+/* Complete the transaction owning app_resp->uid
+ * Sync: response is handed to the waiter, which frees the slot
+ * Async: slot is freed and registered callback is called here
+ * Returns CALLBACK_NOT_REGISTERED if no transaction owns the uid,
+ * app_resp is then still owned by caller
  **/
-static int call_event_callback(ctrl_cmd_t *app_event)
+static int rpc_slot_complete(ctrl_cmd_t *app_resp)
 {
-	if ((app_event->msg_id <= RPC_ID__Event_Base) ||
-	    (app_event->msg_id >= RPC_ID__Event_Max)) {
+	rpc_slot_t *slot = NULL;
+	rpc_rsp_cb_t cb = NULL;
+	void *timer_hdl = NULL;
+	ctrl_cmd_t *heap_req = NULL;
+
+	// msg_id of RPC_ID__Resp_Base now means Invalid RPC Request
+	if ((app_resp->msg_id < RPC_ID__Resp_Base) ||
+	    (app_resp->msg_id >= RPC_ID__Resp_Max)) {
+		ESP_LOGE(TAG, "resp id[0x%x] out of range", app_resp->msg_id);
 		return MSG_ID_OUT_OF_ORDER;
 	}
 
-	if (rpc_evt_cb_table[app_event->msg_id-RPC_ID__Event_Base]) {
-		return rpc_evt_cb_table[app_event->msg_id-RPC_ID__Event_Base](app_event);
+	g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+	slot = rpc_slot_lookup(app_resp->uid);
+	if (!slot || (slot->state != RPC_SLOT_SYNC && slot->state != RPC_SLOT_ASYNC)) {
+		g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+		return CALLBACK_NOT_REGISTERED;
 	}
 
-	return CALLBACK_NOT_REGISTERED;
-}
-
-/* Set asynchronous rpc response callback from rpc **request**
- */
-static int set_async_resp_callback(ctrl_cmd_t *app_req, rpc_rsp_cb_t resp_cb, void *timer_hdl)
-{
-	int i;
-
-	int exp_resp_msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-	if (exp_resp_msg_id >= RPC_ID__Resp_Max) {
-		ESP_LOGW(TAG, "Not able to map new request to resp id");
-		return MSG_ID_OUT_OF_ORDER;
+	if (slot->state == RPC_SLOT_SYNC) {
+		slot->resp = app_resp;
+		slot->state = RPC_SLOT_DONE;
+		g_h.funcs->_h_post_semaphore(slot->sem);
+		g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+		return SUCCESS;
 	}
 
-	for (i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (!async_rsp_table[i].uid) {
-			async_rsp_table[i].uid = app_req->uid;
-			async_rsp_table[i].cb = resp_cb;
-			async_rsp_table[i].timer_hdl = timer_hdl;
-			return CALLBACK_SET_SUCCESS;
-		}
-	}
+	cb = slot->cb;
+	timer_hdl = slot->timer_hdl;
+	heap_req = rpc_slot_reset(slot);
+	g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
 
-	ESP_LOGE(TAG, "Async cb not registered: out of buffer space");
-	return CALLBACK_NOT_REGISTERED;
+	g_h.funcs->_h_post_semaphore(rpc_slot_free_sem);
+	if (timer_hdl)
+		g_h.funcs->_h_timer_stop(timer_hdl);
+	HOSTED_FREE(heap_req);
+
+	cb(app_resp);
+	return SUCCESS;
 }
 
-/* Set synchronous rpc response semaphore
- * In case of asynchronous request, `rx_sem` will be NULL or disregarded
- * `rpc_rsp_cb_sem_table` will be updated with NULL for async
- * In case of synchronous request, valid callback will be cached
- * This sem will posted after receiving the mapping response
- **/
-static int set_sync_resp_sem(ctrl_cmd_t *app_req)
+/* Complete transaction with locally generated failure response */
+static void rpc_slot_fail(uint32_t req_uid, uint16_t req_msg_id, int32_t status)
 {
-	int exp_resp_msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-	int i;
+	ctrl_cmd_t *app_resp = NULL;
 
-	if (app_req->rx_sem)
-		g_h.funcs->_h_destroy_semaphore(app_req->rx_sem);
+	HOSTED_CALLOC(ctrl_cmd_t, app_resp, sizeof(ctrl_cmd_t), fail_resp);
 
-	if (exp_resp_msg_id >= RPC_ID__Resp_Max) {
-		ESP_LOGW(TAG, "Not able to map new request to resp id");
-		return MSG_ID_OUT_OF_ORDER;
-	} else if (!app_req->rpc_rsp_cb) {
-		/* For sync, set sem */
-		app_req->rx_sem = g_h.funcs->_h_create_semaphore(1);
-		g_h.funcs->_h_get_semaphore(app_req->rx_sem, 0);
-
-		for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-			if (!sync_rsp_table[i].uid) {
-				ESP_LOGD(TAG, "Register sync sem %p for uid %ld", app_req->rx_sem, app_req->uid);
-				sync_rsp_table[i].uid = app_req->uid;
-				sync_rsp_table[i].sem = app_req->rx_sem;
-				return CALLBACK_SET_SUCCESS;
-			}
-		}
-		ESP_LOGE(TAG, "Symc sem not registered: out of buffer space");
-		return CALLBACK_NOT_REGISTERED;
-	} else {
-		/* For async, nothing to be done */
-		ESP_LOGD(TAG, "NOT Register sync sem for resp[0x%x]", exp_resp_msg_id);
-		return CALLBACK_NOT_REGISTERED;
+	app_resp->msg_type = RPC_TYPE__Resp;
+	app_resp->msg_id = (req_msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
+	app_resp->uid = req_uid;
+	app_resp->resp_event_status = status;
+
+	if (rpc_slot_complete(app_resp)) {
+		ESP_LOGW(TAG, "no transaction to react to failed message uid %" PRIu32, req_uid);
+		HOSTED_FREE(app_resp);
 	}
+	return;
+
+fail_resp:
+	ESP_LOGE(TAG, "could not notify failure of uid %" PRIu32, req_uid);
 }
 
-static int wait_for_sync_response(ctrl_cmd_t *app_req)
+/* Wait for response of the sync request in its slot, and free the slot */
+static ctrl_cmd_t * wait_for_sync_response(ctrl_cmd_t *app_req)
 {
+	rpc_slot_t *slot = NULL;
+	ctrl_cmd_t *app_resp = NULL;
+	ctrl_cmd_t *heap_req = NULL;
+	uint16_t req_msg_id = app_req->msg_id;
 	int timeout_sec = 0;
-	int exp_resp_msg_id = 0;
 	int ret = 0;
-	int i;
 
 	/* If timeout not specified, use default */
 	if (!app_req->rsp_timeout_sec)
@@ -784,63 +778,62 @@ static int wait_for_sync_response(ctrl_cmd_t *app_req)
 	else
 		timeout_sec = app_req->rsp_timeout_sec;
 
-	exp_resp_msg_id = (app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base);
-
-	if (exp_resp_msg_id >= RPC_ID__Resp_Max) {
-		ESP_LOGW(TAG, "Not able to map new request to resp id");
-		return MSG_ID_OUT_OF_ORDER;
+	/* The sync slot is only freed by its waiter */
+	g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+	slot = rpc_slot_lookup(app_req->uid);
+	g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+	if (!slot) {
+		ESP_LOGW(TAG, "No transaction for Req[0x%x] uid %" PRIu32,
+				req_msg_id, app_req->uid);
+		rpc_core_free_req(app_req);
+		return NULL;
 	}
 
 	ESP_LOGV(TAG, "Wait for sync resp for Req[0x%x] with timer of %u sec",
-			app_req->msg_id, timeout_sec);
-	for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-		if (sync_rsp_table[i].uid == app_req->uid) {
-			ret = g_h.funcs->_h_get_semaphore(sync_rsp_table[i].sem, timeout_sec);
-			if (g_h.funcs->_h_destroy_semaphore(sync_rsp_table[i].sem)) {
-				ESP_LOGE(TAG, "read sem rx for resp[0x%x] destroy failed", exp_resp_msg_id);
-			}
-			// clear table entry
-			sync_rsp_table[i].uid = 0;
-			sync_rsp_table[i].sem = NULL;
-			return ret;
-		}
+			req_msg_id, timeout_sec);
+	ret = g_h.funcs->_h_get_semaphore(slot->sem, timeout_sec);
+
+	g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+	/* response may have landed just after timeout */
+	app_resp = slot->resp;
+	if (ret && app_resp)
+		g_h.funcs->_h_get_semaphore(slot->sem, 0);
+	heap_req = rpc_slot_reset(slot);
+	g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+
+	/* app_req may be reused from here on */
+	g_h.funcs->_h_post_semaphore(rpc_slot_free_sem);
+	HOSTED_FREE(heap_req);
+
+	if (!app_resp) {
+		if ((ret == RET_FAIL_TIMEOUT) || (errno == ETIMEDOUT))
+			ESP_LOGW(TAG, "Timeout waiting for Resp for Req[0x%x]", req_msg_id);
+		else
+			ESP_LOGE(TAG, "ERR [%u] ret[%d] for Req[0x%x]", errno, ret, req_msg_id);
 	}
-	ESP_LOGW(TAG, "Not able to map new request to resp id");
-	return MSG_ID_OUT_OF_ORDER;
+
+	return app_resp;
 }
 
-/* Is asynchronous rpc response callback from rpc response */
-static int is_async_resp_callback_available(ctrl_cmd_t *app_resp)
+/* Check and call rpc event asynchronous callback if available
+ * else flag error
+ *     MSG_ID_OUT_OF_ORDER - if event id is not understandable
+ *     CALLBACK_NOT_REGISTERED - callback is not registered
+ **/
+static int call_event_callback(ctrl_cmd_t *app_event)
 {
-	int i;
-
-	// msg_id of RPC_ID__Resp_Base now means Invalid RPC Request
-	if ((app_resp->msg_id < RPC_ID__Resp_Base) || (app_resp->msg_id >= RPC_ID__Resp_Max)) {
-		ESP_LOGE(TAG, "resp id[0x%x] out of range", app_resp->msg_id);
+	if ((app_event->msg_id <= RPC_ID__Event_Base) ||
+	    (app_event->msg_id >= RPC_ID__Event_Max)) {
 		return MSG_ID_OUT_OF_ORDER;
 	}
 
-	for (i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (async_rsp_table[i].uid == app_resp->uid) {
-			return CALLBACK_AVAILABLE;
-		}
+	if (rpc_evt_cb_table[app_event->msg_id-RPC_ID__Event_Base]) {
+		return rpc_evt_cb_table[app_event->msg_id-RPC_ID__Event_Base](app_event);
 	}
 
 	return CALLBACK_NOT_REGISTERED;
 }
 
-static int is_sync_resp_sem_available(uint32_t uid)
-{
-	int i;
-
-	for (i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-		if (sync_rsp_table[i].uid == uid) {
-			return CALLBACK_AVAILABLE;
-		}
-	}
-	return CALLBACK_NOT_REGISTERED;
-}
-
 /* Set rpc event callback
  * `rpc_evt_cb_table` will be updated with NULL by default
  * when user sets event callback, user provided function pointer
@@ -866,6 +859,102 @@ int reset_event_callback(int event)
 	return set_event_callback(event, NULL);
 }
 
+/* Set event callback, with events of this id coming closer than
+ * min_interval_ms to the last one delivered flagged evt_rate_limited.
+ * min_interval_ms of 0 removes the limit
+ **/
+int set_event_callback_rate_limited(int event, rpc_rsp_cb_t event_cb,
+		uint32_t min_interval_ms)
+{
+	rpc_evt_rate_t *rate = NULL;
+	int ret = set_event_callback(event, event_cb);
+
+	if (ret != CALLBACK_SET_SUCCESS)
+		return ret;
+
+	rate = &rpc_evt_rate_table[event - RPC_ID__Event_Base];
+	rate->min_interval_ms = min_interval_ms;
+	return CALLBACK_SET_SUCCESS;
+}
+
+/* Events flagged by rate limit since start */
+uint32_t get_event_rate_limit_drops(int event)
+{
+	if ((event<=RPC_ID__Event_Base) || (event>=RPC_ID__Event_Max))
+		return 0;
+
+	return rpc_evt_rate_table[event - RPC_ID__Event_Base].dropped;
+}
+
+static rpc_evt_kind_t * rpc_evt_kind_lookup(uint16_t event, int32_t wifi_event_id)
+{
+	rpc_evt_kind_t *kind = NULL;
+	uint8_t i = 0;
+
+	for (i = 0; i < rpc_evt_kinds_used; i++) {
+		kind = &rpc_evt_kinds[i];
+		if (kind->event == event && kind->wifi_event_id == wifi_event_id)
+			return kind;
+	}
+
+	if (rpc_evt_kinds_used == RPC_EVT_RATE_KINDS)
+		return NULL;
+
+	kind = &rpc_evt_kinds[rpc_evt_kinds_used++];
+	kind->event = event;
+	kind->wifi_event_id = wifi_event_id;
+	return kind;
+}
+
+/* Returns ms left of the rate limit interval if event is to be held back,
+ * else 0 and marks it delivered */
+static uint32_t is_event_rate_limited(ctrl_cmd_t *app_event)
+{
+	uint16_t event = app_event->msg_id;
+	rpc_evt_rate_t *rate = &rpc_evt_rate_table[event - RPC_ID__Event_Base];
+	rpc_evt_kind_t *kind = NULL;
+	int32_t wifi_event_id = 0;
+	uint32_t now_ms = 0;
+	uint32_t elapsed_ms = 0;
+
+	if (!rate->min_interval_ms)
+		return 0;
+
+	if (event == RPC_ID__Event_WifiEventNoArgs)
+		wifi_event_id = app_event->u.e_wifi_simple.wifi_event_id;
+
+	/* no room to track it: not limited */
+	kind = rpc_evt_kind_lookup(event, wifi_event_id);
+	if (!kind)
+		return 0;
+
+	now_ms = g_h.funcs->_h_get_time_ms();
+	if (!kind->delivered) {
+		kind->delivered = 1;
+		kind->last_ms = now_ms;
+		return 0;
+	}
+
+	elapsed_ms = now_ms - kind->last_ms;
+	if (kind->held && elapsed_ms >= rate->min_interval_ms) {
+		/* latest one held back went out as interval ended */
+		kind->last_ms += rate->min_interval_ms;
+		kind->held = 0;
+		elapsed_ms = now_ms - kind->last_ms;
+	}
+
+	if (elapsed_ms < rate->min_interval_ms) {
+		kind->held = 1;
+		rate->dropped++;
+		ESP_LOGV(TAG, "event id [0x%x:%" PRId32 "]: rate limited, %" PRIu32 " held back",
+				event, wifi_event_id, rate->dropped);
+		return rate->min_interval_ms - elapsed_ms;
+	}
+
+	kind->last_ms = now_ms;
+	return 0;
+}
+
 /* This is only used in synchrounous rpc
  * When request is sent without async callback, this function will be called
  * It will wait for rpc response or timeout for rpc response
@@ -873,16 +962,13 @@ int reset_event_callback(int event)
 ctrl_cmd_t * rpc_wait_and_parse_sync_resp(ctrl_cmd_t *app_req)
 {
 	ctrl_cmd_t * rx_buf = NULL;
-	int rx_buf_len = 0;
+	uint16_t req_msg_id = app_req->msg_id;
 
-	rx_buf = get_response(&rx_buf_len, app_req);
-	if (!rx_buf || !rx_buf_len) {
-		ESP_LOGE(TAG, "Response not received for [0x%x]", app_req->msg_id);
-		if (rx_buf) {
-			HOSTED_FREE(rx_buf);
-		}
+	/* app_req is freed along with its slot */
+	rx_buf = wait_for_sync_response(app_req);
+	if (!rx_buf) {
+		ESP_LOGE(TAG, "Response not received for [0x%x]", req_msg_id);
 	}
-	HOSTED_FREE(app_req);
 	return rx_buf;
 }
 
@@ -900,29 +986,25 @@ static void rpc_async_timeout_handler(void *arg)
 	 * timer should not expire incorrect duration (Check os_wrapper layer for
 	 * correct seconds to milliseconds or ticks etc depending upon the platform
 	 * */
-	ctrl_cmd_t *app_req = (ctrl_cmd_t *)arg;
-
-	if (!app_req || !app_req->rpc_rsp_cb) {
-	  if (!app_req)
-		ESP_LOGE(TAG, "NULL app_req");
-
-	  if (!app_req->rpc_rsp_cb)
-		ESP_LOGE(TAG, "NULL app_req->resp_cb");
-	  return;
-	}
+	uint32_t req_uid = (uint32_t)(uintptr_t)arg;
+	rpc_slot_t *slot = NULL;
+	uint16_t req_msg_id = 0;
+
+	/* uid, not app_req, is passed: response may have won the race
+	 * and recycled the slot already */
+	g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+	slot = rpc_slot_lookup(req_uid);
+	if (slot && slot->state == RPC_SLOT_ASYNC)
+		req_msg_id = slot->req->msg_id;
+	g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+
+	if (!req_msg_id)
+		return;
 
-	ESP_LOGW(TAG, "ASYNC Timeout for req [0x%x]",app_req->msg_id);
-	rpc_rsp_cb_t func = app_req->rpc_rsp_cb;
-	ctrl_cmd_t *app_resp = NULL;
-	HOSTED_CALLOC(ctrl_cmd_t, app_resp, sizeof(ctrl_cmd_t), free_buffers);
-	app_resp->msg_id = app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base;
-	app_resp->msg_type = RPC_TYPE__Resp;
-	app_resp->resp_event_status = RPC_ERR_REQUEST_TIMEOUT;
+	ESP_LOGW(TAG, "ASYNC Timeout for req [0x%x]", req_msg_id);
 
 	/* call func pointer to notify failure */
-	func(app_resp);
-free_buffers:
-	return;
+	rpc_slot_fail(req_uid, req_msg_id, RPC_ERR_REQUEST_TIMEOUT);
 }
 
 /* This is entry level function when rpc request APIs are used
@@ -932,73 +1014,211 @@ free_buffers:
  **/
 int rpc_send_req(ctrl_cmd_t *app_req)
 {
+	rpc_slot_t *slot = NULL;
+	void *timer_hdl = NULL;
+	uint32_t req_uid = 0;
+	int timeout_sec = 0;
+
 	if (!app_req) {
 		ESP_LOGE(TAG, "Invalid param in rpc_send_req");
 		return FAILURE;
 	}
 
+	if ((app_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base) >= RPC_ID__Resp_Max) {
+		ESP_LOGW(TAG, "Not able to map new request to resp id");
+		goto fail_req;
+	}
 
-	uid++;
-	// handle rollover in uid value
-	if (!uid)
-		uid++;
-	app_req->uid = uid;
+	if (!app_req->rsp_timeout_sec)
+		timeout_sec = DEFAULT_RPC_RSP_TIMEOUT;
+	else
+		timeout_sec = app_req->rsp_timeout_sec;
 
-	ESP_LOGD(TAG, "app_req msgid[0x%x] with uid %" PRIu32, app_req->msg_id, app_req->uid);
-	if (!app_req->rpc_rsp_cb) {
-		/* sync proc only */
-		if (set_sync_resp_sem(app_req)) {
-			ESP_LOGE(TAG, "could not set sync resp sem for req[0x%x]",app_req->msg_id);
+	/* 1. Pooled request already owns its slot, else wait for a free one */
+	slot = rpc_slot_of_req(app_req);
+	if (!slot) {
+		slot = rpc_slot_acquire(timeout_sec);
+		if (!slot) {
+			ESP_LOGE(TAG, "No free rpc slot for req[0x%x]", app_req->msg_id);
 			goto fail_req;
 		}
+	} else if (slot->state != RPC_SLOT_RESERVED) {
+		ESP_LOGE(TAG, "req[0x%x] already sent", app_req->msg_id);
+		return FAILURE;
 	}
 
+	/* 2. Assign uid and arm the slot */
+	g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+	slot->req = app_req;
+	slot->uid = rpc_slot_uid(slot);
+	slot->cb = app_req->rpc_rsp_cb;
+	slot->state = app_req->rpc_rsp_cb ? RPC_SLOT_ASYNC : RPC_SLOT_SYNC;
+	app_req->uid = slot->uid;
 	app_req->msg_type = RPC_TYPE__Req;
+	g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+
+	ESP_LOGD(TAG, "app_req msgid[0x%x] with uid %" PRIu32, app_req->msg_id, app_req->uid);
+
+	/* 3. Start timeout for response for async only
+	 * For sync procedures, g_h.funcs->_h_get_semaphore takes care to
+	 * handle timeout situations */
+	if (app_req->rpc_rsp_cb) {
+		ESP_LOGD(TAG, "starting async resp timer for req[0x%x]", app_req->msg_id);
+		timer_hdl = g_h.funcs->_h_timer_start("rpc_async_timeout_timer",
+				SEC_TO_MILLISEC(timeout_sec), H_TIMER_TYPE_ONESHOT,
+				rpc_async_timeout_handler, (void *)(uintptr_t)app_req->uid);
+		if (!timer_hdl) {
+			ESP_LOGE(TAG, "Failed to start async resp timer");
+			goto fail_req;
+		}
+		/* not queued yet, slot is still ours */
+		g_h.funcs->_h_lock_mutex(rpc_slot_mutex, HOSTED_BLOCK_MAX);
+		slot->timer_hdl = timer_hdl;
+		g_h.funcs->_h_unlock_mutex(rpc_slot_mutex);
+	}
 
-	ESP_LOGV(TAG, "queueing rpc tx q with uid %" PRIu32, app_req->uid);
-	if (g_h.funcs->_h_queue_item(rpc_tx_q, &app_req, HOSTED_BLOCK_MAX)) {
+	/* uid is queued rather than app_req: if the request times out
+	 * before tx thread gets to it, the stale uid is simply dropped */
+	req_uid = app_req->uid;
+	ESP_LOGV(TAG, "queueing rpc tx q with uid %" PRIu32, req_uid);
+	if (g_h.funcs->_h_queue_item(rpc_tx_q, &req_uid, HOSTED_BLOCK_MAX)) {
 	  ESP_LOGE(TAG, "Failed to new app rpc req[0x%x] in tx queue", app_req->msg_id);
 	  goto fail_req;
 	}
 
 	rpc_tx_ind();
 
-	/* TODO : commenting, Review again to avoid duable free */
-	//H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
-
 	return SUCCESS;
 
 fail_req:
-	if (app_req->rx_sem)
-		g_h.funcs->_h_destroy_semaphore(app_req->rx_sem);
-
 	H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
-	HOSTED_FREE(app_req);
+	if (slot)
+		rpc_slot_release(slot);
+	else
+		rpc_core_free_req(app_req);
 
 	return FAILURE;
 }
 
-static int cleanup_sync_async_timer_table(void)
+/* Request from the slot pool, zeroed.
+ * Falls back to heap when all slots are in flight */
+ctrl_cmd_t * rpc_core_alloc_req(void)
 {
-	for (int i = 0; i < MAX_ASYNC_RPC_TRANSACTIONS; i++) {
-		if (async_rsp_table[i].timer_hdl) {
-			g_h.funcs->_h_timer_stop(async_rsp_table[i].timer_hdl);
-		}
-		async_rsp_table[i].timer_hdl = NULL;
-		async_rsp_table[i].uid = 0;
-		async_rsp_table[i].cb = NULL;
+	rpc_slot_t *slot = NULL;
+	ctrl_cmd_t *app_req = NULL;
+
+	slot = rpc_slot_acquire(0);
+	if (!slot)
+		return (ctrl_cmd_t *)g_h.funcs->_h_calloc(1, sizeof(ctrl_cmd_t));
+
+	app_req = &slot->req_buf;
+	g_h.funcs->_h_memset(app_req, 0, sizeof(ctrl_cmd_t));
+	slot->req = app_req;
+
+	return app_req;
+}
+
+void rpc_core_batch_free(void *batch_msg)
+{
+	ctrl_cmd_t *msg = (ctrl_cmd_t *)batch_msg;
+	ctrl_cmd_t *sub = NULL;
+	uint8_t i = 0;
+
+	if (!msg || !msg->u.batch.cmds)
+		return;
+
+	for (i = 0; i < msg->u.batch.n_cmds; i++) {
+		sub = &msg->u.batch.cmds[i];
+		H_FREE_PTR_WITH_FUNC(sub->app_free_buff_func, sub->app_free_buff_hdl);
+	}
+	HOSTED_FREE(msg->u.batch.cmds);
+	msg->u.batch.n_cmds = 0;
+	msg->u.batch.max_cmds = 0;
+}
+
+/* Free request that was never passed to rpc_send_req() */
+void rpc_core_free_req(ctrl_cmd_t *app_req)
+{
+	rpc_slot_t *slot = rpc_slot_of_req(app_req);
+
+	if (app_req)
+		H_FREE_PTR_WITH_FUNC(app_req->app_free_buff_func, app_req->app_free_buff_hdl);
+
+	if (!slot) {
+		HOSTED_FREE(app_req);
+		return;
 	}
 
-	for (int i = 0; i < MAX_SYNC_RPC_TRANSACTIONS; i++) {
-		if (sync_rsp_table[i].sem) {
-			g_h.funcs->_h_get_semaphore(sync_rsp_table[i].sem, 0);
-			g_h.funcs->_h_destroy_semaphore(sync_rsp_table[i].sem);
+	/* sent requests are freed with their transaction */
+	if (slot->state == RPC_SLOT_RESERVED)
+		rpc_slot_release(slot);
+}
+
+static int cleanup_rpc_slots(void)
+{
+	int i;
+
+	if (!rpc_slots)
+		return SUCCESS;
+
+	for (i = 0; i < RPC_MAX_SLOTS; i++) {
+		if (rpc_slots[i].timer_hdl)
+			g_h.funcs->_h_timer_stop(rpc_slots[i].timer_hdl);
+
+		if (rpc_slots[i].sem) {
+			g_h.funcs->_h_get_semaphore(rpc_slots[i].sem, 0);
+			g_h.funcs->_h_destroy_semaphore(rpc_slots[i].sem);
 		}
-		sync_rsp_table[i].uid = 0;
-		sync_rsp_table[i].sem = NULL;
+
+		HOSTED_FREE(rpc_slots[i].resp);
+		if (rpc_slots[i].req != &rpc_slots[i].req_buf)
+			HOSTED_FREE(rpc_slots[i].req);
+	}
+	HOSTED_FREE(rpc_slots);
+
+	if (rpc_slot_free_sem) {
+		g_h.funcs->_h_destroy_semaphore(rpc_slot_free_sem);
+		rpc_slot_free_sem = NULL;
+	}
+
+	if (rpc_slot_mutex) {
+		g_h.funcs->_h_destroy_mutex(rpc_slot_mutex);
+		rpc_slot_mutex = NULL;
+	}
+
+	return SUCCESS;
+}
+
+static int init_rpc_slots(void)
+{
+	int i;
+
+	HOSTED_CALLOC(rpc_slot_t, rpc_slots, sizeof(rpc_slot_t) * RPC_MAX_SLOTS, fail_slots);
+
+	for (i = 0; i < RPC_MAX_SLOTS; i++) {
+		/* reused for every sync request on this slot, start taken */
+		rpc_slots[i].sem = g_h.funcs->_h_create_semaphore(1);
+		if (!rpc_slots[i].sem)
+			goto fail_slots;
+		g_h.funcs->_h_get_semaphore(rpc_slots[i].sem, 0);
 	}
 
+	rpc_slot_mutex = g_h.funcs->_h_create_mutex();
+
+	/* created with one count given, make it all slots */
+	rpc_slot_free_sem = g_h.funcs->_h_create_semaphore(RPC_MAX_SLOTS);
+	if (!rpc_slot_mutex || !rpc_slot_free_sem)
+		goto fail_slots;
+	for (i = 1; i < RPC_MAX_SLOTS; i++)
+		g_h.funcs->_h_post_semaphore(rpc_slot_free_sem);
+
+	rpc_slot_next = 0;
 	return SUCCESS;
+
+fail_slots:
+	ESP_LOGE(TAG, "Failed to create rpc slots");
+	cleanup_rpc_slots();
+	return FAILURE;
 }
 
 /* De-init hosted rpc lib */
@@ -1011,10 +1231,6 @@ int rpc_core_deinit(void)
 
 	set_rpc_lib_state(RPC_LIB_STATE_INACTIVE);
 
-	if (rpc_rx_q) {
-		g_h.funcs->_h_destroy_queue(rpc_rx_q);
-	}
-
 	if (rpc_tx_q) {
 		g_h.funcs->_h_destroy_queue(rpc_tx_q);
 	}
@@ -1024,8 +1240,6 @@ int rpc_core_deinit(void)
 		ESP_LOGE(TAG, "read sem tx deinit failed");
 	}
 
-	cleanup_sync_async_timer_table();
-
 	if (serial_deinit()) {
 		ret = FAILURE;
 		ESP_LOGE(TAG, "Serial de-init failed");
@@ -1036,6 +1250,11 @@ int rpc_core_deinit(void)
 		ESP_LOGE(TAG, "cancel rpc rx thread failed");
 	}
 
+	cleanup_rpc_slots();
+
+	esp_hosted_rpc_arena_deinit(&rpc_tx_arena);
+	esp_hosted_rpc_arena_deinit(&rpc_rx_arena);
+
 	return ret;
 }
 
@@ -1045,8 +1264,7 @@ int rpc_core_init(void)
 	int ret = SUCCESS;
 
 	/* semaphore init */
-	rpc_tx_sem = g_h.funcs->_h_create_semaphore(MAX_SYNC_RPC_TRANSACTIONS +
-			MAX_ASYNC_RPC_TRANSACTIONS);
+	rpc_tx_sem = g_h.funcs->_h_create_semaphore(RPC_MAX_SLOTS);
 	if (!rpc_tx_sem) {
 		ESP_LOGE(TAG, "sem init failed, exiting");
 		goto free_bufs;
@@ -1055,18 +1273,27 @@ int rpc_core_init(void)
 	/* Get semaphore for first time */
 	g_h.funcs->_h_get_semaphore(rpc_tx_sem, 0);
 
+	/* transaction slots init */
+	if (init_rpc_slots())
+		goto free_bufs;
+
+	/* protobuf arenas init */
+	if (esp_hosted_rpc_arena_init(&rpc_tx_arena, H_RPC_ARENA_SIZE) ||
+	    esp_hosted_rpc_arena_init(&rpc_rx_arena, H_RPC_ARENA_SIZE)) {
+		ESP_LOGE(TAG, "Failed to allocate rpc arenas");
+		goto free_bufs;
+	}
+
 	/* serial init */
 	if (serial_init()) {
 		ESP_LOGE(TAG, "Failed to serial_init");
 		goto free_bufs;
 	}
 
-	rpc_rx_q = g_h.funcs->_h_create_queue(RPC_RX_QUEUE_SIZE,
-			sizeof(esp_queue_elem_t));
-
-	rpc_tx_q = g_h.funcs->_h_create_queue(RPC_TX_QUEUE_SIZE,
-			sizeof(void *));
-	if (!rpc_rx_q || !rpc_tx_q) {
+	/* every queued request holds a slot, so this never fills up */
+	rpc_tx_q = g_h.funcs->_h_create_queue(RPC_MAX_SLOTS,
+			sizeof(uint32_t));
+	if (!rpc_tx_q) {
 		ESP_LOGE(TAG, "Failed to create app rpc msg Q");
 		goto free_bufs;
 	}
@@ -13,6 +13,7 @@
 #include <stdbool.h>
 #include "rpc_slave_if.h"
 #include "os_wrapper.h"
+#include "esp_hosted_rpc_arena.h"
 
 #ifndef BIT
 #define BIT(n) (1UL << (n))
@@ -51,12 +52,6 @@
     }
 
 
-#define RPC_FREE_BUFFS() {                                                    \
-  uint8_t idx = 0;                                                            \
-  for (idx=0;idx<app_req->n_rpc_free_buff_hdls; idx++)                        \
-    HOSTED_FREE(app_req->rpc_free_buff_hdls[idx]);                            \
-}
-
 typedef struct q_element {
     void *buf;
     int buf_len;
@@ -102,6 +97,18 @@ int rpc_core_deinit(void);
  */
 int rpc_send_req(ctrl_cmd_t *app_req);
 
+/* Request from the transaction slot pool, zeroed
+ * Falls back to heap allocation when all slots are in flight.
+ * Once passed to rpc_send_req(), it is freed by rpc core, else
+ * rpc_core_free_req() is to be used
+ */
+ctrl_cmd_t * rpc_core_alloc_req(void);
+void rpc_core_free_req(ctrl_cmd_t *app_req);
+
+/* app_free_buff_func of batch request and response, with the msg itself
+ * as app_free_buff_hdl. Frees sub msgs and their buffers */
+void rpc_core_batch_free(void *batch_msg);
+
 /* When request is sent without an async callback, this function will be called
  * It will wait for control response or timeout for control response
  * This is only used in synchrounous control path
@@ -128,7 +135,8 @@ ctrl_cmd_t * rpc_wait_and_parse_sync_resp(ctrl_cmd_t *req);
  * > MSG_ID_OUT_OF_ORDER - if request msg id is unsupported
  * > CALLBACK_NOT_REGISTERED - if aync callback is not available
  **/
-int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req, int32_t *failure_status);
+int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req,
+		esp_hosted_rpc_arena_t *arena, int32_t *failure_status);
 
 int is_event_callback_registered(int event);
 
@@ -11,39 +11,39 @@
 #include "esp_hosted_wifi_config.h"
 #include "esp_hosted_transport.h"
 #include "esp_hosted_bitmasks.h"
+#include "esp_hosted_transport_init.h"
+#include "transport_drv.h"
 
 DEFINE_LOG_TAG(rpc_req);
 
-#define ADD_RPC_BUFF_TO_FREE_LATER(BuFf) {                                      \
-	assert((app_req->n_rpc_free_buff_hdls+1)<=MAX_FREE_BUFF_HANDLES);           \
-	app_req->rpc_free_buff_hdls[app_req->n_rpc_free_buff_hdls++] = BuFf;        \
-}
-
+/* Nested messages live in the tx arena, released after the request is packed */
 #define RPC_ALLOC_ASSIGN(TyPe,MsG_StRuCt,InItFuNc)                            \
     TyPe *req_payload = (TyPe *)                                              \
-        g_h.funcs->_h_calloc(1, sizeof(TyPe));                                \
+        esp_hosted_rpc_arena_calloc(arena, 1, sizeof(TyPe));                  \
     if (!req_payload) {                                                       \
         ESP_LOGE(TAG, "Failed to allocate memory for req->%s\n",#MsG_StRuCt);     \
         *failure_status = RPC_ERR_MEMORY_FAILURE;                              \
 		return FAILURE;                                                       \
     }                                                                         \
     req->MsG_StRuCt = req_payload;                                             \
-	InItFuNc(req_payload);                                                    \
-    ADD_RPC_BUFF_TO_FREE_LATER((uint8_t*)req_payload);
+	InItFuNc(req_payload);
 
 //TODO: How this is different in slave_control.c
 #define RPC_ALLOC_ELEMENT(TyPe,MsG_StRuCt,InIt_FuN) {                         \
-    TyPe *NeW_AllocN = (TyPe *) g_h.funcs->_h_calloc(1, sizeof(TyPe));        \
+    TyPe *NeW_AllocN = (TyPe *) esp_hosted_rpc_arena_calloc(arena, 1, sizeof(TyPe)); \
     if (!NeW_AllocN) {                                                        \
         ESP_LOGE(TAG, "Failed to allocate memory for req->%s\n",#MsG_StRuCt);     \
         *failure_status = RPC_ERR_MEMORY_FAILURE;                              \
 		return FAILURE;                                                       \
     }                                                                         \
-    ADD_RPC_BUFF_TO_FREE_LATER((uint8_t*)NeW_AllocN);                         \
     MsG_StRuCt = NeW_AllocN;                                                  \
     InIt_FuN(MsG_StRuCt);                                                     \
 }
 
+/* scan and station lists as esp_hosted_wifi_records.h, if slave can */
+#define RPC_SLAVE_SENDS_PACKED_RECORDS()                                      \
+    ((get_slave_ext_capabilities() & ESP_RPC_PACKED_RECORDS_SUPPORT) ? true : false)
+
 /* RPC request is simple remote function invokation at slave from host
  *
  * For new RPC request, add up switch case for your message
@@ -55,7 +55,8 @@ DEFINE_LOG_TAG(rpc_req);
  * For altogether new RPC function addition, please check
  * esp_hosted_fg/common/proto/esp_hosted_config.proto
  */
-int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req, int32_t *failure_status)
+int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req,
+		esp_hosted_rpc_arena_t *arena, int32_t *failure_status)
 {
 	switch(req->msg_id) {
 
@@ -83,7 +84,6 @@ int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req, int32_t *failure_status)
 	case RPC_ID__Req_WifiGetChannel:
 	case RPC_ID__Req_WifiGetCountryCode:
 	case RPC_ID__Req_WifiGetCountry:
-	case RPC_ID__Req_WifiApGetStaList:
 	case RPC_ID__Req_WifiStaGetRssi:
 	case RPC_ID__Req_WifiStaGetNegotiatedPhymode:
 	case RPC_ID__Req_WifiStaGetAid:
@@ -140,6 +140,7 @@ int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req, int32_t *failure_status)
 
 		req_payload->ota_data.data = p->ota_data;
 		req_payload->ota_data.len = p->ota_data_len;
+		req_payload->seq_num = p->seq_num;
 		break;
 	} case RPC_ID__Req_WifiSetMaxTxPower: {
 		RPC_ALLOC_ASSIGN(RpcReqWifiSetMaxTxPower,
@@ -407,6 +408,12 @@ int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req, int32_t *failure_status)
 		RPC_ALLOC_ASSIGN(RpcReqWifiScanGetApRecords, req_wifi_scan_get_ap_records,
 				rpc__req__wifi_scan_get_ap_records__init);
 		req_payload->number = app_req->u.wifi_scan_ap_list.number;
+		req_payload->packed = RPC_SLAVE_SENDS_PACKED_RECORDS();
+		break;
+	} case RPC_ID__Req_WifiApGetStaList: {
+		RPC_ALLOC_ASSIGN(RpcReqWifiApGetStaList, req_wifi_ap_get_sta_list,
+				rpc__req__wifi_ap_get_sta_list__init);
+		req_payload->packed = RPC_SLAVE_SENDS_PACKED_RECORDS();
 		break;
 	} case RPC_ID__Req_WifiDeauthSta: {
 		RPC_ALLOC_ASSIGN(RpcReqWifiDeauthSta, req_wifi_deauth_sta,
@@ -598,6 +605,50 @@ int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req, int32_t *failure_status)
 		req_payload->bandmode = app_req->u.wifi_band_mode;
 		break;
 #endif
+	} case RPC_ID__Req_Batch: {
+		rpc_batch_t *p = &app_req->u.batch;
+		ctrl_cmd_t *sub_app_req = NULL;
+		Rpc *sub_req = NULL;
+		uint8_t i = 0;
+		RPC_ALLOC_ASSIGN(RpcReqBatch, req_batch,
+				rpc__req__batch__init);
+
+		if (!p->cmds || !p->n_cmds || (p->n_cmds > RPC_BATCH_MAX_CMDS)) {
+			ESP_LOGE(TAG, "Invalid batch of %u reqs\n", p->n_cmds);
+			*failure_status = RPC_ERR_INCORRECT_ARG;
+			return FAILURE;
+		}
+
+		req_payload->reqs = (Rpc **)esp_hosted_rpc_arena_calloc(arena,
+				p->n_cmds, sizeof(Rpc *));
+		if (!req_payload->reqs) {
+			*failure_status = RPC_ERR_MEMORY_FAILURE;
+			return FAILURE;
+		}
+
+		/* uid of sub request is its index in batch */
+		for (i = 0; i < p->n_cmds; i++) {
+			sub_app_req = &p->cmds[i];
+			if (sub_app_req->msg_id == RPC_ID__Req_Batch) {
+				ESP_LOGE(TAG, "Nested batch not supported\n");
+				*failure_status = RPC_ERR_INCORRECT_ARG;
+				return FAILURE;
+			}
+
+			RPC_ALLOC_ELEMENT(Rpc, sub_req, rpc__init);
+			sub_req->msg_type = RPC_TYPE__Req;
+			sub_req->msg_id = sub_app_req->msg_id;
+			sub_req->uid = i;
+			sub_req->payload_case = (Rpc__PayloadCase) sub_app_req->msg_id;
+
+			if (compose_rpc_req(sub_req, sub_app_req, arena, failure_status)) {
+				ESP_LOGE(TAG, "batch: compose failed for [0x%x]", sub_app_req->msg_id);
+				return FAILURE;
+			}
+			req_payload->reqs[i] = sub_req;
+			req_payload->n_reqs = i + 1;
+		}
+		break;
 	} case RPC_ID__Req_SetDhcpDnsStatus: {
 		RPC_ALLOC_ASSIGN(RpcReqSetDhcpDnsStatus, req_set_dhcp_dns,
 				rpc__req__set_dhcp_dns_status__init);
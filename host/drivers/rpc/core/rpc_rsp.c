@@ -6,11 +6,13 @@
 
 #include "rpc_core.h"
 #include "rpc_slave_if.h"
+#include "esp_hosted_rpc.h"
 #include "esp_log.h"
 #include "esp_hosted_wifi_config.h"
 #include "esp_hosted_transport.h"
 #include "esp_hosted_bitmasks.h"
 #include "esp_hosted_config.h"
+#include "esp_hosted_wifi_records.h"
 
 DEFINE_LOG_TAG(rpc_rsp);
 
@@ -115,6 +117,105 @@ static int rpc_copy_ap_record(wifi_ap_record_t *ap_record, WifiApRecord *rpc_ap_
 	return 0;
 }
 
+/* Records shorter than ours come from an older slave: missing fields stay 0 */
+#define RPC_PACKED_REC_GET(dst, src, rec_len) do {                            \
+    g_h.funcs->_h_memset(&dst, 0, sizeof(dst));                               \
+    g_h.funcs->_h_memcpy(&dst, src, rec_len < sizeof(dst) ? rec_len : sizeof(dst)); \
+} while (0)
+
+static int rpc_copy_packed_ap_records(wifi_ap_record_t *list, int number,
+		ProtobufCBinaryData *packed, uint32_t rec_len)
+{
+	esp_hosted_ap_record_packed_t p = {0};
+	wifi_ap_record_t *ap_record = NULL;
+	int i = 0;
+
+	if (!rec_len || (packed->len < (size_t)number * rec_len)) {
+		ESP_LOGE(TAG, "packed ap records: %u bytes for %d x %" PRIu32,
+				(unsigned)packed->len, number, rec_len);
+		return FAILURE;
+	}
+
+	for (i = 0; i < number; i++) {
+		RPC_PACKED_REC_GET(p, packed->data + i * rec_len, rec_len);
+		ap_record = &list[i];
+
+		g_h.funcs->_h_memcpy(ap_record->bssid, p.bssid, sizeof(p.bssid));
+		g_h.funcs->_h_memcpy(ap_record->ssid, p.ssid, sizeof(p.ssid));
+		ap_record->primary         = p.primary;
+		ap_record->second          = p.second;
+		ap_record->rssi            = p.rssi;
+		ap_record->authmode        = p.authmode;
+		ap_record->pairwise_cipher = p.pairwise_cipher;
+		ap_record->group_cipher    = p.group_cipher;
+		ap_record->ant             = p.ant;
+
+		ap_record->phy_11b       = H_GET_BIT(WIFI_SCAN_AP_REC_phy_11b_BIT, p.bitmask);
+		ap_record->phy_11g       = H_GET_BIT(WIFI_SCAN_AP_REC_phy_11g_BIT, p.bitmask);
+		ap_record->phy_11n       = H_GET_BIT(WIFI_SCAN_AP_REC_phy_11n_BIT, p.bitmask);
+		ap_record->phy_lr        = H_GET_BIT(WIFI_SCAN_AP_REC_phy_lr_BIT, p.bitmask);
+		ap_record->phy_11a       = H_GET_BIT(WIFI_SCAN_AP_REC_phy_11a_BIT, p.bitmask);
+		ap_record->phy_11ac      = H_GET_BIT(WIFI_SCAN_AP_REC_phy_11ac_BIT, p.bitmask);
+		ap_record->phy_11ax      = H_GET_BIT(WIFI_SCAN_AP_REC_phy_11ax_BIT, p.bitmask);
+		ap_record->wps           = H_GET_BIT(WIFI_SCAN_AP_REC_wps_BIT, p.bitmask);
+		ap_record->ftm_responder = H_GET_BIT(WIFI_SCAN_AP_REC_ftm_responder_BIT, p.bitmask);
+		ap_record->ftm_initiator = H_GET_BIT(WIFI_SCAN_AP_REC_ftm_initiator_BIT, p.bitmask);
+		ap_record->reserved      = WIFI_SCAN_AP_GET_RESERVED_VAL(p.bitmask);
+
+		g_h.funcs->_h_memcpy(ap_record->country.cc, p.country_cc, sizeof(p.country_cc));
+		ap_record->country.schan        = p.country_schan;
+		ap_record->country.nchan        = p.country_nchan;
+		ap_record->country.max_tx_power = p.country_max_tx_power;
+		ap_record->country.policy       = p.country_policy;
+
+		ap_record->he_ap.bss_color          = p.he_ap_bitmask & WIFI_HE_AP_INFO_BSS_COLOR_BITS;
+		ap_record->he_ap.partial_bss_color  = H_GET_BIT(WIFI_HE_AP_INFO_partial_bss_color_BIT, p.he_ap_bitmask);
+		ap_record->he_ap.bss_color_disabled = H_GET_BIT(WIFI_HE_AP_INFO_bss_color_disabled_BIT, p.he_ap_bitmask);
+		ap_record->he_ap.bssid_index        = p.he_ap_bssid_index;
+
+		ap_record->bandwidth    = p.bandwidth;
+		ap_record->vht_ch_freq1 = p.vht_ch_freq1;
+		ap_record->vht_ch_freq2 = p.vht_ch_freq2;
+	}
+	return SUCCESS;
+}
+
+static int rpc_copy_packed_sta_list(wifi_sta_list_t *sta_list,
+		ProtobufCBinaryData *packed, uint32_t rec_len)
+{
+	esp_hosted_sta_info_packed_t p = {0};
+	wifi_sta_info_t *p_a_sta = NULL;
+	uint32_t num_stations = 0;
+	uint32_t i = 0;
+
+	if (!rec_len)
+		return FAILURE;
+
+	num_stations = packed->len / rec_len;
+	if (num_stations > ESP_WIFI_MAX_CONN_NUM) {
+		ESP_LOGW(TAG, "Slave returned %" PRIu32 " connected stations, but we can only accept %d items", num_stations, ESP_WIFI_MAX_CONN_NUM);
+		num_stations = ESP_WIFI_MAX_CONN_NUM;
+	}
+
+	for (i = 0; i < num_stations; i++) {
+		RPC_PACKED_REC_GET(p, packed->data + i * rec_len, rec_len);
+		p_a_sta = &sta_list->sta[i];
+
+		g_h.funcs->_h_memcpy(p_a_sta->mac, p.mac, sizeof(p.mac));
+		p_a_sta->rssi = p.rssi;
+
+		p_a_sta->phy_11b = H_GET_BIT(WIFI_STA_INFO_phy_11b_BIT, p.bitmask);
+		p_a_sta->phy_11g = H_GET_BIT(WIFI_STA_INFO_phy_11g_BIT, p.bitmask);
+		p_a_sta->phy_11n = H_GET_BIT(WIFI_STA_INFO_phy_11n_BIT, p.bitmask);
+		p_a_sta->phy_lr = H_GET_BIT(WIFI_STA_INFO_phy_lr_BIT, p.bitmask);
+		p_a_sta->phy_11ax = H_GET_BIT(WIFI_STA_INFO_phy_11ax_BIT, p.bitmask);
+		p_a_sta->is_mesh_child = H_GET_BIT(WIFI_STA_INFO_is_mesh_child_BIT, p.bitmask);
+		p_a_sta->reserved = WIFI_STA_INFO_GET_RESERVED_VAL(p.bitmask);
+	}
+	sta_list->num = num_stations;
+	return SUCCESS;
+}
+
 /* This will copy rpc response from `Rpc` into
  * application structure `ctrl_cmd_t`
  * This function is called after protobuf decoding is successful
@@ -183,6 +284,7 @@ int rpc_parse_rsp(Rpc *rpc_msg, ctrl_cmd_t *app_resp)
 		break;
 	} case RPC_ID__Resp_OTAWrite : {
 		RPC_FAIL_ON_NULL(resp_ota_write);
+		app_resp->u.ota_write.seq_num = rpc_msg->resp_ota_write->written_seq_num;
 		RPC_ERR_IN_RESP(resp_ota_write);
 		if (rpc_msg->resp_ota_write->resp) {
 			ESP_LOGE(TAG, "OTA write failed");
@@ -397,7 +499,8 @@ int rpc_parse_rsp(Rpc *rpc_msg, ctrl_cmd_t *app_resp)
 		ESP_LOGD(TAG, "Num AP records: %u",
 				app_resp->u.wifi_scan_ap_list.number);
 
-		RPC_FAIL_ON_NULL(resp_wifi_scan_get_ap_records->ap_records);
+		if (!rpc_msg->resp_wifi_scan_get_ap_records->packed_rec_len)
+			RPC_FAIL_ON_NULL(resp_wifi_scan_get_ap_records->ap_records);
 
 		list = (wifi_ap_record_t*)g_h.funcs->_h_calloc(p_a->number,
 				sizeof(wifi_ap_record_t));
@@ -409,6 +512,15 @@ int rpc_parse_rsp(Rpc *rpc_msg, ctrl_cmd_t *app_resp)
 		app_resp->app_free_buff_hdl = list;
 
 		ESP_LOGD(TAG, "Number of available APs is %d", p_a->number);
+		if (rpc_msg->resp_wifi_scan_get_ap_records->packed_rec_len) {
+			if (rpc_copy_packed_ap_records(list, p_a->number,
+					&rpc_msg->resp_wifi_scan_get_ap_records->packed_records,
+					rpc_msg->resp_wifi_scan_get_ap_records->packed_rec_len)) {
+				app_resp->resp_event_status = RPC_ERR_PROTOBUF_DECODE;
+				goto fail_parse_rpc_msg;
+			}
+			break;
+		}
 		for (i=0; i<p_a->number; i++) {
 			rpc_copy_ap_record(&list[i], p_c_list[i]);
 		}
@@ -509,6 +621,17 @@ int rpc_parse_rsp(Rpc *rpc_msg, ctrl_cmd_t *app_resp)
 		RPC_FAIL_ON_NULL(resp_wifi_ap_get_sta_list);
 		RPC_ERR_IN_RESP(resp_wifi_ap_get_sta_list);
 
+		if (rpc_msg->resp_wifi_ap_get_sta_list->packed_rec_len) {
+			if (rpc_copy_packed_sta_list(&app_resp->u.wifi_ap_sta_list,
+					&rpc_msg->resp_wifi_ap_get_sta_list->packed_sta,
+					rpc_msg->resp_wifi_ap_get_sta_list->packed_rec_len)) {
+				app_resp->resp_event_status = RPC_ERR_PROTOBUF_DECODE;
+				goto fail_parse_rpc_msg;
+			}
+			break;
+		}
+		RPC_FAIL_ON_NULL(resp_wifi_ap_get_sta_list->sta_list);
+
 		// handle case where slave's num is bigger than our ESP_WIFI_MAX_CONN_NUM
 		uint32_t num_stations = rpc_msg->resp_wifi_ap_get_sta_list->sta_list->num;
 		if (num_stations > ESP_WIFI_MAX_CONN_NUM) {
@@ -679,6 +802,44 @@ int rpc_parse_rsp(Rpc *rpc_msg, ctrl_cmd_t *app_resp)
 		RPC_FAIL_ON_NULL(resp_set_dhcp_dns);
 		RPC_ERR_IN_RESP(resp_set_dhcp_dns);
 		break;
+	} case RPC_ID__Resp_Batch: {
+		RpcRespBatch *p_c = NULL;
+		rpc_batch_t *p_a = &app_resp->u.batch;
+		ctrl_cmd_t *sub = NULL;
+
+		RPC_FAIL_ON_NULL(resp_batch);
+		RPC_ERR_IN_RESP(resp_batch);
+		p_c = rpc_msg->resp_batch;
+
+		if (!p_c->n_resps || (p_c->n_resps > RPC_BATCH_MAX_CMDS)) {
+			ESP_LOGE(TAG, "Invalid batch of %u resps", (unsigned int)p_c->n_resps);
+			app_resp->resp_event_status = RPC_ERR_PROTOBUF_DECODE;
+			goto fail_parse_rpc_msg;
+		}
+
+		p_a->cmds = (ctrl_cmd_t *)g_h.funcs->_h_calloc(p_c->n_resps,
+				sizeof(ctrl_cmd_t));
+		if (!p_a->cmds) {
+			ESP_LOGE(TAG, "Malloc Failed");
+			app_resp->resp_event_status = RPC_ERR_MEMORY_FAILURE;
+			goto fail_parse_rpc_msg;
+		}
+		p_a->n_cmds = p_c->n_resps;
+		p_a->max_cmds = p_c->n_resps;
+
+		app_resp->app_free_buff_func = rpc_core_batch_free;
+		app_resp->app_free_buff_hdl = app_resp;
+
+		/* Each sub response has own status, a failed one
+		 * does not fail the batch */
+		for (i = 0; i < p_c->n_resps; i++) {
+			sub = &p_a->cmds[i];
+			sub->resp_event_status = RPC_ERR_PROTOBUF_DECODE;
+			if (p_c->resps[i]->msg_id == RPC_ID__Resp_Batch)
+				continue;
+			rpc_parse_rsp(p_c->resps[i], sub);
+		}
+		break;
 	} default: {
 		ESP_LOGE(TAG, "Unsupported rpc Resp[%u]", rpc_msg->msg_id);
 		goto fail_parse_rpc_msg;
@@ -11,17 +11,23 @@
 
 DEFINE_LOG_TAG(rpc_api);
 
-#define RPC_SEND_REQ(msGiD) do {                                                \
+/* Once sent, an async req may complete and its slot be reused by another
+ * task at any time, so only the copies taken before sending are used */
+#define RPC_SEND_REQ(msGiD)                                                     \
+    uint16_t req_msg_id = msGiD;                                                \
+    rpc_rsp_cb_t req_rsp_cb = NULL;                                             \
+    do {                                                                        \
     assert(req);                                                                \
-    req->msg_id = msGiD;                                                        \
+    req->msg_id = req_msg_id;                                                   \
+    req_rsp_cb = req->rpc_rsp_cb;                                               \
     if(SUCCESS != rpc_send_req(req)) {                                          \
-        ESP_LOGE(TAG,"Failed to send control req 0x%x\n", req->msg_id);         \
+        ESP_LOGE(TAG,"Failed to send control req 0x%x\n", req_msg_id);          \
         return NULL;                                                            \
     }                                                                           \
 } while(0);
 
 #define RPC_DECODE_RSP_IF_NOT_ASYNC() do {                                      \
-  if (req->rpc_rsp_cb)                                                          \
+  if (req_rsp_cb)                                                               \
     return NULL;                                                                \
   return rpc_wait_and_parse_sync_resp(req);                                     \
 } while(0);
@@ -45,6 +51,16 @@ int rpc_slaveif_stop(void)
 	return rpc_core_stop();
 }
 
+ctrl_cmd_t * rpc_slaveif_alloc_req(void)
+{
+	return rpc_core_alloc_req();
+}
+
+void rpc_slaveif_free_req(ctrl_cmd_t *req)
+{
+	rpc_core_free_req(req);
+}
+
 int rpc_slaveif_deinit(void)
 {
 	ESP_LOGD(TAG, "%s", __func__);
@@ -118,6 +134,54 @@ ctrl_cmd_t * rpc_slaveif_ota_write(ctrl_cmd_t *req)
 	RPC_DECODE_RSP_IF_NOT_ASYNC();
 }
 
+int rpc_slaveif_ota_write_async(ctrl_cmd_t *req)
+{
+	assert(req && req->rpc_rsp_cb);
+	req->msg_id = RPC_ID__Req_OTAWrite;
+	return rpc_send_req(req);
+}
+
+int rpc_slaveif_batch_init(ctrl_cmd_t *req, uint8_t max_cmds)
+{
+	assert(req);
+	if (!max_cmds || max_cmds > RPC_BATCH_MAX_CMDS)
+		max_cmds = RPC_BATCH_MAX_CMDS;
+
+	req->u.batch.cmds = g_h.funcs->_h_calloc(max_cmds, sizeof(ctrl_cmd_t));
+	if (!req->u.batch.cmds)
+		return FAILURE;
+
+	req->u.batch.n_cmds = 0;
+	req->u.batch.max_cmds = max_cmds;
+
+	/* sub requests are released once packed, or if never sent */
+	req->app_free_buff_hdl = req;
+	req->app_free_buff_func = rpc_core_batch_free;
+	return SUCCESS;
+}
+
+ctrl_cmd_t * rpc_slaveif_batch_add(ctrl_cmd_t *req, uint16_t req_msg_id)
+{
+	ctrl_cmd_t *sub = NULL;
+
+	assert(req);
+	if (!req->u.batch.cmds || req->u.batch.n_cmds >= req->u.batch.max_cmds) {
+		ESP_LOGE(TAG, "batch full, req 0x%x not added", req_msg_id);
+		return NULL;
+	}
+
+	sub = &req->u.batch.cmds[req->u.batch.n_cmds++];
+	sub->msg_type = RPC_TYPE__Req;
+	sub->msg_id = req_msg_id;
+	return sub;
+}
+
+ctrl_cmd_t * rpc_slaveif_batch(ctrl_cmd_t *req)
+{
+	RPC_SEND_REQ(RPC_ID__Req_Batch);
+	RPC_DECODE_RSP_IF_NOT_ASYNC();
+}
+
 ctrl_cmd_t * rpc_slaveif_ota_end(ctrl_cmd_t *req)
 {
 	RPC_SEND_REQ(RPC_ID__Req_OTAEnd);
@@ -34,8 +34,6 @@ extern "C" {
 #define CALLBACK_NOT_REGISTERED              -1
 #define MSG_ID_OUT_OF_ORDER                  -2
 
-#define MAX_FREE_BUFF_HANDLES                20
-
 #define MACSTR "%02x:%02x:%02x:%02x:%02x:%02x"
 #define MAC2STR(a) (a)[0], (a)[1], (a)[2], (a)[3], (a)[4], (a)[5]
 
@@ -47,13 +45,13 @@ extern "C" {
 #define DEFAULT_RPC_RSP_TIMEOUT             5
 #define DEFAULT_RPC_RSP_SCAN_TIMEOUT        30
 
+/* Sub requests in one batch request */
+#define RPC_BATCH_MAX_CMDS                  16
+
 #define SUCCESS_STR                          "success"
 #define FAILURE_STR                          "failure"
 #define NOT_CONNECTED_STR                    "not_connected"
 
-#define RPC_RX_QUEUE_SIZE 3
-#define RPC_TX_QUEUE_SIZE 5
-
 /*---- Control structures ----*/
 
 typedef struct {
@@ -104,6 +102,9 @@ typedef struct {
 typedef struct {
 	uint8_t *ota_data;
 	uint32_t ota_data_len;
+	/* req: chunk number of windowed OTA, 0 otherwise
+	 * resp: chunks written to flash so far */
+	uint32_t seq_num;
 } ota_write_t;
 
 typedef struct {
@@ -201,6 +202,16 @@ typedef struct {
 	int32_t wifi_event_id;
 } event_wifi_simple_t;
 
+struct Ctrl_cmd_t;
+
+typedef struct {
+	/* req: sub requests, filled in as for single requests
+	 * resp: their responses, in same order */
+	struct Ctrl_cmd_t *cmds;
+	uint8_t n_cmds;
+	uint8_t max_cmds;
+} rpc_batch_t;
+
 typedef struct Ctrl_cmd_t {
 	/* msg type could be 1. req 2. resp 3. notification */
 	uint8_t msg_type;
@@ -214,6 +225,10 @@ typedef struct Ctrl_cmd_t {
 	/* statusof response or notification */
 	int32_t resp_event_status;
 
+	/* event only: over the rate limit, ms left of the interval,
+	 * after which latest one held back is to be passed on to application */
+	uint32_t evt_rate_limited;
+
 	void * rx_sem;
 
 	union {
@@ -292,6 +307,8 @@ typedef struct Ctrl_cmd_t {
 
 		rpc_set_dhcp_dns_status_t   slave_dhcp_dns_status;
 
+		rpc_batch_t                 batch;
+
 		event_heartbeat_t           e_heartbeat;
 
 		event_wifi_simple_t         e_wifi_simple;
@@ -347,9 +364,6 @@ typedef struct Ctrl_cmd_t {
 	/* free handle to be registered
 	 * Ignored if assigned as NULL */
 	void (*app_free_buff_func)(void *app_free_buff_hdl);
-
-	void *rpc_free_buff_hdls[MAX_FREE_BUFF_HANDLES];
-	uint8_t n_rpc_free_buff_hdls;
 } ctrl_cmd_t;
 
 
@@ -406,6 +420,31 @@ int set_event_callback(int event, rpc_rsp_cb_t event_cb);
  **/
 int reset_event_callback(int event);
 
+/* Set control event callback with rate limit
+ *
+ * Same as set_event_callback, but an event arriving within
+ * min_interval_ms of the last one delivered is passed to event_cb with
+ * evt_rate_limited set to the ms left of the interval. event_cb is to
+ * update its own state from it, but hold it back from application, and
+ * hand on the latest one held back once the interval ends. Meant for
+ * bursty events application does not need each of, like heartbeat or
+ * no-args Wi-Fi events. The latter are limited per wifi_event_id.
+ *
+ * Inputs:
+ * > event - Control Event ID
+ * > event_cb - callback, as in set_event_callback
+ * > min_interval_ms - 0 removes the limit
+ *
+ * Returns:
+ * > MSG_ID_OUT_OF_ORDER - If event is not registered with hosted control lib
+ * > CALLBACK_SET_SUCCESS - Callback is set successful
+ **/
+int set_event_callback_rate_limited(int event, rpc_rsp_cb_t event_cb,
+		uint32_t min_interval_ms);
+
+/* Number of events of this id held back from application by rate limit */
+uint32_t get_event_rate_limit_drops(int event);
+
 
 /* Initialize hosted control library
  *
@@ -433,6 +472,15 @@ int rpc_slaveif_start(void);
 
 int rpc_slaveif_stop(void);
 
+/* Allocate control request, from the rpc transaction pool when a slot is free
+ *
+ * Request passed to any rpc_slaveif_* call below is freed by the library.
+ * Use rpc_slaveif_free_req() only for a request that was never sent
+ **/
+ctrl_cmd_t * rpc_slaveif_alloc_req(void);
+
+void rpc_slaveif_free_req(ctrl_cmd_t *req);
+
 /* Get the MAC address of station or softAP interface of ESP32 */
 ctrl_cmd_t * rpc_slaveif_wifi_get_mac(ctrl_cmd_t *req);
 
@@ -467,6 +515,11 @@ ctrl_cmd_t * rpc_slaveif_ota_begin(ctrl_cmd_t *req);
  * total size written equals size of complete binary */
 ctrl_cmd_t * rpc_slaveif_ota_write(ctrl_cmd_t *req);
 
+/* Same as rpc_slaveif_ota_write, for req with rpc_rsp_cb set.
+ * Returns SUCCESS once sent, else FAILURE, with req and its
+ * app_free_buff_hdl already freed */
+int rpc_slaveif_ota_write_async(ctrl_cmd_t *req);
+
 /* Performs an OTA end operation for ESP32, It validates written OTA image,
  * sets newly written OTA partition as boot partition for next boot,
  * Creates timer which reset ESP32 after 5 sec */
@@ -475,6 +528,27 @@ ctrl_cmd_t * rpc_slaveif_ota_end(ctrl_cmd_t *req);
 /* Gets the co-processor FW Version */
 ctrl_cmd_t * rpc_slaveif_get_coprocessor_fwversion(ctrl_cmd_t *req);
 
+/* Batch of requests, executed in order by ESP32 in a single round trip
+ *
+ * Sub requests are filled in as for single requests, but do not take
+ * rpc transactions of their own. Response of i'th sub request is in
+ * resp->u.batch.cmds[i], with its own resp_event_status.
+ *
+ *   req = rpc_slaveif_alloc_req();
+ *   rpc_slaveif_batch_init(req, 2);
+ *   sub = rpc_slaveif_batch_add(req, RPC_ID__Req_GetMACAddress);
+ *   sub->u.wifi_mac.mode = WIFI_IF_STA;
+ *   rpc_slaveif_batch_add(req, RPC_ID__Req_GetWifiMode);
+ *   resp = rpc_slaveif_batch(req);
+ *
+ * Returns:
+ * > rpc_slaveif_batch_init: SUCCESS or FAILURE on no memory
+ * > rpc_slaveif_batch_add: sub request, NULL when batch is full
+ **/
+int rpc_slaveif_batch_init(ctrl_cmd_t *req, uint8_t max_cmds);
+ctrl_cmd_t * rpc_slaveif_batch_add(ctrl_cmd_t *req, uint16_t req_msg_id);
+ctrl_cmd_t * rpc_slaveif_batch(ctrl_cmd_t *req);
+
 /* TODO: add descriptions */
 ctrl_cmd_t * rpc_slaveif_wifi_init(ctrl_cmd_t *req);
 ctrl_cmd_t * rpc_slaveif_wifi_deinit(ctrl_cmd_t *req);
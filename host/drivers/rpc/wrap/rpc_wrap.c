@@ -31,6 +31,7 @@ uint8_t restart_after_slave_ota = 0;
 #define CHUNK_SIZE                                        1400
 
 #define OTA_BEGIN_RSP_TIMEOUT_SEC                         15
+#define OTA_WRITE_RSP_TIMEOUT_SEC                         10
 #define WIFI_INIT_RSP_TIMEOUT_SEC                         10
 #define OTA_FROM_WEB_URL                                  1
 
@@ -38,9 +39,134 @@ uint8_t restart_after_slave_ota = 0;
 /* Forward declarations */
 static int rpc_wifi_connect_async(void);
 
+/* Windowed OTA: chunks in flight are bounded by credits, one given back
+ * per OTA write response, or per chunk failed to be sent. First failure
+ * is kept and reported */
+static struct {
+	void *credits;
+	uint8_t window;
+	uint32_t seq_num;
+	volatile int err;
+} ota_win;
+
+static int rpc_ota_window_init(void);
+
+typedef struct {
+	uint8_t primary;
+	wifi_second_chan_t second;
+} wcache_channel_t;
+
+#if H_WIFI_STATE_CACHE
+/* Read-through cache of slave Wi-Fi state. Getters fill it, setters
+ * refresh or drop their entry and events changing the state on slave
+ * drop the affected entries. Dropping bumps gen, so that a getter whose
+ * request raced with the event does not store what it fetched */
+#define WCACHE_MODE                                       (1 << 0)
+#define WCACHE_AP_INFO                                    (1 << 1)
+#define WCACHE_CHANNEL                                    (1 << 2)
+#define WCACHE_MAC(ifx)                                   (1 << (3 + (ifx)))
+#define WCACHE_CONFIG(ifx)                                (1 << (5 + (ifx)))
+#define WCACHE_BW(ifx)                                    (1 << (7 + (ifx)))
+#define WCACHE_ALL                                        0xFFFFFFFF
+
+static struct {
+	void *lock;
+	uint32_t valid;
+	uint32_t gen;
+	uint32_t ap_info_ms;
+	wifi_mode_t mode;
+	uint8_t mac[2][BSSID_BYTES_SIZE];
+	wifi_config_t config[2];
+	wifi_bandwidth_t bw[2];
+	wcache_channel_t channel;
+	wifi_ap_record_t ap_info;
+} wcache;
+
+static bool wcache_fresh(uint32_t bit)
+{
+	if (!(wcache.valid & bit))
+		return false;
+#if H_WIFI_STATE_CACHE_AP_INFO_MS
+	if ((bit == WCACHE_AP_INFO) &&
+	    (g_h.funcs->_h_get_time_ms() - wcache.ap_info_ms >= H_WIFI_STATE_CACHE_AP_INFO_MS))
+		return false;
+#endif
+	return true;
+}
+
+static bool wcache_get(uint32_t bit, void *out, const void *entry, size_t len)
+{
+	bool hit = false;
+
+	if (!wcache.lock)
+		return false;
+
+	g_h.funcs->_h_lock_mutex(wcache.lock, HOSTED_BLOCK_MAX);
+	if (wcache_fresh(bit)) {
+		g_h.funcs->_h_memcpy(out, entry, len);
+		hit = true;
+	}
+	g_h.funcs->_h_unlock_mutex(wcache.lock);
+	return hit;
+}
+
+static uint32_t wcache_gen(void)
+{
+	uint32_t gen = 0;
+
+	if (!wcache.lock)
+		return 0;
+
+	g_h.funcs->_h_lock_mutex(wcache.lock, HOSTED_BLOCK_MAX);
+	gen = wcache.gen;
+	g_h.funcs->_h_unlock_mutex(wcache.lock);
+	return gen;
+}
+
+static void wcache_put(uint32_t bit, uint32_t gen, void *entry, const void *val, size_t len)
+{
+	if (!wcache.lock)
+		return;
+
+	g_h.funcs->_h_lock_mutex(wcache.lock, HOSTED_BLOCK_MAX);
+	if (gen == wcache.gen) {
+		g_h.funcs->_h_memcpy(entry, val, len);
+		wcache.valid |= bit;
+		if (bit == WCACHE_AP_INFO)
+			wcache.ap_info_ms = g_h.funcs->_h_get_time_ms();
+	}
+	g_h.funcs->_h_unlock_mutex(wcache.lock);
+}
+
+static void wcache_drop(uint32_t bits)
+{
+	if (!wcache.lock)
+		return;
+
+	g_h.funcs->_h_lock_mutex(wcache.lock, HOSTED_BLOCK_MAX);
+	wcache.valid &= ~bits;
+	wcache.gen++;
+	g_h.funcs->_h_unlock_mutex(wcache.lock);
+}
+
+/* only STA and AP are cached */
+#define WCACHE_IFX(ifx)             (((ifx) == WIFI_IF_STA) || ((ifx) == WIFI_IF_AP))
+#define WCACHE_GEN()                wcache_gen()
+#define WCACHE_GET(bit, out, field) wcache_get(bit, out, &wcache.field, sizeof(wcache.field))
+#define WCACHE_PUT(bit, gen, field, val) \
+	wcache_put(bit, gen, &wcache.field, val, sizeof(wcache.field))
+#define WCACHE_DROP(bits)           wcache_drop(bits)
+#else
+#define WCACHE_IFX(ifx)             0
+#define WCACHE_GEN()                0
+#define WCACHE_GET(bit, out, field) false
+#define WCACHE_PUT(bit, gen, field, val) (void)(gen)
+#define WCACHE_DROP(bits)
+#endif
+
 static ctrl_cmd_t * RPC_DEFAULT_REQ(void)
 {
-  ctrl_cmd_t *new_req = (ctrl_cmd_t*)g_h.funcs->_h_calloc(1, sizeof(ctrl_cmd_t));
+  ctrl_cmd_t *new_req = rpc_slaveif_alloc_req();
   assert(new_req);
   new_req->msg_type = RPC_TYPE__Req;
   new_req->rpc_rsp_cb = NULL;
@@ -72,15 +198,46 @@ typedef struct {
 	rpc_rsp_cb_t fun;
 } event_callback_table_t;
 
+/* Posts held back by event rate limit, made when the interval ends.
+ * Only the latest post of each Wi-Fi event id is kept. Held posts go
+ * out ahead of any post made straight away, to keep the order */
+#define EVT_HELD_MAX                                      8
+
+typedef struct {
+	uint32_t uid;
+	int32_t event_id;
+	void *data;
+	size_t size;
+	void *timer_hdl;
+} evt_held_t;
+
+static struct {
+	void *lock;
+	uint32_t uid;
+	evt_held_t post[EVT_HELD_MAX];
+} evt_held;
+
 int rpc_init(void)
 {
 	ESP_LOGD(TAG, "%s", __func__);
+#if H_WIFI_STATE_CACHE
+	if (!wcache.lock)
+		wcache.lock = g_h.funcs->_h_create_mutex();
+	if (!wcache.lock)
+		ESP_LOGW(TAG, "Wi-Fi state cache disabled, no mutex");
+#endif
+	if (!evt_held.lock)
+		evt_held.lock = g_h.funcs->_h_create_mutex();
+	if (!evt_held.lock)
+		ESP_LOGW(TAG, "Event rate limit posts all events, no mutex");
 	return rpc_slaveif_init();
 }
 
 int rpc_start(void)
 {
 	ESP_LOGD(TAG, "%s", __func__);
+	/* slave may have restarted meanwhile */
+	WCACHE_DROP(WCACHE_ALL);
 	return rpc_slaveif_start();
 }
 
@@ -92,7 +249,33 @@ int rpc_stop(void)
 
 int rpc_deinit(void)
 {
+	evt_held_t post[EVT_HELD_MAX];
+	uint8_t i = 0;
+
 	ESP_LOGD(TAG, "%s", __func__);
+	if (evt_held.lock) {
+		/* held posts are dropped */
+		g_h.funcs->_h_lock_mutex(evt_held.lock, HOSTED_BLOCK_MAX);
+		memcpy(post, evt_held.post, sizeof(post));
+		memset(evt_held.post, 0, sizeof(evt_held.post));
+		g_h.funcs->_h_unlock_mutex(evt_held.lock);
+
+		for (i = 0; i < EVT_HELD_MAX; i++) {
+			if (post[i].timer_hdl)
+				g_h.funcs->_h_timer_stop(post[i].timer_hdl);
+			if (post[i].data)
+				g_h.funcs->_h_free(post[i].data);
+		}
+		g_h.funcs->_h_destroy_mutex(evt_held.lock);
+		evt_held.lock = NULL;
+	}
+#if H_WIFI_STATE_CACHE
+	if (wcache.lock) {
+		g_h.funcs->_h_destroy_mutex(wcache.lock);
+		wcache.lock = NULL;
+	}
+	wcache.valid = 0;
+#endif
 	return rpc_slaveif_deinit();
 }
 
@@ -103,6 +286,154 @@ static bool is_wifi_netif_started(wifi_interface_t wifi_if) {
 	return (netif != NULL) && esp_netif_is_netif_up(netif);
 }
 
+/* Takes out held post uid, or oldest one for uid 0. Called with evt_held.lock */
+static int evt_held_take(uint32_t uid, evt_held_t *out)
+{
+	evt_held_t *post = NULL;
+	uint8_t i = 0;
+
+	for (i = 0; i < EVT_HELD_MAX; i++) {
+		if (!evt_held.post[i].uid)
+			continue;
+		if (uid ? (evt_held.post[i].uid == uid) :
+		    (!post || (int32_t)(evt_held.post[i].uid - post->uid) < 0))
+			post = &evt_held.post[i];
+	}
+	if (!post)
+		return 0;
+
+	*out = *post;
+	memset(post, 0, sizeof(evt_held_t));
+	return 1;
+}
+
+static void evt_held_post(evt_held_t *post)
+{
+	g_h.funcs->_h_event_wifi_post(post->event_id, post->data, post->size, HOSTED_BLOCK_MAX);
+	if (post->data)
+		g_h.funcs->_h_free(post->data);
+}
+
+/* Posts all held back ones, oldest first. Called with evt_held.lock.
+ * Their timers are returned in timer_hdl, to be stopped after unlock,
+ * as timer handler may be waiting on the lock */
+static void evt_held_flush(void *timer_hdl[EVT_HELD_MAX])
+{
+	evt_held_t post = {0};
+	uint8_t n = 0;
+
+	while (evt_held_take(0, &post)) {
+		evt_held_post(&post);
+		while (timer_hdl[n])
+			n++;
+		timer_hdl[n] = post.timer_hdl;
+	}
+}
+
+static void evt_held_timeout_handler(void *arg)
+{
+	uint32_t uid = (uint32_t)(uintptr_t)arg;
+	evt_held_t post = {0};
+	int found = 0;
+
+	/* uid, not slot, is passed: post may have been flushed or replaced */
+	g_h.funcs->_h_lock_mutex(evt_held.lock, HOSTED_BLOCK_MAX);
+	found = evt_held_take(uid, &post);
+	if (found)
+		evt_held_post(&post);
+	g_h.funcs->_h_unlock_mutex(evt_held.lock);
+
+	if (found && post.timer_hdl)
+		g_h.funcs->_h_timer_stop(post.timer_hdl);
+}
+
+/* Keeps a copy of the post, replacing the one held for event_id if any,
+ * to be made in hold_ms */
+static void evt_held_add(int32_t event_id, void *event_data,
+		size_t event_data_size, uint32_t hold_ms,
+		void *timer_hdl[EVT_HELD_MAX])
+{
+	evt_held_t *post = NULL;
+	evt_held_t old = {0};
+	uint8_t i = 0;
+
+	for (i = 0; i < EVT_HELD_MAX; i++) {
+		if (evt_held.post[i].uid && evt_held.post[i].event_id == event_id) {
+			old = evt_held.post[i];
+			memset(&evt_held.post[i], 0, sizeof(evt_held_t));
+			if (old.data)
+				g_h.funcs->_h_free(old.data);
+			timer_hdl[0] = old.timer_hdl;
+			break;
+		}
+	}
+
+	for (i = 0; i < EVT_HELD_MAX && !post; i++)
+		if (!evt_held.post[i].uid)
+			post = &evt_held.post[i];
+
+	if (!post) {
+		/* no room: not held back then */
+		evt_held_flush(timer_hdl);
+		g_h.funcs->_h_event_wifi_post(event_id, event_data, event_data_size, HOSTED_BLOCK_MAX);
+		return;
+	}
+
+	if (event_data_size) {
+		post->data = g_h.funcs->_h_malloc(event_data_size);
+		if (!post->data) {
+			ESP_LOGE(TAG, "event[%" PRId32 "]: no memory to hold back, posting", event_id);
+			evt_held_flush(timer_hdl);
+			g_h.funcs->_h_event_wifi_post(event_id, event_data, event_data_size, HOSTED_BLOCK_MAX);
+			return;
+		}
+		memcpy(post->data, event_data, event_data_size);
+	}
+	post->size = event_data_size;
+	post->event_id = event_id;
+	if (!++evt_held.uid)
+		evt_held.uid++;
+	post->uid = evt_held.uid;
+
+	/* started with lock held, so handler finds timer_hdl set */
+	post->timer_hdl = g_h.funcs->_h_timer_start("rpc_evt_held", hold_ms,
+			H_TIMER_TYPE_ONESHOT, evt_held_timeout_handler,
+			(void *)(uintptr_t)post->uid);
+	if (!post->timer_hdl) {
+		ESP_LOGE(TAG, "event[%" PRId32 "]: failed to start hold timer, posting", event_id);
+		evt_held_flush(timer_hdl);
+	}
+}
+
+/* Posts event to application, or holds it back by rate limit until the
+ * interval ends. Rate limited events still go through rpc_event_callback,
+ * so the netif state and cached values follow every event */
+static void rpc_event_post(ctrl_cmd_t *app_event, int32_t event_id,
+		void *event_data, size_t event_data_size)
+{
+	void *timer_hdl[EVT_HELD_MAX] = {0};
+	uint8_t i = 0;
+
+	if (!evt_held.lock) {
+		g_h.funcs->_h_event_wifi_post(event_id, event_data, event_data_size, HOSTED_BLOCK_MAX);
+		return;
+	}
+
+	g_h.funcs->_h_lock_mutex(evt_held.lock, HOSTED_BLOCK_MAX);
+	if (app_event->evt_rate_limited) {
+		evt_held_add(event_id, event_data, event_data_size,
+				app_event->evt_rate_limited, timer_hdl);
+	} else {
+		evt_held_flush(timer_hdl);
+		g_h.funcs->_h_event_wifi_post(event_id, event_data, event_data_size, HOSTED_BLOCK_MAX);
+	}
+	g_h.funcs->_h_unlock_mutex(evt_held.lock);
+
+	for (i = 0; i < EVT_HELD_MAX; i++)
+		if (timer_hdl[i])
+			g_h.funcs->_h_timer_stop(timer_hdl[i]);
+}
+
 static int rpc_event_callback(ctrl_cmd_t * app_event)
 {
 	static bool netif_started = false;
@@ -126,6 +457,7 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 
 		case RPC_ID__Event_ESPInit: {
 			ESP_LOGI(TAG, "--- ESP Event: Slave ESP Init ---");
+			WCACHE_DROP(WCACHE_ALL);
 			break;
 		} case RPC_ID__Event_Heartbeat: {
 			ESP_LOGI(TAG, "ESP Event: Heartbeat event [%lu]",
@@ -135,16 +467,16 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 			wifi_event_ap_staconnected_t *p_e = &app_event->u.e_wifi_ap_staconnected;
 			if (strlen((char*)p_e->mac)) {
 				ESP_LOGI(TAG, "ESP Event: SoftAP mode: station connected with MAC Addr " MACSTR, MAC2STR(p_e->mac));
-				g_h.funcs->_h_event_wifi_post(WIFI_EVENT_AP_STACONNECTED,
-					p_e, sizeof(wifi_event_ap_staconnected_t), HOSTED_BLOCK_MAX);
+				rpc_event_post(app_event, WIFI_EVENT_AP_STACONNECTED,
+					p_e, sizeof(wifi_event_ap_staconnected_t));
 			}
 			break;
 		} case RPC_ID__Event_AP_StaDisconnected: {
 			wifi_event_ap_stadisconnected_t *p_e = &app_event->u.e_wifi_ap_stadisconnected;
 			if (strlen((char*)p_e->mac)) {
 				ESP_LOGI(TAG, "ESP Event: SoftAP mode: disconnected station");
-				g_h.funcs->_h_event_wifi_post(WIFI_EVENT_AP_STADISCONNECTED,
-					p_e, sizeof(wifi_event_ap_stadisconnected_t), HOSTED_BLOCK_MAX);
+				rpc_event_post(app_event, WIFI_EVENT_AP_STADISCONNECTED,
+					p_e, sizeof(wifi_event_ap_stadisconnected_t));
 			}
 			break;
 		} case RPC_ID__Event_StaConnected: {
@@ -152,45 +484,48 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 
 			wifi_event_sta_connected_t *p_e = &app_event->u.e_wifi_sta_connected;
 
+			WCACHE_DROP(WCACHE_AP_INFO | WCACHE_CHANNEL |
+					WCACHE_CONFIG(WIFI_IF_STA) | WCACHE_BW(WIFI_IF_STA));
 			if (!netif_connected && netif_started) {
-				g_h.funcs->_h_event_wifi_post(WIFI_EVENT_STA_STOP, 0, 0, HOSTED_BLOCK_MAX);
-				g_h.funcs->_h_event_wifi_post(WIFI_EVENT_STA_START, 0, 0, HOSTED_BLOCK_MAX);
-				g_h.funcs->_h_event_wifi_post(WIFI_EVENT_STA_CONNECTED,
-					p_e, sizeof(wifi_event_sta_connected_t), HOSTED_BLOCK_MAX);
+				rpc_event_post(app_event, WIFI_EVENT_STA_STOP, 0, 0);
+				rpc_event_post(app_event, WIFI_EVENT_STA_START, 0, 0);
+				rpc_event_post(app_event, WIFI_EVENT_STA_CONNECTED,
+					p_e, sizeof(wifi_event_sta_connected_t));
 				netif_connected = true;
 			}
 			break;
 		} case RPC_ID__Event_StaDisconnected: {
 			ESP_LOGI(TAG, "ESP Event: Station mode: Disconnected");
 			wifi_event_sta_disconnected_t *p_e = &app_event->u.e_wifi_sta_disconnected;
-			g_h.funcs->_h_event_wifi_post(WIFI_EVENT_STA_DISCONNECTED,
-				p_e, sizeof(wifi_event_sta_disconnected_t), HOSTED_BLOCK_MAX);
+			WCACHE_DROP(WCACHE_AP_INFO | WCACHE_CHANNEL);
+			rpc_event_post(app_event, WIFI_EVENT_STA_DISCONNECTED,
+				p_e, sizeof(wifi_event_sta_disconnected_t));
 			netif_connected = false;
 			break;
 #if H_WIFI_HE_SUPPORT
 		} case RPC_ID__Event_StaItwtSetup: {
 			ESP_LOGV(TAG, "ESP Event: iTWT: Setup");
 			wifi_event_sta_itwt_setup_t *p_e = &app_event->u.e_wifi_sta_itwt_setup;
-			g_h.funcs->_h_event_wifi_post(WIFI_EVENT_ITWT_SETUP,
-				p_e, sizeof(wifi_event_sta_itwt_setup_t), HOSTED_BLOCK_MAX);
+			rpc_event_post(app_event, WIFI_EVENT_ITWT_SETUP,
+				p_e, sizeof(wifi_event_sta_itwt_setup_t));
 			break;
 		} case RPC_ID__Event_StaItwtTeardown: {
 			ESP_LOGV(TAG, "ESP Event: iTWT: Teardown");
 			wifi_event_sta_itwt_teardown_t *p_e = &app_event->u.e_wifi_sta_itwt_teardown;
-			g_h.funcs->_h_event_wifi_post(WIFI_EVENT_ITWT_TEARDOWN,
-				p_e, sizeof(wifi_event_sta_itwt_teardown_t), HOSTED_BLOCK_MAX);
+			rpc_event_post(app_event, WIFI_EVENT_ITWT_TEARDOWN,
+				p_e, sizeof(wifi_event_sta_itwt_teardown_t));
 			break;
 		} case RPC_ID__Event_StaItwtSuspend: {
 			ESP_LOGV(TAG, "ESP Event: iTWT: Suspend");
 			wifi_event_sta_itwt_suspend_t *p_e = &app_event->u.e_wifi_sta_itwt_suspend;
-			g_h.funcs->_h_event_wifi_post(WIFI_EVENT_ITWT_SUSPEND,
-				p_e, sizeof(wifi_event_sta_itwt_suspend_t), HOSTED_BLOCK_MAX);
+			rpc_event_post(app_event, WIFI_EVENT_ITWT_SUSPEND,
+				p_e, sizeof(wifi_event_sta_itwt_suspend_t));
 			break;
 		} case RPC_ID__Event_StaItwtProbe: {
 			ESP_LOGV(TAG, "ESP Event: iTWT: Probe");
 			wifi_event_sta_itwt_probe_t *p_e = &app_event->u.e_wifi_sta_itwt_probe;
-			g_h.funcs->_h_event_wifi_post(WIFI_EVENT_ITWT_PROBE,
-				p_e, sizeof(wifi_event_sta_itwt_probe_t), HOSTED_BLOCK_MAX);
+			rpc_event_post(app_event, WIFI_EVENT_ITWT_PROBE,
+				p_e, sizeof(wifi_event_sta_itwt_probe_t));
 			break;
 #endif // H_WIFI_HE_SUPPORT
 		} case RPC_ID__Event_WifiEventNoArgs: {
@@ -200,37 +535,42 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 
 			case WIFI_EVENT_STA_START:
 				ESP_LOGI(TAG, "ESP Event: wifi station started");
+				WCACHE_DROP(WCACHE_AP_INFO | WCACHE_CHANNEL);
 				/* Trigger connection when station is started */
 				if (!netif_started && !is_wifi_netif_started(WIFI_IF_STA)) {
-					g_h.funcs->_h_event_wifi_post(wifi_event_id, 0, 0, HOSTED_BLOCK_MAX);
+					rpc_event_post(app_event, wifi_event_id, 0, 0);
 					rpc_wifi_connect_async();
 					netif_started = true;
 				}
 				break;
 			case WIFI_EVENT_STA_STOP:
 				ESP_LOGI(TAG, "ESP Event: wifi station stopped");
+				WCACHE_DROP(WCACHE_AP_INFO | WCACHE_CHANNEL);
 				netif_started = false;
 				netif_connected = false;
-				g_h.funcs->_h_event_wifi_post(wifi_event_id, 0, 0, HOSTED_BLOCK_MAX);
+				rpc_event_post(app_event, wifi_event_id, 0, 0);
 				break;
 
 			case WIFI_EVENT_AP_START:
 				ESP_LOGI(TAG,"ESP Event: softap started");
+				WCACHE_DROP(WCACHE_CHANNEL | WCACHE_CONFIG(WIFI_IF_AP) | WCACHE_BW(WIFI_IF_AP));
 				if (!softap_started && !is_wifi_netif_started(WIFI_IF_AP)) {
-					g_h.funcs->_h_event_wifi_post(wifi_event_id, 0, 0, HOSTED_BLOCK_MAX);
+					rpc_event_post(app_event, wifi_event_id, 0, 0);
 					softap_started = true;
 				}
 				break;
 
 			case WIFI_EVENT_AP_STOP:
 				ESP_LOGI(TAG,"ESP Event: softap stopped");
+				WCACHE_DROP(WCACHE_CHANNEL | WCACHE_CONFIG(WIFI_IF_AP) | WCACHE_BW(WIFI_IF_AP));
 				softap_started = false;
-				g_h.funcs->_h_event_wifi_post(wifi_event_id, 0, 0, HOSTED_BLOCK_MAX);
+				rpc_event_post(app_event, wifi_event_id, 0, 0);
 				break;
 
 			case WIFI_EVENT_HOME_CHANNEL_CHANGE:
 				ESP_LOGD(TAG,"ESP Event: Home channel changed");
-				g_h.funcs->_h_event_wifi_post(wifi_event_id, 0, 0, HOSTED_BLOCK_MAX);
+				WCACHE_DROP(WCACHE_AP_INFO | WCACHE_CHANNEL);
+				rpc_event_post(app_event, wifi_event_id, 0, 0);
 				break;
 
 			case WIFI_EVENT_AP_STACONNECTED:
@@ -252,8 +592,8 @@ static int rpc_event_callback(ctrl_cmd_t * app_event)
 			wifi_event_sta_scan_done_t *p_e = &app_event->u.e_wifi_sta_scan_done;
 			ESP_LOGI(TAG, "ESP Event: StaScanDone");
 			ESP_LOGV(TAG, "scan: status: %lu number:%u scan_id:%u", p_e->status, p_e->number, p_e->scan_id);
-			g_h.funcs->_h_event_wifi_post(WIFI_EVENT_SCAN_DONE,
-				p_e, sizeof(wifi_event_sta_scan_done_t), HOSTED_BLOCK_MAX);
+			rpc_event_post(app_event, WIFI_EVENT_SCAN_DONE,
+				p_e, sizeof(wifi_event_sta_scan_done_t));
 			break;
 		} case RPC_ID__Event_DhcpDnsStatus: {
 			break;
@@ -381,6 +721,18 @@ int rpc_register_event_callbacks(void)
 	return ret;
 }
 
+esp_err_t rpc_set_event_rate_limit(int32_t event_id, uint32_t min_interval_ms)
+{
+	if (CALLBACK_SET_SUCCESS != set_event_callback_rate_limited(event_id,
+				rpc_event_callback, min_interval_ms)) {
+		ESP_LOGE(TAG, "rate limit failed for event[%" PRId32 "]", event_id);
+		return ESP_ERR_INVALID_ARG;
+	}
+	ESP_LOGI(TAG, "event[%" PRId32 "]: at most one per %" PRIu32 " ms",
+			event_id, min_interval_ms);
+	return ESP_OK;
+}
+
 
 int rpc_rsp_callback(ctrl_cmd_t * app_resp)
 {
@@ -548,6 +900,9 @@ int rpc_rsp_callback(ctrl_cmd_t * app_resp)
 	case RPC_ID__Resp_GetCoprocessorFwVersion: {
 		/* Intended fallthrough */
 		break;
+	} case RPC_ID__Resp_Batch: {
+		ESP_LOGV(TAG, "batch of %u resps", app_resp->u.batch.n_cmds);
+		break;
 	} default: {
 		ESP_LOGE(TAG, "Invalid Response[0x%x] to parse", app_resp->msg_id);
 		goto fail_resp;
@@ -589,6 +944,10 @@ int rpc_set_wifi_mode(wifi_mode_t mode)
 	req->u.wifi_mode.mode = mode;
 	resp = rpc_slaveif_wifi_set_mode(req);
 
+	WCACHE_DROP(WCACHE_MODE | WCACHE_AP_INFO | WCACHE_CHANNEL);
+	if (resp && resp->resp_event_status == SUCCESS)
+		WCACHE_PUT(WCACHE_MODE, WCACHE_GEN(), mode, &mode);
+
 	return rpc_rsp_callback(resp);
 }
 
@@ -614,10 +973,16 @@ int rpc_set_wifi_mode_none(void)
 
 int rpc_wifi_get_mac(wifi_interface_t mode, uint8_t out_mac[6])
 {
+	ctrl_cmd_t *req = NULL;
 	ctrl_cmd_t *resp = NULL;
+	uint32_t gen = 0;
+
+	if (WCACHE_IFX(mode) && WCACHE_GET(WCACHE_MAC(mode), out_mac, mac[mode]))
+		return SUCCESS;
+	gen = WCACHE_GEN();
 
 	/* implemented synchronous */
-	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	req = RPC_DEFAULT_REQ();
 
 	req->u.wifi_mac.mode = mode;
 	resp = rpc_slaveif_wifi_get_mac(req);
@@ -627,6 +992,8 @@ int rpc_wifi_get_mac(wifi_interface_t mode, uint8_t out_mac[6])
 		g_h.funcs->_h_memcpy(out_mac, resp->u.wifi_mac.mac, BSSID_BYTES_SIZE);
 		ESP_LOGI(TAG, "%s mac address is [" MACSTR "]",
 			mode==WIFI_IF_STA? "sta":"ap", MAC2STR(out_mac));
+		if (WCACHE_IFX(mode))
+			WCACHE_PUT(WCACHE_MAC(mode), gen, mac[mode], out_mac);
 	}
 	return rpc_rsp_callback(resp);
 }
@@ -646,6 +1013,12 @@ int rpc_wifi_set_mac(wifi_interface_t mode, const uint8_t mac[6])
 	g_h.funcs->_h_memcpy(req->u.wifi_mac.mac, mac, BSSID_BYTES_SIZE);
 
 	resp = rpc_slaveif_wifi_set_mac(req);
+
+	if (WCACHE_IFX(mode)) {
+		WCACHE_DROP(WCACHE_MAC(mode));
+		if (resp && resp->resp_event_status == SUCCESS)
+			WCACHE_PUT(WCACHE_MAC(mode), WCACHE_GEN(), mac[mode], mac);
+	}
 	return rpc_rsp_callback(resp);
 }
 
@@ -661,6 +1034,12 @@ int rpc_ota_begin(void)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
+	if (rpc_ota_window_init()) {
+		ESP_LOGE(TAG, "OTA window init failed");
+		CLEANUP_RPC(req);
+		return FAILURE;
+	}
+
 	/* OTA begin takes some time to clear the partition */
 	req->rsp_timeout_sec = OTA_BEGIN_RSP_TIMEOUT_SEC;
 
@@ -669,6 +1048,114 @@ int rpc_ota_begin(void)
 	return rpc_rsp_callback(resp);
 }
 
+static int rpc_ota_write_rsp_cb(ctrl_cmd_t *resp)
+{
+	if (resp->resp_event_status) {
+		ESP_LOGE(TAG, "OTA write of chunk failed: %d", resp->resp_event_status);
+		if (!ota_win.err)
+			ota_win.err = resp->resp_event_status;
+	}
+
+	CLEANUP_RPC(resp);
+	g_h.funcs->_h_post_semaphore(ota_win.credits);
+	return SUCCESS;
+}
+
+/* Wait for all chunks in flight to be answered */
+static int rpc_ota_write_flush(void)
+{
+	uint8_t i = 0;
+	uint8_t got = 0;
+
+	if (!ota_win.credits)
+		return SUCCESS;
+
+	for (i = 0; i < ota_win.window; i++) {
+		if (g_h.funcs->_h_get_semaphore(ota_win.credits, OTA_WRITE_RSP_TIMEOUT_SEC)) {
+			ESP_LOGE(TAG, "OTA write responses missing");
+			if (!ota_win.err)
+				ota_win.err = FAILURE;
+			break;
+		}
+		got++;
+	}
+	for (i = 0; i < got; i++)
+		g_h.funcs->_h_post_semaphore(ota_win.credits);
+
+	ESP_LOGD(TAG, "OTA: %" PRIu32 " chunks sent", ota_win.seq_num);
+	return ota_win.err;
+}
+
+static int rpc_ota_window_init(void)
+{
+	uint8_t i = 0;
+
+	/* leftovers of an aborted OTA */
+	rpc_ota_write_flush();
+
+	if (!ota_win.credits) {
+		ota_win.window = H_OTA_WINDOW;
+		if (ota_win.window > H_MAX_ASYNC_RPC_REQUESTS)
+			ota_win.window = H_MAX_ASYNC_RPC_REQUESTS;
+
+		/* created with one credit given */
+		ota_win.credits = g_h.funcs->_h_create_semaphore(ota_win.window);
+		if (!ota_win.credits)
+			return FAILURE;
+		for (i = 1; i < ota_win.window; i++)
+			g_h.funcs->_h_post_semaphore(ota_win.credits);
+	}
+
+	ota_win.seq_num = 0;
+	ota_win.err = SUCCESS;
+	return SUCCESS;
+}
+
+int rpc_ota_write_async(uint8_t* ota_data, uint32_t ota_data_len)
+{
+	ctrl_cmd_t *req = NULL;
+
+	if (!ota_win.credits) {
+		ESP_LOGE(TAG, "OTA not begun");
+		g_h.funcs->_h_free(ota_data);
+		return FAILURE;
+	}
+
+	/* wait for room in window */
+	if (g_h.funcs->_h_get_semaphore(ota_win.credits, OTA_WRITE_RSP_TIMEOUT_SEC)) {
+		ESP_LOGE(TAG, "OTA write response timed out");
+		g_h.funcs->_h_free(ota_data);
+		return FAILURE;
+	}
+
+	if (ota_win.err) {
+		g_h.funcs->_h_post_semaphore(ota_win.credits);
+		g_h.funcs->_h_free(ota_data);
+		return ota_win.err;
+	}
+
+	req = RPC_DEFAULT_REQ();
+	req->rpc_rsp_cb = rpc_ota_write_rsp_cb;
+	req->rsp_timeout_sec = OTA_WRITE_RSP_TIMEOUT_SEC;
+	req->u.ota_write.ota_data = ota_data;
+	req->u.ota_write.ota_data_len = ota_data_len;
+	req->u.ota_write.seq_num = ++ota_win.seq_num;
+
+	/* chunk is freed once packed, or if not sent */
+	req->app_free_buff_hdl = ota_data;
+	req->app_free_buff_func = g_h.funcs->_h_free;
+
+	if (rpc_slaveif_ota_write_async(req)) {
+		ESP_LOGE(TAG, "OTA write of chunk %" PRIu32 " not sent", ota_win.seq_num);
+		if (!ota_win.err)
+			ota_win.err = FAILURE;
+		/* no response to give credit back */
+		g_h.funcs->_h_post_semaphore(ota_win.credits);
+		return FAILURE;
+	}
+	return SUCCESS;
+}
+
 int rpc_ota_write(uint8_t* ota_data, uint32_t ota_data_len)
 {
 	/* implemented synchronous */
@@ -686,11 +1173,20 @@ int rpc_ota_write(uint8_t* ota_data, uint32_t ota_data_len)
 int rpc_ota_end(void)
 {
 	/* implemented synchronous */
-	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	ctrl_cmd_t *req = NULL;
 	ctrl_cmd_t *resp = NULL;
+	int ret = 0;
 
+	/* slave is ended anyway, to release its OTA handle */
+	ret = rpc_ota_write_flush();
+
+	req = RPC_DEFAULT_REQ();
 	resp = rpc_slaveif_ota_end(req);
 
+	if (ret) {
+		CLEANUP_RPC(resp);
+		return ret;
+	}
 	return rpc_rsp_callback(resp);
 }
 
@@ -795,8 +1291,10 @@ esp_err_t rpc_wifi_sta_twt_config(wifi_twt_config_t *config)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!config)
+	if (!config) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	g_h.funcs->_h_memcpy(&req->u.wifi_twt_config, config, sizeof(wifi_twt_config_t));
 	resp = rpc_slaveif_wifi_sta_twt_config(req);
@@ -809,8 +1307,10 @@ esp_err_t rpc_wifi_sta_itwt_setup(wifi_itwt_setup_config_t *setup_config)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!setup_config)
+	if (!setup_config) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	g_h.funcs->_h_memcpy(&req->u.wifi_itwt_setup_config, setup_config, sizeof(wifi_itwt_setup_config_t));
 	resp = rpc_slaveif_wifi_sta_itwt_setup(req);
@@ -910,6 +1410,7 @@ esp_err_t rpc_wifi_set_band_mode(wifi_band_mode_t band_mode)
 
 	req->u.wifi_band_mode = band_mode;
 	resp = rpc_slaveif_wifi_set_band_mode(req);
+	WCACHE_DROP(WCACHE_CHANNEL | WCACHE_BW(WIFI_IF_STA) | WCACHE_BW(WIFI_IF_AP));
 
 	return rpc_rsp_callback(resp);
 }
@@ -968,6 +1469,7 @@ esp_err_t rpc_wifi_set_bandwidths(wifi_interface_t ifx, wifi_bandwidths_t *bw)
 	req->u.wifi_bandwidths.ghz_5g = bw->ghz_5g;
 
 	resp = rpc_slaveif_wifi_set_bandwidths(req);
+	WCACHE_DROP(WCACHE_BW(WIFI_IF_STA) | WCACHE_BW(WIFI_IF_AP));
 	return rpc_rsp_callback(resp);
 }
 
@@ -1022,8 +1524,10 @@ int rpc_wifi_init(const wifi_init_config_t *arg)
 
 	req->rsp_timeout_sec = WIFI_INIT_RSP_TIMEOUT_SEC;
 
-	if (!arg)
+	if (!arg) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	g_h.funcs->_h_memcpy(&req->u.wifi_init_config, (void*)arg, sizeof(wifi_init_config_t));
 
@@ -1031,6 +1535,7 @@ int rpc_wifi_init(const wifi_init_config_t *arg)
 	req->u.wifi_init_config.nvs_enable = YES;
 #endif
 	resp = rpc_slaveif_wifi_init(req);
+	WCACHE_DROP(WCACHE_ALL);
 
 	return rpc_rsp_callback(resp);
 }
@@ -1042,6 +1547,7 @@ int rpc_wifi_deinit(void)
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_deinit(req);
+	WCACHE_DROP(WCACHE_ALL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1052,17 +1558,24 @@ int rpc_wifi_set_mode(wifi_mode_t mode)
 
 int rpc_wifi_get_mode(wifi_mode_t* mode)
 {
-	/* implemented synchronous */
-	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	ctrl_cmd_t *req = NULL;
 	ctrl_cmd_t *resp = NULL;
+	uint32_t gen = 0;
 
 	if (!mode)
 		return FAILURE;
 
+	if (WCACHE_GET(WCACHE_MODE, mode, mode))
+		return SUCCESS;
+	gen = WCACHE_GEN();
+
+	/* implemented synchronous */
+	req = RPC_DEFAULT_REQ();
 	resp = rpc_slaveif_wifi_get_mode(req);
 
 	if (resp && resp->resp_event_status == SUCCESS) {
 		*mode = resp->u.wifi_mode.mode;
+		WCACHE_PUT(WCACHE_MODE, gen, mode, mode);
 	}
 
 	return rpc_rsp_callback(resp);
@@ -1075,6 +1588,7 @@ int rpc_wifi_start(void)
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_start(req);
+	WCACHE_DROP(WCACHE_AP_INFO | WCACHE_CHANNEL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1088,6 +1602,7 @@ int rpc_wifi_stop(void)
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_stop(req);
+	WCACHE_DROP(WCACHE_AP_INFO | WCACHE_CHANNEL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1120,6 +1635,7 @@ int rpc_wifi_disconnect(void)
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_disconnect(req);
+	WCACHE_DROP(WCACHE_AP_INFO | WCACHE_CHANNEL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1129,30 +1645,45 @@ int rpc_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!conf)
+	if (!conf) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	g_h.funcs->_h_memcpy(&req->u.wifi_config.u, conf, sizeof(wifi_config_t));
 
 	req->u.wifi_config.iface = interface;
 	resp = rpc_slaveif_wifi_set_config(req);
+	/* slave may adjust what was set, so fetch it again on next get */
+	if (WCACHE_IFX(interface))
+		WCACHE_DROP(WCACHE_CONFIG(interface) | WCACHE_CHANNEL);
 	return rpc_rsp_callback(resp);
 }
 
 int rpc_wifi_get_config(wifi_interface_t interface, wifi_config_t *conf)
 {
-	/* implemented synchronous */
-	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	ctrl_cmd_t *req = NULL;
 	ctrl_cmd_t *resp = NULL;
+	uint32_t gen = 0;
 
 	if (!conf)
 		return FAILURE;
 
+	if (WCACHE_IFX(interface) && WCACHE_GET(WCACHE_CONFIG(interface), conf, config[interface]))
+		return SUCCESS;
+	gen = WCACHE_GEN();
+
+	/* implemented synchronous */
+	req = RPC_DEFAULT_REQ();
 	req->u.wifi_config.iface = interface;
 
 	resp = rpc_slaveif_wifi_get_config(req);
 
-	g_h.funcs->_h_memcpy(conf, &resp->u.wifi_config.u, sizeof(wifi_config_t));
+	if (resp && resp->resp_event_status == SUCCESS) {
+		g_h.funcs->_h_memcpy(conf, &resp->u.wifi_config.u, sizeof(wifi_config_t));
+		if (WCACHE_IFX(interface))
+			WCACHE_PUT(WCACHE_CONFIG(interface), gen, config[interface], conf);
+	}
 
 	return rpc_rsp_callback(resp);
 }
@@ -1195,8 +1726,10 @@ int rpc_wifi_scan_get_ap_num(uint16_t *number)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!number)
+	if (!number) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	resp = rpc_slaveif_wifi_scan_get_ap_num(req);
 
@@ -1212,8 +1745,10 @@ int rpc_wifi_scan_get_ap_record(wifi_ap_record_t *ap_record)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!ap_record)
+	if (!ap_record) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	resp = rpc_slaveif_wifi_scan_get_ap_record(req);
 	if (resp && resp->resp_event_status == SUCCESS) {
@@ -1228,8 +1763,10 @@ int rpc_wifi_scan_get_ap_records(uint16_t *number, wifi_ap_record_t *ap_records)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!number || !*number || !ap_records)
+	if (!number || !*number || !ap_records) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	g_h.funcs->_h_memset(ap_records, 0, (*number)*sizeof(wifi_ap_record_t));
 
@@ -1262,6 +1799,7 @@ int rpc_wifi_restore(void)
 	ctrl_cmd_t *resp = NULL;
 
 	resp = rpc_slaveif_wifi_restore(req);
+	WCACHE_DROP(WCACHE_ALL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1288,18 +1826,25 @@ int rpc_wifi_deauth_sta(uint16_t aid)
 
 int rpc_wifi_sta_get_ap_info(wifi_ap_record_t *ap_info)
 {
-	/* implemented synchronous */
-	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	ctrl_cmd_t *req = NULL;
 	ctrl_cmd_t *resp = NULL;
+	uint32_t gen = 0;
 
 	if (!ap_info)
 		return FAILURE;
 
+	if (WCACHE_GET(WCACHE_AP_INFO, ap_info, ap_info))
+		return SUCCESS;
+	gen = WCACHE_GEN();
+
+	/* implemented synchronous */
+	req = RPC_DEFAULT_REQ();
 	resp = rpc_slaveif_wifi_sta_get_ap_info(req);
 
 	if (resp && resp->resp_event_status == SUCCESS) {
 		g_h.funcs->_h_memcpy(ap_info, resp->u.wifi_scan_ap_list.out_list,
 				sizeof(wifi_ap_record_t));
+		WCACHE_PUT(WCACHE_AP_INFO, gen, ap_info, ap_info);
 	}
 	return rpc_rsp_callback(resp);
 }
@@ -1310,8 +1855,10 @@ int rpc_wifi_set_ps(wifi_ps_type_t type)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (type > WIFI_PS_MAX_MODEM)
+	if (type > WIFI_PS_MAX_MODEM) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	req->u.wifi_ps.ps_mode = type;
 
@@ -1329,8 +1876,10 @@ int rpc_wifi_get_ps(wifi_ps_type_t *type)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!type)
+	if (!type) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	resp = rpc_slaveif_wifi_get_ps(req);
 
@@ -1359,23 +1908,37 @@ int rpc_wifi_set_bandwidth(wifi_interface_t ifx, wifi_bandwidth_t bw)
 	req->u.wifi_bandwidth.ifx = ifx;
 	req->u.wifi_bandwidth.bw = bw;
 	resp = rpc_slaveif_wifi_set_bandwidth(req);
+
+	if (WCACHE_IFX(ifx)) {
+		WCACHE_DROP(WCACHE_BW(ifx) | WCACHE_CHANNEL);
+		if (resp && resp->resp_event_status == SUCCESS)
+			WCACHE_PUT(WCACHE_BW(ifx), WCACHE_GEN(), bw[ifx], &bw);
+	}
 	return rpc_rsp_callback(resp);
 }
 
 int rpc_wifi_get_bandwidth(wifi_interface_t ifx, wifi_bandwidth_t *bw)
 {
-	/* implemented synchronous */
-	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	ctrl_cmd_t *req = NULL;
 	ctrl_cmd_t *resp = NULL;
+	uint32_t gen = 0;
 
 	if (!bw)
 		return FAILURE;
 
+	if (WCACHE_IFX(ifx) && WCACHE_GET(WCACHE_BW(ifx), bw, bw[ifx]))
+		return SUCCESS;
+	gen = WCACHE_GEN();
+
+	/* implemented synchronous */
+	req = RPC_DEFAULT_REQ();
 	req->u.wifi_bandwidth.ifx = ifx;
 	resp = rpc_slaveif_wifi_get_bandwidth(req);
 
 	if (resp && resp->resp_event_status == SUCCESS) {
 		*bw = resp->u.wifi_bandwidth.bw;
+		if (WCACHE_IFX(ifx))
+			WCACHE_PUT(WCACHE_BW(ifx), gen, bw[ifx], bw);
 	}
 	return rpc_rsp_callback(resp);
 }
@@ -1389,23 +1952,38 @@ int rpc_wifi_set_channel(uint8_t primary, wifi_second_chan_t second)
 	req->u.wifi_channel.primary = primary;
 	req->u.wifi_channel.second = second;
 	resp = rpc_slaveif_wifi_set_channel(req);
+	/* not applied by slave while connected, fetch it again */
+	WCACHE_DROP(WCACHE_CHANNEL);
 	return rpc_rsp_callback(resp);
 }
 
 int rpc_wifi_get_channel(uint8_t *primary, wifi_second_chan_t *second)
 {
-	/* implemented synchronous */
-	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
+	ctrl_cmd_t *req = NULL;
 	ctrl_cmd_t *resp = NULL;
+	wcache_channel_t ch = {0};
+	uint32_t gen = 0;
 
 	if ((!primary) || (!second))
 		return FAILURE;
 
+	if (WCACHE_GET(WCACHE_CHANNEL, &ch, channel)) {
+		*primary = ch.primary;
+		*second = ch.second;
+		return SUCCESS;
+	}
+	gen = WCACHE_GEN();
+
+	/* implemented synchronous */
+	req = RPC_DEFAULT_REQ();
 	resp = rpc_slaveif_wifi_get_channel(req);
 
 	if (resp && resp->resp_event_status == SUCCESS) {
 		*primary = resp->u.wifi_channel.primary;
 		*second = resp->u.wifi_channel.second;
+		ch.primary = *primary;
+		ch.second = *second;
+		WCACHE_PUT(WCACHE_CHANNEL, gen, channel, &ch);
 	}
 	return rpc_rsp_callback(resp);
 }
@@ -1416,12 +1994,15 @@ int rpc_wifi_set_country_code(const char *country, bool ieee80211d_enabled)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!country)
+	if (!country) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	memcpy(&req->u.wifi_country_code.cc[0], country, sizeof(req->u.wifi_country_code.cc));
 	req->u.wifi_country_code.ieee80211d_enabled = ieee80211d_enabled;
 	resp = rpc_slaveif_wifi_set_country_code(req);
+	WCACHE_DROP(WCACHE_CHANNEL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1431,8 +2012,10 @@ int rpc_wifi_get_country_code(char *country)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!country)
+	if (!country) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	resp = rpc_slaveif_wifi_get_country_code(req);
 
@@ -1448,8 +2031,10 @@ int rpc_wifi_set_country(const wifi_country_t *country)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!country)
+	if (!country) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	memcpy(&req->u.wifi_country.cc[0], &country->cc[0], sizeof(country->cc));
 	req->u.wifi_country.schan        = country->schan;
@@ -1458,6 +2043,7 @@ int rpc_wifi_set_country(const wifi_country_t *country)
 	req->u.wifi_country.policy       = country->policy;
 
 	resp = rpc_slaveif_wifi_set_country(req);
+	WCACHE_DROP(WCACHE_CHANNEL);
 	return rpc_rsp_callback(resp);
 }
 
@@ -1467,8 +2053,10 @@ int rpc_wifi_get_country(wifi_country_t *country)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!country)
+	if (!country) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	resp = rpc_slaveif_wifi_get_country(req);
 	if (resp && resp->resp_event_status == SUCCESS) {
@@ -1487,8 +2075,10 @@ int rpc_wifi_ap_get_sta_list(wifi_sta_list_t *sta)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!sta)
+	if (!sta) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	resp = rpc_slaveif_wifi_ap_get_sta_list(req);
 	if (resp && resp->resp_event_status == SUCCESS) {
@@ -1516,8 +2106,10 @@ int rpc_wifi_ap_get_sta_aid(const uint8_t mac[6], uint16_t *aid)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!mac || !aid)
+	if (!mac || !aid) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	memcpy(&req->u.wifi_ap_get_sta_aid.mac[0], &mac[0], MAC_SIZE_BYTES);
 
@@ -1535,8 +2127,10 @@ int rpc_wifi_sta_get_rssi(int *rssi)
 	ctrl_cmd_t *req = RPC_DEFAULT_REQ();
 	ctrl_cmd_t *resp = NULL;
 
-	if (!rssi)
+	if (!rssi) {
+		rpc_slaveif_free_req(req);
 		return FAILURE;
+	}
 
 	resp = rpc_slaveif_wifi_sta_get_rssi(req);
 	if (resp && resp->resp_event_status == SUCCESS) {
@@ -1608,3 +2202,185 @@ esp_err_t rpc_set_dhcp_dns_status(wifi_interface_t ifx, uint8_t link_up,
 	resp = rpc_slaveif_set_slave_dhcp_dns_status(req);
 	return rpc_rsp_callback(resp);
 }
+
+/* Batched getters: results are written at commit, all fetched from
+ * slave in one request */
+struct rpc_batch {
+	ctrl_cmd_t *req;
+	void *out[RPC_BATCH_MAX_CMDS];
+	int err;
+};
+
+rpc_batch_handle_t rpc_batch_begin(void)
+{
+	struct rpc_batch *b = NULL;
+
+	b = (struct rpc_batch *)g_h.funcs->_h_calloc(1, sizeof(struct rpc_batch));
+	if (!b)
+		return NULL;
+
+	b->req = RPC_DEFAULT_REQ();
+	if (rpc_slaveif_batch_init(b->req, RPC_BATCH_MAX_CMDS)) {
+		rpc_slaveif_free_req(b->req);
+		g_h.funcs->_h_free(b);
+		return NULL;
+	}
+	return b;
+}
+
+static ctrl_cmd_t * rpc_batch_add(rpc_batch_handle_t b, uint16_t req_msg_id, void *out)
+{
+	ctrl_cmd_t *sub = NULL;
+
+	if (!b)
+		return NULL;
+
+	if (out)
+		sub = rpc_slaveif_batch_add(b->req, req_msg_id);
+	if (!sub) {
+		/* reported at commit */
+		b->err = FAILURE;
+		return NULL;
+	}
+	b->out[b->req->u.batch.n_cmds - 1] = out;
+	return sub;
+}
+
+esp_err_t rpc_batch_get_mode(rpc_batch_handle_t b, wifi_mode_t *mode)
+{
+	return rpc_batch_add(b, RPC_ID__Req_GetWifiMode, mode) ? SUCCESS : FAILURE;
+}
+
+esp_err_t rpc_batch_get_mac(rpc_batch_handle_t b, wifi_interface_t mode, uint8_t mac[6])
+{
+	ctrl_cmd_t *sub = rpc_batch_add(b, RPC_ID__Req_GetMACAddress, mac);
+
+	if (!sub)
+		return FAILURE;
+	sub->u.wifi_mac.mode = mode;
+	return SUCCESS;
+}
+
+esp_err_t rpc_batch_get_config(rpc_batch_handle_t b, wifi_interface_t interface, wifi_config_t *conf)
+{
+	ctrl_cmd_t *sub = rpc_batch_add(b, RPC_ID__Req_WifiGetConfig, conf);
+
+	if (!sub)
+		return FAILURE;
+	sub->u.wifi_config.iface = interface;
+	return SUCCESS;
+}
+
+esp_err_t rpc_batch_get_country(rpc_batch_handle_t b, wifi_country_t *country)
+{
+	return rpc_batch_add(b, RPC_ID__Req_WifiGetCountry, country) ? SUCCESS : FAILURE;
+}
+
+esp_err_t rpc_batch_get_bandwidth(rpc_batch_handle_t b, wifi_interface_t ifx, wifi_bandwidth_t *bw)
+{
+	ctrl_cmd_t *sub = rpc_batch_add(b, RPC_ID__Req_WifiGetBandwidth, bw);
+
+	if (!sub)
+		return FAILURE;
+	sub->u.wifi_bandwidth.ifx = ifx;
+	return SUCCESS;
+}
+
+esp_err_t rpc_batch_get_protocol(rpc_batch_handle_t b, wifi_interface_t ifx, uint8_t *protocol_bitmap)
+{
+	ctrl_cmd_t *sub = rpc_batch_add(b, RPC_ID__Req_WifiGetProtocol, protocol_bitmap);
+
+	if (!sub)
+		return FAILURE;
+	sub->u.wifi_protocol.ifx = ifx;
+	return SUCCESS;
+}
+
+esp_err_t rpc_batch_get_max_tx_power(rpc_batch_handle_t b, int8_t *power)
+{
+	return rpc_batch_add(b, RPC_ID__Req_WifiGetMaxTxPower, power) ? SUCCESS : FAILURE;
+}
+
+static void rpc_batch_copy_out(ctrl_cmd_t *sub, void *out)
+{
+	switch (sub->msg_id) {
+	case RPC_ID__Resp_GetWifiMode: {
+		*(wifi_mode_t *)out = sub->u.wifi_mode.mode;
+		break;
+	} case RPC_ID__Resp_GetMACAddress: {
+		g_h.funcs->_h_memcpy(out, sub->u.wifi_mac.mac, BSSID_BYTES_SIZE);
+		break;
+	} case RPC_ID__Resp_WifiGetConfig: {
+		g_h.funcs->_h_memcpy(out, &sub->u.wifi_config.u, sizeof(wifi_config_t));
+		break;
+	} case RPC_ID__Resp_WifiGetCountry: {
+		wifi_country_t *country = (wifi_country_t *)out;
+
+		memcpy(&country->cc[0], &sub->u.wifi_country.cc[0], sizeof(sub->u.wifi_country.cc));
+		country->schan        = sub->u.wifi_country.schan;
+		country->nchan        = sub->u.wifi_country.nchan;
+		country->max_tx_power = sub->u.wifi_country.max_tx_power;
+		country->policy       = sub->u.wifi_country.policy;
+		break;
+	} case RPC_ID__Resp_WifiGetBandwidth: {
+		*(wifi_bandwidth_t *)out = sub->u.wifi_bandwidth.bw;
+		break;
+	} case RPC_ID__Resp_WifiGetProtocol: {
+		*(uint8_t *)out = sub->u.wifi_protocol.protocol_bitmap;
+		break;
+	} case RPC_ID__Resp_WifiGetMaxTxPower: {
+		*(int8_t *)out = sub->u.wifi_tx_power.power;
+		break;
+	} default: {
+		ESP_LOGW(TAG, "batch: unexpected resp [0x%x]", sub->msg_id);
+		break;
+	}
+	}
+}
+
+esp_err_t rpc_batch_commit(rpc_batch_handle_t b)
+{
+	ctrl_cmd_t *resp = NULL;
+	ctrl_cmd_t *sub = NULL;
+	uint8_t n_cmds = 0;
+	uint8_t i = 0;
+	int ret = SUCCESS;
+
+	if (!b)
+		return FAILURE;
+
+	n_cmds = b->req->u.batch.n_cmds;
+	if (b->err || !n_cmds) {
+		ret = b->err;
+		rpc_slaveif_free_req(b->req);
+		goto done;
+	}
+
+	/* implemented synchronous */
+	resp = rpc_slaveif_batch(b->req);
+	if (resp && (resp->resp_event_status == SUCCESS) &&
+	    (resp->u.batch.n_cmds != n_cmds)) {
+		ESP_LOGE(TAG, "batch: %u resps for %u reqs", resp->u.batch.n_cmds, n_cmds);
+		resp->resp_event_status = FAILURE;
+	}
+	if (!resp || (resp->resp_event_status != SUCCESS)) {
+		ret = rpc_rsp_callback(resp);
+		goto done;
+	}
+
+	/* first failing getter gives the result, rest are still copied */
+	for (i = 0; i < n_cmds; i++) {
+		sub = &resp->u.batch.cmds[i];
+		if (sub->resp_event_status != SUCCESS) {
+			if (ret == SUCCESS)
+				ret = process_failed_responses(sub);
+			continue;
+		}
+		rpc_batch_copy_out(sub, b->out[i]);
+	}
+	CLEANUP_RPC(resp);
+
+done:
+	g_h.funcs->_h_free(b);
+	return ret;
+}
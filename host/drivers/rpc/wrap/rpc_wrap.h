@@ -39,6 +39,7 @@ esp_err_t rpc_stop(void);
 esp_err_t rpc_deinit(void);
 esp_err_t rpc_unregister_event_callbacks(void);
 esp_err_t rpc_register_event_callbacks(void);
+esp_err_t rpc_set_event_rate_limit(int32_t event_id, uint32_t min_interval_ms);
 
 esp_err_t rpc_wifi_init(const wifi_init_config_t *arg);
 esp_err_t rpc_wifi_deinit(void);
@@ -89,6 +90,10 @@ esp_err_t rpc_get_coprocessor_fwversion(esp_hosted_coprocessor_fwver_t *ver_info
 
 esp_err_t rpc_ota_begin(void);
 esp_err_t rpc_ota_write(uint8_t* ota_data, uint32_t ota_data_len);
+/* Windowed: returns once chunk is queued, up to H_OTA_WINDOW in flight.
+ * ota_data must be from g_h.funcs->_h_malloc() and is freed once sent.
+ * Failure of an earlier chunk is returned by a later call or rpc_ota_end() */
+esp_err_t rpc_ota_write_async(uint8_t* ota_data, uint32_t ota_data_len);
 esp_err_t rpc_ota_end(void);
 
 #if H_WIFI_HE_SUPPORT
@@ -116,6 +121,27 @@ esp_err_t rpc_set_dhcp_dns_status(wifi_interface_t interface, uint8_t link_up,
 		uint8_t dhcp_up, char *dhcp_ip, char *dhcp_nm, char *dhcp_gw,
 		uint8_t dns_up, char *dns_ip, uint8_t dns_type);
 
+/* Batched getters, fetched from slave in a single request:
+ *
+ *   rpc_batch_handle_t b = rpc_batch_begin();
+ *   rpc_batch_get_mode(b, &mode);
+ *   rpc_batch_get_mac(b, WIFI_IF_STA, mac);
+ *   err = rpc_batch_commit(b);
+ *
+ * Results are written at commit, which returns the first failure and
+ * releases the batch. Up to RPC_BATCH_MAX_CMDS getters per batch */
+typedef struct rpc_batch *rpc_batch_handle_t;
+
+rpc_batch_handle_t rpc_batch_begin(void);
+esp_err_t rpc_batch_get_mode(rpc_batch_handle_t b, wifi_mode_t *mode);
+esp_err_t rpc_batch_get_mac(rpc_batch_handle_t b, wifi_interface_t mode, uint8_t mac[6]);
+esp_err_t rpc_batch_get_config(rpc_batch_handle_t b, wifi_interface_t interface, wifi_config_t *conf);
+esp_err_t rpc_batch_get_country(rpc_batch_handle_t b, wifi_country_t *country);
+esp_err_t rpc_batch_get_bandwidth(rpc_batch_handle_t b, wifi_interface_t ifx, wifi_bandwidth_t *bw);
+esp_err_t rpc_batch_get_protocol(rpc_batch_handle_t b, wifi_interface_t ifx, uint8_t *protocol_bitmap);
+esp_err_t rpc_batch_get_max_tx_power(rpc_batch_handle_t b, int8_t *power);
+esp_err_t rpc_batch_commit(rpc_batch_handle_t b);
+
 #ifdef __cplusplus
 }
 #endif
@@ -81,31 +81,57 @@ int serial_drv_write (struct serial_drv_handle_t* serial_drv_handle,
 	return RET_OK;
 }
 
+int serial_drv_write_msg(struct serial_drv_handle_t* serial_drv_handle,
+	serial_ll_tx_msg_t *msg)
+{
+	if (!serial_drv_handle || !msg) {
+		ESP_LOGE(TAG,"Invalid parameters in write\n\r");
+		if (msg)
+			serial_ll_tx_msg_free(msg);
+		return RET_INVALID;
+	}
+
+	if (!serial_ll_if_g) {
+		ESP_LOGE(TAG,"serial interface not valid\n\r");
+		serial_ll_tx_msg_free(msg);
+		return RET_INVALID;
+	}
 
-uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
-		uint32_t *out_nbyte)
+	if (serial_ll_tx_msg_send(serial_ll_if_g, msg)) {
+		ESP_LOGE(TAG,"Failed to write data\n\r");
+		return RET_FAIL;
+	}
+
+	return RET_OK;
+}
+
+
+int serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
+		serial_drv_rx_buf_t *rx)
 {
 	uint16_t init_read_len = 0;
-	uint16_t rx_buf_len = 0;
-	uint8_t* read_buf = NULL;
+	interface_buffer_handle_t buf_handle = {0};
+	serial_ll_rx_chain_t *chain = NULL;
+	uint8_t tlv_hdr[TLV_HDR_LEN];
+	uint8_t *tlv = NULL;
+	uint8_t *data = NULL;
 	int ret = 0;
 	/* Any of `RPC_EP_NAME_EVT` and `RPC_EP_NAME_RSP` could be used,
 	 * as both have same strlen in esp_hosted_transport.h */
 	const char* ep_name = RPC_EP_NAME_RSP;
-	uint8_t *buf = NULL;
 	uint32_t buf_len = 0;
 
 
-	if (!serial_drv_handle || !out_nbyte) {
+	if (!serial_drv_handle || !rx) {
 		ESP_LOGE(TAG,"Invalid parameters in read\n\r");
-		return NULL;
+		return RET_INVALID;
 	}
 
-	*out_nbyte = 0;
+	g_h.funcs->_h_memset(rx, 0, sizeof(*rx));
 
 	if(!readSemaphore) {
 		ESP_LOGE(TAG,"Semaphore not initialized\n\r");
-		return NULL;
+		return RET_INVALID;
 	}
 
 	ESP_LOGV(TAG, "Wait for serial_ll_semaphore");
@@ -113,28 +139,24 @@ uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
 
 	if( (!serial_ll_if_g) ||
 		(!serial_ll_if_g->fops) ||
-		(!serial_ll_if_g->fops->read)) {
+		(!serial_ll_if_g->fops->read_buf)) {
 		ESP_LOGE(TAG,"serial interface refusing to read\n\r");
-		return NULL;
+		return RET_INVALID;
 	}
 	ESP_LOGV(TAG, "Starting serial_ll read");
 
 	/* Get buffer from serial interface */
-	read_buf = serial_ll_if_g->fops->read(serial_ll_if_g, &rx_buf_len);
-	if ((!read_buf) || (!rx_buf_len)) {
+	if (serial_ll_if_g->fops->read_buf(serial_ll_if_g, &buf_handle)) {
 		ESP_LOGE(TAG,"serial read failed\n\r");
-		return NULL;
+		return RET_FAIL;
 	}
-	ESP_HEXLOGV("serial_read", read_buf, rx_buf_len, 32);
+	ESP_HEXLOGV("serial_read", buf_handle.payload, buf_handle.payload_len, 32);
 
 /*
- * Read Operation happens in two steps because total read length is unknown
- * at first read.
- *      1) Read fixed length of RX data
- *      2) Read variable length of RX data
+ * TLV is parsed in place, in the buffer received (or its first bytes
+ * copied out, if it arrived as fragment chain):
  *
- * (1) Read fixed length of RX data :
- * Read fixed length of received data in below format:
+ * (1) Fixed length TLV prefix:
  * ----------------------------------------------------------------------------
  *  Endpoint Type | Endpoint Length | Endpoint Value  | Data Type | Data Length
  * ----------------------------------------------------------------------------
@@ -145,60 +167,74 @@ uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
  *  ---------------------------------------------------------------------------
  *
  *  int_read_len = 1 + 2 + Endpoint length + 1 + 2
+ *
+ * (2) Variable length protobuf payload follows, which is handed over as
+ *     view in the same buffer
  */
 
 	init_read_len = SIZE_OF_TYPE + SIZE_OF_LENGTH + strlen(ep_name) +
 		SIZE_OF_TYPE + SIZE_OF_LENGTH;
 
-	if(rx_buf_len < init_read_len) {
-		HOSTED_FREE(read_buf);
+	if(buf_handle.payload_len < init_read_len) {
 		ESP_LOGE(TAG,"Incomplete serial buff, return\n");
-		return NULL;
+		goto free_bufs;
 	}
 
-	HOSTED_CALLOC(uint8_t,buf,init_read_len,free_bufs);
-
-	g_h.funcs->_h_memcpy(buf, read_buf, init_read_len);
+	if (serial_ll_rx_is_chain(&buf_handle)) {
+		chain = (serial_ll_rx_chain_t *)buf_handle.payload;
+		serial_ll_rx_chain_copy(chain, 0, tlv_hdr, init_read_len);
+		tlv = tlv_hdr;
+	} else {
+		tlv = buf_handle.payload;
+	}
 
 	/* parse_tlv function returns variable payload length
 	 * of received data in buf_len
 	 **/
-	ret = parse_tlv(buf, &buf_len);
+	ret = parse_tlv(tlv, &buf_len);
 	if (ret || !buf_len) {
-		HOSTED_FREE(buf);
 		ESP_LOGE(TAG,"Failed to parse RX data \n\r");
 		goto free_bufs;
 	}
 	ESP_LOGV(TAG, "TLV parsed");
 
-	if (rx_buf_len < (init_read_len + buf_len)) {
+	if (buf_handle.payload_len < (init_read_len + buf_len)) {
 		ESP_LOGE(TAG,"Buf read on serial iface is smaller than expected len\n");
-		HOSTED_FREE(buf);
 		goto free_bufs;
 	}
 
-	if (rx_buf_len > (init_read_len + buf_len)) {
+	if (buf_handle.payload_len > (init_read_len + buf_len)) {
 		ESP_LOGE(TAG,"Buf read on serial iface is smaller than expected len\n");
 	}
 
-	HOSTED_FREE(buf);
-/*
- * (2) Read variable length of RX data:
- */
-	HOSTED_CALLOC(uint8_t,buf,buf_len,free_bufs);
-
-	g_h.funcs->_h_memcpy((buf), read_buf+init_read_len, buf_len);
-
-	HOSTED_FREE(read_buf);
+	if (chain) {
+		/* protobuf needs contiguous data, linearise once */
+		data = (uint8_t *)g_h.funcs->_h_malloc(buf_len);
+		if (!data) {
+			ESP_LOGE(TAG,"Failed to allocate %" PRIu32 " bytes\n", buf_len);
+			goto free_bufs;
+		}
+		serial_ll_rx_chain_copy(chain, init_read_len, data, buf_len);
+		H_FREE_PTR_WITH_FUNC(buf_handle.free_buf_handle, buf_handle.priv_buffer_handle);
+
+		rx->buf = data;
+		rx->offset = 0;
+		rx->priv_buffer_handle = data;
+		rx->free_buf_handle = g_h.funcs->_h_free;
+	} else {
+		rx->buf = buf_handle.payload;
+		rx->offset = init_read_len;
+		rx->priv_buffer_handle = buf_handle.priv_buffer_handle;
+		rx->free_buf_handle = buf_handle.free_buf_handle;
+	}
+	rx->len = buf_len;
 
-	*out_nbyte = buf_len;
-	ESP_LOGV(TAG, "Serial payload size(after removing TLV): %" PRIu32, *out_nbyte);
-	return buf;
+	ESP_LOGV(TAG, "Serial payload size(after removing TLV): %" PRIu32, rx->len);
+	return RET_OK;
 
 free_bufs:
-	HOSTED_FREE(read_buf);
-	HOSTED_FREE(buf);
-	return NULL;
+	H_FREE_PTR_WITH_FUNC(buf_handle.free_buf_handle, buf_handle.priv_buffer_handle);
+	return RET_FAIL;
 }
 
 int serial_drv_close(struct serial_drv_handle_t** serial_drv_handle)
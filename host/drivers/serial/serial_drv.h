@@ -72,21 +72,62 @@ struct serial_drv_handle_t* serial_drv_open (const char* transport);
 int serial_drv_write (struct serial_drv_handle_t* serial_drv_handle,
      uint8_t* buf, int in_count, int* out_count);
 
+/*
+ * serial_drv_write_msg function sends a message already
+ * built in transport buffers, without copying it again.
+ * msg is consumed, on failure too
+ *
+ * Input parameter
+ *      serial_drv_handle           :   Driver Handler
+ *      msg                         :   Fully written message
+ *
+ * Returns
+ *      SUCCESS(0) or FAILURE(-1) of above operation
+ */
+int serial_drv_write_msg (struct serial_drv_handle_t* serial_drv_handle,
+     serial_ll_tx_msg_t *msg);
+
+/* Protobuf payload received, as a view in the buffer it arrived in.
+ * Payload is at buf + offset. Whole buffer is released, once done,
+ * with serial_drv_rx_buf_free()
+ */
+typedef struct {
+	uint8_t *buf;
+	uint32_t offset;
+	uint32_t len;
+	void *priv_buffer_handle;
+	void (*free_buf_handle)(void *buf_handle);
+} serial_drv_rx_buf_t;
+
+static inline uint8_t * serial_drv_rx_buf_data(const serial_drv_rx_buf_t *rx)
+{
+	return rx->buf + rx->offset;
+}
+
+static inline void serial_drv_rx_buf_free(serial_drv_rx_buf_t *rx)
+{
+	H_FREE_PTR_WITH_FUNC(rx->free_buf_handle, rx->priv_buffer_handle);
+	rx->buf = NULL;
+	rx->len = 0;
+}
+
 /*
  * serial_drv_read function gets buffer from serial driver
- * after TLV parsing. output buffer is protobuf encoded
+ * and parses TLV in place. Output view points to the
+ * protobuf encoded data, within received buffer
  *
  * Input parameter
  *      serial_drv_handle           :   Driver Handle
  * Output parameter
- *      out_nbyte                   :   Size of TLV parsed buffer
- * Returns
- *      buf                         :   Protocol encoded data Buffer
+ *      rx                          :   View of protobuf encoded data
  *                                      caller will decode the protobuf
+ *                                      and free it
+ * Returns
+ *      SUCCESS(0) or FAILURE(-1) of above operation
  */
 
-uint8_t * serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
-		uint32_t *out_nbyte);
+int serial_drv_read(struct serial_drv_handle_t *serial_drv_handle,
+		serial_drv_rx_buf_t *rx);
 
 /*
  * serial_drv_close function closes driver interface.
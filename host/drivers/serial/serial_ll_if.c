@@ -22,6 +22,7 @@
 #include "esp_hosted_transport.h"
 #include "esp_hosted_header.h"
 #include "esp_hosted_log.h"
+#include "mempool.h"
 
 DEFINE_LOG_TAG(serial_ll);
 
@@ -35,20 +36,23 @@ typedef enum {
 	DESTROY
 } serial_ll_state_e;
 
-static struct rx_data {
-	int len;
-	uint8_t *data;
-} r;
+/* fragments of the serial msg being received */
+static serial_ll_rx_chain_t r;
 
 /* data structures needed for serial driver */
 static queue_handle_t to_serial_ll_intf_queue[MAX_SERIAL_INTF];
 static serial_ll_handle_t * interface_handle_g[MAX_SERIAL_INTF] = {NULL};
 static uint8_t conn_num = 0;
 
+/* transport buffers of single copy Tx messages */
+static struct mempool * serial_tx_mp;
+
 /** Function Declarations **/
 static int       serial_ll_open    (serial_ll_handle_t *serial_ll_hdl);
 static uint8_t * serial_ll_read    (const serial_ll_handle_t * serial_ll_hdl,
 		uint16_t * rlen);
+static int       serial_ll_read_buf(const serial_ll_handle_t * serial_ll_hdl,
+		interface_buffer_handle_t * buf_handle);
 static int       serial_ll_write   (const serial_ll_handle_t * serial_ll_hdl,
 		uint8_t * wbuffer, const uint16_t wlen);
 static int       serial_ll_close   (serial_ll_handle_t * serial_ll_hdl);
@@ -58,6 +62,7 @@ static int       serial_ll_close   (serial_ll_handle_t * serial_ll_hdl);
 static struct serial_ll_operations serial_ll_fops = {
 	.open    = serial_ll_open,
 	.read    = serial_ll_read,
+	.read_buf = serial_ll_read_buf,
 	.write   = serial_ll_write,
 	.close   = serial_ll_close,
 };
@@ -146,21 +151,48 @@ static int serial_ll_close(serial_ll_handle_t * serial_ll_hdl)
   * @brief  Serial interface read non blocking
   * @param  serial_ll_hdl - handle
   *         rlen - output param, number of bytes read
-  * @retval rbuffer - ready buffer read on serial inerface
+  * @retval rbuffer - ready buffer read on serial inerface, to be freed
+  *         by caller. Contiguous copy of the msg, prefer read_buf
   */
 static uint8_t * serial_ll_read(const serial_ll_handle_t * serial_ll_hdl,
 							 uint16_t * rlen)
 {
-	/* This is a non-blocking call */
 	interface_buffer_handle_t buf_handle = {0};
+	uint8_t *rbuffer = NULL;
 
 	/* Initial value */
 	*rlen = 0 ;
 
+	if (serial_ll_read_buf(serial_ll_hdl, &buf_handle))
+		return NULL;
+
+	rbuffer = (uint8_t *)g_h.funcs->_h_malloc(buf_handle.payload_len);
+	if (rbuffer) {
+		if (serial_ll_rx_is_chain(&buf_handle))
+			serial_ll_rx_chain_copy((serial_ll_rx_chain_t *)buf_handle.payload, 0,
+					rbuffer, buf_handle.payload_len);
+		else
+			g_h.funcs->_h_memcpy(rbuffer, buf_handle.payload, buf_handle.payload_len);
+		*rlen = buf_handle.payload_len;
+	}
+
+	H_FREE_PTR_WITH_FUNC(buf_handle.free_buf_handle, buf_handle.priv_buffer_handle);
+	return rbuffer;
+}
+
+/**
+  * @brief  Serial interface read, with ownership of the buffer
+  * @param  serial_ll_hdl - handle
+  *         buf_handle - output param, payload and how to free it
+  * @retval 0 on success, -1 on failure
+  */
+static int serial_ll_read_buf(const serial_ll_handle_t * serial_ll_hdl,
+		interface_buffer_handle_t * buf_handle)
+{
 	/* check if serial interface valid */
 	if ((! serial_ll_hdl) || (serial_ll_hdl->state != ACTIVE)) {
 		ESP_LOGE(TAG, "serial invalid interface");
-		return NULL;
+		return -1;
 	}
 
 	/* This is **blocking** receive.
@@ -177,23 +209,22 @@ static uint8_t * serial_ll_read(const serial_ll_handle_t * serial_ll_hdl,
 	 * In our example, first approach of blocking read is used.
 	 */
 	ESP_LOGV(TAG, "before deQ for ll_read");
-	if (g_h.funcs->_h_dequeue_item(serial_ll_hdl->queue, &buf_handle, HOSTED_BLOCK_MAX)) {
+	if (g_h.funcs->_h_dequeue_item(serial_ll_hdl->queue, buf_handle, HOSTED_BLOCK_MAX)) {
 		ESP_LOGE(TAG, "serial queue recv failed ");
-		return NULL;
+		return -1;
 	}
 	ESP_LOGV(TAG, "after deQ for ll_read");
 
 	/* proceed only if payload and length are sane */
-	if (!buf_handle.payload || !buf_handle.payload_len) {
+	if (!buf_handle->payload || !buf_handle->payload_len) {
 		ESP_LOGE(TAG, "%s: Dequeue result in empty buffer",__func__);
-		return NULL;
+		H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
+		return -1;
 	}
 
-	*rlen = buf_handle.payload_len;
-
-	ESP_HEXLOGV("ll_read", buf_handle.payload, buf_handle.payload_len, 32);
+	ESP_HEXLOGV("ll_read", buf_handle->payload, buf_handle->payload_len, 32);
 
-	return buf_handle.payload;
+	return 0;
 }
 
 /**
@@ -227,11 +258,11 @@ static int serial_ll_write(const serial_ll_handle_t * serial_ll_hdl,
 	uint8_t *buf_to_free = NULL;
 
 	while (remaining_len > 0) {
-		uint16_t frag_len = (remaining_len > MAX_PAYLOAD_SIZE) ? MAX_PAYLOAD_SIZE : remaining_len;
+		uint16_t frag_len = (remaining_len > MAX_SERIAL_FRAG_SIZE) ? MAX_SERIAL_FRAG_SIZE : remaining_len;
 		uint8_t *frag_ptr = wbuffer + offset;
 
 		uint8_t flags = 0;
-		if (remaining_len > MAX_PAYLOAD_SIZE) {
+		if (remaining_len > MAX_SERIAL_FRAG_SIZE) {
 			flags |= MORE_FRAGMENT;
 		}
 		else {
@@ -262,6 +293,129 @@ static int serial_ll_write(const serial_ll_handle_t * serial_ll_hdl,
 	return 0;
 }
 
+static void serial_ll_tx_buf_free(void *buf)
+{
+	mempool_free(serial_tx_mp, buf);
+}
+
+int serial_ll_tx_msg_alloc(serial_ll_tx_msg_t *msg, uint16_t len)
+{
+	uint8_t i = 0;
+
+	g_h.funcs->_h_memset(msg, 0, sizeof(*msg));
+
+	if (!len || len > MAX_FRAGMENTABLE_PAYLOAD_SIZE) {
+		ESP_LOGE(TAG, "Payload too large: %u bytes (max allowed: %u)", len, MAX_FRAGMENTABLE_PAYLOAD_SIZE);
+		return -1;
+	}
+
+	msg->len = len;
+	msg->n_frags = (len + MAX_SERIAL_FRAG_SIZE - 1) / MAX_SERIAL_FRAG_SIZE;
+
+	/* all buffers upfront, so a message is either sent whole or not at all */
+	for (i = 0; i < msg->n_frags; i++) {
+		msg->frag[i] = mempool_alloc(serial_tx_mp, MAX_TRANSPORT_BUFFER_SIZE, MEMSET_REQUIRED);
+		if (!msg->frag[i]) {
+			ESP_LOGE(TAG, "serial tx buffer alloc failed");
+			serial_ll_tx_msg_free(msg);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+uint8_t * serial_ll_tx_msg_reserve(serial_ll_tx_msg_t *msg, uint16_t len)
+{
+	uint16_t frag_off = msg->pos % MAX_SERIAL_FRAG_SIZE;
+	uint8_t *ptr = NULL;
+
+	if (len > msg->len - msg->pos || frag_off + len > MAX_SERIAL_FRAG_SIZE)
+		return NULL;
+
+	ptr = msg->frag[msg->pos / MAX_SERIAL_FRAG_SIZE] + H_ESP_PAYLOAD_HEADER_OFFSET + frag_off;
+	msg->pos += len;
+	return ptr;
+}
+
+int serial_ll_tx_msg_write(serial_ll_tx_msg_t *msg, const uint8_t *data, uint16_t len)
+{
+	uint16_t frag_off = 0;
+	uint16_t chunk = 0;
+
+	if (len > msg->len - msg->pos)
+		return -1;
+
+	while (len) {
+		frag_off = msg->pos % MAX_SERIAL_FRAG_SIZE;
+		chunk = MAX_SERIAL_FRAG_SIZE - frag_off;
+		if (chunk > len)
+			chunk = len;
+
+		g_h.funcs->_h_memcpy(msg->frag[msg->pos / MAX_SERIAL_FRAG_SIZE] +
+				H_ESP_PAYLOAD_HEADER_OFFSET + frag_off, data, chunk);
+		msg->pos += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+void serial_ll_tx_msg_free(serial_ll_tx_msg_t *msg)
+{
+	uint8_t i = 0;
+
+	for (i = 0; i < msg->n_frags; i++) {
+		if (msg->frag[i]) {
+			mempool_free(serial_tx_mp, msg->frag[i]);
+			msg->frag[i] = NULL;
+		}
+	}
+	msg->n_frags = 0;
+}
+
+int serial_ll_tx_msg_send(const serial_ll_handle_t *serial_ll_hdl, serial_ll_tx_msg_t *msg)
+{
+	uint16_t remaining_len = msg->len;
+	uint16_t frag_len = 0;
+	uint8_t flags = 0;
+	uint8_t i = 0;
+	int ret = 0;
+
+	if ((! serial_ll_hdl) || (serial_ll_hdl->state != ACTIVE)) {
+		ESP_LOGE(TAG, "serial invalid interface for write");
+		serial_ll_tx_msg_free(msg);
+		return -1;
+	}
+
+	if (msg->pos != msg->len) {
+		ESP_LOGE(TAG, "serial tx msg incomplete: %u of %u bytes", msg->pos, msg->len);
+		serial_ll_tx_msg_free(msg);
+		return -1;
+	}
+
+	for (i = 0; i < msg->n_frags; i++) {
+		frag_len = (remaining_len > MAX_SERIAL_FRAG_SIZE) ? MAX_SERIAL_FRAG_SIZE : remaining_len;
+		remaining_len -= frag_len;
+		flags = remaining_len ? MORE_FRAGMENT : 0;
+
+		/* transport owns the buffer from here, on failure too */
+		ret = esp_hosted_tx(serial_ll_hdl->if_type, serial_ll_hdl->if_num,
+				msg->frag[i], frag_len, H_BUFF_ZEROCOPY,
+				msg->frag[i], serial_ll_tx_buf_free, flags);
+		msg->frag[i] = NULL;
+		if (ret != ESP_OK) {
+			ESP_LOGE(TAG, "esp_hosted_tx failed at frag %u len=%u", i, frag_len);
+			serial_ll_tx_msg_free(msg);
+			return ret;
+		}
+	}
+
+	msg->n_frags = 0;
+	return 0;
+}
+
 /**
   * @brief Serial rx handler is called by spi driver when there
   *        is incoming data with interface type is Serial.
@@ -274,22 +428,9 @@ static int serial_ll_write(const serial_ll_handle_t * serial_ll_hdl,
   */
 int serial_ll_rx_handler(interface_buffer_handle_t * buf_handle)
 {
-
-#define SERIAL_ALLOC_REALLOC_RDATA() \
-	do { \
-		if(!r.data) { \
-			r.data = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len); \
-		} else { \
-			r.data = (uint8_t *)g_h.funcs->_h_realloc(r.data, r.len + buf_handle->payload_len); \
-		} \
-		if (!r.data) { \
-			ESP_LOGE(TAG, "Failed to allocate serial data"); \
-			goto serial_buff_cleanup; \
-		} \
-	} while(0);
-
 	serial_ll_handle_t * serial_ll_hdl = NULL;
-	uint8_t *serial_buf = NULL;
+	serial_ll_rx_chain_t *chain = NULL;
+	serial_ll_rx_frag_t *frag = NULL;
 	interface_buffer_handle_t new_buf_handle = {0};
 
 	/* Check valid handle and length */
@@ -306,46 +447,58 @@ int serial_ll_rx_handler(interface_buffer_handle_t * buf_handle)
 		goto serial_buff_cleanup;
 	}
 
-
-	/* Accumulate fragments */
-	if (buf_handle->flag & MORE_FRAGMENT) {
-
-		ESP_LOGD(TAG, "Fragment!!!");
-		SERIAL_ALLOC_REALLOC_RDATA();
-
-		g_h.funcs->_h_memcpy((r.data + r.len), buf_handle->payload, buf_handle->payload_len);
-		r.len += buf_handle->payload_len;
-		return 0;
+	if (!buf_handle->priv_buffer_handle) {
+		ESP_LOGE(TAG, "Serial fragment without owning buffer");
+		goto serial_buff_cleanup;
 	}
 
-	SERIAL_ALLOC_REALLOC_RDATA();
+	if ((r.n_frags == MAX_SERIAL_RX_FRAGS) ||
+	    (r.len + buf_handle->payload_len > MAX_FRAGMENTABLE_PAYLOAD_SIZE)) {
+		ESP_LOGE(TAG, "Serial msg too large, drop");
+		goto serial_buff_cleanup;
+	}
 
-	/* No or last fragment */
-	g_h.funcs->_h_memcpy((r.data + r.len), buf_handle->payload, buf_handle->payload_len);
+	/* Link the bus buffer itself in the chain, transport must not free it */
+	frag = &r.frag[r.n_frags++];
+	frag->payload = buf_handle->payload;
+	frag->len = buf_handle->payload_len;
+	frag->priv_buffer_handle = buf_handle->priv_buffer_handle;
+	frag->free_buf_handle = buf_handle->free_buf_handle;
 	r.len += buf_handle->payload_len;
 
-	serial_buf = (uint8_t *)g_h.funcs->_h_malloc(r.len);
-	if(!serial_buf) {
-		ESP_LOGE(TAG, "Malloc failed, drop pkt");
-		goto serial_buff_cleanup;
+	buf_handle->priv_buffer_handle = NULL;
+	buf_handle->payload_zcopy = H_BUFF_ZEROCOPY;
+
+	/* Accumulate fragments */
+	if (buf_handle->flag & MORE_FRAGMENT) {
+		ESP_LOGD(TAG, "Fragment!!!");
+		return 0;
 	}
-	g_h.funcs->_h_memcpy(serial_buf, r.data, r.len);
 
 	/* form new buf handle for processing of serial msg */
 	new_buf_handle.if_type = ESP_SERIAL_IF;
 	new_buf_handle.if_num = buf_handle->if_num;
 	new_buf_handle.payload_len = r.len;
-	new_buf_handle.payload = serial_buf;
-	new_buf_handle.priv_buffer_handle = serial_buf;
-	new_buf_handle.free_buf_handle = g_h.funcs->_h_free;
-
-	/* clear old buf handle */
-	//H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
 
+	if (r.n_frags == 1) {
+		/* Not fragmented: passed up as is */
+		new_buf_handle.payload = frag->payload;
+		new_buf_handle.priv_buffer_handle = frag->priv_buffer_handle;
+		new_buf_handle.free_buf_handle = frag->free_buf_handle;
+	} else {
+		chain = (serial_ll_rx_chain_t *)g_h.funcs->_h_malloc(sizeof(serial_ll_rx_chain_t));
+		if (!chain) {
+			ESP_LOGE(TAG, "Malloc failed, drop pkt");
+			goto serial_buff_cleanup;
+		}
+		g_h.funcs->_h_memcpy(chain, &r, sizeof(serial_ll_rx_chain_t));
+		new_buf_handle.payload = (uint8_t *)chain;
+		new_buf_handle.priv_buffer_handle = chain;
+		new_buf_handle.free_buf_handle = serial_ll_rx_chain_free;
+	}
 
-	r.len = 0;
-	g_h.funcs->_h_free(r.data);
-	r.data = NULL;
+	/* chain handed over to new_buf_handle */
+	g_h.funcs->_h_memset(&r, 0, sizeof(r));
 
 	ESP_LOGV(TAG, "before ENQ for ll_read");
 	/* send to serial queue */
@@ -360,7 +513,8 @@ int serial_ll_rx_handler(interface_buffer_handle_t * buf_handle)
 	if (serial_ll_hdl->serial_rx_callback) {
 		(*serial_ll_hdl->serial_rx_callback) ();
 	} else {
-		goto serial_buff_cleanup;
+		/* already queued, reader will release it */
+		return -1;
 	}
 
 	return 0;
@@ -368,16 +522,60 @@ int serial_ll_rx_handler(interface_buffer_handle_t * buf_handle)
 serial_buff_cleanup:
 
 	ESP_LOGE(TAG, "Err occured, discard current buffer");
-	H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
-
-	r.len = 0;
+	if (buf_handle)
+		H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
 
 	H_FREE_PTR_WITH_FUNC(new_buf_handle.free_buf_handle, new_buf_handle.priv_buffer_handle);
 
-	g_h.funcs->_h_free(r.data);
+	/* partial chain, if any */
+	serial_ll_rx_chain_release(&r);
 	return -1;
 }
 
+void serial_ll_rx_chain_release(serial_ll_rx_chain_t *chain)
+{
+	uint8_t i = 0;
+
+	for (i = 0; i < chain->n_frags; i++)
+		H_FREE_PTR_WITH_FUNC(chain->frag[i].free_buf_handle, chain->frag[i].priv_buffer_handle);
+	chain->n_frags = 0;
+	chain->len = 0;
+}
+
+void serial_ll_rx_chain_free(void *chain)
+{
+	serial_ll_rx_chain_release((serial_ll_rx_chain_t *)chain);
+	g_h.funcs->_h_free(chain);
+}
+
+int serial_ll_rx_chain_copy(const serial_ll_rx_chain_t *chain, uint16_t offset,
+		uint8_t *dst, uint16_t len)
+{
+	uint8_t i = 0;
+	uint16_t chunk = 0;
+
+	if (offset + len > chain->len)
+		return -1;
+
+	for (i = 0; i < chain->n_frags && len; i++) {
+		if (offset >= chain->frag[i].len) {
+			offset -= chain->frag[i].len;
+			continue;
+		}
+
+		chunk = chain->frag[i].len - offset;
+		if (chunk > len)
+			chunk = len;
+
+		g_h.funcs->_h_memcpy(dst, chain->frag[i].payload + offset, chunk);
+		dst += chunk;
+		len -= chunk;
+		offset = 0;
+	}
+
+	return 0;
+}
+
 /** Exported Functions **/
 
 /**
@@ -398,6 +596,10 @@ serial_ll_handle_t * serial_ll_init(void(*serial_rx_callback)(void))
 			return NULL;
 		}
 
+		/* kept across close, buffers may still be queued in transport */
+		if (!serial_tx_mp)
+			serial_tx_mp = mempool_create(MAX_TRANSPORT_BUFFER_SIZE);
+
 		serial_ll_hdl->if_type = ESP_SERIAL_IF;
 		serial_ll_hdl->if_num  = conn_num;
 		serial_ll_hdl->queue   = to_serial_ll_intf_queue[conn_num];
@@ -24,6 +24,16 @@ extern "C" {
 /** includes **/
 #include "transport_drv.h"
 #include "os_wrapper.h"
+#include "esp_hosted_header.h"
+
+/* leave room for the CRC32 trailer, in case it is in use */
+#define MAX_SERIAL_FRAG_SIZE              (MAX_PAYLOAD_SIZE - H_ESP_PAYLOAD_CRC32_LEN)
+#define MAX_SERIAL_TX_FRAGS               ((MAX_FRAGMENTABLE_PAYLOAD_SIZE + \
+                                             MAX_SERIAL_FRAG_SIZE - 1) / MAX_SERIAL_FRAG_SIZE)
+/* slave fragments at ETH_DATA_LEN, leave margin for smaller fragments */
+#define MIN_SERIAL_RX_FRAG_SIZE           1024
+#define MAX_SERIAL_RX_FRAGS               ((MAX_FRAGMENTABLE_PAYLOAD_SIZE + \
+                                             MIN_SERIAL_RX_FRAG_SIZE - 1) / MIN_SERIAL_RX_FRAG_SIZE)
 
 struct serial_ll_operations;
 
@@ -73,6 +83,18 @@ struct serial_ll_operations {
 		uint16_t * rlen);
 
 
+	/**
+	 * @brief  Same as read, but returns the whole buffer handle, so the
+	 *         caller can work in the buffer and release it through
+	 *         free_buf_handle(priv_buffer_handle) once done
+	 * @param  serial_ll_hdl - handle
+	 *         buf_handle - output param, received buffer
+	 * @retval 0 on success, -1 on failure
+	 */
+	int        (*read_buf) (const serial_ll_handle_t * serial_ll_hdl,
+		interface_buffer_handle_t * buf_handle);
+
+
 	/**
 	 * @brief Serial interface write
 	 * @param  serial_ll_hdl - handle
@@ -100,6 +122,88 @@ struct serial_ll_operations {
 serial_ll_handle_t * serial_ll_init(void(*rx_data_ind)(void));
 
 int serial_ll_rx_handler(interface_buffer_handle_t * buf_handle);
+
+/* Fragmented Rx message
+ *
+ * Fragments are not copied on reception. The bus buffers they arrived in
+ * are linked as is, and the message is queued up to the reader as a
+ * chain: payload of the read buffer handle is a serial_ll_rx_chain_t and
+ * its free_buf_handle is serial_ll_rx_chain_free(), which releases all
+ * bus buffers. Reader linearises it with serial_ll_rx_chain_copy(), only
+ * if it needs contiguous memory. Messages in single fragment are queued
+ * up as the bus buffer itself.
+ */
+typedef struct {
+	uint8_t *payload;
+	uint16_t len;
+	void *priv_buffer_handle;
+	void (*free_buf_handle)(void *buf_handle);
+} serial_ll_rx_frag_t;
+
+typedef struct {
+	serial_ll_rx_frag_t frag[MAX_SERIAL_RX_FRAGS];
+	uint8_t n_frags;
+	uint16_t len;
+} serial_ll_rx_chain_t;
+
+/* Release bus buffers of the chain, chain itself is left as is */
+void serial_ll_rx_chain_release(serial_ll_rx_chain_t *chain);
+
+/* free_buf_handle of chained messages, releases chain and its buffers */
+void serial_ll_rx_chain_free(void *chain);
+
+static inline int serial_ll_rx_is_chain(const interface_buffer_handle_t *buf_handle)
+{
+	return buf_handle->free_buf_handle == serial_ll_rx_chain_free;
+}
+
+/**
+  * @brief  Copy 'len' bytes from 'offset' in the chain to 'dst'
+  * @retval 0 on success, -1 if out of chain bounds
+  */
+int serial_ll_rx_chain_copy(const serial_ll_rx_chain_t *chain, uint16_t offset,
+		uint8_t *dst, uint16_t len);
+
+/* Single copy Tx message
+ *
+ * Message of known length is written straight into transport buffers,
+ * one per fragment, each with room for the payload header in front. Once
+ * complete, serial_ll_tx_msg_send() hands them over to the transport as
+ * zerocopy buffers, so nothing is copied again below this layer.
+ */
+typedef struct {
+	uint8_t *frag[MAX_SERIAL_TX_FRAGS];
+	uint8_t n_frags;
+	uint16_t len;
+	uint16_t pos;
+} serial_ll_tx_msg_t;
+
+/**
+  * @brief  Get transport buffers for a message of 'len' bytes
+  * @retval 0 on success, -1 on failure
+  */
+int serial_ll_tx_msg_alloc(serial_ll_tx_msg_t *msg, uint16_t len);
+
+/**
+  * @brief  Append 'len' bytes to the message
+  * @retval 0 on success, -1 if it would overflow the message length
+  */
+int serial_ll_tx_msg_write(serial_ll_tx_msg_t *msg, const uint8_t *data, uint16_t len);
+
+/**
+  * @brief  Reserve next 'len' bytes of the message to be written in place
+  * @retval pointer to them, NULL if they are not contiguous or overflow
+  */
+uint8_t * serial_ll_tx_msg_reserve(serial_ll_tx_msg_t *msg, uint16_t len);
+
+/**
+  * @brief  Send fully written message, buffers are released by transport
+  * @retval 0 on success, -1 on failure
+  */
+int serial_ll_tx_msg_send(const serial_ll_handle_t *serial_ll_hdl, serial_ll_tx_msg_t *msg);
+
+/* Release buffers of a message not sent */
+void serial_ll_tx_msg_free(serial_ll_tx_msg_t *msg);
 #ifdef __cplusplus
 }
 #endif
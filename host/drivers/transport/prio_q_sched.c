@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "prio_q_sched.h"
+#include "esp_hosted_config.h"
+#include "esp_hosted_header.h"
+#include "os_wrapper.h"
+
+#if H_PRIO_Q_WFQ
+static const int32_t prio_q_quantum[MAX_PRIORITY_QUEUES] = {
+	[PRIO_Q_SERIAL] = H_PRIO_Q_SERIAL_QUANTUM,
+	[PRIO_Q_BT]     = H_PRIO_Q_BT_QUANTUM,
+	[PRIO_Q_OTHERS] = H_PRIO_Q_OTHERS_QUANTUM,
+};
+
+static const uint32_t prio_q_max_wait_ms[MAX_PRIORITY_QUEUES] = {
+	[PRIO_Q_SERIAL] = H_PRIO_Q_SERIAL_MAX_WAIT_MS,
+	[PRIO_Q_BT]     = H_PRIO_Q_BT_MAX_WAIT_MS,
+	[PRIO_Q_OTHERS] = H_PRIO_Q_OTHERS_MAX_WAIT_MS,
+};
+
+#define PRIO_Q_ALL_MASK              ((1 << MAX_PRIORITY_QUEUES) - 1)
+
+static inline int32_t prio_q_pkt_cost(interface_buffer_handle_t *buf_handle)
+{
+	return buf_handle->payload_len + sizeof(struct esp_payload_header);
+}
+
+static inline uint8_t prio_q_next(uint8_t prio_q)
+{
+	return (prio_q + 1) % MAX_PRIORITY_QUEUES;
+}
+
+static int prio_q_tx_ring_pop_lane(void *ctx, uint8_t prio_q,
+		interface_buffer_handle_t *buf_handle)
+{
+	return g_h.funcs->_h_tx_ring_pop_lane(ctx, prio_q, buf_handle);
+}
+#endif
+
+void prio_q_sched_init(prio_q_sched_t *sched)
+{
+	uint32_t now = g_h.funcs->_h_get_time_ms();
+	uint8_t i = 0;
+
+	for (i = 0; i < MAX_PRIORITY_QUEUES; i++) {
+		sched->deficit[i] = 0;
+		sched->last_served_ms[i] = now;
+	}
+	sched->cur = 0;
+}
+
+int prio_q_sched_dequeue(prio_q_sched_t *sched, prio_q_pop_fn_t pop, void *ctx,
+		interface_buffer_handle_t *buf_handle)
+{
+#if H_PRIO_Q_WFQ
+	uint32_t now = g_h.funcs->_h_get_time_ms();
+	uint8_t empty = 0;
+	uint8_t q = 0;
+
+	/* Queues waiting past their latency bound jump the round.
+	 * last_served_ms also moves when a queue is seen empty, so it tracks
+	 * how long packets may have been pending. */
+	for (q = 0; q < MAX_PRIORITY_QUEUES; q++) {
+		if (!prio_q_max_wait_ms[q] ||
+		    (int32_t)(now - sched->last_served_ms[q]) < (int32_t)prio_q_max_wait_ms[q])
+			continue;
+
+		sched->last_served_ms[q] = now;
+		if (!pop(ctx, q, buf_handle)) {
+			sched->deficit[q] -= prio_q_pkt_cost(buf_handle);
+			return 0;
+		}
+		empty |= BIT(q);
+	}
+
+	while (empty != PRIO_Q_ALL_MASK) {
+		q = sched->cur;
+
+		if (empty & BIT(q)) {
+			sched->cur = prio_q_next(q);
+			continue;
+		}
+
+		/* quota used up: top up and pass the turn */
+		if (sched->deficit[q] <= 0) {
+			sched->deficit[q] += prio_q_quantum[q];
+			sched->cur = prio_q_next(q);
+			continue;
+		}
+
+		sched->last_served_ms[q] = now;
+		if (!pop(ctx, q, buf_handle)) {
+			/* packet is charged after the fact, so no peek is needed.
+			 * Overdraft is paid back in later rounds */
+			sched->deficit[q] -= prio_q_pkt_cost(buf_handle);
+			return 0;
+		}
+
+		/* idle queue does not bank quota */
+		sched->deficit[q] = 0;
+		empty |= BIT(q);
+		sched->cur = prio_q_next(q);
+	}
+
+	return -1;
+#else
+	uint8_t q = 0;
+
+	for (q = 0; q < MAX_PRIORITY_QUEUES; q++)
+		if (!pop(ctx, q, buf_handle))
+			return 0;
+
+	return -1;
+#endif
+}
+
+int prio_q_sched_tx_ring_pop(prio_q_sched_t *sched, void *ring,
+		interface_buffer_handle_t *buf_handle, int timeout)
+{
+#if H_PRIO_Q_WFQ
+	for (;;) {
+		if (!prio_q_sched_dequeue(sched, prio_q_tx_ring_pop_lane, ring, buf_handle))
+			return 0;
+
+		if (!timeout || g_h.funcs->_h_tx_ring_wait(ring, timeout))
+			return -1;
+	}
+#else
+	/* ring serves lanes in strict priority order itself */
+	return g_h.funcs->_h_tx_ring_pop(ring, buf_handle, timeout);
+#endif
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Picks which priority queue (PRIO_Q_SERIAL, PRIO_Q_BT, PRIO_Q_OTHERS) to
+ * serve next. Strict priority by default; with H_PRIO_Q_WFQ, deficit round
+ * robin using per queue byte quotas and latency bounds.
+ */
+
+#ifndef __PRIO_Q_SCHED_H
+#define __PRIO_Q_SCHED_H
+
+#include <stdint.h>
+#include "common.h"
+#include "esp_hosted_transport.h"
+
+/* Non-blocking pop from one priority queue. Returns 0 on success */
+typedef int (*prio_q_pop_fn_t)(void *ctx, uint8_t prio_q, interface_buffer_handle_t *buf_handle);
+
+typedef struct {
+	int32_t deficit[MAX_PRIORITY_QUEUES];
+	uint32_t last_served_ms[MAX_PRIORITY_QUEUES];
+	uint8_t cur;
+} prio_q_sched_t;
+
+void prio_q_sched_init(prio_q_sched_t *sched);
+
+/**
+ * @brief  Pop the next packet due, from any priority queue
+ * @retval 0 on success, -1 if all queues are empty
+ */
+int prio_q_sched_dequeue(prio_q_sched_t *sched, prio_q_pop_fn_t pop, void *ctx,
+		interface_buffer_handle_t *buf_handle);
+
+/**
+ * @brief  Same as prio_q_sched_dequeue(), over the lanes of a Tx ring
+ *
+ * timeout as for _h_tx_ring_pop()
+ */
+int prio_q_sched_tx_ring_pop(prio_q_sched_t *sched, void *ring,
+		interface_buffer_handle_t *buf_handle, int timeout);
+
+#endif
@@ -11,8 +11,8 @@
  *  TX Path (Host -> Slave):
  *  ------------------------
  *  1. `esp_hosted_tx()`: Higher-level modules call this function to send data.
- *  2. `to_slave_queue`: The data is placed into a priority queue.
- *  3. `sdio_write_task`: This thread waits for data on the queue, retrieves it,
+ *  2. `to_slave_ring`: The data is placed into a per-priority lane of the Tx ring.
+ *  3. `sdio_write_task`: This thread waits for data on the ring, retrieves it,
  *     and writes it to the SDIO bus.
  *
  *  RX Path (Slave -> Host):
@@ -37,7 +37,7 @@
  *        | | esp_hosted_tx()                                      |   | sdio_read_task (Thread)           | |
  *        | |      |                                               |   |    |                              | |
  *        | |      v                                               |   |    | Data Stream                  | |
- *        | | to_slave_queue (Queue)                               |   |    v                              | |
+ *        | | to_slave_ring (Tx ring)                              |   |    v                              | |
  *        | |      |                                               |   | Double Buffer                     | |
  *        | |      v                                               |   |    |                              | |
  *        | | sdio_write_task (Thread)                             |   |    v                              | |
@@ -87,6 +87,7 @@
 #include "esp_hosted_config.h"
 #include "esp_hosted_transport_config.h"
 #include "esp_hosted_bt.h"
+#include "prio_q_sched.h"
 
 static const char TAG[] = "H_SDIO_DRV";
 
@@ -158,14 +159,35 @@ static void * sdio_read_thread;
 static void * sdio_process_rx_thread;
 static void * sdio_write_thread;
 
-static queue_handle_t to_slave_queue[MAX_PRIORITY_QUEUES];
-semaphore_handle_t sem_to_slave_queue;
+static void * to_slave_ring;
+static prio_q_sched_t tx_sched;
 static queue_handle_t from_slave_queue[MAX_PRIORITY_QUEUES];
 semaphore_handle_t sem_from_slave_queue;
+static prio_q_sched_t rx_sched;
 
 /* Counter to hold the amount of buffers already sent to sdio slave */
 static uint32_t sdio_tx_buf_count = 0;
 
+/* Slave Rx buffers known to be free, as last read from slave */
+static uint32_t sdio_tx_buf_available = 0;
+
+#if H_SDIO_TX_CREDIT
+/* Slave token count piggybacked on last Rx packet, written by Rx path only */
+#define SDIO_TX_CREDIT_VALID              (1UL << 31)
+static volatile uint32_t sdio_tx_credit_hint = 0;
+/* Latest token count accepted, from register or piggyback */
+static uint32_t sdio_tx_token = 0;
+/* Last token count taken from piggyback, to cross check with register */
+static uint32_t sdio_tx_credit_last = 0;
+static bool sdio_tx_credit_disabled = false;
+#endif
+
+#if H_SDIO_TX_AGGREGATION
+/* Tx buffer to pack queued packets into, one slave Rx buffer per slot.
+ * Allocated only if slave can split aggregated transfers */
+static uint8_t *sdio_tx_aggr_buf = NULL;
+#endif
+
 /* Counter to hold the amount of bytes already received from sdio slave */
 static uint32_t sdio_rx_byte_count = 0;
 
@@ -253,21 +275,18 @@ void bus_deinit_internal(void *bus_handle)
 		sdio_rx_buf_thread = NULL;
 	}
 
+	if (to_slave_ring) {
+		g_h.funcs->_h_destroy_tx_ring(to_slave_ring);
+		to_slave_ring = NULL;
+	}
+
 	for (prio_q_idx=0; prio_q_idx<MAX_PRIORITY_QUEUES;prio_q_idx++) {
-		if (to_slave_queue[prio_q_idx]) {
-			g_h.funcs->_h_destroy_queue(to_slave_queue[prio_q_idx]);
-			to_slave_queue[prio_q_idx] = NULL;
-		}
 		if (from_slave_queue[prio_q_idx]) {
 			g_h.funcs->_h_destroy_queue(from_slave_queue[prio_q_idx]);
 			from_slave_queue[prio_q_idx] = NULL;
 		}
 	}
 
-	if (sem_to_slave_queue) {
-		g_h.funcs->_h_destroy_semaphore(sem_to_slave_queue);
-		sem_to_slave_queue = NULL;
-	}
 	if (sem_from_slave_queue) {
 		g_h.funcs->_h_destroy_semaphore(sem_from_slave_queue);
 		sem_from_slave_queue = NULL;
@@ -330,6 +349,22 @@ static int sdio_get_tx_buffer_num(uint32_t *tx_num, bool is_lock_needed)
 	}
 
 	len = (len >> 16) & ESP_TX_BUFFER_MASK;
+#if H_SDIO_TX_CREDIT
+#if ESP_PKT_STATS
+	pkt_stats.sdio_tx_credit_reg_read++;
+#endif
+	if (sdio_tx_credit_last && !sdio_tx_credit_disabled) {
+		uint32_t ahead = (sdio_tx_credit_last - len) & ESP_TX_BUFFER_MASK;
+
+		/* piggybacked count must never run ahead of the register */
+		if (ahead && ahead < ESP_TX_BUFFER_MAX / 2) {
+			ESP_LOGW(TAG, "Tx credit %" PRIu32 " ahead of slave token %" PRIu32 ", disable credits",
+					sdio_tx_credit_last, len);
+			sdio_tx_credit_disabled = true;
+		}
+	}
+	sdio_tx_token = len;
+#endif
 	len = (len + ESP_TX_BUFFER_MAX - sdio_tx_buf_count) % ESP_TX_BUFFER_MAX;
 
 	*tx_num = len;
@@ -427,13 +462,48 @@ static int sdio_get_len_from_slave(uint32_t *rx_size, bool is_lock_needed)
 
 #define MAX_BUFF_FETCH_PERIODICITY 30000
 
+#if H_SDIO_TX_CREDIT
+/* Refresh available buffers from the token count piggybacked by slave.
+ * Only moves forward, stale or repeated counts are ignored */
+static void sdio_apply_tx_credit(uint32_t *buf_available)
+{
+	uint32_t hint = sdio_tx_credit_hint;
+	uint32_t token = hint & ESP_TX_BUFFER_MASK;
+	uint32_t fwd = 0;
+
+	if (!(hint & SDIO_TX_CREDIT_VALID) || sdio_tx_credit_disabled)
+		return;
+
+	fwd = (token - sdio_tx_token) & ESP_TX_BUFFER_MASK;
+	if (!fwd || fwd >= ESP_TX_BUFFER_MAX / 2)
+		return;
+
+	sdio_tx_token = token;
+	sdio_tx_credit_last = token;
+	*buf_available = (token + ESP_TX_BUFFER_MAX - sdio_tx_buf_count) % ESP_TX_BUFFER_MAX;
+#if ESP_PKT_STATS
+	pkt_stats.sdio_tx_credit_update++;
+#endif
+}
+#endif
+
 static int sdio_is_write_buffer_available(uint32_t buf_needed)
 {
-	static uint32_t buf_available = 0;
+	uint32_t buf_available = sdio_tx_buf_available;
 	uint8_t retry = MAX_WRITE_BUF_RETRIES;
 	uint32_t max_retry_sdio_not_responding = 2;
 	uint32_t interval_us = 400;
 
+#if H_SDIO_TX_CREDIT
+	/* Try credits from slave before falling back to register read */
+	if (buf_available < buf_needed)
+		sdio_apply_tx_credit(&buf_available);
+#if ESP_PKT_STATS
+	if (buf_available < buf_needed)
+		pkt_stats.sdio_tx_credit_stall++;
+#endif
+#endif
+
 	/*If buffer needed are less than buffer available
 	  then only read for available buffer number from slave*/
 	if (buf_available < buf_needed) {
@@ -468,6 +538,8 @@ static int sdio_is_write_buffer_available(uint32_t buf_needed)
 	if (buf_available >= buf_needed)
 		buf_available -= buf_needed;
 
+	sdio_tx_buf_available = buf_available;
+
 	if (!retry) {
 		/* No buffer available at slave */
 		return BUFFER_UNAVAILABLE;
@@ -476,6 +548,259 @@ static int sdio_is_write_buffer_available(uint32_t buf_needed)
 	return BUFFER_AVAILABLE;
 }
 
+/* Writes data to slave in one or more CMD53 transfers.
+ * To be called with SDIO_DRV_LOCK held */
+static int sdio_write_to_slave(uint8_t *pos, uint32_t data_left)
+{
+	uint32_t len_to_send = 0;
+	int retries = 0;
+	int ret = 0;
+
+	ESP_HEXLOGV("bus_TX", pos, data_left, 32);
+
+	do {
+		len_to_send = data_left;
+
+#if H_SDIO_TX_BLOCK_ONLY_XFER
+		/* Extend the transfer length to do block only transfers.
+		 * This is safe as slave only reads up to data_left, which
+		 * is not changed here. Rest of data is discarded by
+		 * slave.
+		 */
+		uint32_t block_send_len = ((len_to_send + ESP_BLOCK_SIZE - 1) / ESP_BLOCK_SIZE) * ESP_BLOCK_SIZE;
+
+		ret = g_h.funcs->_h_sdio_write_block(sdio_handle, ESP_SLAVE_CMD53_END_ADDR - data_left,
+			pos, block_send_len, ACQUIRE_LOCK);
+#else
+		ret = g_h.funcs->_h_sdio_write_block(sdio_handle, ESP_SLAVE_CMD53_END_ADDR - data_left,
+			pos, len_to_send, ACQUIRE_LOCK);
+#endif
+		if (ret) {
+			ESP_LOGE(TAG, "%s: %d: Failed to send data: %d %" PRIu32 " %" PRIu32, __func__,
+				retries, ret, len_to_send, data_left);
+			retries++;
+			if (retries < MAX_SDIO_WRITE_RETRY) {
+				ESP_LOGD(TAG, "retry");
+				continue;
+			}
+			return ret;
+		}
+
+		data_left -= len_to_send;
+		pos += len_to_send;
+	} while (data_left);
+
+	return 0;
+}
+
+/* Dequeues the next Tx packet, from the lane due as per prio_q_sched */
+static int sdio_dequeue_tx_pkt(interface_buffer_handle_t *buf_handle, int timeout)
+{
+	if (prio_q_sched_tx_ring_pop(&tx_sched, to_slave_ring, buf_handle, timeout))
+		return ESP_FAIL;
+
+	return ESP_OK;
+}
+
+#if H_SDIO_TX_AGGREGATION
+/* Bytes needed in the Tx buffer for the packet, including its header */
+static uint16_t sdio_tx_aggr_pkt_len(interface_buffer_handle_t *buf_handle)
+{
+	uint16_t len = buf_handle->payload_len;
+
+	/* first byte of HCI payload moves to the header */
+	if (buf_handle->if_type == ESP_HCI_IF && !buf_handle->payload_zcopy && len)
+		len--;
+
+	if (is_transport_tx_crc32_enabled())
+		len += H_ESP_PAYLOAD_CRC32_LEN;
+
+	return len + sizeof(struct esp_payload_header);
+}
+
+/* Copies the packet with its own header to 'dst'.
+ * Returns the number of bytes used */
+static uint16_t sdio_tx_aggr_add_pkt(uint8_t *dst, interface_buffer_handle_t *buf_handle)
+{
+	struct esp_payload_header *payload_header = (struct esp_payload_header *) dst;
+	uint8_t *src = buf_handle->payload;
+	uint16_t len = buf_handle->payload_len;
+
+	memset(payload_header, 0, sizeof(struct esp_payload_header));
+
+	if (buf_handle->payload_zcopy) {
+		/* zerocopy payload is preceded by room for the header */
+		payload_header->hci_pkt_type =
+			((struct esp_payload_header *) src)->hci_pkt_type;
+		src += sizeof(struct esp_payload_header);
+	} else if (buf_handle->if_type == ESP_HCI_IF && len) {
+		payload_header->hci_pkt_type = src[0];
+		src++;
+		len--;
+	}
+
+	payload_header->len = htole16(len);
+	payload_header->offset = htole16(sizeof(struct esp_payload_header));
+	payload_header->if_type = buf_handle->if_type;
+	payload_header->if_num = buf_handle->if_num;
+	payload_header->seq_num = htole16(buf_handle->seq_num);
+	payload_header->flags = buf_handle->flag;
+	if (is_transport_tx_crc32_enabled())
+		payload_header->flags |= FLAG_CRC32;
+
+	UPDATE_HEADER_TX_PKT_NO(payload_header);
+
+	g_h.funcs->_h_memcpy(dst + sizeof(struct esp_payload_header), src, len);
+
+	return len + sizeof(struct esp_payload_header) + esp_frame_trailer_len(payload_header);
+}
+
+/* Header is final once it is known whether another packet follows */
+static inline void sdio_tx_aggr_close_pkt(struct esp_payload_header *payload_header)
+{
+	if (payload_header->flags & FLAG_CRC32)
+		esp_frame_crc32_fill(payload_header);
+#if H_SDIO_CHECKSUM
+	else
+		payload_header->checksum = htole16(compute_checksum((uint8_t *)payload_header,
+			sizeof(struct esp_payload_header) + le16toh(payload_header->len)));
+#endif
+}
+
+static void sdio_tx_release_pkt(interface_buffer_handle_t *buf_handle)
+{
+	if (buf_handle->payload_zcopy) {
+		H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->payload);
+	} else {
+		H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
+	}
+}
+
+/* Packs 'buf_handle' and as many queued packets as fit in the free slave
+ * Rx buffers into one transfer.
+ *
+ * Each slave Rx buffer is one slot in sdio_tx_aggr_buf. Packets never cross
+ * a slot, so the slave sees a payload header at the start of every buffer.
+ * Within a slot, packets are placed back-to-back, each flagged with
+ * FLAG_AGGR_NEXT_PKT if another packet follows it.
+ */
+static void sdio_write_aggregated(interface_buffer_handle_t *buf_handle)
+{
+	struct esp_payload_header *prev_header = NULL;
+	uint8_t *slot = NULL;
+	uint32_t pos = 0;
+	uint32_t buf_used = 0;
+	uint32_t max_bufs = 0;
+	uint16_t pkt_len = 0;
+	uint8_t pkt_pending = 1;
+#if ESP_PKT_STATS
+	uint32_t sta_pkts = 0;
+#endif
+	int ret = 0;
+
+	while (pkt_pending) {
+		/* use the free buffer count last advertised by slave */
+		max_bufs = sdio_tx_buf_available;
+		if (max_bufs < 1)
+			max_bufs = 1;
+		if (max_bufs > H_SDIO_TX_AGGR_MAX_BUFS)
+			max_bufs = H_SDIO_TX_AGGR_MAX_BUFS;
+
+		slot = sdio_tx_aggr_buf;
+		pos = 0;
+		buf_used = 1;
+		prev_header = NULL;
+#if ESP_PKT_STATS
+		sta_pkts = 0;
+#endif
+
+		while (pkt_pending) {
+			pkt_len = sdio_tx_aggr_pkt_len(buf_handle);
+
+			if (pkt_len > ESP_RX_BUFFER_SIZE) {
+				ESP_LOGE(TAG, "Pkt len [%u] > Max [%u]. Drop",
+						pkt_len, ESP_RX_BUFFER_SIZE);
+#if ESP_PKT_STATS
+				if (buf_handle->if_type == ESP_STA_IF)
+					pkt_stats.sta_tx_out_drop++;
+#endif
+				goto next_pkt;
+			}
+
+			if (prev_header) {
+				if (H_AGGR_PKT_ALIGN(pos) + pkt_len <= ESP_RX_BUFFER_SIZE) {
+					prev_header->flags |= FLAG_AGGR_NEXT_PKT;
+					pos = H_AGGR_PKT_ALIGN(pos);
+				} else if (buf_used < max_bufs) {
+					slot += ESP_RX_BUFFER_SIZE;
+					pos = 0;
+					buf_used++;
+				} else {
+					/* no room left, packet goes in the next transfer */
+					break;
+				}
+				sdio_tx_aggr_close_pkt(prev_header);
+			}
+
+			prev_header = (struct esp_payload_header *) (slot + pos);
+			pos += sdio_tx_aggr_add_pkt(slot + pos, buf_handle);
+
+#if ESP_PKT_STATS
+			if (buf_handle->if_type == ESP_STA_IF)
+				sta_pkts++;
+#endif
+next_pkt:
+			sdio_tx_release_pkt(buf_handle);
+
+			/* pick up more packets, only if already queued */
+			pkt_pending = 0;
+			if (!sdio_dequeue_tx_pkt(buf_handle, 0))
+				pkt_pending = 1;
+#if ESP_PKT_STATS
+			if (pkt_pending && buf_handle->if_type == ESP_STA_IF)
+				pkt_stats.sta_tx_trans_in++;
+#endif
+		}
+
+		if (!prev_header)
+			continue;
+
+		sdio_tx_aggr_close_pkt(prev_header);
+
+		/* Packets are already released into the batch, and it may carry
+		 * serial frames, so it is held until slave frees buffers for it.
+		 * Bus is given up in between, for Rx to go on */
+		SDIO_DRV_LOCK();
+		while (sdio_is_write_buffer_available(buf_used) != BUFFER_AVAILABLE) {
+			SDIO_DRV_UNLOCK();
+			ESP_LOGV(TAG, "no SDIO write buffers on slave device, retry");
+#if ESP_PKT_STATS
+			pkt_stats.sdio_tx_aggr_wait++;
+#endif
+			g_h.funcs->_h_msleep(1);
+			SDIO_DRV_LOCK();
+		}
+
+		ret = sdio_write_to_slave(sdio_tx_aggr_buf,
+				(slot - sdio_tx_aggr_buf) + pos);
+		if (ret) {
+			SDIO_DRV_UNLOCK();
+			ESP_LOGE(TAG, "Unrecoverable host sdio state, reset host mcu");
+			g_h.funcs->_h_restart_host();
+			return;
+		}
+
+		sdio_tx_buf_count += buf_used;
+		sdio_tx_buf_count = sdio_tx_buf_count % ESP_TX_BUFFER_MAX;
+
+		SDIO_DRV_UNLOCK();
+#if ESP_PKT_STATS
+		pkt_stats.sta_tx_out += sta_pkts;
+#endif
+	}
+}
+#endif
+
 static void sdio_write_task(void const* pvParameters)
 {
 	uint16_t len = 0;
@@ -484,29 +809,32 @@ static void sdio_write_task(void const* pvParameters)
 	struct esp_payload_header * payload_header = NULL;
 	uint8_t * payload  = NULL;
 	interface_buffer_handle_t buf_handle = {0};
-	int retries = 0;
 
 	int ret = 0;
-	uint8_t *pos = NULL;
-	uint32_t data_left;
-	uint32_t len_to_send;
 	uint32_t buf_needed;
 	uint8_t tx_needed = 1;
 	uint8_t flag = 0;
+	uint16_t trailer_len = 0;
 
 	while (!sdio_start_write_thread)
 		g_h.funcs->_h_msleep(10);
 
+#if H_SDIO_TX_AGGREGATION
+	if (get_slave_ext_capabilities() & ESP_SDIO_RX_AGGREGATION_SUPPORT) {
+		sdio_tx_aggr_buf = MEM_ALLOC(H_SDIO_TX_AGGR_MAX_BUFS * ESP_RX_BUFFER_SIZE);
+		if (sdio_tx_aggr_buf)
+			ESP_LOGI(TAG, "SDIO Tx aggregation: up to %u slave buffers per transfer",
+					H_SDIO_TX_AGGR_MAX_BUFS);
+		else
+			ESP_LOGW(TAG, "No memory for SDIO Tx aggregation, using single packet transfers");
+	}
+#endif
+
 	for (;;) {
-		/* Check if higher layers have anything to transmit */
-		g_h.funcs->_h_get_semaphore(sem_to_slave_queue, HOSTED_BLOCK_MAX);
-
-		/* Tx msg is present as per sem */
-		if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_SERIAL], &buf_handle, 0))
-			if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_BT], &buf_handle, 0))
-				if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_OTHERS], &buf_handle, 0)) {
-					tx_needed = 0; /* No Tx msg */
-				}
+		/* Wait for higher layers to have anything to transmit */
+		tx_needed = 1;
+		if (sdio_dequeue_tx_pkt(&buf_handle, HOSTED_BLOCK_MAX))
+			tx_needed = 0; /* No Tx msg */
 
 		if (tx_needed) {
 			len = buf_handle.payload_len;
@@ -522,6 +850,13 @@ static void sdio_write_task(void const* pvParameters)
 			pkt_stats.sta_tx_trans_in++;
 #endif
 
+#if H_SDIO_TX_AGGREGATION
+		if (sdio_tx_aggr_buf && tx_needed) {
+			sdio_write_aggregated(&buf_handle);
+			continue;
+		}
+#endif
+
 		if (!buf_handle.payload_zcopy) {
 			sendbuf = sdio_buffer_alloc(MEMSET_REQUIRED);
 			assert(sendbuf);
@@ -539,10 +874,16 @@ static void sdio_write_task(void const* pvParameters)
 
 		if (buf_handle.payload_len > MAX_SDIO_BUFFER_SIZE - sizeof(struct esp_payload_header)) {
 			ESP_LOGE(TAG, "Pkt len [%u] > Max [%u]. Drop",
-					buf_handle.payload_len, MAX_SDIO_BUFFER_SIZE - sizeof(struct esp_payload_header));
+					buf_handle.payload_len, (unsigned int)(MAX_SDIO_BUFFER_SIZE - sizeof(struct esp_payload_header)));
 			goto done;
 		}
 
+		/* CRC32 trailer, if in use and it fits in */
+		trailer_len = 0;
+		if (is_transport_tx_crc32_enabled() &&
+		    (buf_handle.payload_len + H_ESP_PAYLOAD_CRC32_LEN <= MAX_PAYLOAD_SIZE))
+			trailer_len = H_ESP_PAYLOAD_CRC32_LEN;
+
 		/* Form Tx header */
 		payload_header = (struct esp_payload_header *) sendbuf;
 		payload  = sendbuf + sizeof(struct esp_payload_header);
@@ -553,6 +894,8 @@ static void sdio_write_task(void const* pvParameters)
 		payload_header->if_num = buf_handle.if_num;
 		payload_header->seq_num = htole16(buf_handle.seq_num);
 		payload_header->flags = buf_handle.flag;
+		if (trailer_len)
+			payload_header->flags |= FLAG_CRC32;
 
 		UPDATE_HEADER_TX_PKT_NO(payload_header);
 
@@ -570,12 +913,15 @@ static void sdio_write_task(void const* pvParameters)
 		if (!buf_handle.payload_zcopy)
 			g_h.funcs->_h_memcpy(payload, buf_handle.payload, len);
 
+		if (trailer_len)
+			esp_frame_crc32_fill(payload_header);
 #if H_SDIO_CHECKSUM
-		payload_header->checksum = htole16(compute_checksum(sendbuf,
-			sizeof(struct esp_payload_header) + len));
+		else
+			payload_header->checksum = htole16(compute_checksum(sendbuf,
+				sizeof(struct esp_payload_header) + len));
 #endif
 
-		buf_needed = (len + sizeof(struct esp_payload_header) + ESP_RX_BUFFER_SIZE - 1)
+		buf_needed = (len + sizeof(struct esp_payload_header) + trailer_len + ESP_RX_BUFFER_SIZE - 1)
 			/ ESP_RX_BUFFER_SIZE;
 
 		SDIO_DRV_LOCK();
@@ -590,48 +936,13 @@ static void sdio_write_task(void const* pvParameters)
 			goto unlock_done;
 		}
 
-		pos = sendbuf;
-		data_left = len + sizeof(struct esp_payload_header);
-
-		ESP_HEXLOGV("bus_TX", sendbuf, data_left, 32);
-
-		len_to_send = 0;
-		retries = 0;
-		do {
-			len_to_send = data_left;
-
-#if H_SDIO_TX_BLOCK_ONLY_XFER
-			/* Extend the transfer length to do block only transfers.
-			 * This is safe as slave only reads up to data_left, which
-			 * is not changed here. Rest of data is discarded by
-			 * slave.
-			 */
-			uint32_t block_send_len = ((len_to_send + ESP_BLOCK_SIZE - 1) / ESP_BLOCK_SIZE) * ESP_BLOCK_SIZE;
-
-			ret = g_h.funcs->_h_sdio_write_block(sdio_handle, ESP_SLAVE_CMD53_END_ADDR - data_left,
-				pos, block_send_len, ACQUIRE_LOCK);
-#else
-			ret = g_h.funcs->_h_sdio_write_block(sdio_handle, ESP_SLAVE_CMD53_END_ADDR - data_left,
-				pos, len_to_send, ACQUIRE_LOCK);
-#endif
-			if (ret) {
-				ESP_LOGE(TAG, "%s: %d: Failed to send data: %d %ld %ld", __func__,
-					retries, ret, len_to_send, data_left);
-				retries++;
-				if (retries < MAX_SDIO_WRITE_RETRY) {
-					ESP_LOGD(TAG, "retry");
-					continue;
-				} else {
-					SDIO_DRV_UNLOCK();
-					ESP_LOGE(TAG, "Unrecoverable host sdio state, reset host mcu");
-					g_h.funcs->_h_restart_host();
-					goto done;
-				}
-			}
-
-			data_left -= len_to_send;
-			pos += len_to_send;
-		} while (data_left);
+		ret = sdio_write_to_slave(sendbuf, len + sizeof(struct esp_payload_header) + trailer_len);
+		if (ret) {
+			SDIO_DRV_UNLOCK();
+			ESP_LOGE(TAG, "Unrecoverable host sdio state, reset host mcu");
+			g_h.funcs->_h_restart_host();
+			goto done;
+		}
 
 		sdio_tx_buf_count += buf_needed;
 		sdio_tx_buf_count = sdio_tx_buf_count % ESP_TX_BUFFER_MAX;
@@ -659,6 +970,7 @@ static int is_valid_sdio_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_t
 #if H_SDIO_CHECKSUM
 	uint16_t rx_checksum = 0, checksum = 0;
 #endif
+	uint16_t trailer_len = 0;
 	uint8_t is_wakeup_pkt = 0;
 
 	UPDATE_HEADER_RX_PKT_NO(h);
@@ -668,6 +980,7 @@ static int is_valid_sdio_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_t
 	/* Fetch length and offset from payload header */
 	len = le16toh(h->len);
 	offset = le16toh(h->offset);
+	trailer_len = esp_frame_trailer_len(h);
 	is_wakeup_pkt = h->flags & FLAG_WAKEUP_PKT;
 
 	if (is_wakeup_pkt && len<1500) {
@@ -676,7 +989,7 @@ static int is_valid_sdio_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_t
 	}
 
 	if ((!len) ||
-		(len > MAX_PAYLOAD_SIZE) ||
+		(len + trailer_len > MAX_PAYLOAD_SIZE) ||
 		(offset != sizeof(struct esp_payload_header))) {
 
 		/* Free up buffer, as one of following -
@@ -688,22 +1001,30 @@ static int is_valid_sdio_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_t
 
 		if (len) {
 			ESP_LOGE(TAG, "len[%u]>max[%u] OR offset[%u] != exp[%u], Drop",
-				len, MAX_PAYLOAD_SIZE, offset, sizeof(struct esp_payload_header));
+				len, (unsigned int)(MAX_PAYLOAD_SIZE - trailer_len), offset, (unsigned int)sizeof(struct esp_payload_header));
 		}
 
 		return 0;
 
 	}
 
+	if (h->flags & FLAG_CRC32) {
+		if (esp_frame_crc32_verify(h)) {
+			ESP_LOGE(TAG, "SDIO RX CRC32 mismatch. Drop.");
+			return 0;
+		}
+	}
 #if H_SDIO_CHECKSUM
-	rx_checksum = le16toh(h->checksum);
-	h->checksum = 0;
-	checksum = compute_checksum((uint8_t*)h, len + offset);
+	else {
+		rx_checksum = le16toh(h->checksum);
+		h->checksum = 0;
+		checksum = compute_checksum((uint8_t*)h, len + offset);
 
-	if (checksum != rx_checksum) {
-		ESP_LOGE(TAG, "SDIO RX rx_chksum[%u] != checksum[%u]. Drop.",
-				checksum, rx_checksum);
-		return 0;
+		if (checksum != rx_checksum) {
+			ESP_LOGE(TAG, "SDIO RX rx_chksum[%u] != checksum[%u]. Drop.",
+					checksum, rx_checksum);
+			return 0;
+		}
 	}
 #endif
 
@@ -712,6 +1033,11 @@ static int is_valid_sdio_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_t
 		pkt_stats.sta_rx_in++;
 #endif
 
+#if H_SDIO_TX_CREDIT
+	if ((h->flags & FLAG_TX_CREDIT) && H_HDR_CAN_CARRY_TX_CREDIT(h))
+		sdio_tx_credit_hint = H_HDR_GET_TX_CREDIT(h) | SDIO_TX_CREDIT_VALID;
+#endif
+
 	*len_a = len;
 	*offset_a = offset;
 
@@ -827,7 +1153,7 @@ static uint8_t * sdio_rx_get_buffer(uint32_t len)
 		*buf = (uint8_t *)MEM_ALLOC(len);
 		assert(*buf);
 		double_buf.buffer[index].buf_size = len;
-		ESP_LOGD(TAG, "buf %d size: %ld", index, double_buf.buffer[index].buf_size);
+		ESP_LOGD(TAG, "buf %d size: %" PRIu32, index, double_buf.buffer[index].buf_size);
 	}
 	return *buf;
 }
@@ -859,9 +1185,10 @@ static esp_err_t sdio_push_data_to_queue(uint8_t * buf, uint32_t buf_len)
 		pkt_rxbuff = sdio_buffer_alloc(MEMSET_REQUIRED);
 		assert(pkt_rxbuff);
 
-		packet_size = len + offset;
+		packet_size = len + offset +
+			esp_frame_trailer_len((struct esp_payload_header *)buf);
 		if (packet_size > buf_len) {
-			ESP_LOGE(TAG, "packet size[%lu]>[%lu] too big for remaining stream data",
+			ESP_LOGE(TAG, "packet size[%" PRIu32 "]>[%" PRIu32 "] too big for remaining stream data",
 					packet_size, buf_len);
 			return ESP_FAIL;
 		}
@@ -1070,12 +1397,12 @@ static void sdio_read_task(void const* pvParameters)
 		ret = sdio_get_len_from_slave(&len_from_slave, ACQUIRE_LOCK);
 #endif
 		if (ret || !len_from_slave) {
-			ESP_LOGW(TAG, "invalid ret or len_from_slave: %d %ld", ret, len_from_slave);
+			ESP_LOGW(TAG, "invalid ret or len_from_slave: %d %" PRIu32, ret, len_from_slave);
 
 			SDIO_DRV_UNLOCK();
 			continue;
 		} else {
-			ESP_LOGD(TAG, "len_from_slave: %ld", len_from_slave);
+			ESP_LOGD(TAG, "len_from_slave: %" PRIu32, len_from_slave);
 		}
 #endif
 
@@ -1104,7 +1431,7 @@ static void sdio_read_task(void const* pvParameters)
 					pos, len_to_read, ACQUIRE_LOCK);
 #endif
 			if (ret) {
-				ESP_LOGE(TAG, "%s: Failed to read data - %d %ld %ld",
+				ESP_LOGE(TAG, "%s: Failed to read data - %d %" PRIu32 " %" PRIu32,
 					__func__, ret, len_to_read, data_left);
 				sdio_rx_free_buffer(rxbuff);
 				break;
@@ -1138,11 +1465,15 @@ static void sdio_read_task(void const* pvParameters)
 	}
 }
 
+static int sdio_rx_q_pop(void *ctx, uint8_t prio_q, interface_buffer_handle_t *buf_handle)
+{
+	return g_h.funcs->_h_dequeue_item(from_slave_queue[prio_q], buf_handle, 0);
+}
+
 static void sdio_process_rx_task(void const* pvParameters)
 {
 	interface_buffer_handle_t buf_handle_l = {0};
 	interface_buffer_handle_t *buf_handle = NULL;
-	int ret = 0;
 
 	struct esp_priv_event *event = NULL;
 
@@ -1157,12 +1488,10 @@ static void sdio_process_rx_task(void const* pvParameters)
 	while (1) {
 		g_h.funcs->_h_get_semaphore(sem_from_slave_queue, HOSTED_BLOCK_MAX);
 
-		if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_SERIAL], &buf_handle_l, 0))
-			if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_BT], &buf_handle_l, 0))
-				if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_OTHERS], &buf_handle_l, 0)) {
-					ESP_LOGI(TAG, "No element in any queue found");
-					continue;
-				}
+		if (prio_q_sched_dequeue(&rx_sched, sdio_rx_q_pop, NULL, &buf_handle_l)) {
+			ESP_LOGI(TAG, "No element in any queue found");
+			continue;
+		}
 
 		buf_handle = &buf_handle_l;
 
@@ -1175,31 +1504,11 @@ static void sdio_process_rx_task(void const* pvParameters)
 			serial_rx_handler(buf_handle);
 		} else if((buf_handle->if_type == ESP_STA_IF) ||
 				(buf_handle->if_type == ESP_AP_IF)) {
-#if 1
-			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				/* TODO : Need to abstract heap_caps_malloc */
-				uint8_t * copy_payload = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len);
-				assert(copy_payload);
-				assert(buf_handle->payload_len);
-				assert(buf_handle->payload);
-				memcpy(copy_payload, buf_handle->payload, buf_handle->payload_len);
-				H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
-
 #if ESP_PKT_STATS
-				if (buf_handle->if_type == ESP_STA_IF)
-					pkt_stats.sta_rx_out++;
-#endif
-				ret = chan_arr[buf_handle->if_type]->rx(chan_arr[buf_handle->if_type]->api_chan,
-						copy_payload, copy_payload, buf_handle->payload_len);
-				if (unlikely(ret))
-					HOSTED_FREE(copy_payload);
-			}
-#else
-			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				chan_arr[buf_handle->if_type]->rx(chan_arr[buf_handle->if_type]->api_chan,
-						buf_handle->payload, NULL, buf_handle->payload_len);
-			}
+			if (buf_handle->if_type == ESP_STA_IF)
+				pkt_stats.sta_rx_out++;
 #endif
+			wifi_rx_handler(buf_handle);
 		} else if (buf_handle->if_type == ESP_PRIV_IF) {
 			ESP_LOGI(TAG, "Received ESP_PRIV_IF type message");
 			process_priv_communication(buf_handle);
@@ -1246,9 +1555,10 @@ void *bus_init_internal(void)
 	sdio_bus_lock = g_h.funcs->_h_create_mutex();
 	assert(sdio_bus_lock);
 
-	sem_to_slave_queue = g_h.funcs->_h_create_semaphore(TO_SLAVE_QUEUE_SIZE*MAX_PRIORITY_QUEUES);
-	assert(sem_to_slave_queue);
-	g_h.funcs->_h_get_semaphore(sem_to_slave_queue, 0);
+	to_slave_ring = g_h.funcs->_h_create_tx_ring(MAX_PRIORITY_QUEUES, TO_SLAVE_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
+	assert(to_slave_ring);
+	prio_q_sched_init(&tx_sched);
+	prio_q_sched_init(&rx_sched);
 
 	sem_from_slave_queue = g_h.funcs->_h_create_semaphore(FROM_SLAVE_QUEUE_SIZE*MAX_PRIORITY_QUEUES);
 	assert(sem_from_slave_queue);
@@ -1261,10 +1571,6 @@ void *bus_init_internal(void)
 		/* Queue - rx */
 		from_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(FROM_SLAVE_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
 		assert(from_slave_queue[prio_q_idx]);
-
-		/* Queue - tx */
-		to_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(TO_SLAVE_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
-		assert(to_slave_queue[prio_q_idx]);
 	}
 
 	sdio_mempool_create();
@@ -1333,7 +1639,7 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 
 	if (!payload_buf || !payload_len || (payload_len > MAX_PAYLOAD_SIZE) || !transport_up) {
 		ESP_LOGE(TAG, "tx fail: NULL buff, invalid len (%u) or len > max len (%u), transport_up(%u))",
-				payload_len, MAX_PAYLOAD_SIZE, transport_up);
+				payload_len, (unsigned int)MAX_PAYLOAD_SIZE, transport_up);
 		H_FREE_PTR_WITH_FUNC(free_func, buffer_to_free);
 		return ESP_FAIL;
 	}
@@ -1357,8 +1663,7 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 		pkt_stats.sta_tx_in_pass++;
 #endif
 
-	g_h.funcs->_h_queue_item(to_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
-	g_h.funcs->_h_post_semaphore(sem_to_slave_queue);
+	g_h.funcs->_h_tx_ring_push(to_slave_ring, pkt_prio, &buf_handle, HOSTED_BLOCK_MAX);
 
 
 	return ESP_OK;
@@ -21,6 +21,7 @@
 #include "esp_hosted_power_save.h"
 #include "esp_hosted_transport_config.h"
 #include "esp_hosted_bt.h"
+#include "prio_q_sched.h"
 
 DEFINE_LOG_TAG(spi);
 
@@ -42,13 +43,21 @@ static struct mempool * buf_mp_g;
 static void * spi_bus_lock;
 
 /* Queue declaration */
-static queue_handle_t to_slave_queue[MAX_PRIORITY_QUEUES];
-semaphore_handle_t sem_to_slave_queue;
+static void * to_slave_ring;
+static prio_q_sched_t tx_sched;
 static queue_handle_t from_slave_queue[MAX_PRIORITY_QUEUES];
 semaphore_handle_t sem_from_slave_queue;
+static prio_q_sched_t rx_sched;
 
 static void * spi_rx_thread;
 
+#if H_SPI_PIPELINE
+/* Buffers for next transaction, prepared while current one is on the bus */
+static uint8_t *staged_txbuff = NULL;
+static void (*staged_tx_free_func)(void* ptr) = NULL;
+static uint8_t *staged_rxbuff = NULL;
+#endif
+
 
 /** function declaration **/
 /** Exported functions **/
@@ -194,6 +203,17 @@ void bus_deinit_internal(void *bus_handle)
 		spi_trans_ready_sem = NULL;
 	}
 
+#if H_SPI_PIPELINE
+	if (staged_txbuff) {
+		H_FREE_PTR_WITH_FUNC(staged_tx_free_func, staged_txbuff);
+		staged_tx_free_func = NULL;
+	}
+	if (staged_rxbuff) {
+		spi_buffer_free(staged_rxbuff);
+		staged_rxbuff = NULL;
+	}
+#endif
+
 	/* Destroy memory pool */
 	spi_mempool_destroy();
 
@@ -203,11 +223,11 @@ void bus_deinit_internal(void *bus_handle)
 			g_h.funcs->_h_destroy_queue(from_slave_queue[prio_q_idx]);
 			from_slave_queue[prio_q_idx] = NULL;
 		}
+	}
 
-		if (to_slave_queue[prio_q_idx]) {
-			g_h.funcs->_h_destroy_queue(to_slave_queue[prio_q_idx]);
-			to_slave_queue[prio_q_idx] = NULL;
-		}
+	if (to_slave_ring) {
+		g_h.funcs->_h_destroy_tx_ring(to_slave_ring);
+		to_slave_ring = NULL;
 	}
 
 	/* Delete semaphores for queues */
@@ -216,11 +236,6 @@ void bus_deinit_internal(void *bus_handle)
 		sem_from_slave_queue = NULL;
 	}
 
-	if (sem_to_slave_queue) {
-		g_h.funcs->_h_destroy_semaphore(sem_to_slave_queue);
-		sem_to_slave_queue = NULL;
-	}
-
 	/* Delete mutex */
 	if (spi_bus_lock) {
 		g_h.funcs->_h_destroy_mutex(spi_bus_lock);
@@ -243,9 +258,10 @@ void *bus_init_internal(void)
 	assert(spi_bus_lock);
 
 
-	sem_to_slave_queue = g_h.funcs->_h_create_semaphore(TO_SLAVE_QUEUE_SIZE*MAX_PRIORITY_QUEUES);
-	assert(sem_to_slave_queue);
-	g_h.funcs->_h_get_semaphore(sem_to_slave_queue, 0);
+	to_slave_ring = g_h.funcs->_h_create_tx_ring(MAX_PRIORITY_QUEUES, TO_SLAVE_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
+	assert(to_slave_ring);
+	prio_q_sched_init(&tx_sched);
+	prio_q_sched_init(&rx_sched);
 	sem_from_slave_queue = g_h.funcs->_h_create_semaphore(FROM_SLAVE_QUEUE_SIZE*MAX_PRIORITY_QUEUES);
 	assert(sem_from_slave_queue);
 	g_h.funcs->_h_get_semaphore(sem_from_slave_queue, 0);
@@ -254,10 +270,6 @@ void *bus_init_internal(void)
 		/* Queue - rx */
 		from_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(FROM_SLAVE_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
 		assert(from_slave_queue[prio_q_idx]);
-
-		/* Queue - tx */
-		to_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(TO_SLAVE_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
-		assert(to_slave_queue[prio_q_idx]);
 	}
 
 	spi_mempool_create();
@@ -303,6 +315,7 @@ static int process_spi_rx_buf(uint8_t * rxbuff)
 	int ret = 0;
 	uint8_t pkt_prio = PRIO_Q_OTHERS;
 	uint8_t is_wakeup_pkt = 0;
+	uint8_t frame_ok = 0;
 
 	if (!rxbuff)
 		return -1;
@@ -331,10 +344,10 @@ static int process_spi_rx_buf(uint8_t * rxbuff)
 		goto done;
 	}
 
-	if ((len > MAX_PAYLOAD_SIZE) ||
+	if ((len + esp_frame_trailer_len(h) > MAX_PAYLOAD_SIZE) ||
 		(offset != sizeof(struct esp_payload_header))) {
 		ESP_LOGI(TAG, "rx packet ignored: len [%u], rcvd_offset[%u], exp_offset[%u]\n",
-				len, offset, sizeof(struct esp_payload_header));
+				len, offset, (unsigned int)sizeof(struct esp_payload_header));
 
 		/* 1. no payload to process
 		 * 2. input packet size > driver capacity
@@ -346,12 +359,17 @@ static int process_spi_rx_buf(uint8_t * rxbuff)
 
 	} else {
 		dr_isr_triggered = 0;
-		rx_checksum = le16toh(h->checksum);
-		h->checksum = 0;
+		if (h->flags & FLAG_CRC32) {
+			frame_ok = !esp_frame_crc32_verify(h);
+		} else {
+			rx_checksum = le16toh(h->checksum);
+			h->checksum = 0;
 
-		checksum = compute_checksum(rxbuff, len+offset);
+			checksum = compute_checksum(rxbuff, len+offset);
+			frame_ok = (checksum == rx_checksum);
+		}
 		//TODO: checksum needs to be configurable from menuconfig
-		if (checksum == rx_checksum) {
+		if (frame_ok) {
 			buf_handle.priv_buffer_handle = rxbuff;
 			buf_handle.free_buf_handle = spi_buffer_free;
 			buf_handle.payload_len = len;
@@ -382,7 +400,10 @@ static int process_spi_rx_buf(uint8_t * rxbuff)
 			g_h.funcs->_h_post_semaphore(sem_from_slave_queue);
 
 		} else {
-			ESP_LOGI(TAG, "rcvd_crc[%u] != exp_crc[%u], drop pkt\n",checksum, rx_checksum);
+			if (h->flags & FLAG_CRC32)
+				ESP_LOGI(TAG, "CRC32 mismatch, drop pkt\n");
+			else
+				ESP_LOGI(TAG, "rcvd_crc[%u] != exp_crc[%u], drop pkt\n",checksum, rx_checksum);
 			ret = -4;
 			goto done;
 		}
@@ -403,6 +424,62 @@ done:
 	return ret;
 }
 
+static uint8_t * take_next_tx_buffer(uint8_t *is_valid_tx_buf, void (**free_func)(void* ptr))
+{
+	uint8_t *txbuff = NULL;
+
+#if H_SPI_PIPELINE
+	if (staged_txbuff) {
+		txbuff = staged_txbuff;
+		*free_func = staged_tx_free_func;
+		*is_valid_tx_buf = 1;
+		staged_txbuff = NULL;
+		staged_tx_free_func = NULL;
+		return txbuff;
+	}
+#endif
+	return get_next_tx_buffer(is_valid_tx_buf, free_func);
+}
+
+static uint8_t * take_rx_buffer(void)
+{
+	uint8_t *rxbuff = NULL;
+
+#if H_SPI_PIPELINE
+	if (staged_rxbuff) {
+		rxbuff = staged_rxbuff;
+		staged_rxbuff = NULL;
+		return rxbuff;
+	}
+#endif
+	rxbuff = spi_buffer_alloc(MEMSET_REQUIRED);
+	assert(rxbuff);
+#if H_MEM_STATS
+	h_stats_g.spi_mem_stats.rx_alloc++;
+#endif
+	return rxbuff;
+}
+
+#if H_SPI_PIPELINE
+/* Called while a transaction is on the bus. Rx buffer is always staged,
+ * Tx buffer only if something is queued to send by now */
+static void stage_next_transaction(void)
+{
+	uint8_t is_valid_tx_buf = 0;
+
+	if (!staged_rxbuff) {
+		staged_rxbuff = spi_buffer_alloc(MEMSET_REQUIRED);
+#if H_MEM_STATS
+		if (staged_rxbuff)
+			h_stats_g.spi_mem_stats.rx_alloc++;
+#endif
+	}
+
+	if (!staged_txbuff)
+		staged_txbuff = get_next_tx_buffer(&is_valid_tx_buf, &staged_tx_free_func);
+}
+#endif
+
 static int check_and_execute_spi_transaction(void)
 {
 	uint8_t *txbuff = NULL;
@@ -432,7 +509,7 @@ static int check_and_execute_spi_transaction(void)
 	if (gpio_handshake == H_HS_VAL_ACTIVE) {
 
 		/* Get next tx buffer to be sent */
-		txbuff = get_next_tx_buffer(&is_valid_tx_buf, &tx_buff_free_func);
+		txbuff = take_next_tx_buffer(&is_valid_tx_buf, &tx_buff_free_func);
 
 		if ( (data_ready_active) ||
 				(is_valid_tx_buf) || schedule_dummy_tx || schedule_dummy_rx ) {
@@ -458,12 +535,7 @@ static int check_and_execute_spi_transaction(void)
 
 			ESP_LOGD(TAG, "dr %u tx_valid %u\n", gpio_rx_data_ready, is_valid_tx_buf);
 			/* Allocate rx buffer */
-			rxbuff = spi_buffer_alloc(MEMSET_REQUIRED);
-			assert(rxbuff);
-			//heap_caps_dump_all();
-#if H_MEM_STATS
-			h_stats_g.spi_mem_stats.rx_alloc++;
-#endif
+			rxbuff = take_rx_buffer();
 
 			spi_trans.tx_buf = txbuff;
 			spi_trans.tx_buf_size = MAX_SPI_BUFFER_SIZE;
@@ -480,7 +552,15 @@ static int check_and_execute_spi_transaction(void)
 			 * a. A valid tx buffer to be transmitted towards slave
 			 * b. Slave wants to send something (Rx for host)
 			 */
+#if H_SPI_PIPELINE
+			ret = g_h.funcs->_h_queue_bus_transfer(&spi_trans);
+			if (!ret) {
+				stage_next_transaction();
+				ret = g_h.funcs->_h_wait_bus_transfer();
+			}
+#else
 			ret = g_h.funcs->_h_do_bus_transfer(&spi_trans);
+#endif
 
 			if (!ret)
 				process_spi_rx_buf(spi_trans.rx_buf);
@@ -498,6 +578,10 @@ static int check_and_execute_spi_transaction(void)
 	}
 	if ((gpio_handshake != H_HS_VAL_ACTIVE) || schedule_dummy_tx || schedule_dummy_rx)
 		g_h.funcs->_h_post_semaphore(spi_trans_ready_sem);
+#if H_SPI_PIPELINE
+	else if (staged_txbuff)
+		g_h.funcs->_h_post_semaphore(spi_trans_ready_sem);
+#endif
 
 	g_h.funcs->_h_unlock_mutex(spi_bus_lock);
 
@@ -529,7 +613,7 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 	if ((flags == 0 || flags == MORE_FRAGMENT) &&
 	     (!payload_buf || !payload_len || (payload_len > MAX_PAYLOAD_SIZE))) {
 		ESP_LOGE(TAG, "write fail: buff(%p) 0? OR (0<len(%u)<=max_poss_len(%u))?",
-				 payload_buf, payload_len, MAX_PAYLOAD_SIZE);
+				 payload_buf, payload_len, (unsigned int)MAX_PAYLOAD_SIZE);
 		H_FREE_PTR_WITH_FUNC(free_func, buffer_to_free);
 		return -1;
 	}
@@ -551,8 +635,7 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 		pkt_prio = PRIO_Q_BT;
 	/* else OTHERS by default */
 
-	g_h.funcs->_h_queue_item(to_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
-	g_h.funcs->_h_post_semaphore(sem_to_slave_queue);
+	g_h.funcs->_h_tx_ring_push(to_slave_ring, pkt_prio, &buf_handle, HOSTED_BLOCK_MAX);
 
 #if ESP_PKT_STATS
 	if (buf_handle.if_type == ESP_STA_IF)
@@ -621,22 +704,24 @@ static void spi_transaction_task(void const* pvParameters)
   * @param  argument: Not used
   * @retval None
   */
+static int spi_rx_q_pop(void *ctx, uint8_t prio_q, interface_buffer_handle_t *buf_handle)
+{
+	return g_h.funcs->_h_dequeue_item(from_slave_queue[prio_q], buf_handle, 0);
+}
+
 static void spi_process_rx_task(void const* pvParameters)
 {
 	interface_buffer_handle_t buf_handle_l = {0};
 	interface_buffer_handle_t *buf_handle = NULL;
-	int ret = 0;
 
 	while (1) {
 
 		g_h.funcs->_h_get_semaphore(sem_from_slave_queue, HOSTED_BLOCK_MAX);
 
-		if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_SERIAL], &buf_handle_l, 0))
-			if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_BT], &buf_handle_l, 0))
-				if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_OTHERS], &buf_handle_l, 0)) {
-					ESP_LOGI(TAG, "No element in any queue found");
-					continue;
-				}
+		if (prio_q_sched_dequeue(&rx_sched, spi_rx_q_pop, NULL, &buf_handle_l)) {
+			ESP_LOGI(TAG, "No element in any queue found");
+			continue;
+		}
 
 		buf_handle = &buf_handle_l;
 
@@ -652,26 +737,7 @@ static void spi_process_rx_task(void const* pvParameters)
 		} else if((buf_handle->if_type == ESP_STA_IF) ||
 				(buf_handle->if_type == ESP_AP_IF)) {
 			schedule_dummy_rx = 1;
-#if 1
-			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				/* TODO : Need to abstract heap_caps_malloc */
-				uint8_t * copy_payload = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len);
-				assert(copy_payload);
-				memcpy(copy_payload, buf_handle->payload, buf_handle->payload_len);
-				H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
-
-				ret = chan_arr[buf_handle->if_type]->rx(chan_arr[buf_handle->if_type]->api_chan,
-						copy_payload, copy_payload, buf_handle->payload_len);
-				if (unlikely(ret))
-					HOSTED_FREE(copy_payload);
-			}
-#else
-
-			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				chan_arr[buf_handle->if_type]->rx(chan_arr[buf_handle->if_type]->api_chan,
-						buf_handle->payload, NULL, buf_handle->payload_len);
-			}
-#endif
+			wifi_rx_handler(buf_handle);
 		} else if (buf_handle->if_type == ESP_PRIV_IF) {
 			process_priv_communication(buf_handle);
 			hci_drv_show_configuration();
@@ -737,23 +803,15 @@ static uint8_t * get_next_tx_buffer(uint8_t *is_valid_tx_buf, void (**free_func)
 	*is_valid_tx_buf = 0;
 
 	/* Check if higher layers have anything to transmit, non blocking.
-	 * If nothing is expected to send, queue receive will fail.
+	 * If nothing is expected to send, ring pop will fail.
 	 * In that case only payload header with zero payload
 	 * length would be transmitted.
 	 */
+	if (prio_q_sched_tx_ring_pop(&tx_sched, to_slave_ring, &buf_handle, 0))
+		tx_needed = 0; /* No Tx msg */
 
-	if (!g_h.funcs->_h_get_semaphore(sem_to_slave_queue, 0)) {
-
-		/* Tx msg is present as per sem */
-		if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_SERIAL], &buf_handle, 0))
-			if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_BT], &buf_handle, 0))
-				if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_OTHERS], &buf_handle, 0)) {
-					tx_needed = 0; /* No Tx msg */
-				}
-
-		if (tx_needed)
-			len = buf_handle.payload_len;
-	}
+	if (tx_needed)
+		len = buf_handle.payload_len;
 
 	if (buf_handle.flag || len) {
 		/* Continue transfer if flag or buffer is valid */
@@ -790,6 +848,10 @@ static uint8_t * get_next_tx_buffer(uint8_t *is_valid_tx_buf, void (**free_func)
 		payload_header->if_type = buf_handle.if_type;
 		payload_header->if_num  = buf_handle.if_num;
 		payload_header->flags   = buf_handle.flag;
+		/* SPI transfers are of fixed size, trailer needs to fit in */
+		if (is_transport_tx_crc32_enabled() &&
+		    (len + H_ESP_PAYLOAD_CRC32_LEN <= MAX_PAYLOAD_SIZE))
+			payload_header->flags |= FLAG_CRC32;
 
 		if (payload_header->if_type == ESP_HCI_IF) {
 			// special handling for HCI
@@ -808,8 +870,11 @@ static uint8_t * get_next_tx_buffer(uint8_t *is_valid_tx_buf, void (**free_func)
 		}
 
 		//TODO: checksum should be configurable from menuconfig
-		payload_header->checksum = htole16(compute_checksum(sendbuf,
-				sizeof(struct esp_payload_header)+len));
+		if (payload_header->flags & FLAG_CRC32)
+			esp_frame_crc32_fill(payload_header);
+		else
+			payload_header->checksum = htole16(compute_checksum(sendbuf,
+					sizeof(struct esp_payload_header)+len));
 	}
 
 done:
@@ -25,6 +25,7 @@
 #include "esp_hosted_power_save.h"
 #include "esp_hosted_transport_config.h"
 #include "esp_hosted_bt.h"
+#include "prio_q_sched.h"
 
 static const char TAG[] = "H_SPI_HD_DRV";
 
@@ -81,10 +82,11 @@ static void * spi_hd_read_thread;
 static void * spi_hd_process_rx_thread;
 static void * spi_hd_write_thread;
 
-static queue_handle_t to_slave_queue[MAX_PRIORITY_QUEUES];
-static semaphore_handle_t sem_to_slave_queue;
+static void * to_slave_ring;
+static prio_q_sched_t tx_sched;
 static queue_handle_t from_slave_queue[MAX_PRIORITY_QUEUES];
 static semaphore_handle_t sem_from_slave_queue;
+static prio_q_sched_t rx_sched;
 static semaphore_handle_t spi_hd_data_ready_sem;
 
 /* Counter to hold the amount of buffers already sent to spi hd slave */
@@ -192,7 +194,6 @@ static int spi_hd_write_packet(interface_buffer_handle_t *buf_handle);
 static void spi_hd_write_task(void const* pvParameters)
 {
 	interface_buffer_handle_t buf_handle = {0};
-	uint8_t tx_needed = 1;
 
 	while (!spi_hd_start_write_thread)
 		g_h.funcs->_h_msleep(10);
@@ -200,18 +201,9 @@ static void spi_hd_write_task(void const* pvParameters)
 	ESP_LOGD(TAG, "spi_hd_write_task: write thread started");
 
 	for (;;) {
-		/* Check if higher layers have anything to transmit */
-		g_h.funcs->_h_get_semaphore(sem_to_slave_queue, HOSTED_BLOCK_MAX);
-
-		/* Tx msg is present as per sem */
-		if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_SERIAL], &buf_handle, 0))
-			if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_BT], &buf_handle, 0))
-				if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_OTHERS], &buf_handle, 0)) {
-					tx_needed = 0; /* No Tx msg */
-				}
-
-		if (!tx_needed)
-			continue;
+		/* Wait for higher layers to have anything to transmit */
+		if (prio_q_sched_tx_ring_pop(&tx_sched, to_slave_ring, &buf_handle, HOSTED_BLOCK_MAX))
+			continue; /* No Tx msg */
 
 		/* Send the packet */
 		spi_hd_write_packet(&buf_handle);
@@ -232,6 +224,7 @@ static int spi_hd_write_packet(interface_buffer_handle_t *buf_handle)
 	int ret = 0;
 	uint32_t data_left;
 	uint32_t buf_needed;
+	uint16_t trailer_len = 0;
 	int result = ESP_OK;
 
 	if (unlikely(!buf_handle))
@@ -263,6 +256,11 @@ static int spi_hd_write_packet(interface_buffer_handle_t *buf_handle)
 		goto done;
 	}
 
+	/* CRC32 trailer, if in use and it fits in */
+	if (is_transport_tx_crc32_enabled() &&
+	    (buf_handle->payload_len + H_ESP_PAYLOAD_CRC32_LEN <= MAX_PAYLOAD_SIZE))
+		trailer_len = H_ESP_PAYLOAD_CRC32_LEN;
+
 	/* Form Tx header */
 	payload_header = (struct esp_payload_header *) sendbuf;
 	payload  = sendbuf + sizeof(struct esp_payload_header);
@@ -273,6 +271,8 @@ static int spi_hd_write_packet(interface_buffer_handle_t *buf_handle)
 	payload_header->if_num = buf_handle->if_num;
 	payload_header->seq_num = htole16(buf_handle->seq_num);
 	payload_header->flags = buf_handle->flag;
+	if (trailer_len)
+		payload_header->flags |= FLAG_CRC32;
 
 	if (payload_header->if_type == ESP_HCI_IF) {
 		// special handling for HCI
@@ -290,12 +290,15 @@ static int spi_hd_write_packet(interface_buffer_handle_t *buf_handle)
 		}
 	}
 
+	if (trailer_len)
+		esp_frame_crc32_fill(payload_header);
 #if H_SPI_HD_CHECKSUM
-	payload_header->checksum = htole16(compute_checksum(sendbuf,
-		sizeof(struct esp_payload_header) + len));
+	else
+		payload_header->checksum = htole16(compute_checksum(sendbuf,
+			sizeof(struct esp_payload_header) + len));
 #endif
 
-	buf_needed = (len + sizeof(struct esp_payload_header) + MAX_SPI_HD_BUFFER_SIZE - 1)
+	buf_needed = (len + sizeof(struct esp_payload_header) + trailer_len + MAX_SPI_HD_BUFFER_SIZE - 1)
 		/ MAX_SPI_HD_BUFFER_SIZE;
 
 	SPI_HD_DRV_LOCK();
@@ -307,7 +310,7 @@ static int spi_hd_write_packet(interface_buffer_handle_t *buf_handle)
 		goto unlock_done;
 	}
 
-	data_left = len + sizeof(struct esp_payload_header);
+	data_left = len + sizeof(struct esp_payload_header) + trailer_len;
 
 	ESP_HEXLOGD("h_spi_hd_tx", sendbuf, data_left, 32);
 
@@ -353,7 +356,7 @@ static int is_valid_spi_hd_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_
 	offset = le16toh(h->offset);
 
 	if ((!len) ||
-		(len > MAX_PAYLOAD_SIZE) ||
+		(len + esp_frame_trailer_len(h) > MAX_PAYLOAD_SIZE) ||
 		(offset != sizeof(struct esp_payload_header))) {
 
 		/* Free up buffer, as one of following -
@@ -366,15 +369,23 @@ static int is_valid_spi_hd_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_
 
 	}
 
+	if (h->flags & FLAG_CRC32) {
+		if (esp_frame_crc32_verify(h)) {
+			ESP_LOGE(TAG, "SPI_HD RX CRC32 mismatch. Drop.");
+			return 0;
+		}
+	}
 #if H_SPI_HD_CHECKSUM
-	rx_checksum = le16toh(h->checksum);
-	h->checksum = 0;
-	checksum = compute_checksum((uint8_t*)h, len + offset);
-
-	if (checksum != rx_checksum) {
-		ESP_LOGE(TAG, "SPI_HD RX rx_chksum[%u] != checksum[%u]. Drop.",
-				checksum, rx_checksum);
-		return 0;
+	else {
+		rx_checksum = le16toh(h->checksum);
+		h->checksum = 0;
+		checksum = compute_checksum((uint8_t*)h, len + offset);
+
+		if (checksum != rx_checksum) {
+			ESP_LOGE(TAG, "SPI_HD RX rx_chksum[%u] != checksum[%u]. Drop.",
+					checksum, rx_checksum);
+			return 0;
+		}
 	}
 #endif
 
@@ -608,11 +619,15 @@ static void spi_hd_read_task(void const* pvParameters)
 	}
 }
 
+static int spi_hd_rx_q_pop(void *ctx, uint8_t prio_q, interface_buffer_handle_t *buf_handle)
+{
+	return g_h.funcs->_h_dequeue_item(from_slave_queue[prio_q], buf_handle, 0);
+}
+
 static void spi_hd_process_rx_task(void const* pvParameters)
 {
 	interface_buffer_handle_t buf_handle_l = {0};
 	interface_buffer_handle_t *buf_handle = NULL;
-	int ret = 0;
 
 	struct esp_priv_event *event = NULL;
 
@@ -629,12 +644,10 @@ static void spi_hd_process_rx_task(void const* pvParameters)
 	while (1) {
 		g_h.funcs->_h_get_semaphore(sem_from_slave_queue, HOSTED_BLOCK_MAX);
 
-		if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_SERIAL], &buf_handle_l, 0))
-			if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_BT], &buf_handle_l, 0))
-				if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_OTHERS], &buf_handle_l, 0)) {
-					ESP_LOGI(TAG, "No element in any queue found");
-					continue;
-				}
+		if (prio_q_sched_dequeue(&rx_sched, spi_hd_rx_q_pop, NULL, &buf_handle_l)) {
+			ESP_LOGI(TAG, "No element in any queue found");
+			continue;
+		}
 
 		buf_handle = &buf_handle_l;
 
@@ -646,27 +659,7 @@ static void spi_hd_process_rx_task(void const* pvParameters)
 			serial_rx_handler(buf_handle);
 		} else if((buf_handle->if_type == ESP_STA_IF) ||
 				(buf_handle->if_type == ESP_AP_IF)) {
-#if 1
-			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				/* TODO : Need to abstract heap_caps_malloc */
-				uint8_t * copy_payload = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len);
-				assert(copy_payload);
-				assert(buf_handle->payload_len);
-				assert(buf_handle->payload);
-				memcpy(copy_payload, buf_handle->payload, buf_handle->payload_len);
-				H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
-
-				ret = chan_arr[buf_handle->if_type]->rx(chan_arr[buf_handle->if_type]->api_chan,
-						copy_payload, copy_payload, buf_handle->payload_len);
-				if (unlikely(ret))
-					HOSTED_FREE(copy_payload);
-			}
-#else
-			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				chan_arr[buf_handle->if_type]->rx(chan_arr[buf_handle->if_type]->api_chan,
-						buf_handle->payload, NULL, buf_handle->payload_len);
-			}
-#endif
+			wifi_rx_handler(buf_handle);
 		} else if (buf_handle->if_type == ESP_PRIV_IF) {
 			process_priv_communication(buf_handle);
 			hci_drv_show_configuration();
@@ -712,9 +705,10 @@ void * bus_init_internal(void)
 
 	SPI_HD_DRV_LOCK_CREATE();
 
-	sem_to_slave_queue = g_h.funcs->_h_create_semaphore(H_SPI_HD_TX_QUEUE_SIZE * MAX_PRIORITY_QUEUES);
-	assert(sem_to_slave_queue);
-	g_h.funcs->_h_get_semaphore(sem_to_slave_queue, 0);
+	to_slave_ring = g_h.funcs->_h_create_tx_ring(MAX_PRIORITY_QUEUES, H_SPI_HD_TX_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
+	assert(to_slave_ring);
+	prio_q_sched_init(&tx_sched);
+	prio_q_sched_init(&rx_sched);
 
 	sem_from_slave_queue = g_h.funcs->_h_create_semaphore(H_SPI_HD_RX_QUEUE_SIZE * MAX_PRIORITY_QUEUES);
 	assert(sem_from_slave_queue);
@@ -729,10 +723,6 @@ void * bus_init_internal(void)
 		/* Queue - rx */
 		from_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(H_SPI_HD_RX_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
 		assert(from_slave_queue[prio_q_idx]);
-
-		/* Queue - tx */
-		to_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(H_SPI_HD_TX_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
-		assert(to_slave_queue[prio_q_idx]);
 	}
 
 	spi_hd_mempool_create();
@@ -782,19 +772,14 @@ void bus_deinit_internal(void *bus_handle)
 			g_h.funcs->_h_destroy_queue(from_slave_queue[prio_q_idx]);
 			from_slave_queue[prio_q_idx] = NULL;
 		}
-
-		if (to_slave_queue[prio_q_idx]) {
-			g_h.funcs->_h_destroy_queue(to_slave_queue[prio_q_idx]);
-			to_slave_queue[prio_q_idx] = NULL;
-		}
 	}
 
-	/* Clean up semaphores */
-	if (sem_to_slave_queue) {
-		g_h.funcs->_h_destroy_semaphore(sem_to_slave_queue);
-		sem_to_slave_queue = NULL;
+	if (to_slave_ring) {
+		g_h.funcs->_h_destroy_tx_ring(to_slave_ring);
+		to_slave_ring = NULL;
 	}
 
+	/* Clean up semaphores */
 	if (sem_from_slave_queue) {
 		g_h.funcs->_h_destroy_semaphore(sem_from_slave_queue);
 		sem_from_slave_queue = NULL;
@@ -864,8 +849,7 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 	else if (buf_handle.if_type == ESP_HCI_IF)
 		pkt_prio = PRIO_Q_BT;
 
-	g_h.funcs->_h_queue_item(to_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
-	g_h.funcs->_h_post_semaphore(sem_to_slave_queue);
+	g_h.funcs->_h_tx_ring_push(to_slave_ring, pkt_prio, &buf_handle, HOSTED_BLOCK_MAX);
 
 #if ESP_PKT_STATS
 	if (buf_handle.if_type == ESP_STA_IF)
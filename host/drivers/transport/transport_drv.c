@@ -49,6 +49,8 @@
 
 DEFINE_LOG_TAG(transport);
 static char chip_type = ESP_PRIV_FIRMWARE_CHIP_UNRECOGNIZED;
+static uint32_t slave_ext_cap = 0;
+static uint8_t tx_crc32_enabled = 0;
 void(*transport_esp_hosted_up_cb)(void) = NULL;
 transport_channel_t *chan_arr[ESP_MAX_IF];
 volatile uint8_t wifi_tx_throttling;
@@ -59,6 +61,9 @@ static volatile uint8_t transport_state = TRANSPORT_INACTIVE;
 
 static void process_event(uint8_t *evt_buf, uint16_t len);
 static int process_init_event(uint8_t *evt_buf, uint16_t len);
+#if H_WIFI_TX_ZEROCOPY
+static void tx_zc_init(void);
+#endif
 
 
 #if H_HOST_RESTART_NO_COMMUNICATION_WITH_SLAVE && H_HOST_RESTART_NO_COMMUNICATION_WITH_SLAVE_TIMEOUT != -1
@@ -71,6 +76,16 @@ static void init_timeout_cb(void *arg)
 }
 #endif
 
+uint32_t get_slave_ext_capabilities(void)
+{
+	return slave_ext_cap;
+}
+
+uint8_t is_transport_tx_crc32_enabled(void)
+{
+	return tx_crc32_enabled;
+}
+
 uint8_t is_transport_rx_ready(void)
 {
 	return (transport_state >= TRANSPORT_RX_ACTIVE);
@@ -124,6 +139,9 @@ static void transport_drv_init(void)
 		H_SLAVE_UDP_REMOTE_PORT_RANGE_START, H_SLAVE_UDP_REMOTE_PORT_RANGE_END);
 #endif
 	hci_drv_init();
+#if H_WIFI_TX_ZEROCOPY
+	tx_zc_init();
+#endif
 }
 
 esp_err_t teardown_transport(void)
@@ -253,10 +271,188 @@ static void transport_serial_free_cb(void *buf)
 	mempool_free(chan_arr[ESP_SERIAL_IF]->memp, buf);
 }
 
-static esp_err_t transport_drv_sta_tx(void *h, void *buffer, size_t len)
+#if H_WIFI_TX_ZEROCOPY
+/* Zero-copy Tx
+ *
+ * Buffers handed out by esp_hosted_alloc_tx_buffer() are blocks of one slab,
+ * allocated once, each laid out as
+ *   [tx_zc_tag][room for esp_payload_header][frame]
+ * When the frame address comes back to sta/ap tx, the header is written in
+ * front of it and the block is queued as is. The tag counts users: the glue
+ * until it frees the buffer, plus the transport while the frame is queued.
+ * Only the slab range is checked to tell these frames apart, never memory
+ * in front of some other buffer.
+ */
+#define TX_ZC_TAG_LEN                    MEMPOOL_ALIGNMENT_BYTES
+#define TX_ZC_BLOCK_SIZE                 ((TX_ZC_TAG_LEN + MAX_TRANSPORT_BUFFER_SIZE + \
+                                          MEMPOOL_ALIGNMENT_MASK) & ~MEMPOOL_ALIGNMENT_MASK)
+#define TX_ZC_FRAME_OFFSET               (TX_ZC_TAG_LEN + H_ESP_PAYLOAD_HEADER_OFFSET)
+
+struct tx_zc_tag {
+	uint16_t refs;
+	uint16_t idx;
+};
+
+_Static_assert(sizeof(struct tx_zc_tag) <= TX_ZC_TAG_LEN, "tx_zc_tag must fit in its room");
+
+static struct {
+	uint8_t *slab;
+	void *lock;
+	uint16_t num_free;
+	uint16_t free_idx[H_WIFI_TX_ZEROCOPY_BUFS];
+} tx_zc;
+
+static void tx_zc_init(void)
+{
+	uint16_t i = 0;
+
+	if (tx_zc.slab)
+		return;
+
+	tx_zc.slab = g_h.funcs->_h_malloc_align(H_WIFI_TX_ZEROCOPY_BUFS * TX_ZC_BLOCK_SIZE,
+			MEMPOOL_ALIGNMENT_BYTES);
+	if (!tx_zc.slab) {
+		ESP_LOGW(TAG, "No memory for zero-copy Tx buffers, Tx always copies");
+		return;
+	}
+	tx_zc.lock = g_h.funcs->_h_create_lock_mempool();
+	assert(tx_zc.lock);
+
+	for (i = 0; i < H_WIFI_TX_ZEROCOPY_BUFS; i++)
+		tx_zc.free_idx[i] = i;
+	tx_zc.num_free = H_WIFI_TX_ZEROCOPY_BUFS;
+}
+
+static inline struct tx_zc_tag *tx_zc_tag_of(uint8_t *ptr, uint32_t offset)
+{
+	return (struct tx_zc_tag *)(ptr - offset);
+}
+
+/* Tag of a frame address handed out by esp_hosted_alloc_tx_buffer(),
+ * NULL for any other address */
+static struct tx_zc_tag *tx_zc_tag_of_frame(void *frame)
+{
+	uint8_t *p = frame;
+
+	if (!tx_zc.slab || p < tx_zc.slab ||
+	    p >= tx_zc.slab + H_WIFI_TX_ZEROCOPY_BUFS * TX_ZC_BLOCK_SIZE)
+		return NULL;
+
+	if ((p - tx_zc.slab) % TX_ZC_BLOCK_SIZE != TX_ZC_FRAME_OFFSET)
+		return NULL;
+
+	return tx_zc_tag_of(p, TX_ZC_FRAME_OFFSET);
+}
+
+static void tx_zc_put(struct tx_zc_tag *tag)
+{
+	g_h.funcs->_h_lock_mempool(tx_zc.lock);
+	assert(tag->refs);
+	if (!--tag->refs)
+		tx_zc.free_idx[tx_zc.num_free++] = tag->idx;
+	g_h.funcs->_h_unlock_mempool(tx_zc.lock);
+}
+
+void *esp_hosted_alloc_tx_buffer(size_t len)
+{
+	struct tx_zc_tag *tag = NULL;
+
+	if (!tx_zc.slab || len > MAX_PAYLOAD_SIZE)
+		return NULL;
+
+	g_h.funcs->_h_lock_mempool(tx_zc.lock);
+	if (tx_zc.num_free) {
+		uint16_t idx = tx_zc.free_idx[--tx_zc.num_free];
+
+		tag = (struct tx_zc_tag *)(tx_zc.slab + idx * TX_ZC_BLOCK_SIZE);
+		tag->idx = idx;
+		tag->refs = 1;
+	}
+	g_h.funcs->_h_unlock_mempool(tx_zc.lock);
+
+	if (!tag)
+		return NULL;
+	return (uint8_t *)tag + TX_ZC_FRAME_OFFSET;
+}
+
+void esp_hosted_free_tx_buffer(void *buffer)
+{
+	struct tx_zc_tag *tag = NULL;
+
+	if (!buffer)
+		return;
+
+	tag = tx_zc_tag_of_frame(buffer);
+	if (!tag) {
+		ESP_LOGE(TAG, "%p is not a zero-copy Tx buffer, not freed", buffer);
+		return;
+	}
+	tx_zc_put(tag);
+}
+
+/* free_buf_func of zero-copy Tx, called with the header address */
+static void tx_zc_free_cb(void *buf)
 {
-	void * copy_buff = NULL;
+	tx_zc_put(tx_zc_tag_of(buf, TX_ZC_TAG_LEN));
+}
+
+/* Header address to send 'frame' from, NULL if it has to be copied:
+ * not one of ours, or still queued (e.g. lwIP retransmit) */
+static uint8_t *tx_zc_claim(void *frame)
+{
+	struct tx_zc_tag *tag = NULL;
+	uint8_t *hdr = NULL;
 
+	tag = tx_zc_tag_of_frame(frame);
+	if (!tag)
+		return NULL;
+
+	g_h.funcs->_h_lock_mempool(tx_zc.lock);
+	if (tag->refs == 1) {
+		tag->refs++;
+		hdr = (uint8_t *)frame - H_ESP_PAYLOAD_HEADER_OFFSET;
+	}
+	g_h.funcs->_h_unlock_mempool(tx_zc.lock);
+
+	return hdr;
+}
+#else
+void *esp_hosted_alloc_tx_buffer(size_t len)
+{
+	return NULL;
+}
+
+void esp_hosted_free_tx_buffer(void *buffer)
+{
+}
+#endif
+
+/* Queue a Wi-Fi frame, in place if possible, else copied behind header room */
+static esp_err_t transport_drv_wifi_tx(uint8_t if_type, void *buffer, size_t len,
+		void (*free_cb)(void *buf))
+{
+	uint8_t *sendbuf = NULL;
+
+#if H_WIFI_TX_ZEROCOPY
+	sendbuf = tx_zc_claim(buffer);
+	if (sendbuf) {
+		g_h.funcs->_h_memset(sendbuf, 0, H_ESP_PAYLOAD_HEADER_OFFSET);
+		return esp_hosted_tx(if_type, 0, sendbuf, len, H_BUFF_ZEROCOPY, sendbuf, tx_zc_free_cb, 0);
+	}
+#endif
+
+	/* Prepare transport buffer directly consumable.
+	 * Only the header needs zeroing, frame is copied over the rest */
+	sendbuf = mempool_alloc(((struct mempool*)chan_arr[if_type]->memp), MAX_TRANSPORT_BUFFER_SIZE, false);
+	assert(sendbuf);
+	g_h.funcs->_h_memset(sendbuf, 0, H_ESP_PAYLOAD_HEADER_OFFSET);
+	g_h.funcs->_h_memcpy(sendbuf+H_ESP_PAYLOAD_HEADER_OFFSET, buffer, len);
+
+	return esp_hosted_tx(if_type, 0, sendbuf, len, H_BUFF_ZEROCOPY, sendbuf, free_cb, 0);
+}
+
+static esp_err_t transport_drv_sta_tx(void *h, void *buffer, size_t len)
+{
 	if (!buffer || !len)
 		return ESP_OK;
 
@@ -275,29 +471,17 @@ static esp_err_t transport_drv_sta_tx(void *h, void *buffer, size_t len)
 
 	assert(h && h==chan_arr[ESP_STA_IF]->api_chan);
 
-	/*  Prepare transport buffer directly consumable */
-	copy_buff = mempool_alloc(((struct mempool*)chan_arr[ESP_STA_IF]->memp), MAX_TRANSPORT_BUFFER_SIZE, true);
-	assert(copy_buff);
-	g_h.funcs->_h_memcpy(copy_buff+H_ESP_PAYLOAD_HEADER_OFFSET, buffer, len);
-
-	return esp_hosted_tx(ESP_STA_IF, 0, copy_buff, len, H_BUFF_ZEROCOPY, copy_buff, transport_sta_free_cb, 0);
+	return transport_drv_wifi_tx(ESP_STA_IF, buffer, len, transport_sta_free_cb);
 }
 
 static esp_err_t transport_drv_ap_tx(void *h, void *buffer, size_t len)
 {
-	void * copy_buff = NULL;
-
 	if (!buffer || !len)
 		return ESP_OK;
 
 	assert(h && h==chan_arr[ESP_AP_IF]->api_chan);
 
-	/*  Prepare transport buffer directly consumable */
-	copy_buff = mempool_alloc(((struct mempool*)chan_arr[ESP_AP_IF]->memp), MAX_TRANSPORT_BUFFER_SIZE, true);
-	assert(copy_buff);
-	g_h.funcs->_h_memcpy(copy_buff+H_ESP_PAYLOAD_HEADER_OFFSET, buffer, len);
-
-	return esp_hosted_tx(ESP_AP_IF, 0, copy_buff, len, H_BUFF_ZEROCOPY, copy_buff, transport_ap_free_cb, 0);
+	return transport_drv_wifi_tx(ESP_AP_IF, buffer, len, transport_ap_free_cb);
 }
 
 esp_err_t transport_drv_serial_tx(void *h, void *buffer, size_t len)
@@ -447,13 +631,20 @@ static void print_ext_capabilities(uint8_t * ptr)
 	if (cap & ESP_BT_VHCI_UART_SUPPORT)
 		ESP_LOGI(TAG, "\t * BT over UART (VHCI)");
 #elif H_USB_HOST_TRANSPORT
-	if (cap & ESP_WLAN_USB_SUPPORT)
+	if (cap & ESP_WLAN_USB_EXT_SUPPORT)
 		ESP_LOGI(TAG, "\t * WLAN over USB");
 	if (cap & ESP_BT_VHCI_USB_SUPPORT)
 		ESP_LOGI(TAG, "\t * BT over USB (VHCI)");
+#elif H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	if (cap & ESP_SDIO_RX_AGGREGATION_SUPPORT)
+		ESP_LOGI(TAG, "\t * SDIO Rx aggregation");
+	if (cap & ESP_SDIO_TX_CREDIT_SUPPORT)
+		ESP_LOGI(TAG, "\t * SDIO Tx credits in Rx header");
 #else
 	ESP_LOGI(TAG, "\t No extended features. capabilities[%" PRIu32 "]", cap);
 #endif
+	if (cap & ESP_TRANSPORT_CRC32_SUPPORT)
+		ESP_LOGI(TAG, "\t * CRC32 frame integrity");
 }
 
 static void process_event(uint8_t *evt_buf, uint16_t len)
@@ -676,6 +867,7 @@ static int process_init_event(uint8_t *evt_buf, uint16_t len)
 	uint8_t len_left = len, tag_len;
 	uint8_t *pos;
 	uint8_t raw_tp_config = H_TEST_RAW_TP_DIR;
+	uint8_t host_cap = 0;
 	uint32_t ext_cap = 0;
 	uint32_t slave_fw_version = 0;
 
@@ -760,6 +952,8 @@ static int process_init_event(uint8_t *evt_buf, uint16_t len)
 		ESP_LOGI(TAG, "ESP board type is : %d \n\r", chip_type);
 	}
 
+	slave_ext_cap = ext_cap;
+
 	if (ext_cap) {
 #if H_SPI_HD_HOST_INTERFACE
 		// reconfigure SPI_HD interface based on host and slave capabilities
@@ -791,7 +985,27 @@ static int process_init_event(uint8_t *evt_buf, uint16_t len)
 
 	transport_driver_event_handler(TRANSPORT_TX_ACTIVE);
 
-	ESP_ERROR_CHECK(send_slave_config(0, chip_type, raw_tp_config,
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+  #if H_SDIO_HOST_RX_MODE == H_SDIO_HOST_STREAMING_MODE
+	/* slave can then send multiple packets in one SDIO transfer */
+	host_cap |= ESP_HOST_CAP_SDIO_RX_STREAM;
+  #endif
+#endif
+
+#if H_TRANSPORT_CRC32
+	/* slave checks CRC32 on any frame flagged with it,
+	 * so frames to slave can carry it right away */
+	if (ext_cap & ESP_TRANSPORT_CRC32_SUPPORT) {
+		ESP_LOGI(TAG, "Using CRC32 frame integrity");
+		host_cap |= ESP_HOST_CAP_CRC32;
+		tx_crc32_enabled = 1;
+	} else {
+		ESP_LOGW(TAG, "Slave does not support CRC32 frame integrity");
+		tx_crc32_enabled = 0;
+	}
+#endif
+
+	ESP_ERROR_CHECK(send_slave_config(host_cap, chip_type, raw_tp_config,
 		H_WIFI_TX_DATA_THROTTLE_LOW_THRESHOLD,
 		H_WIFI_TX_DATA_THROTTLE_HIGH_THRESHOLD));
 
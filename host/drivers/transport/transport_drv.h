@@ -88,6 +88,8 @@ typedef struct {
 	void *memp;
 } transport_channel_t;
 
+extern transport_channel_t *chan_arr[ESP_MAX_IF];
+
 
 esp_err_t setup_transport(void(*esp_hosted_up_cb)(void));
 esp_err_t teardown_transport(void);
@@ -108,6 +110,8 @@ esp_err_t send_slave_config(uint8_t host_cap, uint8_t firmware_chip_id,
 
 uint8_t is_transport_rx_ready(void);
 uint8_t is_transport_tx_ready(void);
+uint32_t get_slave_ext_capabilities(void);
+uint8_t is_transport_tx_crc32_enabled(void);
 
 #define H_BUFF_NO_ZEROCOPY 0
 #define H_BUFF_ZEROCOPY 1
@@ -122,6 +126,7 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 		uint8_t *buffer_to_free, void (*free_buf_func)(void *ptr), uint8_t flags);
 
 int serial_rx_handler(interface_buffer_handle_t * buf_handle);
+int wifi_rx_handler(interface_buffer_handle_t * buf_handle);
 void set_transport_state(uint8_t state);
 
 int ensure_slave_bus_ready(void *bus_handle);
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Wi-Fi Rx delivery from transport to the registered netif channel.
+ * Kept apart from transport_drv.c so the POSIX port can build and
+ * benchmark it without the rest of the driver.
+ */
+
+#include "transport_drv.h"
+#include "esp_hosted_transport.h"
+#include "esp_hosted_config.h"
+#include "os_wrapper.h"
+
+#if H_WIFI_RX_ZEROCOPY
+/* In zero-copy Rx, the transport buffer is handed over to the netif as is.
+ * The esp_payload_header at the start of the buffer is already consumed by
+ * then, so it is re-used to remember how the buffer is to be released.
+ */
+struct rx_buf_owner {
+	void (*free_func)(void *buf);
+};
+
+_Static_assert(sizeof(struct rx_buf_owner) <= H_ESP_PAYLOAD_HEADER_OFFSET,
+		"rx_buf_owner must fit in esp_payload_header");
+
+void esp_hosted_free_rx_buffer(void *buff_to_free)
+{
+	struct rx_buf_owner *owner = (struct rx_buf_owner *)buff_to_free;
+
+	if (!owner)
+		return;
+
+	if (owner->free_func)
+		owner->free_func(buff_to_free);
+	else
+		g_h.funcs->_h_free(buff_to_free);
+}
+#else
+void esp_hosted_free_rx_buffer(void *buff_to_free)
+{
+	HOSTED_FREE(buff_to_free);
+}
+#endif
+
+int wifi_rx_handler(interface_buffer_handle_t * buf_handle)
+{
+	transport_channel_t *chan = NULL;
+	int ret = ESP_FAIL;
+
+	if (!buf_handle || !buf_handle->payload || !buf_handle->payload_len)
+		return ESP_FAIL;
+
+	chan = chan_arr[buf_handle->if_type];
+	if (!chan || !chan->rx)
+		return ESP_FAIL;
+
+#if H_WIFI_RX_ZEROCOPY
+	assert(buf_handle->priv_buffer_handle);
+	((struct rx_buf_owner *)buf_handle->priv_buffer_handle)->free_func =
+		buf_handle->free_buf_handle;
+
+	ret = chan->rx(chan->api_chan, buf_handle->payload,
+			buf_handle->priv_buffer_handle, buf_handle->payload_len);
+	if (likely(!ret)) {
+		/* netif owns the buffer now, released once lwIP is done */
+		buf_handle->priv_buffer_handle = NULL;
+		buf_handle->payload_zcopy = H_BUFF_ZEROCOPY;
+	}
+#else
+	uint8_t * copy_payload = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len);
+	assert(copy_payload);
+	g_h.funcs->_h_memcpy(copy_payload, buf_handle->payload, buf_handle->payload_len);
+	H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
+
+	ret = chan->rx(chan->api_chan, copy_payload, copy_payload, buf_handle->payload_len);
+	if (unlikely(ret))
+		HOSTED_FREE(copy_payload);
+#endif
+
+	return ret;
+}
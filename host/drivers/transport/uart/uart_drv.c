@@ -19,6 +19,7 @@
 #include "esp_hosted_transport_config.h"
 #include "power_save_drv.h"
 #include "esp_hosted_bt.h"
+#include "prio_q_sched.h"
 
 static const char TAG[] = "H_UART_DRV";
 
@@ -40,10 +41,11 @@ static void * h_uart_process_rx_task_info;
 
 static void * uart_handle = NULL;
 
-static queue_handle_t to_slave_queue[MAX_PRIORITY_QUEUES];
-static semaphore_handle_t sem_to_slave_queue;
+static void * to_slave_ring;
+static prio_q_sched_t tx_sched;
 static queue_handle_t from_slave_queue[MAX_PRIORITY_QUEUES];
 static semaphore_handle_t sem_from_slave_queue;
+static prio_q_sched_t rx_sched;
 
 // one-time trigger to start write thread
 static bool uart_start_write_thread = false;
@@ -83,6 +85,7 @@ static int h_uart_write_packet(interface_buffer_handle_t *buf_handle)
 	struct esp_payload_header * payload_header = NULL;
 	int tx_len_to_send;
 	int tx_len;
+	uint16_t trailer_len = 0;
 	int result = ESP_OK;
 
 	if (unlikely(!buf_handle))
@@ -109,11 +112,16 @@ static int h_uart_write_packet(interface_buffer_handle_t *buf_handle)
 
 	if (buf_handle->payload_len > MAX_UART_BUFFER_SIZE - sizeof(struct esp_payload_header)) {
 		ESP_LOGE(TAG, "Pkt len [%u] > Max [%u]. Drop",
-				buf_handle->payload_len, MAX_UART_BUFFER_SIZE - sizeof(struct esp_payload_header));
+				buf_handle->payload_len, (unsigned int)(MAX_UART_BUFFER_SIZE - sizeof(struct esp_payload_header)));
 		result = ESP_FAIL;
 		goto done;
 	}
 
+	/* CRC32 trailer, if in use and it fits in */
+	if (is_transport_tx_crc32_enabled() &&
+	    (buf_handle->payload_len + H_ESP_PAYLOAD_CRC32_LEN <= MAX_PAYLOAD_SIZE))
+		trailer_len = H_ESP_PAYLOAD_CRC32_LEN;
+
 	/* Form Tx header */
 	payload_header = (struct esp_payload_header *) sendbuf;
 	payload  = sendbuf + sizeof(struct esp_payload_header);
@@ -124,6 +132,8 @@ static int h_uart_write_packet(interface_buffer_handle_t *buf_handle)
 	payload_header->if_num = buf_handle->if_num;
 	payload_header->seq_num = htole16(buf_handle->seq_num);
 	payload_header->flags = buf_handle->flag;
+	if (trailer_len)
+		payload_header->flags |= FLAG_CRC32;
 
 	if (payload_header->if_type == ESP_HCI_IF) {
 		// special handling for HCI
@@ -141,12 +151,15 @@ static int h_uart_write_packet(interface_buffer_handle_t *buf_handle)
 		}
 	}
 
+	if (trailer_len)
+		esp_frame_crc32_fill(payload_header);
 #if H_UART_CHECKSUM
-	payload_header->checksum = htole16(compute_checksum(sendbuf,
-		sizeof(struct esp_payload_header) + len));
+	else
+		payload_header->checksum = htole16(compute_checksum(sendbuf,
+			sizeof(struct esp_payload_header) + len));
 #endif
 
-	tx_len_to_send = len + sizeof(struct esp_payload_header);
+	tx_len_to_send = len + sizeof(struct esp_payload_header) + trailer_len;
 	tx_len = g_h.funcs->_h_uart_write(uart_handle, sendbuf, tx_len_to_send);
 	if (tx_len != tx_len_to_send) {
 		ESP_LOGE(TAG, "failed to send uart data");
@@ -172,7 +185,6 @@ done:
 static void h_uart_write_task(void const* pvParameters)
 {
 	interface_buffer_handle_t buf_handle = {0};
-	uint8_t tx_needed = 1;
 
 	while (!uart_start_write_thread)
 		g_h.funcs->_h_msleep(10);
@@ -180,18 +192,9 @@ static void h_uart_write_task(void const* pvParameters)
 	ESP_LOGD(TAG, "h_uart_write_task: write thread started");
 
 	while (1) {
-		/* Check if higher layers have anything to transmit */
-		g_h.funcs->_h_get_semaphore(sem_to_slave_queue, HOSTED_BLOCK_MAX);
-
-		/* Tx msg is present as per sem */
-		if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_SERIAL], &buf_handle, 0))
-			if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_BT], &buf_handle, 0))
-				if (g_h.funcs->_h_dequeue_item(to_slave_queue[PRIO_Q_OTHERS], &buf_handle, 0)) {
-					tx_needed = 0; /* No Tx msg */
-				}
-
-		if (!tx_needed)
-			continue;
+		/* Wait for higher layers to have anything to transmit */
+		if (prio_q_sched_tx_ring_pop(&tx_sched, to_slave_ring, &buf_handle, HOSTED_BLOCK_MAX))
+			continue; /* No Tx msg */
 
 		/* Send the packet */
 		h_uart_write_packet(&buf_handle);
@@ -216,11 +219,15 @@ static int update_flow_ctrl(uint8_t *rxbuff)
 }
 #endif
 
+static int h_uart_rx_q_pop(void *ctx, uint8_t prio_q, interface_buffer_handle_t *buf_handle)
+{
+	return g_h.funcs->_h_dequeue_item(from_slave_queue[prio_q], buf_handle, 0);
+}
+
 static void h_uart_process_rx_task(void const* pvParameters)
 {
 	interface_buffer_handle_t buf_handle_l = {0};
 	interface_buffer_handle_t *buf_handle = NULL;
-	int ret = 0;
 
 	struct esp_priv_event *event = NULL;
 
@@ -234,12 +241,10 @@ static void h_uart_process_rx_task(void const* pvParameters)
 	while (1) {
 		g_h.funcs->_h_get_semaphore(sem_from_slave_queue, HOSTED_BLOCK_MAX);
 
-		if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_SERIAL], &buf_handle_l, 0))
-			if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_BT], &buf_handle_l, 0))
-				if (g_h.funcs->_h_dequeue_item(from_slave_queue[PRIO_Q_OTHERS], &buf_handle_l, 0)) {
-					ESP_LOGI(TAG, "No element in any queue found");
-					continue;
-				}
+		if (prio_q_sched_dequeue(&rx_sched, h_uart_rx_q_pop, NULL, &buf_handle_l)) {
+			ESP_LOGI(TAG, "No element in any queue found");
+			continue;
+		}
 
 		buf_handle = &buf_handle_l;
 
@@ -250,27 +255,7 @@ static void h_uart_process_rx_task(void const* pvParameters)
 			serial_rx_handler(buf_handle);
 		} else if((buf_handle->if_type == ESP_STA_IF) ||
 				(buf_handle->if_type == ESP_AP_IF)) {
-#if 1
-			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				/* TODO : Need to abstract heap_caps_malloc */
-				uint8_t * copy_payload = (uint8_t *)g_h.funcs->_h_malloc(buf_handle->payload_len);
-				assert(copy_payload);
-				assert(buf_handle->payload_len);
-				assert(buf_handle->payload);
-				memcpy(copy_payload, buf_handle->payload, buf_handle->payload_len);
-				H_FREE_PTR_WITH_FUNC(buf_handle->free_buf_handle, buf_handle->priv_buffer_handle);
-
-				ret = chan_arr[buf_handle->if_type]->rx(chan_arr[buf_handle->if_type]->api_chan,
-						copy_payload, copy_payload, buf_handle->payload_len);
-				if (unlikely(ret))
-					HOSTED_FREE(copy_payload);
-			}
-#else
-			if (chan_arr[buf_handle->if_type] && chan_arr[buf_handle->if_type]->rx) {
-				chan_arr[buf_handle->if_type]->rx(chan_arr[buf_handle->if_type]->api_chan,
-						buf_handle->payload, NULL, buf_handle->payload_len);
-			}
-#endif
+			wifi_rx_handler(buf_handle);
 		} else if (buf_handle->if_type == ESP_PRIV_IF) {
 			process_priv_communication(buf_handle);
 			hci_drv_show_configuration();
@@ -358,7 +343,7 @@ static int is_valid_uart_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_t
 	offset = le16toh(h->offset);
 
 	if ((!len) ||
-		(len > MAX_PAYLOAD_SIZE) ||
+		(len + esp_frame_trailer_len(h) > MAX_PAYLOAD_SIZE) ||
 		(offset != sizeof(struct esp_payload_header))) {
 
 		/* Free up buffer, as one of following -
@@ -370,15 +355,23 @@ static int is_valid_uart_rx_packet(uint8_t *rxbuff_a, uint16_t *len_a, uint16_t
 		return 0;
 	}
 
+	if (h->flags & FLAG_CRC32) {
+		if (esp_frame_crc32_verify(h)) {
+			ESP_LOGE(TAG, "UART RX CRC32 mismatch. Drop.");
+			return 0;
+		}
+	}
 #if H_UART_CHECKSUM
-	rx_checksum = le16toh(h->checksum);
-	h->checksum = 0;
-	checksum = compute_checksum((uint8_t*)h, len + offset);
-
-	if (checksum != rx_checksum) {
-		ESP_LOGE(TAG, "UART RX rx_chksum[%u] != checksum[%u]. Drop.",
-				checksum, rx_checksum);
-		return 0;
+	else {
+		rx_checksum = le16toh(h->checksum);
+		h->checksum = 0;
+		checksum = compute_checksum((uint8_t*)h, len + offset);
+
+		if (checksum != rx_checksum) {
+			ESP_LOGE(TAG, "UART RX rx_chksum[%u] != checksum[%u]. Drop.",
+					checksum, rx_checksum);
+			return 0;
+		}
 	}
 #endif
 
@@ -404,6 +397,7 @@ static void h_uart_read_task(void const* pvParameters)
 #endif
 	int bytes_read;
 	int total_len;
+	uint16_t trailer_len;
 	uint8_t * rxbuff = NULL;
 
 	// wait for transport to be in ready
@@ -435,16 +429,17 @@ static void h_uart_read_task(void const* pvParameters)
 
 		len = le16toh(header->len);
 		offset = le16toh(header->offset);
-		total_len = len + sizeof(struct esp_payload_header);
+		trailer_len = esp_frame_trailer_len(header);
+		total_len = len + sizeof(struct esp_payload_header) + trailer_len;
 		if (total_len > MAX_UART_BUFFER_SIZE) {
 			ESP_LOGE(TAG, "incoming data too big: %d", total_len);
 			continue;
 		}
 
-		// get the data
-		bytes_read = g_h.funcs->_h_uart_read(uart_handle, &uart_scratch_buf[offset], len);
+		// get the data, and CRC32 trailer if any
+		bytes_read = g_h.funcs->_h_uart_read(uart_handle, &uart_scratch_buf[offset], len + trailer_len);
 		ESP_LOGD(TAG, "Read %d bytes (payload)", bytes_read);
-		if (bytes_read < len) {
+		if (bytes_read < len + trailer_len) {
 			ESP_LOGE(TAG, "Failed to read payload");
 			continue;
 		}
@@ -489,9 +484,10 @@ void *bus_init_internal(void)
 {
 	uint8_t prio_q_idx = 0;
 
-	sem_to_slave_queue = g_h.funcs->_h_create_semaphore(H_UART_TX_QUEUE_SIZE*MAX_PRIORITY_QUEUES);
-	assert(sem_to_slave_queue);
-	g_h.funcs->_h_get_semaphore(sem_to_slave_queue, 0);
+	to_slave_ring = g_h.funcs->_h_create_tx_ring(MAX_PRIORITY_QUEUES, H_UART_TX_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
+	assert(to_slave_ring);
+	prio_q_sched_init(&tx_sched);
+	prio_q_sched_init(&rx_sched);
 
 	sem_from_slave_queue = g_h.funcs->_h_create_semaphore(H_UART_RX_QUEUE_SIZE*MAX_PRIORITY_QUEUES);
 	assert(sem_from_slave_queue);
@@ -501,10 +497,6 @@ void *bus_init_internal(void)
 		/* Queue - rx */
 		from_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(H_UART_RX_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
 		assert(from_slave_queue[prio_q_idx]);
-
-		/* Queue - tx */
-		to_slave_queue[prio_q_idx] = g_h.funcs->_h_create_queue(H_UART_TX_QUEUE_SIZE, sizeof(interface_buffer_handle_t));
-		assert(to_slave_queue[prio_q_idx]);
 	}
 
 	h_uart_mempool_create();
@@ -553,7 +545,7 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 	if ((flags == 0 || flags == MORE_FRAGMENT) &&
 	     (!payload_buf || !payload_len || (payload_len > MAX_PAYLOAD_SIZE) || !transport_up)) {
 		ESP_LOGE(TAG, "tx fail: NULL buff, invalid len (%u) or len > max len (%u), transport_up(%u))",
-				payload_len, MAX_PAYLOAD_SIZE, transport_up);
+				payload_len, (unsigned int)MAX_PAYLOAD_SIZE, transport_up);
 		H_FREE_PTR_WITH_FUNC(free_func, buffer_to_free);
 		return ESP_FAIL;
 	}
@@ -572,8 +564,7 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 	else if (buf_handle.if_type == ESP_HCI_IF)
 		pkt_prio = PRIO_Q_BT;
 
-	g_h.funcs->_h_queue_item(to_slave_queue[pkt_prio], &buf_handle, HOSTED_BLOCK_MAX);
-	g_h.funcs->_h_post_semaphore(sem_to_slave_queue);
+	g_h.funcs->_h_tx_ring_push(to_slave_ring, pkt_prio, &buf_handle, HOSTED_BLOCK_MAX);
 
 #if ESP_PKT_STATS
 	if (buf_handle.if_type == ESP_STA_IF)
@@ -609,19 +600,14 @@ void bus_deinit_internal(void *bus_handle)
 			g_h.funcs->_h_destroy_queue(from_slave_queue[prio_q_idx]);
 			from_slave_queue[prio_q_idx] = NULL;
 		}
-
-		if (to_slave_queue[prio_q_idx]) {
-			g_h.funcs->_h_destroy_queue(to_slave_queue[prio_q_idx]);
-			to_slave_queue[prio_q_idx] = NULL;
-		}
 	}
 
-	/* Clean up semaphores */
-	if (sem_to_slave_queue) {
-		g_h.funcs->_h_destroy_semaphore(sem_to_slave_queue);
-		sem_to_slave_queue = NULL;
+	if (to_slave_ring) {
+		g_h.funcs->_h_destroy_tx_ring(to_slave_ring);
+		to_slave_ring = NULL;
 	}
 
+	/* Clean up semaphores */
 	if (sem_from_slave_queue) {
 		g_h.funcs->_h_destroy_semaphore(sem_from_slave_queue);
 		sem_from_slave_queue = NULL;
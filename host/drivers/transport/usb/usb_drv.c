@@ -33,8 +33,7 @@ static void * h_usb_process_rx_task_info;
 static void * usb_handle = NULL;
 static usb_context_t *usb_context = NULL;
 
-static queue_handle_t to_slave_queue[MAX_PRIORITY_QUEUES];
-static semaphore_handle_t sem_to_slave_queue;
+static void * to_slave_ring;
 static queue_handle_t from_slave_queue[MAX_PRIORITY_QUEUES];
 static semaphore_handle_t sem_from_slave_queue;
 
@@ -133,23 +132,27 @@ void *bus_init_internal(void)
 	usb_context->product_id = config->product_id;
 	
 	// Initialize queues
+	to_slave_ring = g_h.funcs->_h_create_tx_ring(MAX_PRIORITY_QUEUES,
+		config->tx_queue_size, sizeof(interface_buffer_handle_t));
+	if (!to_slave_ring) {
+		ESP_LOGE(TAG, "Failed to create Tx ring");
+		goto cleanup;
+	}
+
 	for (int i = 0; i < MAX_PRIORITY_QUEUES; i++) {
-		to_slave_queue[i] = H_PLATFORM_Q_CREATE(config->tx_queue_size,
-			sizeof(interface_buffer_handle_t));
 		from_slave_queue[i] = H_PLATFORM_Q_CREATE(config->rx_queue_size,
 			sizeof(interface_buffer_handle_t));
 			
-		if (!to_slave_queue[i] || !from_slave_queue[i]) {
+		if (!from_slave_queue[i]) {
 			ESP_LOGE(TAG, "Failed to create queues");
 			goto cleanup;
 		}
 	}
 	
 	// Initialize semaphores
-	sem_to_slave_queue = H_PLATFORM_SEM_CREATE(MAX_PRIORITY_QUEUES, 0);
 	sem_from_slave_queue = H_PLATFORM_SEM_CREATE(MAX_PRIORITY_QUEUES, 0);
 	
-	if (!sem_to_slave_queue || !sem_from_slave_queue) {
+	if (!sem_from_slave_queue) {
 		ESP_LOGE(TAG, "Failed to create semaphores");
 		goto cleanup;
 	}
@@ -204,11 +207,12 @@ void bus_deinit_internal(void *bus_handle)
 	}
 	
 	// Cleanup queues
+	if (to_slave_ring) {
+		g_h.funcs->_h_destroy_tx_ring(to_slave_ring);
+		to_slave_ring = NULL;
+	}
+
 	for (int i = 0; i < MAX_PRIORITY_QUEUES; i++) {
-		if (to_slave_queue[i]) {
-			H_PLATFORM_Q_DELETE(to_slave_queue[i]);
-			to_slave_queue[i] = NULL;
-		}
 		if (from_slave_queue[i]) {
 			H_PLATFORM_Q_DELETE(from_slave_queue[i]);
 			from_slave_queue[i] = NULL;
@@ -216,11 +220,6 @@ void bus_deinit_internal(void *bus_handle)
 	}
 	
 	// Cleanup semaphores
-	if (sem_to_slave_queue) {
-		H_PLATFORM_SEM_DELETE(sem_to_slave_queue);
-		sem_to_slave_queue = NULL;
-	}
-	
 	if (sem_from_slave_queue) {
 		H_PLATFORM_SEM_DELETE(sem_from_slave_queue);
 		sem_from_slave_queue = NULL;
@@ -258,12 +257,8 @@ int esp_hosted_tx(uint8_t iface_type, uint8_t iface_num,
 	buf_handle.free_buf_handle = buffer_to_free;
 	buf_handle.func = free_buf_func;
 	
-	if (to_slave_queue[prio] && 
-		H_PLATFORM_Q_SEND(to_slave_queue[prio], &buf_handle, 0) == pdTRUE) {
-		
-		if (sem_to_slave_queue) {
-			H_PLATFORM_SEM_POST(sem_to_slave_queue);
-		}
+	if (to_slave_ring &&
+		!g_h.funcs->_h_tx_ring_push(to_slave_ring, prio, &buf_handle, 0)) {
 		
 		if (!usb_start_write_thread) {
 			usb_start_write_thread = true;
@@ -291,21 +286,15 @@ static void h_usb_write_task(void const* pvParameters)
 	interface_buffer_handle_t buf_handle = {0};
 	
 	while(1) {
-		if (usb_start_write_thread && sem_to_slave_queue &&
-			H_PLATFORM_SEM_WAIT(sem_to_slave_queue, portMAX_DELAY)) {
+		if (usb_start_write_thread && to_slave_ring &&
+			!g_h.funcs->_h_tx_ring_pop(to_slave_ring, &buf_handle, HOSTED_BLOCK_MAX)) {
 			
-			for (int prio = 0; prio < MAX_PRIORITY_QUEUES; prio++) {
-				if (to_slave_queue[prio] &&
-					H_PLATFORM_Q_RECEIVE(to_slave_queue[prio], &buf_handle, 0)) {
-					
-					ESP_LOGV(TAG, "USB TX: prio=%u, len=%u", prio, buf_handle.payload_len);
-					
-					// Actual USB transmission will be implemented in Phase 3
-					// For now, just acknowledge the packet
-					if (buf_handle.func && buf_handle.free_buf_handle) {
-						buf_handle.func(buf_handle.free_buf_handle);
-					}
-				}
+			ESP_LOGV(TAG, "USB TX: len=%u", buf_handle.payload_len);
+			
+			// Actual USB transmission will be implemented in Phase 3
+			// For now, just acknowledge the packet
+			if (buf_handle.func && buf_handle.free_buf_handle) {
+				buf_handle.func(buf_handle.free_buf_handle);
 			}
 		}
 	}
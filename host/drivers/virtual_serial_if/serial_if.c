@@ -32,7 +32,8 @@ struct serial_drv_handle_t* serial_handle = NULL;
  * value is actual data to be transferred
  */
 
-uint16_t compose_tlv(uint8_t* buf, uint8_t* data, uint16_t data_length)
+/* Everything of the TLV except the data value itself */
+static uint16_t compose_tlv_hdr(uint8_t* buf, uint16_t data_length)
 {
 	char* ep_name = RPC_EP_NAME_RSP;
 	uint16_t ep_length = strlen(ep_name);
@@ -57,6 +58,13 @@ uint16_t compose_tlv(uint8_t* buf, uint8_t* data, uint16_t data_length)
 	count++;
 	buf[count] = ((data_length >> 8) & 0xFF);
 	count++;
+	return count;
+}
+
+uint16_t compose_tlv(uint8_t* buf, uint8_t* data, uint16_t data_length)
+{
+	uint16_t count = compose_tlv_hdr(buf, data_length);
+
 	g_h.funcs->_h_memcpy(&buf[count], data, data_length);
 	count = count + data_length;
 	return count;
@@ -146,18 +154,21 @@ int transport_pserial_open(void)
 }
 
 
-int transport_pserial_send(uint8_t* data, uint16_t data_length)
+int transport_pserial_send_begin(serial_ll_tx_msg_t *msg, uint16_t data_length)
 {
-	char* ep_name = RPC_EP_NAME_RSP;
-	int count = 0, ret = 0;
-	uint16_t buf_len = 0;
-	uint8_t *write_buf = NULL;
+	uint8_t hdr[TLV_HDR_LEN];
+	uint16_t count = 0;
 
-	if (!data || !data_length) {
+	if (!data_length) {
 		ESP_LOGW(TAG, "Empty RPC data, ignored");
 		return FAILURE;
 	}
 
+	if (!serial_handle) {
+		ESP_LOGE(TAG, "Serial connection closed?\n");
+		return FAILURE;
+	}
+
 /*
  * TLV (Type - Length - Value) structure is as follows:
  * --------------------------------------------------------------------------------------------
@@ -169,39 +180,46 @@ int transport_pserial_send(uint8_t* data, uint16_t data_length)
  *       1        |        2        | Endpoint length |     1     |      2      | Data length |
  * --------------------------------------------------------------------------------------------
  */
-	buf_len = SIZE_OF_TYPE + SIZE_OF_LENGTH + strlen(ep_name) +
-		SIZE_OF_TYPE + SIZE_OF_LENGTH + data_length;
-
-	HOSTED_CALLOC(uint8_t,write_buf,buf_len,free_bufs2);
-
-	if (!serial_handle) {
-		ESP_LOGE(TAG, "Serial connection closed?\n");
-		goto free_bufs1;
+	if (data_length > MAX_FRAGMENTABLE_PAYLOAD_SIZE - TLV_HDR_LEN) {
+		ESP_LOGE(TAG, "RPC data too large: %u\n", data_length);
+		return FAILURE;
 	}
 
-	count = compose_tlv(write_buf, data, data_length);
-	if (!count) {
-		ESP_LOGE(TAG, "Failed to compose TX data\n");
-		goto free_bufs1;
+	if (serial_ll_tx_msg_alloc(msg, TLV_HDR_LEN + data_length)) {
+		ESP_LOGE(TAG, "Failed to allocate TX msg\n");
+		return FAILURE;
 	}
 
-	ret = serial_drv_write(serial_handle, write_buf, count, &count);
-	if (ret != SUCCESS) {
+	count = compose_tlv_hdr(hdr, data_length);
+	serial_ll_tx_msg_write(msg, hdr, count);
+	return SUCCESS;
+}
+
+int transport_pserial_send_end(serial_ll_tx_msg_t *msg)
+{
+	if (serial_drv_write_msg(serial_handle, msg) != SUCCESS) {
 		ESP_LOGE(TAG, "Failed to write TX data\n");
-		goto free_bufs2;
+		return FAILURE;
 	}
+	return SUCCESS;
+}
 
-	return ret;
+int transport_pserial_send(uint8_t* data, uint16_t data_length)
+{
+	serial_ll_tx_msg_t msg;
 
-free_bufs1:
-	HOSTED_FREE(write_buf);
-free_bufs2:
-	/* write_buf is supposed to be freed by serial_drv_write() */
-	return FAILURE;
+	if (!data)
+		return FAILURE;
+
+	if (transport_pserial_send_begin(&msg, data_length))
+		return FAILURE;
+
+	serial_ll_tx_msg_write(&msg, data, data_length);
+	return transport_pserial_send_end(&msg);
 }
 
-uint8_t * transport_pserial_read(uint32_t *out_nbyte)
+int transport_pserial_read(serial_drv_rx_buf_t *rx)
 {
-	/* Two step parsing TLV is moved in serial_drv_read */
-	return serial_drv_read(serial_handle, out_nbyte);
+	/* TLV parsing is moved in serial_drv_read */
+	return serial_drv_read(serial_handle, rx);
 }
@@ -10,9 +10,13 @@
 #include <stdint.h>
 #include "esp_hosted_transport.h"
 #include "os_wrapper.h"
+#include "serial_drv.h"
 
 #define SIZE_OF_TYPE                1
 #define SIZE_OF_LENGTH              2
+/* TLV up to data value, RPC_EP_NAME_EVT has same length as RPC_EP_NAME_RSP */
+#define TLV_HDR_LEN                 (SIZE_OF_TYPE + SIZE_OF_LENGTH + \
+		sizeof(RPC_EP_NAME_RSP) - 1 + SIZE_OF_TYPE + SIZE_OF_LENGTH)
 
 /*
  * The data written on serial driver file, `SERIAL_IF_FILE` from esp_hosted_transport.h
@@ -42,7 +46,20 @@ int transport_pserial_close(void);
  **/
 int transport_pserial_send(uint8_t* data, uint16_t data_length);
 
-/* Read and return number of bytes and buffer from serial interface
+/* Allocate transport buffers for data_length bytes of data and write the
+ * TLV header. Data is then written with serial_ll_tx_msg_write() or
+ * serial_ll_tx_msg_reserve(), and sent by transport_pserial_send_end().
+ * On failure nothing is left allocated
  **/
-uint8_t * transport_pserial_read(uint32_t *out_nbyte);
+int transport_pserial_send_begin(serial_ll_tx_msg_t *msg, uint16_t data_length);
+
+/* Send message prepared by transport_pserial_send_begin().
+ * msg is consumed, on failure too
+ **/
+int transport_pserial_send_end(serial_ll_tx_msg_t *msg);
+
+/* Read protobuf payload from serial interface, as view in the received
+ * buffer. Release it with serial_drv_rx_buf_free()
+ **/
+int transport_pserial_read(serial_drv_rx_buf_t *rx);
 #endif
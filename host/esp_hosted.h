@@ -18,6 +18,7 @@ extern "C" {
 #include "esp_hosted_api_types.h"
 #include "esp_hosted_host_fw_ver.h"
 #include "esp_hosted_ota.h"
+#include "esp_hosted_batch.h"
 
 typedef struct esp_hosted_transport_config esp_hosted_config_t;
 
@@ -28,6 +29,15 @@ int esp_hosted_deinit(void);
 int esp_hosted_connect_to_slave(void);
 int esp_hosted_get_coprocessor_fwversion(esp_hosted_coprocessor_fwver_t *ver_info);
 
+/* Deliver at most one event of event_id (RPC_ID__Event_*) per
+ * min_interval_ms to application, the latest one held back when the
+ * interval ends. RPC_ID__Event_WifiEventNoArgs is limited per Wi-Fi
+ * event. Events held back still update the host's netif state and
+ * cached Wi-Fi values. 0 delivers all.
+ * Co-processor side merging of repeated events is set by its
+ * CONFIG_ESP_HOSTED_EVENT_COALESCE_WINDOW_MS */
+int esp_hosted_set_event_rate_limit(int32_t event_id, uint32_t min_interval_ms);
+
 /* --------- Exhaustive API list --------- */
 /*
  * 1. All Wi-Fi supported APIs
@@ -38,6 +48,9 @@ int esp_hosted_get_coprocessor_fwversion(esp_hosted_coprocessor_fwver_t *ver_inf
  *
  * 3. Co-Processor OTA API
  *    File : host/api/include/esp_hosted_ota.h
+ *
+ * 4. Batched Wi-Fi getters, one RPC round trip
+ *    File : host/api/include/esp_hosted_batch.h
  */
 
 #ifdef __cplusplus
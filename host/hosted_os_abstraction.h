@@ -55,6 +55,15 @@ typedef struct {
           /* Timer */
 /* 32 */  int    (*_h_timer_stop)(void *timer_handle);
 /* 33 */  void*  (*_h_timer_start)(const char *name, int duration_ms, int type, void (*timeout_handler)(void *), void *arg);
+/* 33a */ uint32_t (*_h_get_time_ms)(void);
+
+          /* Tx ring: per-priority lanes, lock-free enqueue, single consumer */
+/* 33b */ void*  (*_h_create_tx_ring)(uint32_t num_lanes, uint32_t lane_depth, uint32_t item_size);
+/* 33c */ int    (*_h_tx_ring_push)(void * ring_handle, uint32_t lane, void *item, int timeout);
+/* 33d */ int    (*_h_tx_ring_pop)(void * ring_handle, void *item, int timeout);
+/* 33e */ int    (*_h_tx_ring_pop_lane)(void * ring_handle, uint32_t lane, void *item);
+/* 33f */ int    (*_h_tx_ring_wait)(void * ring_handle, int timeout);
+/* 33g */ int    (*_h_destroy_tx_ring)(void * ring_handle);
 
           /* Mempool */
 #ifdef H_USE_MEMPOOL
@@ -78,6 +87,8 @@ typedef struct {
           /* Transport - SPI */
 #if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
 /* 43 */ int (*_h_do_bus_transfer)(void *transfer_context);
+/* 43a */ int (*_h_queue_bus_transfer)(void *transfer_context);
+/* 43b */ int (*_h_wait_bus_transfer)(void);
 #endif
 /* 44 */ int (*_h_event_wifi_post)(int32_t event_id, void* event_data, size_t event_data_size, uint32_t ticks_to_wait);
 // 45 - int (*_h_event_ip_post)(int32_t event_id, void* event_data, size_t event_data_size, uint32_t ticks_to_wait);
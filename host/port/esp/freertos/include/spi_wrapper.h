@@ -29,4 +29,10 @@ int hosted_spi_deinit(void *handle);
 /* Hosted SPI transfer function */
 int hosted_do_spi_transfer(void *trans);
 
+/* Start transfer in background, to be followed by hosted_wait_spi_transfer() */
+int hosted_queue_spi_transfer(void *trans);
+
+/* Wait for transfer queued by hosted_queue_spi_transfer() */
+int hosted_wait_spi_transfer(void);
+
 #endif
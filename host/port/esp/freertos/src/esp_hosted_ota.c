@@ -10,8 +10,9 @@
  * Procedure:
  * 1. Prepare OTA binary
  * 2. Call rpc_ota_begin() to start OTA
- * 3. Repeatedly call rpc_ota_write() with a continuous chunk of OTA data
- * 4. Call rpc_ota_end()
+ * 3. Repeatedly call rpc_ota_write_async() with a continuous chunk of OTA
+ *    data. Up to H_OTA_WINDOW chunks are in flight while slave writes flash
+ * 4. Call rpc_ota_end(), which waits for chunks in flight
  */
 
 #include "esp_http_client.h"
@@ -19,8 +20,9 @@
 
 #include "rpc_wrap.h"
 #include "esp_hosted_ota.h"
+#include "esp_hosted_config.h"
 
-#define CHUNK_SIZE                                        1400
+#define CHUNK_SIZE                                        H_OTA_CHUNK_SIZE
 #define OTA_FROM_WEB_URL                                  1
 
 static char* TAG = "hosted_ota";
@@ -120,7 +122,7 @@ static esp_err_t _hosted_ota(const char* image_url)
 			esp_http_client_get_content_length(client));
 
 	ESP_LOGW(TAG, "********* Started Slave OTA *******************");
-	ESP_LOGI(TAG, "*** Please wait for 5 mins to let slave OTA complete ***");
+	ESP_LOGI(TAG, "*** Please wait to let slave OTA complete ***");
 
 	ESP_LOGI(TAG, "Preparing OTA");
 	if ((err = rpc_ota_begin())) {
@@ -131,27 +133,32 @@ static esp_err_t _hosted_ota(const char* image_url)
 		return ESP_FAIL;
 	}
 
-	ota_chunk = (uint8_t*)g_h.funcs->_h_calloc(1, CHUNK_SIZE);
-	if (!ota_chunk) {
-		ESP_LOGE(TAG, "Failed to allocate otachunk mem\n");
-		err = -ENOMEM;
-	}
-
 	ESP_LOGI(TAG, "Starting OTA");
 
-	if (!err) {
-		while ((data_read = esp_http_client_read(client, (char*)ota_chunk, CHUNK_SIZE)) > 0) {
+	/* Each chunk is handed over to rpc_ota_write_async(), which frees it
+	 * once sent, so next chunk is read while previous ones are in flight */
+	while (1) {
+		ota_chunk = (uint8_t*)g_h.funcs->_h_malloc(CHUNK_SIZE);
+		if (!ota_chunk) {
+			ESP_LOGE(TAG, "Failed to allocate otachunk mem\n");
+			err = -ENOMEM;
+			break;
+		}
+
+		data_read = esp_http_client_read(client, (char*)ota_chunk, CHUNK_SIZE);
+		if (data_read <= 0) {
+			g_h.funcs->_h_free(ota_chunk);
+			break;
+		}
 
-			ESP_LOGV(TAG, "Read image length %d", data_read);
-			if ((err = rpc_ota_write(ota_chunk, data_read))) {
-				ESP_LOGI(TAG, "rpc_ota_write failed");
-				ota_failed = err;
-				break;
-			}
+		ESP_LOGV(TAG, "Read image length %d", data_read);
+		if ((err = rpc_ota_write_async(ota_chunk, data_read))) {
+			ESP_LOGI(TAG, "rpc_ota_write failed");
+			ota_failed = err;
+			break;
 		}
 	}
 
-	g_h.funcs->_h_free(ota_chunk);
 	if (err) {
 		ESP_LOGW(TAG, "********* Slave OTA Failed *******************");
 		ESP_LOGI(TAG, "esp_ota_write failed, error=%s", esp_err_to_name(err));
@@ -18,6 +18,7 @@
 #include "os_wrapper.h"
 #include "esp_log.h"
 #include <stdlib.h>
+#include <stdatomic.h>
 #include "driver/gpio.h"
 #include "esp_event.h"
 #include "esp_heap_caps.h"
@@ -562,6 +563,299 @@ int hosted_destroy_semaphore(void * semaphore_handle)
 	return ret;
 }
 
+/* -------- Tx ring ------------- */
+/* One bounded ring per priority lane. Producers claim a slot with a single
+ * CAS on the lane head and publish it through the slot sequence number, so
+ * enqueue takes no lock and no kernel call. Only one task may dequeue.
+ *
+ * A single binary semaphore wakes the consumer. It is given only when the
+ * consumer has flagged that it is about to block, so a busy consumer costs
+ * producers nothing beyond the CAS.
+ */
+struct hosted_tx_lane {
+	atomic_uint head;              /* next slot to claim, producers */
+	uint32_t tail;                 /* next slot to read, consumer */
+	atomic_uint *seq;
+	uint8_t *items;
+};
+
+struct hosted_tx_ring {
+	uint32_t num_lanes;
+	uint32_t mask;
+	uint32_t item_size;
+	atomic_uint consumer_waiting;
+	atomic_uint producers_waiting;
+	SemaphoreHandle_t wakeup;
+	SemaphoreHandle_t space;
+	struct hosted_tx_lane lane[];
+};
+
+#define TX_RING_ALIGN(x)             (((x) + 7) & ~7)
+
+static TickType_t hosted_timeout_to_ticks(int timeout)
+{
+	if (timeout < 0)
+		return HOSTED_BLOCK_MAX;
+
+	return pdMS_TO_TICKS(SEC_TO_MILLISEC(timeout));
+}
+
+void * hosted_create_tx_ring(uint32_t num_lanes, uint32_t lane_depth, uint32_t item_size)
+{
+	struct hosted_tx_ring *ring = NULL;
+	uint32_t depth = 1;
+	size_t seq_off = 0;
+	size_t item_off = 0;
+	uint8_t *mem = NULL;
+	uint32_t i = 0, j = 0;
+
+	if (!num_lanes || !lane_depth || !item_size) {
+		ESP_LOGE(TAG, "Invalid Tx ring params\n");
+		return NULL;
+	}
+
+	/* power of two, so slot index is a mask of the position */
+	while (depth < lane_depth)
+		depth <<= 1;
+
+	seq_off = TX_RING_ALIGN(sizeof(struct hosted_tx_ring) +
+			num_lanes * sizeof(struct hosted_tx_lane));
+	item_off = TX_RING_ALIGN(seq_off + num_lanes * depth * sizeof(atomic_uint));
+
+	mem = hosted_calloc(1, item_off + num_lanes * depth * item_size);
+	if (!mem) {
+		ESP_LOGE(TAG, "Tx ring allocation failed\n");
+		return NULL;
+	}
+
+	ring = (struct hosted_tx_ring *)mem;
+	ring->num_lanes = num_lanes;
+	ring->mask = depth - 1;
+	ring->item_size = item_size;
+	atomic_init(&ring->consumer_waiting, 0);
+	atomic_init(&ring->producers_waiting, 0);
+
+	for (i = 0; i < num_lanes; i++) {
+		struct hosted_tx_lane *lane = &ring->lane[i];
+
+		atomic_init(&lane->head, 0);
+		lane->tail = 0;
+		lane->seq = (atomic_uint *)(mem + seq_off) + i * depth;
+		lane->items = mem + item_off + i * depth * item_size;
+		for (j = 0; j < depth; j++)
+			atomic_init(&lane->seq[j], j);
+	}
+
+	ring->wakeup = xSemaphoreCreateBinary();
+	ring->space = xSemaphoreCreateBinary();
+	if (!ring->wakeup || !ring->space) {
+		ESP_LOGE(TAG, "Tx ring sem create failed\n");
+		if (ring->wakeup)
+			vSemaphoreDelete(ring->wakeup);
+		if (ring->space)
+			vSemaphoreDelete(ring->space);
+		HOSTED_FREE(mem);
+		return NULL;
+	}
+
+	return ring;
+}
+
+static int tx_ring_lane_push(struct hosted_tx_ring *ring,
+		struct hosted_tx_lane *lane, void *item)
+{
+	uint32_t pos = atomic_load_explicit(&lane->head, memory_order_relaxed);
+	uint32_t seq = 0;
+	int32_t diff = 0;
+
+	for (;;) {
+		seq = atomic_load_explicit(&lane->seq[pos & ring->mask], memory_order_acquire);
+		diff = (int32_t)(seq - pos);
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&lane->head, &pos, pos + 1,
+					memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			/* lane full */
+			return RET_FAIL;
+		} else {
+			pos = atomic_load_explicit(&lane->head, memory_order_relaxed);
+		}
+	}
+
+	memcpy(lane->items + (pos & ring->mask) * ring->item_size, item, ring->item_size);
+	atomic_store_explicit(&lane->seq[pos & ring->mask], pos + 1, memory_order_release);
+
+	return RET_OK;
+}
+
+static int tx_ring_lane_pop(struct hosted_tx_ring *ring,
+		struct hosted_tx_lane *lane, void *item)
+{
+	uint32_t pos = lane->tail;
+	uint32_t seq = atomic_load_explicit(&lane->seq[pos & ring->mask], memory_order_acquire);
+
+	if (seq != pos + 1)
+		return RET_FAIL;
+
+	memcpy(item, lane->items + (pos & ring->mask) * ring->item_size, ring->item_size);
+	atomic_store_explicit(&lane->seq[pos & ring->mask], pos + ring->mask + 1,
+			memory_order_release);
+	lane->tail = pos + 1;
+
+	return RET_OK;
+}
+
+static int tx_ring_lane_ready(struct hosted_tx_ring *ring, struct hosted_tx_lane *lane)
+{
+	return atomic_load_explicit(&lane->seq[lane->tail & ring->mask],
+			memory_order_acquire) == lane->tail + 1;
+}
+
+static void tx_ring_wake_producers(struct hosted_tx_ring *ring)
+{
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load_explicit(&ring->producers_waiting, memory_order_relaxed))
+		xSemaphoreGive(ring->space);
+}
+
+/* Strict priority: lane 0 first */
+static int tx_ring_pop_any(struct hosted_tx_ring *ring, void *item)
+{
+	uint32_t i = 0;
+
+	for (i = 0; i < ring->num_lanes; i++) {
+		if (!tx_ring_lane_pop(ring, &ring->lane[i], item)) {
+			tx_ring_wake_producers(ring);
+			return RET_OK;
+		}
+	}
+
+	return RET_FAIL;
+}
+
+/* User expected to pass item's address to this func eg. &item */
+int hosted_tx_ring_push(void * ring_handle, uint32_t lane, void *item, int timeout)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+	int ret = RET_FAIL;
+
+	if (!ring || lane >= ring->num_lanes) {
+		ESP_LOGE(TAG, "Invalid Tx ring/lane\n");
+		return RET_INVALID;
+	}
+
+	while (tx_ring_lane_push(ring, &ring->lane[lane], item)) {
+		if (!timeout)
+			return RET_FAIL;
+
+		/* lane full: wait for the consumer to free a slot */
+		atomic_fetch_add(&ring->producers_waiting, 1);
+		ret = tx_ring_lane_push(ring, &ring->lane[lane], item);
+		if (ret && xSemaphoreTake(ring->space, hosted_timeout_to_ticks(timeout)) != pdTRUE) {
+			atomic_fetch_sub(&ring->producers_waiting, 1);
+			return RET_FAIL_TIMEOUT;
+		}
+		atomic_fetch_sub(&ring->producers_waiting, 1);
+		if (!ret)
+			break;
+	}
+
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load_explicit(&ring->consumer_waiting, memory_order_relaxed) &&
+	    atomic_exchange(&ring->consumer_waiting, 0))
+		xSemaphoreGive(ring->wakeup);
+
+	return RET_OK;
+}
+
+/* User expected to pass item's address to this func eg. &item */
+int hosted_tx_ring_pop_lane(void * ring_handle, uint32_t lane, void *item)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+
+	if (!ring || lane >= ring->num_lanes) {
+		ESP_LOGE(TAG, "Invalid Tx ring/lane\n");
+		return RET_INVALID;
+	}
+
+	if (tx_ring_lane_pop(ring, &ring->lane[lane], item))
+		return RET_FAIL;
+
+	tx_ring_wake_producers(ring);
+
+	return RET_OK;
+}
+
+/* Blocks until any lane has an item, for consumers doing their own lane pick */
+int hosted_tx_ring_wait(void * ring_handle, int timeout)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+	uint32_t i = 0;
+
+	if (!ring) {
+		ESP_LOGE(TAG, "Uninitialized Tx ring\n");
+		return RET_INVALID;
+	}
+
+	/* announce the sleep, then look once more so a push racing with
+	 * the flag is not missed */
+	atomic_store(&ring->consumer_waiting, 1);
+	atomic_thread_fence(memory_order_seq_cst);
+	for (i = 0; i < ring->num_lanes; i++) {
+		if (tx_ring_lane_ready(ring, &ring->lane[i])) {
+			atomic_store(&ring->consumer_waiting, 0);
+			return RET_OK;
+		}
+	}
+
+	if (!timeout ||
+	    xSemaphoreTake(ring->wakeup, hosted_timeout_to_ticks(timeout)) != pdTRUE) {
+		atomic_store(&ring->consumer_waiting, 0);
+		return RET_FAIL_TIMEOUT;
+	}
+
+	return RET_OK;
+}
+
+/* User expected to pass item's address to this func eg. &item */
+int hosted_tx_ring_pop(void * ring_handle, void *item, int timeout)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+
+	if (!ring) {
+		ESP_LOGE(TAG, "Uninitialized Tx ring\n");
+		return RET_INVALID;
+	}
+
+	for (;;) {
+		if (!tx_ring_pop_any(ring, item))
+			return RET_OK;
+
+		if (!timeout)
+			return RET_FAIL;
+
+		if (hosted_tx_ring_wait(ring, timeout))
+			return RET_FAIL_TIMEOUT;
+	}
+}
+
+int hosted_destroy_tx_ring(void * ring_handle)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+
+	if (!ring) {
+		ESP_LOGE(TAG, "Uninitialized Tx ring\n");
+		return RET_INVALID;
+	}
+
+	vSemaphoreDelete(ring->wakeup);
+	vSemaphoreDelete(ring->space);
+	HOSTED_FREE(ring_handle);
+
+	return RET_OK;
+}
+
 #ifdef H_USE_MEMPOOL
 static void * hosted_create_spinlock(void)
 {
@@ -692,6 +986,12 @@ void *hosted_timer_start(const char *name, int duration_ms, int type,
 	return timer_handle;
 }
 
+/* Monotonic time since boot, wraps after ~49 days */
+uint32_t hosted_get_time_ms(void)
+{
+	return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
 
 /* GPIO */
 
@@ -907,6 +1207,13 @@ hosted_osi_funcs_t g_hosted_osi_funcs = {
 	._h_destroy_semaphore        =  hosted_destroy_semaphore       ,
 	._h_timer_stop               =  hosted_timer_stop              ,
 	._h_timer_start              =  hosted_timer_start             ,
+	._h_get_time_ms              =  hosted_get_time_ms             ,
+	._h_create_tx_ring           =  hosted_create_tx_ring          ,
+	._h_tx_ring_push             =  hosted_tx_ring_push            ,
+	._h_tx_ring_pop              =  hosted_tx_ring_pop             ,
+	._h_tx_ring_pop_lane         =  hosted_tx_ring_pop_lane        ,
+	._h_tx_ring_wait             =  hosted_tx_ring_wait            ,
+	._h_destroy_tx_ring          =  hosted_destroy_tx_ring         ,
 #ifdef H_USE_MEMPOOL
 	._h_create_lock_mempool      =  hosted_create_lock_mempool     ,
 	._h_lock_mempool             =  hosted_lock_mempool            ,
@@ -926,6 +1233,8 @@ hosted_osi_funcs_t g_hosted_osi_funcs = {
 	._h_bus_init                 =  hosted_spi_init                ,
 	._h_bus_deinit               =  hosted_spi_deinit              ,
 	._h_do_bus_transfer          =  hosted_do_spi_transfer         ,
+	._h_queue_bus_transfer       =  hosted_queue_spi_transfer      ,
+	._h_wait_bus_transfer        =  hosted_wait_spi_transfer       ,
 #endif
 	._h_event_wifi_post          =  hosted_wifi_event_post         ,
 	._h_printf                   =  hosted_log_write               ,
@@ -128,21 +128,46 @@ int hosted_spi_deinit(void *handle)
 }
 
 
-int hosted_do_spi_transfer(void *trans)
+static void hosted_fill_spi_transaction(spi_transaction_t *t,
+        struct hosted_transport_context_t *spi_trans)
 {
-    spi_transaction_t t = {0};
-    struct hosted_transport_context_t * spi_trans = trans;
-
 #if SPI_WORKAROUND
     /* this ensures RX DMA data in cache is sync to memory */
     assert(ESP_OK == esp_cache_msync((void *)spi_trans->rx_buf, spi_trans->tx_buf_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M));
 #endif
 
-    t.length=spi_trans->tx_buf_size*8;
-    t.tx_buffer=spi_trans->tx_buf;
-    t.rx_buffer=spi_trans->rx_buf;
+    *t = (spi_transaction_t){0};
+    t->length=spi_trans->tx_buf_size*8;
+    t->tx_buffer=spi_trans->tx_buf;
+    t->rx_buffer=spi_trans->rx_buf;
     /* tell lower layer that we have manually aligned buffers for dma */
-    t.flags |= SPI_TRANS_DMA_BUFFER_ALIGN_MANUAL;
+    t->flags |= SPI_TRANS_DMA_BUFFER_ALIGN_MANUAL;
+}
+
+int hosted_do_spi_transfer(void *trans)
+{
+    spi_transaction_t t = {0};
+
+    hosted_fill_spi_transaction(&t, trans);
 
     return spi_device_transmit(*((spi_device_handle_t *)spi_handle), &t);
 }
+
+/* Only one transfer in flight: slave arms a single transaction per handshake */
+static spi_transaction_t spi_async_trans;
+
+int hosted_queue_spi_transfer(void *trans)
+{
+    hosted_fill_spi_transaction(&spi_async_trans, trans);
+
+    return spi_device_queue_trans(*((spi_device_handle_t *)spi_handle),
+            &spi_async_trans, portMAX_DELAY);
+}
+
+int hosted_wait_spi_transfer(void)
+{
+    spi_transaction_t *t = NULL;
+
+    return spi_device_get_trans_result(*((spi_device_handle_t *)spi_handle),
+            &t, portMAX_DELAY);
+}
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Transport checksum micro-benchmark
+ *
+ * Compares compute_checksum() from esp_hosted_checksum.h against the
+ * byte-wise loop it replaced, and the slice-by-8 esp_hosted_crc32() used
+ * with CRC32 frame integrity, over frame sizes seen on the bus. Results are
+ * first checked against the byte-wise loop and a bit-wise CRC32 on random
+ * lengths, alignments and split points.
+ *
+ * Built without auto-vectorization (see CMakeLists.txt), as the compilers
+ * for the ESP targets do not vectorize either loop. Cycles are TSC cycles
+ * on x86; elsewhere only the byte rate is printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <getopt.h>
+#include <time.h>
+#include "esp_hosted_checksum.h"
+#include "esp_hosted_crc32.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_CYCLES                1
+#else
+#define BENCH_HAVE_CYCLES                0
+#endif
+
+#define BENCH_BUF_SIZE                   2048
+#define BENCH_VERIFY_ROUNDS              100000
+
+#define BENCH_CRC32_CHECK                0xCBF43926 /* of "123456789" */
+
+typedef uint32_t (*checksum_fn_t)(uint8_t *buf, uint16_t len);
+
+/* Loop used before esp_hosted_checksum.h */
+static uint16_t __attribute__((noinline)) checksum_bytewise(uint8_t *buf, uint16_t len)
+{
+	uint16_t checksum = 0;
+	uint16_t i = 0;
+
+	while(i < len) {
+		checksum += buf[i];
+		i++;
+	}
+
+	return checksum;
+}
+
+static uint16_t __attribute__((noinline)) checksum_wordwise(uint8_t *buf, uint16_t len)
+{
+	return compute_checksum(buf, len);
+}
+
+/* CRC32 by definition, one bit at a time */
+static uint32_t crc32_bitwise(const uint8_t *buf, uint32_t len)
+{
+	uint32_t crc = 0xFFFFFFFF;
+
+	while (len--) {
+		crc ^= *buf++;
+		for (int k = 0; k < 8; k++)
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+	}
+	return ~crc;
+}
+
+static uint32_t run_bytewise(uint8_t *buf, uint16_t len)
+{
+	return checksum_bytewise(buf, len);
+}
+
+static uint32_t run_wordwise(uint8_t *buf, uint16_t len)
+{
+	return checksum_wordwise(buf, len);
+}
+
+static uint32_t run_crc32(uint8_t *buf, uint16_t len)
+{
+	return esp_hosted_crc32(buf, len);
+}
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t bench_cycles(void)
+{
+#if BENCH_HAVE_CYCLES
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+static int verify(uint8_t *buf)
+{
+	for (uint32_t i = 0; i < BENCH_VERIFY_ROUNDS; i++) {
+		uint16_t off = rand() % 8;
+		uint16_t len = rand() % (BENCH_BUF_SIZE - 8);
+		uint16_t split = len ? rand() % len : 0;
+		uint16_t ref = checksum_bytewise(buf + off, len);
+		uint16_t part = compute_checksum_update(
+				compute_checksum_update(0, buf + off, split),
+				buf + off + split, len - split);
+
+		uint32_t crc_ref = crc32_bitwise(buf + off, len);
+		uint32_t crc_part = esp_hosted_crc32_update(
+				esp_hosted_crc32_update(0, buf + off, split),
+				buf + off + split, len - split);
+
+		if (checksum_wordwise(buf + off, len) != ref || part != ref) {
+			printf("mismatch: off %u len %u split %u\n", off, len, split);
+			return -1;
+		}
+		if (esp_hosted_crc32(buf + off, len) != crc_ref || crc_part != crc_ref) {
+			printf("crc32 mismatch: off %u len %u split %u\n", off, len, split);
+			return -1;
+		}
+	}
+
+	if (esp_hosted_crc32((const uint8_t *)"123456789", 9) != BENCH_CRC32_CHECK) {
+		printf("crc32 check value mismatch\n");
+		return -1;
+	}
+	return 0;
+}
+
+static void run(const char *name, checksum_fn_t fn, uint8_t *buf,
+		uint16_t len, uint32_t iters)
+{
+	volatile uint32_t sink = 0;
+	uint64_t ns = 0, cycles = 0;
+	double bytes = (double)len * iters;
+
+	/* warm up caches and branch predictors */
+	for (uint32_t i = 0; i < iters / 16 + 1; i++)
+		sink += fn(buf, len);
+
+	ns = bench_now_ns();
+	cycles = bench_cycles();
+	for (uint32_t i = 0; i < iters; i++)
+		sink += fn(buf, len);
+	cycles = bench_cycles() - cycles;
+	ns = bench_now_ns() - ns;
+
+	printf("  %-9s %8.1f ns/frame %9.1f MB/s", name,
+			(double)ns / iters, bytes * 1000 / ns);
+	if (BENCH_HAVE_CYCLES)
+		printf(" %6.2f bytes/cycle", bytes / cycles);
+	printf("\n");
+	(void)sink;
+}
+
+int main(int argc, char *argv[])
+{
+	static const uint16_t lens[] = { 64, 256, 512, 1500, 1600 };
+	uint8_t *buf = NULL;
+	uint32_t iters = 200000;
+	int opt = 0;
+
+	while ((opt = getopt(argc, argv, "n:h")) != -1) {
+		switch (opt) {
+		case 'n':
+			iters = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			printf("Usage: %s [-n iterations]\n", argv[0]);
+			return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	buf = aligned_alloc(64, BENCH_BUF_SIZE);
+	if (!buf || !iters)
+		return EXIT_FAILURE;
+
+	srand(1);
+	for (int i = 0; i < BENCH_BUF_SIZE; i++)
+		buf[i] = rand();
+
+	if (verify(buf))
+		return EXIT_FAILURE;
+	printf("verified against byte-wise loop and bit-wise CRC32: %u random frames\n",
+			BENCH_VERIFY_ROUNDS);
+
+	for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		for (int off = 0; off <= 1; off++) {
+			printf("len %u%s:\n", lens[i], off ? ", unaligned" : "");
+			run("bytewise", run_bytewise, buf + off, lens[i], iters);
+			run("wordwise", run_wordwise, buf + off, lens[i], iters);
+			run("crc32", run_crc32, buf + off, lens[i], iters);
+		}
+	}
+
+	free(buf);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,477 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* Throughput and latency of the host transport over the simulated bus.
+ *
+ * The bench stands in for the layers above the transport (transport_drv,
+ * serial, netif, BT): it sends STA frames with esp_hosted_tx() and takes
+ * received ones on a STA channel, fed by the real wifi_rx_handler().
+ *
+ *  tx    : host -> slave, as fast as transport accepts
+ *  rx    : slave -> host, slave keeps its Tx queue full
+ *  rxpps : rx without wire delay or slave turnaround by default, so host
+ *          Rx cost per packet sets the rate. Compare the zero-copy build
+ *          (hosted_sim_bench_rx_zc) against hosted_sim_bench
+ *  echo  : one frame in flight, slave echoes it, round trip time is measured
+ *
+ * On SDIO, the slave advertises Rx aggregation unless -a is given, so tx
+ * runs with and without sdio_drv's Tx aggregation can be compared.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "os_wrapper.h"
+#include "transport_drv.h"
+#include "esp_hosted_transport.h"
+#include "esp_hosted_transport_config.h"
+#include "esp_hosted_transport_init.h"
+#include "esp_hosted_power_save.h"
+#include "esp_hosted_bt.h"
+#include "hci_drv.h"
+#include "power_save_drv.h"
+#include "stats.h"
+#include "sim_bus.h"
+
+#define BENCH_MAX_SAMPLES                (1024 * 1024)
+#define BENCH_ECHO_TIMEOUT_NS            (1000ULL * 1000 * 1000)
+
+enum {
+	BENCH_MODE_TX,
+	BENCH_MODE_RX,
+	BENCH_MODE_RX_PPS,
+	BENCH_MODE_ECHO,
+};
+
+struct bench_echo_hdr {
+	uint32_t seq;
+	uint64_t sent_ns;
+} __attribute__((packed));
+
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	uint8_t tx_ready;
+	uint8_t crc32;
+	uint8_t no_aggr;
+
+	uint64_t rx_frames;
+	uint64_t rx_bytes;
+
+	uint32_t echo_seq;
+	uint8_t echo_done;
+	uint64_t *rtt_ns;
+	uint32_t rtt_count;
+	uint64_t echo_lost;
+} bench = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static volatile uint8_t bench_stop;
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t bench_cpu_us(void)
+{
+	struct rusage ru;
+
+	getrusage(RUSAGE_SELF, &ru);
+	return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000ULL +
+		ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+}
+
+/* -------- Layers above transport ---------- */
+
+volatile uint8_t wifi_tx_throttling;
+transport_channel_t *chan_arr[ESP_MAX_IF];
+
+/* From esp_hosted_wifi_remote_glue.h, which needs esp_wifi_remote */
+void esp_hosted_free_rx_buffer(void *buff_to_free);
+
+uint8_t is_transport_rx_ready(void)
+{
+	return 1;
+}
+
+uint8_t is_transport_tx_ready(void)
+{
+	return bench.tx_ready;
+}
+
+uint8_t is_transport_tx_crc32_enabled(void)
+{
+	return bench.crc32;
+}
+
+uint32_t get_slave_ext_capabilities(void)
+{
+	return bench.no_aggr ? 0 : ESP_SDIO_RX_AGGREGATION_SUPPORT;
+}
+
+void process_priv_communication(interface_buffer_handle_t *buf_handle)
+{
+	pthread_mutex_lock(&bench.lock);
+	bench.tx_ready = 1;
+	pthread_cond_broadcast(&bench.cond);
+	pthread_mutex_unlock(&bench.lock);
+}
+
+int serial_rx_handler(interface_buffer_handle_t *buf_handle)
+{
+	return 0;
+}
+
+/* netif stand-in, registered as STA channel */
+static esp_err_t bench_netif_rx(void *h, void *buffer, void *buff_to_free, size_t len)
+{
+	struct bench_echo_hdr hdr;
+
+	pthread_mutex_lock(&bench.lock);
+	bench.rx_frames++;
+	bench.rx_bytes += len;
+
+	if (len >= sizeof(hdr)) {
+		memcpy(&hdr, buffer, sizeof(hdr));
+		if (hdr.seq == bench.echo_seq && !bench.echo_done) {
+			if (bench.rtt_ns && bench.rtt_count < BENCH_MAX_SAMPLES)
+				bench.rtt_ns[bench.rtt_count++] = bench_now_ns() - hdr.sent_ns;
+			bench.echo_done = 1;
+			pthread_cond_signal(&bench.cond);
+		}
+	}
+	pthread_mutex_unlock(&bench.lock);
+
+	/* as lwIP does once done with the pbuf */
+	esp_hosted_free_rx_buffer(buff_to_free);
+
+	return ESP_OK;
+}
+
+static transport_channel_t bench_sta_chan = {
+	.if_type = ESP_STA_IF,
+	.rx = bench_netif_rx,
+};
+
+int hci_rx_handler(uint8_t *buf, size_t buf_len)
+{
+	return 0;
+}
+
+void hci_drv_show_configuration(void)
+{
+}
+
+void create_debugging_tasks(void)
+{
+}
+
+esp_hosted_transport_err_t esp_hosted_transport_get_reset_config(gpio_pin_t *pin_config)
+{
+	return ESP_TRANSPORT_OK;
+}
+
+int esp_hosted_woke_from_power_save(void)
+{
+	return 0;
+}
+
+int release_slave_reset_gpio_post_wakeup(void)
+{
+	return 0;
+}
+
+int stop_host_power_save(void)
+{
+	return 0;
+}
+
+void set_transport_state(uint8_t state)
+{
+}
+
+/* -------- Traffic ---------- */
+
+static int bench_send(uint16_t len, uint32_t seq)
+{
+	struct bench_echo_hdr hdr = { .seq = seq, .sent_ns = bench_now_ns() };
+	uint8_t *buf = malloc(len);
+
+	if (!buf)
+		return -1;
+
+	memset(buf, (uint8_t)seq, len);
+	if (len >= sizeof(hdr))
+		memcpy(buf, &hdr, sizeof(hdr));
+
+	return esp_hosted_tx(ESP_STA_IF, 0, buf, len, H_BUFF_NO_ZEROCOPY,
+			buf, free, 0);
+}
+
+static void * bench_slave_tx_thread(void *arg)
+{
+	uint16_t len = *(uint16_t *)arg;
+	uint8_t *payload = calloc(1, len);
+
+	while (!bench_stop) {
+		if (sim_slave_send(ESP_STA_IF, 0, payload, len, 0))
+			usleep(1000);
+	}
+	free(payload);
+
+	return NULL;
+}
+
+static void bench_run_echo(uint16_t len, uint64_t end_ns)
+{
+	struct timespec deadline;
+	uint64_t timeout_ns = 0;
+	uint32_t seq = 0;
+
+	bench.rtt_ns = calloc(BENCH_MAX_SAMPLES, sizeof(uint64_t));
+	assert(bench.rtt_ns);
+
+	while (bench_now_ns() < end_ns) {
+		pthread_mutex_lock(&bench.lock);
+		bench.echo_seq = ++seq;
+		bench.echo_done = 0;
+		pthread_mutex_unlock(&bench.lock);
+
+		bench_send(len, seq);
+
+		timeout_ns = bench_now_ns() + BENCH_ECHO_TIMEOUT_NS;
+		deadline.tv_sec = timeout_ns / 1000000000ULL;
+		deadline.tv_nsec = timeout_ns % 1000000000ULL;
+
+		pthread_mutex_lock(&bench.lock);
+		while (!bench.echo_done) {
+			if (pthread_cond_timedwait(&bench.cond, &bench.lock, &deadline)) {
+				bench.echo_lost++;
+				break;
+			}
+		}
+		pthread_mutex_unlock(&bench.lock);
+	}
+}
+
+static int bench_cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void bench_print_rtt(void)
+{
+	uint64_t sum = 0;
+	uint32_t i = 0, n = bench.rtt_count;
+
+	if (!n) {
+		printf("echo: no samples\n");
+		return;
+	}
+
+	qsort(bench.rtt_ns, n, sizeof(uint64_t), bench_cmp_u64);
+	for (i = 0; i < n; i++)
+		sum += bench.rtt_ns[i];
+
+	printf("echo: %u samples, %" PRIu64 " lost\n", n, bench.echo_lost);
+	printf("rtt us: min %.1f avg %.1f p50 %.1f p99 %.1f max %.1f\n",
+			bench.rtt_ns[0] / 1000.0, sum / n / 1000.0,
+			bench.rtt_ns[n / 2] / 1000.0, bench.rtt_ns[(uint64_t)n * 99 / 100] / 1000.0,
+			bench.rtt_ns[n - 1] / 1000.0);
+}
+
+static void usage(const char *prog)
+{
+	printf("Usage: %s [-m tx|rx|rxpps|echo] [-s payload_len] [-d seconds]\n"
+		"          [-b bus_bps] [-t slave_turnaround_us] [-c] [-a]\n"
+		"  -c  CRC32 frame trailer instead of header checksum\n"
+		"  -a  slave does not advertise SDIO Rx aggregation\n", prog);
+}
+
+int main(int argc, char *argv[])
+{
+	sim_bus_config_t cfg = SIM_BUS_CONFIG_DEFAULT();
+	struct esp_priv_event init_event = { .event_type = ESP_PRIV_EVENT_INIT };
+	sim_bus_stats_t stats = {0};
+	pthread_condattr_t cond_attr;
+	pthread_t slave_thread;
+	uint64_t start_ns = 0, end_ns = 0, cpu_us = 0;
+	uint64_t frames = 0, bytes = 0;
+	double secs = 0;
+	uint16_t len = 1460;
+	int duration = 5;
+	int mode = BENCH_MODE_ECHO;
+	int bus_set = 0;
+	int opt = 0;
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_UART
+	cfg.bus_bps = H_UART_BAUD_RATE;
+	len = 256;
+#elif H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	cfg.bus_bps = H_SDIO_CLOCK_FREQ_KHZ * 1000 * H_SDIO_BUS_WIDTH;
+#endif
+
+	while ((opt = getopt(argc, argv, "m:s:d:b:t:cah")) != -1) {
+		switch (opt) {
+		case 'm':
+			if (!strcmp(optarg, "tx"))
+				mode = BENCH_MODE_TX;
+			else if (!strcmp(optarg, "rx"))
+				mode = BENCH_MODE_RX;
+			else if (!strcmp(optarg, "rxpps"))
+				mode = BENCH_MODE_RX_PPS;
+			else if (!strcmp(optarg, "echo"))
+				mode = BENCH_MODE_ECHO;
+			else {
+				usage(argv[0]);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 's':
+			len = atoi(optarg);
+			break;
+		case 'd':
+			duration = atoi(optarg);
+			break;
+		case 'b':
+			cfg.bus_bps = strtoul(optarg, NULL, 0);
+			bus_set |= 1;
+			break;
+		case 't':
+			cfg.slave_turnaround_us = strtoul(optarg, NULL, 0);
+			bus_set |= 2;
+			break;
+		case 'c':
+			bench.crc32 = 1;
+			break;
+		case 'a':
+			bench.no_aggr = 1;
+			break;
+		default:
+			usage(argv[0]);
+			return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	if (!len || len + H_ESP_PAYLOAD_CRC32_LEN > MAX_PAYLOAD_SIZE) {
+		printf("payload_len must be 1..%u\n", (unsigned int)(MAX_PAYLOAD_SIZE - H_ESP_PAYLOAD_CRC32_LEN));
+		return EXIT_FAILURE;
+	}
+
+	/* echo deadlines are on the monotonic clock */
+	pthread_condattr_init(&cond_attr);
+	pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&bench.cond, &cond_attr);
+	pthread_condattr_destroy(&cond_attr);
+
+	if (mode == BENCH_MODE_RX_PPS) {
+		if (!(bus_set & 1))
+			cfg.bus_bps = 0;
+		if (!(bus_set & 2))
+			cfg.slave_turnaround_us = 0;
+	}
+
+	chan_arr[ESP_STA_IF] = &bench_sta_chan;
+
+	cfg.loopback = (mode == BENCH_MODE_ECHO);
+	cfg.crc32 = bench.crc32;
+	sim_bus_configure(&cfg);
+
+	if (!bus_init_internal()) {
+		printf("transport init failed\n");
+		return EXIT_FAILURE;
+	}
+
+	/* slave comes up and announces itself, as on target */
+	sim_slave_send(ESP_PRIV_IF, 0, (uint8_t *)&init_event, sizeof(init_event), 0);
+
+	pthread_mutex_lock(&bench.lock);
+	while (!bench.tx_ready)
+		pthread_cond_wait(&bench.cond, &bench.lock);
+	pthread_mutex_unlock(&bench.lock);
+
+	sim_bus_get_stats(&stats);
+	cpu_us = bench_cpu_us();
+	start_ns = bench_now_ns();
+	end_ns = start_ns + duration * 1000000000ULL;
+
+	switch (mode) {
+	case BENCH_MODE_TX:
+		while (bench_now_ns() < end_ns)
+			bench_send(len, 0);
+		break;
+	case BENCH_MODE_RX:
+	case BENCH_MODE_RX_PPS:
+		pthread_create(&slave_thread, NULL, bench_slave_tx_thread, &len);
+		usleep(duration * 1000000);
+		bench_stop = 1;
+		pthread_join(slave_thread, NULL);
+		break;
+	default:
+		bench_run_echo(len, end_ns);
+		break;
+	}
+
+	secs = (bench_now_ns() - start_ns) / 1e9;
+	cpu_us = bench_cpu_us() - cpu_us;
+	frames = stats.host_frames;
+	bytes = stats.host_bytes;
+	sim_bus_get_stats(&stats);
+
+	if (mode == BENCH_MODE_TX) {
+		frames = stats.host_frames - frames;
+		bytes = stats.host_bytes - bytes;
+	} else {
+		pthread_mutex_lock(&bench.lock);
+		frames = bench.rx_frames;
+		bytes = bench.rx_bytes;
+		pthread_mutex_unlock(&bench.lock);
+	}
+
+	printf("transport %s, bus %u bps, turnaround %u us, payload %u, %s, wifi rx %s\n",
+			(H_TRANSPORT_IN_USE == H_TRANSPORT_SPI) ? "SPI" :
+			(H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO) ? "SDIO" : "UART",
+			cfg.bus_bps, cfg.slave_turnaround_us, len,
+			bench.crc32 ? "crc32" : "checksum",
+			H_WIFI_RX_ZEROCOPY ? "zero-copy" : "copy");
+	printf("%" PRIu64 " frames in %.2f s: %.0f frames/s, %.2f Mbps\n",
+			frames, secs, frames / secs, bytes * 8 / secs / 1e6);
+	if (mode == BENCH_MODE_RX_PPS && frames)
+		printf("cpu per frame: %.2f us\n", (double)cpu_us / frames);
+	printf("bus: %" PRIu64 " transfers, %" PRIu64 " dummy, %" PRIu64 " bad frames, %" PRIu64 " slave drops\n",
+			stats.transfers, stats.dummy_transfers, stats.host_frames_bad,
+			stats.slave_frames_dropped);
+	/* includes the simulated slave and its busy waits */
+	printf("process cpu: %.1f%%\n", cpu_us / 10000.0 / secs);
+
+	if (mode == BENCH_MODE_ECHO)
+		bench_print_rtt();
+
+	fflush(stdout);
+	/* transport threads do not exit, leave them to the OS */
+	_exit(EXIT_SUCCESS);
+}
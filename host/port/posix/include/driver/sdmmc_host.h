@@ -0,0 +1,12 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Stands in for ESP-IDF driver/sdmmc_host.h, included by esp_hosted_config.h.
+ * The simulated SDIO bus needs nothing from it */
+
+#ifndef __POSIX_DRIVER_SDMMC_HOST_H__
+#define __POSIX_DRIVER_SDMMC_HOST_H__
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Subset of ESP-IDF error codes used by host drivers */
+#ifndef __POSIX_ESP_ERR_H__
+#define __POSIX_ESP_ERR_H__
+
+#include <stdint.h>
+#include <assert.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK                                           0
+#define ESP_FAIL                                         -1
+
+#define ESP_ERR_NO_MEM                                   0x101
+#define ESP_ERR_INVALID_ARG                              0x102
+#define ESP_ERR_INVALID_STATE                            0x103
+#define ESP_ERR_INVALID_SIZE                             0x104
+#define ESP_ERR_NOT_FOUND                                0x105
+#define ESP_ERR_NOT_SUPPORTED                            0x106
+#define ESP_ERR_TIMEOUT                                  0x107
+#define ESP_ERR_INVALID_RESPONSE                         0x108
+#define ESP_ERR_INVALID_CRC                              0x109
+#define ESP_ERR_INVALID_VERSION                          0x10A
+#define ESP_ERR_NOT_FINISHED                             0x10C
+#define ESP_ERR_NOT_ALLOWED                              0x10D
+
+#define ESP_ERROR_CHECK(x) do {                                                \
+	esp_err_t err_rc_ = (x);                                                   \
+	assert(err_rc_ == ESP_OK);                                                 \
+	(void)err_rc_;                                                             \
+} while (0)
+
+#define ESP_ERROR_CHECK_WITHOUT_ABORT(x)                 (x)
+
+static inline const char *esp_err_to_name(esp_err_t code)
+{
+	return code ? "ESP_FAIL" : "ESP_OK";
+}
+
+#endif
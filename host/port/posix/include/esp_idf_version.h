@@ -0,0 +1,20 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* IDF version the POSIX port behaves as, for version checks in shared code */
+#ifndef __POSIX_ESP_IDF_VERSION_H__
+#define __POSIX_ESP_IDF_VERSION_H__
+
+#define ESP_IDF_VERSION_MAJOR                            5
+#define ESP_IDF_VERSION_MINOR                            5
+#define ESP_IDF_VERSION_PATCH                            0
+
+#define ESP_IDF_VERSION_VAL(major, minor, patch) ((major << 16) | (minor << 8) | (patch))
+
+#define ESP_IDF_VERSION  ESP_IDF_VERSION_VAL(ESP_IDF_VERSION_MAJOR, \
+                                             ESP_IDF_VERSION_MINOR, \
+                                             ESP_IDF_VERSION_PATCH)
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* ESP_LOGx on stdout. Level is fixed at build time by LOG_LOCAL_LEVEL,
+ * so logs below it cost nothing in benchmarks. */
+#ifndef __POSIX_ESP_LOG_H__
+#define __POSIX_ESP_LOG_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+
+typedef enum {
+	ESP_LOG_NONE,
+	ESP_LOG_ERROR,
+	ESP_LOG_WARN,
+	ESP_LOG_INFO,
+	ESP_LOG_DEBUG,
+	ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+#ifndef LOG_LOCAL_LEVEL
+#define LOG_LOCAL_LEVEL                                  CONFIG_LOG_MAXIMUM_LEVEL
+#endif
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+	__attribute__((format(printf, 3, 4)));
+void esp_log_buffer_hexdump_internal(const char *tag, const void *buffer,
+		uint16_t buff_len, esp_log_level_t level);
+
+#define ESP_LOG_LEVEL_LOCAL(level, tag, format, ...) do {                      \
+	if (LOG_LOCAL_LEVEL >= (level))                                            \
+		esp_log_write(level, tag, format, ##__VA_ARGS__);                      \
+} while (0)
+
+#define ESP_LOGE(tag, format, ...)  ESP_LOG_LEVEL_LOCAL(ESP_LOG_ERROR,   tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...)  ESP_LOG_LEVEL_LOCAL(ESP_LOG_WARN,    tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...)  ESP_LOG_LEVEL_LOCAL(ESP_LOG_INFO,    tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...)  ESP_LOG_LEVEL_LOCAL(ESP_LOG_DEBUG,   tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...)  ESP_LOG_LEVEL_LOCAL(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+#define ESP_EARLY_LOGE ESP_LOGE
+#define ESP_EARLY_LOGW ESP_LOGW
+#define ESP_EARLY_LOGI ESP_LOGI
+#define ESP_EARLY_LOGD ESP_LOGD
+#define ESP_EARLY_LOGV ESP_LOGV
+#define ESP_DRAM_LOGE  ESP_LOGE
+
+#define ESP_LOG_BUFFER_HEXDUMP(tag, buffer, buff_len, level) do {              \
+	if (LOG_LOCAL_LEVEL >= (level))                                            \
+		esp_log_buffer_hexdump_internal(tag, buffer, buff_len, level);         \
+} while (0)
+
+#define ESP_LOG_BUFFER_HEX(tag, buffer, buff_len)                              \
+	ESP_LOG_BUFFER_HEXDUMP(tag, buffer, buff_len, ESP_LOG_INFO)
+
+#define esp_log_level_set(tag, level)                    ((void)(tag), (void)(level))
+
+#endif
@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Task priorities are not used by the POSIX port */
+#ifndef __POSIX_ESP_TASK_H__
+#define __POSIX_ESP_TASK_H__
+
+/* pulled in through FreeRTOS headers on ESP-IDF */
+#include "esp_err.h"
+#include "esp_idf_version.h"
+
+#define ESP_TASK_PRIO_MAX                                25
+#define ESP_TASK_PRIO_MIN                                0
+
+#endif
@@ -0,0 +1,11 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __POSIX_ESP_WIFI_H__
+#define __POSIX_ESP_WIFI_H__
+
+#include "esp_wifi_types.h"
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Opaque stand-ins for the ESP-IDF Wi-Fi types in rpc_slave_if.h.
+ * POSIX builds move RPC requests through rpc_core only, and never
+ * look inside them */
+#ifndef __POSIX_ESP_WIFI_TYPES_H__
+#define __POSIX_ESP_WIFI_TYPES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+typedef enum {
+	WIFI_IF_STA,
+	WIFI_IF_AP,
+} wifi_interface_t;
+
+typedef enum {
+	WIFI_MODE_NULL,
+	WIFI_MODE_STA,
+	WIFI_MODE_AP,
+	WIFI_MODE_APSTA,
+	WIFI_MODE_MAX
+} wifi_mode_t;
+
+typedef int wifi_band_mode_t;
+typedef int wifi_band_t;
+typedef int wifi_bandwidth_t;
+typedef int wifi_phy_mode_t;
+typedef int wifi_second_chan_t;
+typedef int wifi_storage_t;
+typedef int wifi_ps_type_t;
+typedef int wifi_vendor_ie_type_t;
+typedef int wifi_auth_mode_t;
+typedef int wifi_cipher_type_t;
+typedef int wifi_ant_t;
+typedef int wifi_country_policy_t;
+
+#define WIFI_OPAQUE_TYPE(t)  typedef struct { uint8_t opaque[64]; } t
+
+WIFI_OPAQUE_TYPE(wifi_ap_record_t);
+WIFI_OPAQUE_TYPE(wifi_config_t);
+WIFI_OPAQUE_TYPE(wifi_country_t);
+WIFI_OPAQUE_TYPE(wifi_init_config_t);
+WIFI_OPAQUE_TYPE(wifi_scan_config_t);
+WIFI_OPAQUE_TYPE(wifi_scan_default_params_t);
+WIFI_OPAQUE_TYPE(wifi_sta_list_t);
+WIFI_OPAQUE_TYPE(wifi_sta_info_t);
+WIFI_OPAQUE_TYPE(wifi_protocols_t);
+WIFI_OPAQUE_TYPE(wifi_bandwidths_t);
+WIFI_OPAQUE_TYPE(wifi_twt_config_t);
+WIFI_OPAQUE_TYPE(wifi_itwt_setup_config_t);
+WIFI_OPAQUE_TYPE(wifi_vendor_ie_id_t);
+WIFI_OPAQUE_TYPE(vendor_ie_data_t);
+WIFI_OPAQUE_TYPE(wifi_csi_config_t);
+WIFI_OPAQUE_TYPE(wifi_promiscuous_filter_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_connected_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_disconnected_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_scan_done_t);
+WIFI_OPAQUE_TYPE(wifi_event_ap_staconnected_t);
+WIFI_OPAQUE_TYPE(wifi_event_ap_stadisconnected_t);
+WIFI_OPAQUE_TYPE(wifi_event_ap_probe_req_rx_t);
+WIFI_OPAQUE_TYPE(wifi_event_bss_rssi_low_t);
+WIFI_OPAQUE_TYPE(wifi_event_ftm_report_t);
+WIFI_OPAQUE_TYPE(wifi_event_home_channel_change_t);
+WIFI_OPAQUE_TYPE(wifi_event_roc_done_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_neighbor_rep_t);
+WIFI_OPAQUE_TYPE(wifi_event_dpp_uri_ready_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_itwt_probe_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_itwt_setup_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_itwt_suspend_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_itwt_teardown_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_wps_er_success_t);
+WIFI_OPAQUE_TYPE(wifi_event_sta_wps_er_pin_t);
+WIFI_OPAQUE_TYPE(wifi_event_ap_wps_rg_success_t);
+WIFI_OPAQUE_TYPE(wifi_event_ap_wps_rg_fail_reason_t);
+WIFI_OPAQUE_TYPE(wifi_event_ap_wps_rg_pin_t);
+
+#endif
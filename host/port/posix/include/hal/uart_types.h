@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Subset of ESP-IDF hal/uart_types.h used by esp_hosted_config.h */
+
+#ifndef __POSIX_HAL_UART_TYPES_H__
+#define __POSIX_HAL_UART_TYPES_H__
+
+typedef enum {
+	UART_HW_FLOWCTRL_DISABLE = 0x0,
+	UART_HW_FLOWCTRL_RTS     = 0x1,
+	UART_HW_FLOWCTRL_CTS     = 0x2,
+	UART_HW_FLOWCTRL_CTS_RTS = 0x3,
+} uart_hw_flowcontrol_t;
+
+typedef enum {
+	UART_SCLK_DEFAULT = 0,
+} uart_sclk_t;
+
+#endif
@@ -0,0 +1,27 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+
+#ifndef __OS_HEADER_H
+#define __OS_HEADER_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unistd.h>
+
+#ifndef DEFINE_LOG_TAG
+#define DEFINE_LOG_TAG(sTr) static const char TAG[] = #sTr
+#endif
+
+#ifndef likely
+#define likely(x)                                    __builtin_expect(!!(x), 1)
+#define unlikely(x)                                  __builtin_expect(!!(x), 0)
+#endif
+
+/* FreeRTOS calls still made directly by some drivers, in ms ticks */
+#define pdMS_TO_TICKS(ms)                            (ms)
+#define vTaskDelay(ticks)                            usleep((ticks) * 1000)
+#endif /*__OS_HEADER_H*/
@@ -0,0 +1,36 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+
+/* SDIO over the simulated bus */
+
+#ifndef __SDIO_WRAPPER_H_
+#define __SDIO_WRAPPER_H_
+
+#include <stdbool.h>
+
+#define MAX_TRANSPORT_BUFFER_SIZE        MAX_SDIO_BUFFER_SIZE
+#define ESP_HOSTED_SDIO_UNRESPONSIVE_CODE 0x107
+
+/* Hosted init function to init the SDIO host
+ * returns a pointer to the sdio context */
+void * hosted_sdio_init(void);
+
+/* Hosted SDIO deinit function
+ * expects a pointer to the sdio context */
+int hosted_sdio_deinit(void *ctx);
+
+/* Simulated card is always there, these only log */
+int hosted_sdio_card_init(void *ctx);
+int hosted_sdio_card_deinit(void *ctx);
+
+/* Slave register and CMD53 block access.
+ * Simulated bus locks itself, lock_required is not used */
+int hosted_sdio_read_reg(void *ctx, uint32_t reg, uint8_t *data, uint16_t size, bool lock_required);
+int hosted_sdio_write_reg(void *ctx, uint32_t reg, uint8_t *data, uint16_t size, bool lock_required);
+int hosted_sdio_read_block(void *ctx, uint32_t reg, uint8_t *data, uint16_t size, bool lock_required);
+int hosted_sdio_write_block(void *ctx, uint32_t reg, uint8_t *data, uint16_t size, bool lock_required);
+
+/* Blocks until slave raises an interrupt, or timeout */
+int hosted_sdio_wait_slave_intr(void *ctx, uint32_t ticks_to_wait);
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host config for the POSIX port, in place of the one menuconfig generates.
+ * Transport is picked by the build (see CMakeLists.txt), the rest are the
+ * Kconfig defaults. Any entry can be overridden with -D on the compiler
+ * command line.
+ */
+
+#ifndef __POSIX_SDKCONFIG_H__
+#define __POSIX_SDKCONFIG_H__
+
+#define CONFIG_ESP_HOSTED_ENABLED                       1
+#define CONFIG_ESP_HOSTED_DFLT_TASK_STACK               5120
+#define CONFIG_ESP_HOSTED_GPIO_SLAVE_RESET_SLAVE        7
+
+#if !defined(CONFIG_ESP_HOSTED_SPI_HOST_INTERFACE) && \
+    !defined(CONFIG_ESP_HOSTED_UART_HOST_INTERFACE) && \
+    !defined(CONFIG_ESP_HOSTED_SDIO_HOST_INTERFACE)
+#define CONFIG_ESP_HOSTED_SPI_HOST_INTERFACE            1
+#endif
+
+#define CONFIG_SLAVE_IDF_TARGET_ESP32C6                 1
+#define CONFIG_ESP_HOSTED_PRIV_WIFI_TX_SDIO_HIGH_THRESHOLD 80
+#define CONFIG_ESP_HOSTED_PRIV_WIFI_TX_SDIO_LOW_THRESHOLD  60
+
+/* SPI full duplex */
+#define CONFIG_ESP_HOSTED_SPI_MODE                      2
+#define CONFIG_ESP_HOSTED_SPI_CLK_FREQ                  40
+#define CONFIG_ESP_HOSTED_SPI_GPIO_MOSI                 1
+#define CONFIG_ESP_HOSTED_SPI_GPIO_MISO                 2
+#define CONFIG_ESP_HOSTED_SPI_GPIO_CLK                  3
+#define CONFIG_ESP_HOSTED_SPI_GPIO_CS                   4
+#define CONFIG_ESP_HOSTED_SPI_GPIO_HANDSHAKE            5
+#define CONFIG_ESP_HOSTED_SPI_GPIO_DATA_READY           6
+#define CONFIG_ESP_HOSTED_SPI_GPIO_RESET_SLAVE          7
+#define CONFIG_ESP_HOSTED_SPI_RESET_ACTIVE_HIGH         1
+#define CONFIG_ESP_HOSTED_SPI_TX_Q_SIZE                 20
+#define CONFIG_ESP_HOSTED_SPI_RX_Q_SIZE                 20
+#define CONFIG_ESP_HOSTED_SPI_CHECKSUM                  1
+#define CONFIG_ESP_HOSTED_SPI_PIPELINE                  1
+
+/* UART */
+#define CONFIG_ESP_HOSTED_UART_PORT                     1
+#define CONFIG_ESP_HOSTED_UART_BAUDRATE                 921600
+#define CONFIG_ESP_HOSTED_UART_NUM_DATA_BITS            8
+#define CONFIG_ESP_HOSTED_UART_PARITY                   0
+#define CONFIG_ESP_HOSTED_UART_STOP_BITS                0
+#define CONFIG_ESP_HOSTED_UART_PIN_TX                   1
+#define CONFIG_ESP_HOSTED_UART_PIN_RX                   2
+#define CONFIG_ESP_HOSTED_UART_PIN_RESET                7
+#define CONFIG_ESP_HOSTED_UART_RESET_ACTIVE_HIGH        1
+#define CONFIG_ESP_HOSTED_UART_TX_Q_SIZE                20
+#define CONFIG_ESP_HOSTED_UART_RX_Q_SIZE                20
+#define CONFIG_ESP_HOSTED_UART_CHECKSUM                 1
+
+/* SDIO */
+#define CONFIG_ESP_HOSTED_SDIO_CLOCK_FREQ_KHZ           40000
+#define CONFIG_ESP_HOSTED_SDIO_BUS_WIDTH                4
+#define CONFIG_ESP_HOSTED_SDIO_SLOT                     1
+#define CONFIG_ESP_HOSTED_SDIO_RESET_ACTIVE_HIGH        1
+#define CONFIG_ESP_HOSTED_SDIO_OPTIMIZATION_RX_STREAMING_MODE 1
+#define CONFIG_ESP_HOSTED_SDIO_TX_Q_SIZE                20
+#define CONFIG_ESP_HOSTED_SDIO_RX_Q_SIZE                20
+#define CONFIG_ESP_HOSTED_SDIO_CHECKSUM                 1
+#define CONFIG_ESP_HOSTED_SDIO_TX_AGGREGATION           1
+#define CONFIG_ESP_HOSTED_SDIO_TX_AGGREGATION_MAX_BUFS  4
+#define CONFIG_ESP_HOSTED_SDIO_TX_CREDIT                1
+
+/* Data path */
+#define CONFIG_ESP_HOSTED_PRIO_Q_WFQ                    1
+#define CONFIG_ESP_HOSTED_PRIO_Q_SERIAL_QUANTUM         1600
+#define CONFIG_ESP_HOSTED_PRIO_Q_BT_QUANTUM             1600
+#define CONFIG_ESP_HOSTED_PRIO_Q_OTHERS_QUANTUM         3200
+#define CONFIG_ESP_HOSTED_PRIO_Q_SERIAL_MAX_WAIT_MS     20
+#define CONFIG_ESP_HOSTED_PRIO_Q_BT_MAX_WAIT_MS         10
+#define CONFIG_ESP_HOSTED_PRIO_Q_OTHERS_MAX_WAIT_MS     0
+#define CONFIG_ESP_HOSTED_TRANSPORT_CRC32               1
+
+#define CONFIG_LOG_MAXIMUM_LEVEL                        3
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+
+/* In-process simulated bus and slave for the POSIX port
+ *
+ * The host transport driver runs unchanged on top of hosted_osi_funcs_t.
+ * Its bus calls (SPI transfers, UART reads/writes, SDIO register and block
+ * access) and GPIO calls are served by a software slave, which speaks the
+ * ESP-Hosted frame format:
+ *  - frames from host are checked (checksum / CRC32) and counted per
+ *    interface, and optionally echoed back to host
+ *  - frames queued with sim_slave_send() are delivered to host the way the
+ *    real slave would, raising data ready / handshake as per transport
+ *  - on SDIO, host writes are split into slave Rx buffers and aggregated
+ *    packets in each buffer are walked, and queued frames are read out by
+ *    host as one byte stream, as with the slave's streaming Rx
+ *
+ * Bus timing (clock rate and slave turnaround) is modelled, so transfer
+ * gaps and driver overheads show up in benchmarks as they would on target.
+ */
+
+#ifndef __SIM_BUS_H__
+#define __SIM_BUS_H__
+
+#include <stdint.h>
+
+typedef struct {
+	/* bus clock in bits per second, 0 for no wire delay */
+	uint32_t bus_bps;
+	/* time slave takes to re-arm after each transfer, in us */
+	uint32_t slave_turnaround_us;
+	/* echo each valid frame from host back to host */
+	uint8_t loopback;
+	/* slave frames carry CRC32 trailer instead of header checksum */
+	uint8_t crc32;
+} sim_bus_config_t;
+
+#define SIM_BUS_CONFIG_DEFAULT() {                                             \
+	.bus_bps = 40 * 1000 * 1000,                                               \
+	.slave_turnaround_us = 20,                                                 \
+	.loopback = 1,                                                             \
+	.crc32 = 0,                                                                \
+}
+
+typedef struct {
+	uint64_t transfers;
+	uint64_t dummy_transfers;
+	uint64_t host_frames;
+	uint64_t host_bytes;
+	uint64_t host_frames_bad;
+	uint64_t slave_frames;
+	uint64_t slave_bytes;
+	uint64_t slave_frames_dropped;
+} sim_bus_stats_t;
+
+/* To be called before transport is initialised */
+int sim_bus_configure(const sim_bus_config_t *config);
+
+/* Queue a frame from slave to host. Returns 0, or -1 if slave queue is full */
+int sim_slave_send(uint8_t if_type, uint8_t if_num, const uint8_t *payload,
+		uint16_t len, uint8_t flags);
+
+void sim_bus_get_stats(sim_bus_stats_t *stats);
+
+/* Called from bus side for every valid frame received from host.
+ * Default (weak) implementation does nothing */
+void sim_slave_rx_hook(uint8_t if_type, uint8_t if_num, const uint8_t *payload,
+		uint16_t len);
+
+/* -------- used by port ---------- */
+void * sim_bus_init(void);
+int sim_bus_deinit(void *ctx);
+
+int sim_gpio_read(uint32_t gpio_num);
+int sim_gpio_write(uint32_t gpio_num, uint32_t value);
+int sim_gpio_set_isr(uint32_t gpio_num, uint32_t intr_type,
+		void (*fn)(void *), void *arg);
+
+int sim_spi_transfer(const uint8_t *tx_buf, uint8_t *rx_buf, uint32_t len);
+/* Split form of sim_spi_transfer(), one transfer in flight at a time */
+int sim_spi_queue_transfer(const uint8_t *tx_buf, uint8_t *rx_buf, uint32_t len);
+int sim_spi_wait_transfer(void);
+
+int sim_uart_read(uint8_t *data, uint16_t size);
+int sim_uart_write(const uint8_t *data, uint16_t size);
+
+/* Slave registers (sdio_reg.h addresses) and CMD53 data at
+ * ESP_SLAVE_CMD53_END_ADDR - len, as on the ESP SDIO slave */
+int sim_sdio_read_reg(uint32_t reg, uint8_t *data, uint16_t size);
+int sim_sdio_write_reg(uint32_t reg, const uint8_t *data, uint16_t size);
+int sim_sdio_read_block(uint32_t addr, uint8_t *data, uint16_t size);
+int sim_sdio_write_block(uint32_t addr, const uint8_t *data, uint16_t size);
+/* Blocks until a slave interrupt is raised. Timeout in seconds, <0 for ever */
+int sim_sdio_wait_intr(int timeout);
+
+#endif
@@ -0,0 +1,26 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+
+/* SPI full duplex over the simulated bus */
+
+#ifndef __SPI_WRAPPER_H_
+#define __SPI_WRAPPER_H_
+
+#define MAX_TRANSPORT_BUFFER_SIZE        MAX_SPI_BUFFER_SIZE
+/* Hosted SPI init function
+ * returns a pointer to the spi context */
+void * hosted_spi_init(void);
+
+/* Hosted SPI deinit function */
+int hosted_spi_deinit(void *handle);
+
+/* Hosted SPI transfer function */
+int hosted_do_spi_transfer(void *trans);
+
+/* Start transfer in background, to be followed by hosted_wait_spi_transfer() */
+int hosted_queue_spi_transfer(void *trans);
+
+/* Wait for transfer queued by hosted_queue_spi_transfer() */
+int hosted_wait_spi_transfer(void);
+
+#endif
@@ -0,0 +1,24 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+
+/* UART over the simulated bus */
+
+#ifndef __UART_WRAPPER_H_
+#define __UART_WRAPPER_H_
+
+#define MAX_TRANSPORT_BUFFER_SIZE        MAX_UART_BUFFER_SIZE
+
+/* Hosted init function to init the UART interface
+ * returns a pointer to the UART context */
+void * hosted_uart_init(void);
+
+/* Hosted UART deinit function
+ * expects a pointer to the UART context */
+esp_err_t hosted_uart_deinit(void *ctx);
+
+/* Hosted UART functions to read / write
+ * Returns -1 (error) or number of bytes read / written */
+int hosted_uart_read(void *ctx, uint8_t *data, uint16_t size);
+int hosted_uart_write(void *ctx, uint8_t *data, uint16_t size);
+
+#endif
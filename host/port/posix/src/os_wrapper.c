@@ -0,0 +1,1218 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* hosted_osi_funcs_t for Linux / POSIX: pthreads, condition variables and
+ * CLOCK_MONOTONIC. Bus and GPIO calls go to the simulated bus. */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <inttypes.h>
+#include "os_wrapper.h"
+#include "esp_log.h"
+#include "esp_hosted_config.h"
+#include "esp_hosted_power_save.h"
+#include "sim_bus.h"
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+#include "spi_wrapper.h"
+#endif
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_UART
+#include "uart_wrapper.h"
+#endif
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+#include "sdio_wrapper.h"
+#endif
+
+DEFINE_LOG_TAG(os_wrapper_posix);
+
+struct mempool * nw_mp_g = NULL;
+
+struct hosted_config_t g_h = HOSTED_CONFIG_INIT_DEFAULT();
+
+/* Counting semaphore, also used for queues and timers */
+struct hosted_sem {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int count;
+	int max_count;
+};
+
+struct hosted_queue {
+	pthread_mutex_t lock;
+	pthread_cond_t not_empty;
+	pthread_cond_t not_full;
+	uint32_t num_elem;
+	uint32_t item_size;
+	uint32_t head;
+	uint32_t count;
+	uint8_t *items;
+};
+
+struct timer_handle_t {
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	uint8_t stop;
+	int type;
+	int duration_ms;
+	void (*timeout_handler)(void *);
+	void *arg;
+};
+
+/* -------- Time ------------- */
+
+static void hosted_abs_deadline(struct timespec *ts, uint64_t delay_us)
+{
+	clock_gettime(CLOCK_MONOTONIC, ts);
+	ts->tv_sec += delay_us / 1000000;
+	ts->tv_nsec += (delay_us % 1000000) * 1000;
+	if (ts->tv_nsec >= 1000000000) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000;
+	}
+}
+
+static void hosted_cond_init(pthread_cond_t *cond)
+{
+	pthread_condattr_t attr;
+
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(cond, &attr);
+	pthread_condattr_destroy(&attr);
+}
+
+/* Same convention as the other ports: 0 polls, <0 blocks, >0 is seconds.
+ * Called with lock held, returns 0 if woken, ETIMEDOUT otherwise */
+static int hosted_cond_wait(pthread_cond_t *cond, pthread_mutex_t *lock,
+		const struct timespec *deadline)
+{
+	if (!deadline)
+		return pthread_cond_wait(cond, lock);
+
+	return pthread_cond_timedwait(cond, lock, deadline);
+}
+
+static const struct timespec * hosted_timeout_to_deadline(int timeout,
+		struct timespec *ts)
+{
+	if (timeout < 0)
+		return NULL;
+
+	hosted_abs_deadline(ts, (uint64_t)SEC_TO_MICROSEC((uint64_t)timeout));
+	return ts;
+}
+
+/* -------- Memory ---------- */
+
+void * hosted_memcpy(void* dest, const void* src, uint32_t size)
+{
+	if (size && (!dest || !src)) {
+		if (!dest)
+			ESP_LOGE(TAG, "%s:%u dest is NULL\n", __func__, __LINE__);
+		if (!src)
+			ESP_LOGE(TAG, "%s:%u src is NULL\n", __func__, __LINE__);
+
+		assert(dest);
+		assert(src);
+		return NULL;
+	}
+
+	return memcpy(dest, src, size);
+}
+
+void * hosted_memset(void* buf, int val, size_t len)
+{
+	return memset(buf, val, len);
+}
+
+void* hosted_malloc(size_t size)
+{
+	return MALLOC(size);
+}
+
+void* hosted_calloc(size_t blk_no, size_t size)
+{
+	return calloc(blk_no, size);
+}
+
+void hosted_free(void* ptr)
+{
+	if(ptr) {
+		FREE(ptr);
+		ptr=NULL;
+	}
+}
+
+void *hosted_realloc(void *mem, size_t newsize)
+{
+	if (newsize == 0) {
+		HOSTED_FREE(mem);
+		return NULL;
+	}
+
+	return realloc(mem, newsize);
+}
+
+void *hosted_malloc_align(size_t size, size_t align)
+{
+	return aligned_alloc(align, (size + align - 1) & ~(align - 1));
+}
+
+void hosted_free_align(void* ptr)
+{
+	FREE(ptr);
+}
+
+void hosted_init_hook(void)
+{
+	/* This is hook to initialize port specific contexts, if any */
+}
+
+
+/* -------- Threads ---------- */
+
+struct hosted_thread_arg {
+	void (*start_routine)(void const *);
+	void *sr_arg;
+};
+
+static void * hosted_thread_entry(void *arg)
+{
+	struct hosted_thread_arg targ = *(struct hosted_thread_arg *)arg;
+
+	hosted_free(arg);
+	targ.start_routine(targ.sr_arg);
+
+	return NULL;
+}
+
+void *hosted_thread_create(const char *tname, uint32_t tprio, uint32_t tstack_size, void (*start_routine)(void const *), void *sr_arg)
+{
+	thread_handle_t *thread_handle = NULL;
+	struct hosted_thread_arg *targ = NULL;
+
+	if (!start_routine) {
+		ESP_LOGE(TAG, "start_routine is mandatory for thread create\n");
+		return NULL;
+	}
+
+	thread_handle = (thread_handle_t *)hosted_malloc(sizeof(thread_handle_t));
+	targ = (struct hosted_thread_arg *)hosted_malloc(sizeof(*targ));
+	if (!thread_handle || !targ) {
+		ESP_LOGE(TAG, "Failed to allocate thread handle\n");
+		HOSTED_FREE(thread_handle);
+		HOSTED_FREE(targ);
+		return NULL;
+	}
+
+	targ->start_routine = start_routine;
+	targ->sr_arg = sr_arg;
+
+	/* priority and stack size are left to the host OS */
+	if (pthread_create(thread_handle, NULL, hosted_thread_entry, targ)) {
+		ESP_LOGE(TAG, "Failed to create thread: %s\n", tname);
+		HOSTED_FREE(thread_handle);
+		HOSTED_FREE(targ);
+		return NULL;
+	}
+#ifdef __linux__
+	pthread_setname_np(*thread_handle, tname);
+#endif
+
+	return thread_handle;
+}
+
+int hosted_thread_cancel(void *thread_handle)
+{
+	thread_handle_t *thread_hdl = NULL;
+
+	if (!thread_handle) {
+		ESP_LOGE(TAG, "Invalid thread handle\n");
+		return RET_INVALID;
+	}
+
+	thread_hdl = (thread_handle_t *)thread_handle;
+
+	pthread_cancel(*thread_hdl);
+	pthread_join(*thread_hdl, NULL);
+
+	HOSTED_FREE(thread_handle);
+	return RET_OK;
+}
+
+/* -------- Sleeps -------------- */
+unsigned int hosted_usleep(unsigned int useconds)
+{
+	struct timespec ts = {
+		.tv_sec = useconds / 1000000,
+		.tv_nsec = (useconds % 1000000) * 1000,
+	};
+
+	while (nanosleep(&ts, &ts) && errno == EINTR);
+	return 0;
+}
+
+unsigned int hosted_msleep(unsigned int mseconds)
+{
+	return hosted_usleep(mseconds * 1000U);
+}
+
+unsigned int hosted_sleep(unsigned int seconds)
+{
+	return hosted_msleep(seconds * 1000UL);
+}
+
+/* Non sleepable delays - BLOCKING dead wait */
+unsigned int hosted_for_loop_delay(unsigned int number)
+{
+	volatile int idx = 0;
+	for (idx=0; idx<100*number; idx++) {
+	}
+	return 0;
+}
+
+
+/* -------- Queue --------------- */
+/* User expected to pass item's address to this func eg. &item */
+int hosted_queue_item(void * queue_handle, void *item, int timeout)
+{
+	struct hosted_queue *q = (struct hosted_queue *)queue_handle;
+	struct timespec ts;
+	const struct timespec *deadline = NULL;
+	uint32_t pos = 0;
+
+	if (!q) {
+		ESP_LOGE(TAG, "Uninitialized Q id 3\n");
+		return RET_INVALID;
+	}
+
+	deadline = hosted_timeout_to_deadline(timeout, &ts);
+
+	pthread_mutex_lock(&q->lock);
+	while (q->count == q->num_elem) {
+		if (!timeout || hosted_cond_wait(&q->not_full, &q->lock, deadline) == ETIMEDOUT) {
+			pthread_mutex_unlock(&q->lock);
+			return RET_FAIL;
+		}
+	}
+
+	pos = (q->head + q->count) % q->num_elem;
+	memcpy(q->items + pos * q->item_size, item, q->item_size);
+	q->count++;
+	pthread_cond_signal(&q->not_empty);
+	pthread_mutex_unlock(&q->lock);
+
+	return RET_OK;
+}
+
+void * hosted_create_queue(uint32_t qnum_elem, uint32_t qitem_size)
+{
+	struct hosted_queue *q = NULL;
+
+	q = (struct hosted_queue *)hosted_calloc(1, sizeof(*q));
+	if (!q) {
+		ESP_LOGE(TAG, "Q allocation failed\n");
+		return NULL;
+	}
+
+	q->items = hosted_malloc(qnum_elem * qitem_size);
+	if (!q->items) {
+		ESP_LOGE(TAG, "Q create failed\n");
+		HOSTED_FREE(q);
+		return NULL;
+	}
+
+	q->num_elem = qnum_elem;
+	q->item_size = qitem_size;
+	pthread_mutex_init(&q->lock, NULL);
+	hosted_cond_init(&q->not_empty);
+	hosted_cond_init(&q->not_full);
+
+	return q;
+}
+
+
+/* User expected to pass item's address to this func eg. &item */
+int hosted_dequeue_item(void * queue_handle, void *item, int timeout)
+{
+	struct hosted_queue *q = (struct hosted_queue *)queue_handle;
+	struct timespec ts;
+	const struct timespec *deadline = NULL;
+
+	if (!q) {
+		ESP_LOGE(TAG, "Uninitialized Q id 1\n\r");
+		return RET_INVALID;
+	}
+
+	deadline = hosted_timeout_to_deadline(timeout, &ts);
+
+	pthread_mutex_lock(&q->lock);
+	while (!q->count) {
+		if (!timeout || hosted_cond_wait(&q->not_empty, &q->lock, deadline) == ETIMEDOUT) {
+			pthread_mutex_unlock(&q->lock);
+			return RET_FAIL;
+		}
+	}
+
+	memcpy(item, q->items + q->head * q->item_size, q->item_size);
+	q->head = (q->head + 1) % q->num_elem;
+	q->count--;
+	pthread_cond_signal(&q->not_full);
+	pthread_mutex_unlock(&q->lock);
+
+	return 0;
+}
+
+int hosted_queue_msg_waiting(void * queue_handle)
+{
+	struct hosted_queue *q = (struct hosted_queue *)queue_handle;
+	int count = 0;
+
+	if (!q) {
+		ESP_LOGE(TAG, "Uninitialized Q id 9\n");
+		return RET_INVALID;
+	}
+
+	pthread_mutex_lock(&q->lock);
+	count = q->count;
+	pthread_mutex_unlock(&q->lock);
+
+	return count;
+}
+
+int hosted_destroy_queue(void * queue_handle)
+{
+	struct hosted_queue *q = (struct hosted_queue *)queue_handle;
+
+	if (!q) {
+		ESP_LOGE(TAG, "Uninitialized Q id 4\n");
+		return RET_INVALID;
+	}
+
+	pthread_cond_destroy(&q->not_empty);
+	pthread_cond_destroy(&q->not_full);
+	pthread_mutex_destroy(&q->lock);
+	HOSTED_FREE(q->items);
+	HOSTED_FREE(queue_handle);
+
+	return RET_OK;
+}
+
+
+int hosted_reset_queue(void * queue_handle)
+{
+	struct hosted_queue *q = (struct hosted_queue *)queue_handle;
+
+	if (!q) {
+		ESP_LOGE(TAG, "Uninitialized Q id 5\n");
+		return RET_INVALID;
+	}
+
+	pthread_mutex_lock(&q->lock);
+	q->head = 0;
+	q->count = 0;
+	pthread_cond_broadcast(&q->not_full);
+	pthread_mutex_unlock(&q->lock);
+
+	/* pdPASS, as returned by xQueueReset() */
+	return 1;
+}
+
+/* -------- Mutex --------------- */
+
+int hosted_unlock_mutex(void * mutex_handle)
+{
+	if (!mutex_handle) {
+		ESP_LOGE(TAG, "Uninitialized mut id 3\n");
+		return RET_INVALID;
+	}
+
+	if (pthread_mutex_unlock((mutex_handle_t *)mutex_handle))
+		return RET_FAIL;
+
+	return 0;
+}
+
+void * hosted_create_mutex(void)
+{
+	mutex_handle_t *mut_id = NULL;
+	pthread_mutexattr_t attr;
+
+	mut_id = (mutex_handle_t*)hosted_malloc(sizeof(mutex_handle_t));
+	if (!mut_id) {
+		ESP_LOGE(TAG, "mut allocation failed\n");
+		return NULL;
+	}
+
+	/* FreeRTOS mutexes are not recursive either, but tolerate unlock by
+	 * another task. Error checking type catches misuse in simulation */
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+	pthread_mutex_init(mut_id, &attr);
+	pthread_mutexattr_destroy(&attr);
+
+	return mut_id;
+}
+
+
+int hosted_lock_mutex(void * mutex_handle, int timeout)
+{
+	if (!mutex_handle) {
+		ESP_LOGE(TAG, "Uninitialized mut id 1\n\r");
+		return RET_INVALID;
+	}
+
+	/* blocking always, as on FreeRTOS port */
+	if (pthread_mutex_lock((mutex_handle_t *)mutex_handle))
+		return RET_FAIL;
+
+	return 0;
+}
+
+int hosted_destroy_mutex(void * mutex_handle)
+{
+	if (!mutex_handle) {
+		ESP_LOGE(TAG, "Uninitialized mut id 4\n");
+		return RET_INVALID;
+	}
+
+	pthread_mutex_destroy((mutex_handle_t *)mutex_handle);
+	HOSTED_FREE(mutex_handle);
+
+	return RET_OK;
+}
+
+/* -------- Semaphores ---------- */
+int hosted_post_semaphore(void * semaphore_handle)
+{
+	struct hosted_sem *sem = (struct hosted_sem *)semaphore_handle;
+	int ret = RET_OK;
+
+	if (!sem) {
+		ESP_LOGE(TAG, "Uninitialized sem id 3\n");
+		return RET_INVALID;
+	}
+
+	pthread_mutex_lock(&sem->lock);
+	if (sem->count < sem->max_count) {
+		sem->count++;
+		pthread_cond_signal(&sem->cond);
+	} else {
+		ret = RET_FAIL;
+	}
+	pthread_mutex_unlock(&sem->lock);
+
+	return ret;
+}
+
+/* No interrupts here: 'ISR' callers are simulated bus threads */
+int hosted_post_semaphore_from_isr(void * semaphore_handle)
+{
+	return hosted_post_semaphore(semaphore_handle);
+}
+
+void * hosted_create_semaphore(int maxCount)
+{
+	struct hosted_sem *sem = NULL;
+
+	sem = (struct hosted_sem *)hosted_calloc(1, sizeof(*sem));
+	if (!sem) {
+		ESP_LOGE(TAG, "Sem allocation failed\n");
+		return NULL;
+	}
+
+	pthread_mutex_init(&sem->lock, NULL);
+	hosted_cond_init(&sem->cond);
+	sem->max_count = maxCount > 1 ? maxCount : 1;
+
+	/* created given, as on FreeRTOS port */
+	sem->count = 1;
+
+	return sem;
+}
+
+
+int hosted_get_semaphore(void * semaphore_handle, int timeout)
+{
+	struct hosted_sem *sem = (struct hosted_sem *)semaphore_handle;
+	struct timespec ts;
+	const struct timespec *deadline = NULL;
+
+	if (!sem) {
+		ESP_LOGE(TAG, "Uninitialized sem id 1\n\r");
+		return RET_INVALID;
+	}
+
+	deadline = hosted_timeout_to_deadline(timeout, &ts);
+
+	pthread_mutex_lock(&sem->lock);
+	while (!sem->count) {
+		if (!timeout || hosted_cond_wait(&sem->cond, &sem->lock, deadline) == ETIMEDOUT) {
+			pthread_mutex_unlock(&sem->lock);
+			return RET_FAIL_TIMEOUT;
+		}
+	}
+	sem->count--;
+	pthread_mutex_unlock(&sem->lock);
+
+	return 0;
+}
+
+int hosted_destroy_semaphore(void * semaphore_handle)
+{
+	struct hosted_sem *sem = (struct hosted_sem *)semaphore_handle;
+
+	if (!sem) {
+		ESP_LOGE(TAG, "Uninitialized sem id 4\n");
+		assert(semaphore_handle);
+		return RET_INVALID;
+	}
+
+	pthread_cond_destroy(&sem->cond);
+	pthread_mutex_destroy(&sem->lock);
+	HOSTED_FREE(semaphore_handle);
+
+	return RET_OK;
+}
+
+static void hosted_sem_reset(struct hosted_sem *sem)
+{
+	pthread_mutex_lock(&sem->lock);
+	sem->count = 0;
+	pthread_mutex_unlock(&sem->lock);
+}
+
+/* -------- Tx ring ------------- */
+/* Same lock-free ring as the FreeRTOS port: per lane bounded MPSC ring with
+ * per slot sequence numbers. Only wakeups use the semaphores above.
+ */
+struct hosted_tx_lane {
+	atomic_uint head;              /* next slot to claim, producers */
+	uint32_t tail;                 /* next slot to read, consumer */
+	atomic_uint *seq;
+	uint8_t *items;
+};
+
+struct hosted_tx_ring {
+	uint32_t num_lanes;
+	uint32_t mask;
+	uint32_t item_size;
+	atomic_uint consumer_waiting;
+	atomic_uint producers_waiting;
+	struct hosted_sem *wakeup;
+	struct hosted_sem *space;
+	struct hosted_tx_lane lane[];
+};
+
+#define TX_RING_ALIGN(x)             (((x) + 7) & ~7)
+
+void * hosted_create_tx_ring(uint32_t num_lanes, uint32_t lane_depth, uint32_t item_size)
+{
+	struct hosted_tx_ring *ring = NULL;
+	uint32_t depth = 1;
+	size_t seq_off = 0;
+	size_t item_off = 0;
+	uint8_t *mem = NULL;
+	uint32_t i = 0, j = 0;
+
+	if (!num_lanes || !lane_depth || !item_size) {
+		ESP_LOGE(TAG, "Invalid Tx ring params\n");
+		return NULL;
+	}
+
+	/* power of two, so slot index is a mask of the position */
+	while (depth < lane_depth)
+		depth <<= 1;
+
+	seq_off = TX_RING_ALIGN(sizeof(struct hosted_tx_ring) +
+			num_lanes * sizeof(struct hosted_tx_lane));
+	item_off = TX_RING_ALIGN(seq_off + num_lanes * depth * sizeof(atomic_uint));
+
+	mem = hosted_calloc(1, item_off + num_lanes * depth * item_size);
+	if (!mem) {
+		ESP_LOGE(TAG, "Tx ring allocation failed\n");
+		return NULL;
+	}
+
+	ring = (struct hosted_tx_ring *)mem;
+	ring->num_lanes = num_lanes;
+	ring->mask = depth - 1;
+	ring->item_size = item_size;
+	atomic_init(&ring->consumer_waiting, 0);
+	atomic_init(&ring->producers_waiting, 0);
+
+	for (i = 0; i < num_lanes; i++) {
+		struct hosted_tx_lane *lane = &ring->lane[i];
+
+		atomic_init(&lane->head, 0);
+		lane->tail = 0;
+		lane->seq = (atomic_uint *)(mem + seq_off) + i * depth;
+		lane->items = mem + item_off + i * depth * item_size;
+		for (j = 0; j < depth; j++)
+			atomic_init(&lane->seq[j], j);
+	}
+
+	ring->wakeup = hosted_create_semaphore(1);
+	ring->space = hosted_create_semaphore(1);
+	if (!ring->wakeup || !ring->space) {
+		ESP_LOGE(TAG, "Tx ring sem create failed\n");
+		if (ring->wakeup)
+			hosted_destroy_semaphore(ring->wakeup);
+		if (ring->space)
+			hosted_destroy_semaphore(ring->space);
+		HOSTED_FREE(mem);
+		return NULL;
+	}
+	/* binary semaphores, start taken */
+	hosted_sem_reset(ring->wakeup);
+	hosted_sem_reset(ring->space);
+
+	return ring;
+}
+
+static int tx_ring_lane_push(struct hosted_tx_ring *ring,
+		struct hosted_tx_lane *lane, void *item)
+{
+	uint32_t pos = atomic_load_explicit(&lane->head, memory_order_relaxed);
+	uint32_t seq = 0;
+	int32_t diff = 0;
+
+	for (;;) {
+		seq = atomic_load_explicit(&lane->seq[pos & ring->mask], memory_order_acquire);
+		diff = (int32_t)(seq - pos);
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&lane->head, &pos, pos + 1,
+					memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			/* lane full */
+			return RET_FAIL;
+		} else {
+			pos = atomic_load_explicit(&lane->head, memory_order_relaxed);
+		}
+	}
+
+	memcpy(lane->items + (pos & ring->mask) * ring->item_size, item, ring->item_size);
+	atomic_store_explicit(&lane->seq[pos & ring->mask], pos + 1, memory_order_release);
+
+	return RET_OK;
+}
+
+static int tx_ring_lane_pop(struct hosted_tx_ring *ring,
+		struct hosted_tx_lane *lane, void *item)
+{
+	uint32_t pos = lane->tail;
+	uint32_t seq = atomic_load_explicit(&lane->seq[pos & ring->mask], memory_order_acquire);
+
+	if (seq != pos + 1)
+		return RET_FAIL;
+
+	memcpy(item, lane->items + (pos & ring->mask) * ring->item_size, ring->item_size);
+	atomic_store_explicit(&lane->seq[pos & ring->mask], pos + ring->mask + 1,
+			memory_order_release);
+	lane->tail = pos + 1;
+
+	return RET_OK;
+}
+
+static int tx_ring_lane_ready(struct hosted_tx_ring *ring, struct hosted_tx_lane *lane)
+{
+	return atomic_load_explicit(&lane->seq[lane->tail & ring->mask],
+			memory_order_acquire) == lane->tail + 1;
+}
+
+static void tx_ring_wake_producers(struct hosted_tx_ring *ring)
+{
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load_explicit(&ring->producers_waiting, memory_order_relaxed))
+		hosted_post_semaphore(ring->space);
+}
+
+/* Strict priority: lane 0 first */
+static int tx_ring_pop_any(struct hosted_tx_ring *ring, void *item)
+{
+	uint32_t i = 0;
+
+	for (i = 0; i < ring->num_lanes; i++) {
+		if (!tx_ring_lane_pop(ring, &ring->lane[i], item)) {
+			tx_ring_wake_producers(ring);
+			return RET_OK;
+		}
+	}
+
+	return RET_FAIL;
+}
+
+/* User expected to pass item's address to this func eg. &item */
+int hosted_tx_ring_push(void * ring_handle, uint32_t lane, void *item, int timeout)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+	int ret = RET_FAIL;
+
+	if (!ring || lane >= ring->num_lanes) {
+		ESP_LOGE(TAG, "Invalid Tx ring/lane\n");
+		return RET_INVALID;
+	}
+
+	while (tx_ring_lane_push(ring, &ring->lane[lane], item)) {
+		if (!timeout)
+			return RET_FAIL;
+
+		/* lane full: wait for the consumer to free a slot */
+		atomic_fetch_add(&ring->producers_waiting, 1);
+		ret = tx_ring_lane_push(ring, &ring->lane[lane], item);
+		if (ret && hosted_get_semaphore(ring->space, timeout)) {
+			atomic_fetch_sub(&ring->producers_waiting, 1);
+			return RET_FAIL_TIMEOUT;
+		}
+		atomic_fetch_sub(&ring->producers_waiting, 1);
+		if (!ret)
+			break;
+	}
+
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load_explicit(&ring->consumer_waiting, memory_order_relaxed) &&
+	    atomic_exchange(&ring->consumer_waiting, 0))
+		hosted_post_semaphore(ring->wakeup);
+
+	return RET_OK;
+}
+
+/* User expected to pass item's address to this func eg. &item */
+int hosted_tx_ring_pop_lane(void * ring_handle, uint32_t lane, void *item)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+
+	if (!ring || lane >= ring->num_lanes) {
+		ESP_LOGE(TAG, "Invalid Tx ring/lane\n");
+		return RET_INVALID;
+	}
+
+	if (tx_ring_lane_pop(ring, &ring->lane[lane], item))
+		return RET_FAIL;
+
+	tx_ring_wake_producers(ring);
+
+	return RET_OK;
+}
+
+/* Blocks until any lane has an item, for consumers doing their own lane pick */
+int hosted_tx_ring_wait(void * ring_handle, int timeout)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+	uint32_t i = 0;
+
+	if (!ring) {
+		ESP_LOGE(TAG, "Uninitialized Tx ring\n");
+		return RET_INVALID;
+	}
+
+	/* announce the sleep, then look once more so a push racing with
+	 * the flag is not missed */
+	atomic_store(&ring->consumer_waiting, 1);
+	atomic_thread_fence(memory_order_seq_cst);
+	for (i = 0; i < ring->num_lanes; i++) {
+		if (tx_ring_lane_ready(ring, &ring->lane[i])) {
+			atomic_store(&ring->consumer_waiting, 0);
+			return RET_OK;
+		}
+	}
+
+	if (!timeout || hosted_get_semaphore(ring->wakeup, timeout)) {
+		atomic_store(&ring->consumer_waiting, 0);
+		return RET_FAIL_TIMEOUT;
+	}
+
+	return RET_OK;
+}
+
+/* User expected to pass item's address to this func eg. &item */
+int hosted_tx_ring_pop(void * ring_handle, void *item, int timeout)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+
+	if (!ring) {
+		ESP_LOGE(TAG, "Uninitialized Tx ring\n");
+		return RET_INVALID;
+	}
+
+	for (;;) {
+		if (!tx_ring_pop_any(ring, item))
+			return RET_OK;
+
+		if (!timeout)
+			return RET_FAIL;
+
+		if (hosted_tx_ring_wait(ring, timeout))
+			return RET_FAIL_TIMEOUT;
+	}
+}
+
+int hosted_destroy_tx_ring(void * ring_handle)
+{
+	struct hosted_tx_ring *ring = (struct hosted_tx_ring *)ring_handle;
+
+	if (!ring) {
+		ESP_LOGE(TAG, "Uninitialized Tx ring\n");
+		return RET_INVALID;
+	}
+
+	hosted_destroy_semaphore(ring->wakeup);
+	hosted_destroy_semaphore(ring->space);
+	HOSTED_FREE(ring_handle);
+
+	return RET_OK;
+}
+
+#ifdef H_USE_MEMPOOL
+void* hosted_create_lock_mempool(void)
+{
+	spinlock_handle_t *lock = hosted_malloc(sizeof(spinlock_handle_t));
+
+	if (!lock) {
+		ESP_LOGE(TAG, "mut allocation failed\n");
+		return NULL;
+	}
+	pthread_mutex_init(lock, NULL);
+
+	return lock;
+}
+
+void hosted_lock_mempool(void *lock_handle)
+{
+	assert(lock_handle);
+	pthread_mutex_lock((spinlock_handle_t *)lock_handle);
+}
+
+void hosted_unlock_mempool(void *lock_handle)
+{
+	assert(lock_handle);
+	pthread_mutex_unlock((spinlock_handle_t *)lock_handle);
+}
+#endif
+
+/* -------- Timers  ---------- */
+/* One thread per timer, callbacks run on it, like esp_timer task */
+static void * hosted_timer_thread(void *arg)
+{
+	struct timer_handle_t *timer = (struct timer_handle_t *)arg;
+	struct timespec deadline;
+
+	pthread_mutex_lock(&timer->lock);
+	hosted_abs_deadline(&deadline, MILLISEC_TO_MICROSEC((uint64_t)timer->duration_ms));
+	while (!timer->stop) {
+		if (pthread_cond_timedwait(&timer->cond, &timer->lock, &deadline) != ETIMEDOUT)
+			continue;
+
+		pthread_mutex_unlock(&timer->lock);
+		timer->timeout_handler(timer->arg);
+		pthread_mutex_lock(&timer->lock);
+
+		if (timer->type != H_TIMER_TYPE_PERIODIC)
+			break;
+
+		/* periodic: next expiry from previous one, no drift */
+		deadline.tv_sec += timer->duration_ms / 1000;
+		deadline.tv_nsec += (timer->duration_ms % 1000) * 1000000L;
+		if (deadline.tv_nsec >= 1000000000) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000;
+		}
+	}
+	pthread_mutex_unlock(&timer->lock);
+
+	return NULL;
+}
+
+int hosted_timer_stop(void *timer_handle)
+{
+	struct timer_handle_t *timer = (struct timer_handle_t *)timer_handle;
+
+	ESP_LOGD(TAG, "Stop the timer\n");
+	if (!timer)
+		return RET_FAIL;
+
+	pthread_mutex_lock(&timer->lock);
+	timer->stop = 1;
+	pthread_cond_signal(&timer->cond);
+	pthread_mutex_unlock(&timer->lock);
+
+	/* stop may be called from the timer callback itself */
+	if (pthread_equal(pthread_self(), timer->thread))
+		pthread_detach(timer->thread);
+	else
+		pthread_join(timer->thread, NULL);
+
+	pthread_cond_destroy(&timer->cond);
+	pthread_mutex_destroy(&timer->lock);
+	HOSTED_FREE(timer_handle);
+
+	return RET_OK;
+}
+
+void *hosted_timer_start(const char *name, int duration_ms, int type,
+		void (*timeout_handler)(void *), void *arg)
+{
+	struct timer_handle_t *timer_handle = NULL;
+
+	ESP_LOGD(TAG, "Start the timer %u\n", duration_ms);
+
+	if (type != H_TIMER_TYPE_PERIODIC && type != H_TIMER_TYPE_ONESHOT) {
+		ESP_LOGE(TAG, "Unsupported timer type. supported: one_shot, periodic\n");
+		return NULL;
+	}
+
+	timer_handle = (struct timer_handle_t *)hosted_calloc(1,
+			sizeof(struct timer_handle_t));
+	if (!timer_handle) {
+		ESP_LOGE(TAG, "Memory allocation failed for timer\n");
+		return NULL;
+	}
+
+	timer_handle->type = type;
+	timer_handle->duration_ms = duration_ms;
+	timer_handle->timeout_handler = timeout_handler;
+	timer_handle->arg = arg;
+	pthread_mutex_init(&timer_handle->lock, NULL);
+	hosted_cond_init(&timer_handle->cond);
+
+	if (pthread_create(&timer_handle->thread, NULL, hosted_timer_thread, timer_handle)) {
+		ESP_LOGE(TAG, "Failed to create timer %s", name);
+		pthread_cond_destroy(&timer_handle->cond);
+		pthread_mutex_destroy(&timer_handle->lock);
+		HOSTED_FREE(timer_handle);
+		return NULL;
+	}
+
+	return timer_handle;
+}
+
+/* Monotonic time since boot, wraps after ~49 days */
+uint32_t hosted_get_time_ms(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000);
+}
+
+
+/* GPIO */
+
+int hosted_config_gpio(void* gpio_port, uint32_t gpio_num, uint32_t mode)
+{
+	return 0;
+}
+
+int hosted_setup_gpio_interrupt(void* gpio_port, uint32_t gpio_num, uint32_t intr_type, void (*fn)(void *), void *arg)
+{
+	return sim_gpio_set_isr(gpio_num, intr_type, fn, arg);
+}
+
+int hosted_teardown_gpio_interrupt(void* gpio_port, uint32_t gpio_num)
+{
+	return sim_gpio_set_isr(gpio_num, H_GPIO_INTR_DISABLE, NULL, NULL);
+}
+
+int hosted_read_gpio(void*gpio_port, uint32_t gpio_num)
+{
+	return sim_gpio_read(gpio_num);
+}
+
+int hosted_write_gpio(void* gpio_port, uint32_t gpio_num, uint32_t value)
+{
+	return sim_gpio_write(gpio_num, value);
+}
+
+int hosted_hold_gpio(void* gpio_port, uint32_t gpio_num, uint32_t hold_value)
+{
+	return 0;
+}
+
+int hosted_pull_gpio(void* gpio_port, uint32_t gpio_num, uint32_t pull_value, uint32_t enable)
+{
+	return 0;
+}
+
+
+int hosted_wifi_event_post(int32_t event_id,
+		void* event_data, size_t event_data_size, uint32_t ticks_to_wait)
+{
+	ESP_LOGV(TAG, "event %d recvd --> event_data:%p event_data_size: %zu\n",
+			(int)event_id, event_data, event_data_size);
+	return 0;
+}
+
+void hosted_log_write(int  level,
+					const char *tag,
+					const char *format, ...)
+{
+	va_list list;
+	va_start(list, format);
+	vprintf(format, list);
+	va_end(list);
+}
+
+static const char log_level_char[] = { 'N', 'E', 'W', 'I', 'D', 'V' };
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+	va_list list;
+
+	printf("%c (%" PRIu32 ") %s: ", log_level_char[level], hosted_get_time_ms(), tag);
+	va_start(list, format);
+	vprintf(format, list);
+	va_end(list);
+	/* most driver logs carry no newline, as IDF adds one */
+	if (format[0] && format[strlen(format) - 1] != '\n')
+		putchar('\n');
+}
+
+void esp_log_buffer_hexdump_internal(const char *tag, const void *buffer,
+		uint16_t buff_len, esp_log_level_t level)
+{
+	const uint8_t *buf = (const uint8_t *)buffer;
+	char line[16 * 3 + 1];
+	uint16_t i = 0, j = 0;
+
+	for (i = 0; i < buff_len; i += 16) {
+		for (j = 0; j < 16 && i + j < buff_len; j++)
+			snprintf(&line[j * 3], 4, "%02x ", buf[i + j]);
+		line[j * 3] = '\0';
+		esp_log_write(level, tag, "0x%p   %s", buf + i, line);
+	}
+}
+
+int hosted_restart_host(void)
+{
+	ESP_LOGE(TAG, "Host restart requested, exiting");
+	exit(EXIT_FAILURE);
+	return 0;
+}
+
+
+int hosted_config_host_power_save(uint32_t power_save_type, void* gpio_port, uint32_t gpio_num, int level)
+{
+	return -1;
+}
+
+int hosted_start_host_power_save(uint32_t power_save_type)
+{
+	if (power_save_type == HOSTED_POWER_SAVE_TYPE_NONE)
+		return 0;
+
+	return -1;
+}
+
+
+int hosted_get_host_wakeup_or_reboot_reason(void)
+{
+	return HOSTED_WAKEUP_NORMAL_REBOOT;
+}
+
+
+hosted_osi_funcs_t g_hosted_osi_funcs = {
+	._h_memcpy                   =  hosted_memcpy                  ,
+	._h_memset                   =  hosted_memset                  ,
+	._h_malloc                   =  hosted_malloc                  ,
+	._h_calloc                   =  hosted_calloc                  ,
+	._h_free                     =  hosted_free                    ,
+	._h_realloc                  =  hosted_realloc                 ,
+	._h_malloc_align             =  hosted_malloc_align            ,
+	._h_free_align               =  hosted_free_align              ,
+	._h_thread_create            =  hosted_thread_create           ,
+	._h_thread_cancel            =  hosted_thread_cancel           ,
+	._h_msleep                   =  hosted_msleep                  ,
+	._h_usleep                   =  hosted_usleep                  ,
+	._h_sleep                    =  hosted_sleep                   ,
+	._h_blocking_delay           =  hosted_for_loop_delay          ,
+	._h_queue_item               =  hosted_queue_item              ,
+	._h_create_queue             =  hosted_create_queue            ,
+	._h_queue_msg_waiting        =  hosted_queue_msg_waiting       ,
+	._h_dequeue_item             =  hosted_dequeue_item            ,
+	._h_destroy_queue            =  hosted_destroy_queue           ,
+	._h_reset_queue              =  hosted_reset_queue             ,
+	._h_unlock_mutex             =  hosted_unlock_mutex            ,
+	._h_create_mutex             =  hosted_create_mutex            ,
+	._h_lock_mutex               =  hosted_lock_mutex              ,
+	._h_destroy_mutex            =  hosted_destroy_mutex           ,
+	._h_post_semaphore           =  hosted_post_semaphore          ,
+	._h_post_semaphore_from_isr  =  hosted_post_semaphore_from_isr ,
+	._h_create_semaphore         =  hosted_create_semaphore        ,
+	._h_get_semaphore            =  hosted_get_semaphore           ,
+	._h_destroy_semaphore        =  hosted_destroy_semaphore       ,
+	._h_timer_stop               =  hosted_timer_stop              ,
+	._h_timer_start              =  hosted_timer_start             ,
+	._h_get_time_ms              =  hosted_get_time_ms             ,
+	._h_create_tx_ring           =  hosted_create_tx_ring          ,
+	._h_tx_ring_push             =  hosted_tx_ring_push            ,
+	._h_tx_ring_pop              =  hosted_tx_ring_pop             ,
+	._h_tx_ring_pop_lane         =  hosted_tx_ring_pop_lane        ,
+	._h_tx_ring_wait             =  hosted_tx_ring_wait            ,
+	._h_destroy_tx_ring          =  hosted_destroy_tx_ring         ,
+#ifdef H_USE_MEMPOOL
+	._h_create_lock_mempool      =  hosted_create_lock_mempool     ,
+	._h_lock_mempool             =  hosted_lock_mempool            ,
+	._h_unlock_mempool           =  hosted_unlock_mempool          ,
+#endif
+	._h_config_gpio              =  hosted_config_gpio             ,
+	._h_config_gpio_as_interrupt =  hosted_setup_gpio_interrupt,
+	._h_teardown_gpio_interrupt  = hosted_teardown_gpio_interrupt,
+	._h_hold_gpio                = hosted_hold_gpio,
+	._h_read_gpio                =  hosted_read_gpio               ,
+	._h_write_gpio               =  hosted_write_gpio              ,
+	._h_pull_gpio                = hosted_pull_gpio,
+
+	._h_get_host_wakeup_or_reboot_reason = hosted_get_host_wakeup_or_reboot_reason,
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+	._h_bus_init                 =  hosted_spi_init                ,
+	._h_bus_deinit               =  hosted_spi_deinit              ,
+	._h_do_bus_transfer          =  hosted_do_spi_transfer         ,
+	._h_queue_bus_transfer       =  hosted_queue_spi_transfer      ,
+	._h_wait_bus_transfer        =  hosted_wait_spi_transfer       ,
+#endif
+	._h_event_wifi_post          =  hosted_wifi_event_post         ,
+	._h_printf                   =  hosted_log_write               ,
+	._h_hosted_init_hook         =  hosted_init_hook               ,
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_UART
+	._h_bus_init                 = hosted_uart_init                ,
+	._h_bus_deinit               = hosted_uart_deinit              ,
+	._h_uart_read                = hosted_uart_read                ,
+	._h_uart_write               = hosted_uart_write               ,
+#endif
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	._h_bus_init                 = hosted_sdio_init                ,
+	._h_bus_deinit               = hosted_sdio_deinit              ,
+	._h_sdio_card_init           = hosted_sdio_card_init           ,
+	._h_sdio_card_deinit         = hosted_sdio_card_deinit         ,
+	._h_sdio_read_reg            = hosted_sdio_read_reg            ,
+	._h_sdio_write_reg           = hosted_sdio_write_reg           ,
+	._h_sdio_read_block          = hosted_sdio_read_block          ,
+	._h_sdio_write_block         = hosted_sdio_write_block         ,
+	._h_sdio_wait_slave_intr     = hosted_sdio_wait_slave_intr     ,
+#endif
+	._h_restart_host             = hosted_restart_host             ,
+
+	._h_config_host_power_save_hal_impl = hosted_config_host_power_save,
+	._h_start_host_power_save_hal_impl = hosted_start_host_power_save,
+};
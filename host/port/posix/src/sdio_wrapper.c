@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "esp_log.h"
+#include "os_wrapper.h"
+#include "transport_drv.h"
+#include "sdio_wrapper.h"
+#include "sim_bus.h"
+
+DEFINE_LOG_TAG(sdio_wrapper);
+
+#define SDIO_FAIL_IF_NULL_CTX(x) do {                      \
+		if (!x) return ESP_FAIL;                           \
+	} while (0);
+
+void * hosted_sdio_init(void)
+{
+	ESP_LOGI(TAG, "Transport: SDIO (simulated), Clk:%uKHz Width:%u TxQ:%u RxQ:%u",
+			H_SDIO_CLOCK_FREQ_KHZ, H_SDIO_BUS_WIDTH, H_SDIO_TX_Q, H_SDIO_RX_Q);
+
+	return sim_bus_init();
+}
+
+int hosted_sdio_deinit(void *ctx)
+{
+	SDIO_FAIL_IF_NULL_CTX(ctx);
+
+	if (sim_bus_deinit(ctx))
+		return ESP_FAIL;
+
+	ESP_LOGI(TAG, "SDIO deinitialized");
+	return ESP_OK;
+}
+
+int hosted_sdio_card_init(void *ctx)
+{
+	SDIO_FAIL_IF_NULL_CTX(ctx);
+
+	ESP_LOGI(TAG, "SDIO card ready");
+	return ESP_OK;
+}
+
+int hosted_sdio_card_deinit(void *ctx)
+{
+	SDIO_FAIL_IF_NULL_CTX(ctx);
+
+	return ESP_OK;
+}
+
+int hosted_sdio_read_reg(void *ctx, uint32_t reg, uint8_t *data, uint16_t size, bool lock_required)
+{
+	SDIO_FAIL_IF_NULL_CTX(ctx);
+
+	return sim_sdio_read_reg(reg, data, size);
+}
+
+int hosted_sdio_write_reg(void *ctx, uint32_t reg, uint8_t *data, uint16_t size, bool lock_required)
+{
+	SDIO_FAIL_IF_NULL_CTX(ctx);
+
+	return sim_sdio_write_reg(reg, data, size);
+}
+
+int hosted_sdio_read_block(void *ctx, uint32_t reg, uint8_t *data, uint16_t size, bool lock_required)
+{
+	SDIO_FAIL_IF_NULL_CTX(ctx);
+
+	return sim_sdio_read_block(reg, data, size);
+}
+
+int hosted_sdio_write_block(void *ctx, uint32_t reg, uint8_t *data, uint16_t size, bool lock_required)
+{
+	SDIO_FAIL_IF_NULL_CTX(ctx);
+
+	return sim_sdio_write_block(reg, data, size);
+}
+
+int hosted_sdio_wait_slave_intr(void *ctx, uint32_t ticks_to_wait)
+{
+	SDIO_FAIL_IF_NULL_CTX(ctx);
+
+	/* HOSTED_BLOCK_MAX comes in as all ones */
+	return sim_sdio_wait_intr((int)ticks_to_wait);
+}
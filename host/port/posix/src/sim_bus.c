@@ -0,0 +1,759 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+#include "os_wrapper.h"
+#include "esp_hosted_header.h"
+#include "esp_hosted_checksum.h"
+#include "esp_hosted_crc32.h"
+#include "esp_hosted_interface.h"
+#include "endian.h"
+#include "sim_bus.h"
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+#include "sdio_reg.h"
+#endif
+
+DEFINE_LOG_TAG(sim_bus);
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+#define SIM_FRAME_MAX                    MAX_SPI_BUFFER_SIZE
+#define SIM_HOST_CHECKSUM                1
+#elif H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+#define SIM_FRAME_MAX                    MAX_SDIO_BUFFER_SIZE
+#define SIM_HOST_CHECKSUM                H_SDIO_CHECKSUM
+/* slave defaults CONFIG_ESP_SDIO_RX_Q_SIZE and CONFIG_ESP_SDIO_TX_Q_SIZE.
+ * Tx queue depth also bounds the stream host reads in one go */
+#define SIM_SDIO_SLAVE_RX_BUFS           20
+#define SIM_SLAVE_TXQ_LEN                20
+#else
+#define SIM_FRAME_MAX                    MAX_UART_BUFFER_SIZE
+#define SIM_HOST_CHECKSUM                H_UART_CHECKSUM
+#endif
+
+#ifndef SIM_SLAVE_TXQ_LEN
+#define SIM_SLAVE_TXQ_LEN                64
+#endif
+#define SIM_MAX_GPIO_ISR                 4
+
+enum {
+	SIM_XFER_IDLE,
+	SIM_XFER_QUEUED,
+	SIM_XFER_DONE,
+};
+
+struct sim_frame {
+	uint16_t len;
+	uint16_t pos;
+	uint8_t buf[SIM_FRAME_MAX];
+};
+
+struct sim_gpio_isr {
+	uint32_t gpio_num;
+	void (*fn)(void *);
+	void *arg;
+};
+
+struct sim_bus_ctx {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	uint8_t running;
+
+	/* slave to host frames */
+	struct sim_frame *txq;
+	uint32_t txq_head;
+	uint32_t txq_count;
+	uint16_t seq_num;
+
+	uint8_t hs_active;
+	uint8_t dr_active;
+	struct sim_gpio_isr isr[SIM_MAX_GPIO_ISR];
+
+	/* SPI transfer in flight */
+	pthread_t bus_thread;
+	const uint8_t *xfer_tx;
+	uint8_t *xfer_rx;
+	uint32_t xfer_len;
+	uint8_t xfer_state;
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	uint8_t sdio_regs[ESP_ADDRESS_MASK + 1];
+	uint32_t sdio_int_raw;
+	/* bytes queued for host, mod ESP_RX_BYTE_MAX, and as last read by host */
+	uint32_t sdio_rx_len;
+	uint32_t sdio_rx_len_read;
+	/* slave Rx buffers handed back to host, mod ESP_TX_BUFFER_MAX */
+	uint32_t sdio_token;
+#endif
+
+	sim_bus_stats_t stats;
+};
+
+static sim_bus_config_t sim_cfg = SIM_BUS_CONFIG_DEFAULT();
+static struct sim_bus_ctx *sim = NULL;
+
+__attribute__((weak)) void sim_slave_rx_hook(uint8_t if_type, uint8_t if_num,
+		const uint8_t *payload, uint16_t len)
+{
+}
+
+int sim_bus_configure(const sim_bus_config_t *config)
+{
+	if (!config || sim)
+		return -1;
+
+	sim_cfg = *config;
+	return 0;
+}
+
+void sim_bus_get_stats(sim_bus_stats_t *stats)
+{
+	if (!stats || !sim)
+		return;
+
+	pthread_mutex_lock(&sim->lock);
+	*stats = sim->stats;
+	pthread_mutex_unlock(&sim->lock);
+}
+
+/* Sleeps rather than spins, so the slave does not steal CPU from the host
+ * threads under test. Timer slack is cut down in sim_bus_init() */
+static void sim_delay_us(uint64_t us)
+{
+	struct timespec ts;
+
+	if (!us)
+		return;
+
+	ts.tv_sec = us / 1000000;
+	ts.tv_nsec = (us % 1000000) * 1000;
+	while (nanosleep(&ts, &ts) && errno == EINTR);
+}
+
+/* Time to clock 'bits' out at configured bus rate */
+static void sim_wire_delay(uint64_t bits)
+{
+	if (sim_cfg.bus_bps)
+		sim_delay_us(bits * 1000000 / sim_cfg.bus_bps);
+}
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+/* Fire ISR of a line that just went active. Called without lock held */
+static void sim_gpio_raise(uint32_t gpio_num)
+{
+	void (*fn)(void *) = NULL;
+	void *arg = NULL;
+	int i = 0;
+
+	pthread_mutex_lock(&sim->lock);
+	for (i = 0; i < SIM_MAX_GPIO_ISR; i++) {
+		if (sim->isr[i].fn && sim->isr[i].gpio_num == gpio_num) {
+			fn = sim->isr[i].fn;
+			arg = sim->isr[i].arg;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&sim->lock);
+
+	if (fn)
+		fn(arg);
+}
+#endif
+
+int sim_gpio_set_isr(uint32_t gpio_num, uint32_t intr_type,
+		void (*fn)(void *), void *arg)
+{
+	int i = 0, free_idx = -1;
+
+	if (!sim)
+		return -1;
+
+	pthread_mutex_lock(&sim->lock);
+	for (i = 0; i < SIM_MAX_GPIO_ISR; i++) {
+		if (sim->isr[i].fn && sim->isr[i].gpio_num == gpio_num) {
+			free_idx = i;
+			break;
+		}
+		if (!sim->isr[i].fn && free_idx < 0)
+			free_idx = i;
+	}
+
+	if (free_idx >= 0) {
+		/* lines only ever raise an interrupt on going active */
+		sim->isr[free_idx].gpio_num = gpio_num;
+		sim->isr[free_idx].fn = (intr_type == H_GPIO_INTR_DISABLE) ? NULL : fn;
+		sim->isr[free_idx].arg = arg;
+	}
+	pthread_mutex_unlock(&sim->lock);
+
+	return (free_idx >= 0) ? 0 : -1;
+}
+
+int sim_gpio_read(uint32_t gpio_num)
+{
+	int val = 0;
+
+	if (!sim)
+		return 0;
+
+	pthread_mutex_lock(&sim->lock);
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+	if (gpio_num == H_GPIO_HANDSHAKE_Pin)
+		val = sim->hs_active ? H_HS_VAL_ACTIVE : H_HS_VAL_INACTIVE;
+	else if (gpio_num == H_GPIO_DATA_READY_Pin)
+		val = sim->dr_active ? H_DR_VAL_ACTIVE : H_DR_VAL_INACTIVE;
+#endif
+	pthread_mutex_unlock(&sim->lock);
+
+	return val;
+}
+
+int sim_gpio_write(uint32_t gpio_num, uint32_t value)
+{
+	/* only slave reset is driven by host, slave is always up */
+	return 0;
+}
+
+int sim_slave_send(uint8_t if_type, uint8_t if_num, const uint8_t *payload,
+		uint16_t len, uint8_t flags)
+{
+	struct esp_payload_header *h = NULL;
+	struct sim_frame *frame = NULL;
+	uint16_t trailer_len = sim_cfg.crc32 ? H_ESP_PAYLOAD_CRC32_LEN : 0;
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+	uint8_t raise_dr = 0;
+#endif
+
+	if (!sim || (len && !payload) ||
+	    (sizeof(struct esp_payload_header) + len + trailer_len > SIM_FRAME_MAX))
+		return -1;
+
+	pthread_mutex_lock(&sim->lock);
+	if (sim->txq_count == SIM_SLAVE_TXQ_LEN) {
+		sim->stats.slave_frames_dropped++;
+		pthread_mutex_unlock(&sim->lock);
+		return -1;
+	}
+
+	frame = &sim->txq[(sim->txq_head + sim->txq_count) % SIM_SLAVE_TXQ_LEN];
+	h = (struct esp_payload_header *)frame->buf;
+	memset(h, 0, sizeof(*h));
+	h->if_type = if_type;
+	h->if_num = if_num;
+	h->flags = flags;
+	h->len = htole16(len);
+	h->offset = htole16(sizeof(struct esp_payload_header));
+	h->seq_num = htole16(sim->seq_num++);
+	if (len)
+		memcpy(frame->buf + sizeof(*h), payload, len);
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	/* piggyback the token count, as slave does */
+	if (H_HDR_CAN_CARRY_TX_CREDIT(h))
+		H_HDR_SET_TX_CREDIT(h, sim->sdio_token);
+#endif
+
+	if (trailer_len) {
+		h->flags |= FLAG_CRC32;
+		esp_frame_crc32_fill(h);
+	} else {
+		h->checksum = htole16(compute_checksum(frame->buf, sizeof(*h) + len));
+	}
+
+	frame->len = sizeof(*h) + len + trailer_len;
+	frame->pos = 0;
+	sim->txq_count++;
+
+	sim->stats.slave_frames++;
+	sim->stats.slave_bytes += len;
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+	raise_dr = !sim->dr_active;
+#endif
+	sim->dr_active = 1;
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	sim->sdio_rx_len = (sim->sdio_rx_len + frame->len) % ESP_RX_BYTE_MAX;
+	sim->sdio_int_raw |= BIT(SDIO_INT_NEW_PACKET);
+#endif
+	pthread_cond_broadcast(&sim->cond);
+	pthread_mutex_unlock(&sim->lock);
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+	if (raise_dr)
+		sim_gpio_raise(H_GPIO_DATA_READY_Pin);
+#endif
+
+	return 0;
+}
+
+/* Frame as the slave sees it. Returns bytes consumed from buf */
+static uint32_t sim_slave_rx_frame(uint8_t *buf, uint32_t buf_len)
+{
+	struct esp_payload_header *h = (struct esp_payload_header *)buf;
+	struct esp_payload_header hdr;
+	uint16_t len = 0, offset = 0, trailer_len = 0;
+	uint8_t frame_ok = 1;
+
+	if (buf_len < sizeof(*h))
+		return buf_len;
+
+	len = le16toh(h->len);
+	offset = le16toh(h->offset);
+	trailer_len = esp_frame_trailer_len(h);
+
+	if (h->if_type == ESP_MAX_IF || (!len && !h->flags))
+		return buf_len;
+
+	if ((offset != sizeof(*h)) || (offset + len + trailer_len > buf_len)) {
+		frame_ok = 0;
+	} else if (h->flags & FLAG_CRC32) {
+		frame_ok = !esp_frame_crc32_verify(h);
+	} else if (SIM_HOST_CHECKSUM) {
+		hdr = *h;
+		hdr.checksum = 0;
+		frame_ok = (le16toh(h->checksum) == compute_checksum_update(
+				compute_checksum((uint8_t *)&hdr, sizeof(hdr)),
+				buf + offset, len));
+	}
+
+	pthread_mutex_lock(&sim->lock);
+	if (frame_ok) {
+		sim->stats.host_frames++;
+		sim->stats.host_bytes += len;
+	} else {
+		sim->stats.host_frames_bad++;
+	}
+	pthread_mutex_unlock(&sim->lock);
+
+	if (!frame_ok) {
+		ESP_LOGW(TAG, "bad frame from host: if_type %u len %u\n", h->if_type, len);
+		return buf_len;
+	}
+
+	sim_slave_rx_hook(h->if_type, h->if_num, buf + offset, len);
+	if (sim_cfg.loopback)
+		sim_slave_send(h->if_type, h->if_num, buf + offset, len,
+				h->flags & ~(FLAG_CRC32 | FLAG_TX_CREDIT | FLAG_AGGR_NEXT_PKT));
+
+	return offset + len + trailer_len;
+}
+
+/* -------- SPI ---------- */
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+
+/* Slave side of the full duplex bus, one transfer at a time:
+ * handshake drops, slave's pre-loaded frame and host's frame cross on the
+ * wire, then handshake comes back once slave re-armed */
+static void * sim_spi_bus_thread(void *arg)
+{
+	struct sim_frame *frame = NULL;
+	uint32_t len = 0;
+	uint8_t slave_had_data = 0;
+
+	for (;;) {
+		pthread_mutex_lock(&sim->lock);
+		while (sim->running && sim->xfer_state != SIM_XFER_QUEUED)
+			pthread_cond_wait(&sim->cond, &sim->lock);
+		if (!sim->running) {
+			pthread_mutex_unlock(&sim->lock);
+			break;
+		}
+
+		sim->hs_active = 0;
+		len = sim->xfer_len;
+
+		slave_had_data = !!sim->txq_count;
+		if (slave_had_data) {
+			frame = &sim->txq[sim->txq_head];
+			memcpy(sim->xfer_rx, frame->buf, min(frame->len, len));
+			sim->txq_head = (sim->txq_head + 1) % SIM_SLAVE_TXQ_LEN;
+			sim->txq_count--;
+		} else {
+			memset(sim->xfer_rx, 0, sizeof(struct esp_payload_header));
+		}
+		sim->dr_active = !!sim->txq_count;
+		sim->stats.transfers++;
+		pthread_mutex_unlock(&sim->lock);
+
+		sim_wire_delay((uint64_t)len * 8);
+
+		if (!slave_had_data &&
+		    ((struct esp_payload_header *)sim->xfer_tx)->if_type == ESP_MAX_IF) {
+			pthread_mutex_lock(&sim->lock);
+			sim->stats.dummy_transfers++;
+			pthread_mutex_unlock(&sim->lock);
+		}
+		sim_slave_rx_frame((uint8_t *)sim->xfer_tx, len);
+
+		pthread_mutex_lock(&sim->lock);
+		sim->xfer_state = SIM_XFER_DONE;
+		pthread_cond_broadcast(&sim->cond);
+		pthread_mutex_unlock(&sim->lock);
+
+		sim_delay_us(sim_cfg.slave_turnaround_us);
+
+		pthread_mutex_lock(&sim->lock);
+		sim->hs_active = 1;
+		pthread_mutex_unlock(&sim->lock);
+		sim_gpio_raise(H_GPIO_HANDSHAKE_Pin);
+	}
+
+	return NULL;
+}
+
+int sim_spi_queue_transfer(const uint8_t *tx_buf, uint8_t *rx_buf, uint32_t len)
+{
+	if (!sim || !tx_buf || !rx_buf || !len)
+		return -1;
+
+	pthread_mutex_lock(&sim->lock);
+	if (sim->xfer_state != SIM_XFER_IDLE) {
+		pthread_mutex_unlock(&sim->lock);
+		return -1;
+	}
+	sim->xfer_tx = tx_buf;
+	sim->xfer_rx = rx_buf;
+	sim->xfer_len = len;
+	sim->xfer_state = SIM_XFER_QUEUED;
+	pthread_cond_broadcast(&sim->cond);
+	pthread_mutex_unlock(&sim->lock);
+
+	return 0;
+}
+
+int sim_spi_wait_transfer(void)
+{
+	int ret = 0;
+
+	if (!sim)
+		return -1;
+
+	pthread_mutex_lock(&sim->lock);
+	while (sim->running && sim->xfer_state == SIM_XFER_QUEUED)
+		pthread_cond_wait(&sim->cond, &sim->lock);
+
+	if (sim->xfer_state != SIM_XFER_DONE)
+		ret = -1;
+	sim->xfer_state = SIM_XFER_IDLE;
+	pthread_mutex_unlock(&sim->lock);
+
+	return ret;
+}
+
+int sim_spi_transfer(const uint8_t *tx_buf, uint8_t *rx_buf, uint32_t len)
+{
+	if (sim_spi_queue_transfer(tx_buf, rx_buf, len))
+		return -1;
+
+	return sim_spi_wait_transfer();
+}
+#endif
+
+/* -------- UART ---------- */
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_UART
+
+int sim_uart_write(const uint8_t *data, uint16_t size)
+{
+	uint32_t pos = 0;
+
+	if (!sim || !data)
+		return -1;
+
+	/* 8N1: 10 bits per byte */
+	sim_wire_delay((uint64_t)size * 10);
+
+	pthread_mutex_lock(&sim->lock);
+	sim->stats.transfers++;
+	pthread_mutex_unlock(&sim->lock);
+
+	while (pos < size)
+		pos += sim_slave_rx_frame((uint8_t *)data + pos, size - pos);
+
+	return size;
+}
+
+/* Blocks until 'size' bytes from slave are there, like uart_read_bytes() */
+int sim_uart_read(uint8_t *data, uint16_t size)
+{
+	struct sim_frame *frame = NULL;
+	uint16_t copied = 0, chunk = 0;
+
+	if (!sim || !data)
+		return -1;
+
+	pthread_mutex_lock(&sim->lock);
+	while (copied < size) {
+		while (sim->running && !sim->txq_count)
+			pthread_cond_wait(&sim->cond, &sim->lock);
+		if (!sim->running)
+			break;
+
+		frame = &sim->txq[sim->txq_head];
+		chunk = min(size - copied, frame->len - frame->pos);
+		memcpy(data + copied, frame->buf + frame->pos, chunk);
+		frame->pos += chunk;
+		copied += chunk;
+
+		if (frame->pos == frame->len) {
+			sim->txq_head = (sim->txq_head + 1) % SIM_SLAVE_TXQ_LEN;
+			sim->txq_count--;
+			sim->stats.transfers++;
+		}
+	}
+	pthread_mutex_unlock(&sim->lock);
+
+	sim_wire_delay((uint64_t)copied * 10);
+
+	return copied ? copied : -1;
+}
+#endif
+
+/* -------- SDIO ---------- */
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+
+static void sim_sdio_put_reg(uint32_t reg, uint32_t val)
+{
+	val = htole32(val);
+	memcpy(&sim->sdio_regs[SDIO_REG(reg)], &val, sizeof(val));
+}
+
+int sim_sdio_read_reg(uint32_t reg, uint8_t *data, uint16_t size)
+{
+	if (!sim || !data || SDIO_REG(reg) + size > sizeof(sim->sdio_regs))
+		return -1;
+
+	pthread_mutex_lock(&sim->lock);
+	sim_sdio_put_reg(ESP_SLAVE_INT_RAW_REG, sim->sdio_int_raw);
+	sim_sdio_put_reg(ESP_SLAVE_PACKET_LEN_REG, sim->sdio_rx_len);
+	sim_sdio_put_reg(ESP_SLAVE_TOKEN_RDATA, sim->sdio_token << 16);
+	sim->sdio_rx_len_read = sim->sdio_rx_len;
+	memcpy(data, &sim->sdio_regs[SDIO_REG(reg)], size);
+	pthread_mutex_unlock(&sim->lock);
+
+	sim_wire_delay((uint64_t)size * 8);
+
+	return 0;
+}
+
+int sim_sdio_write_reg(uint32_t reg, const uint8_t *data, uint16_t size)
+{
+	uint32_t val = 0;
+
+	if (!sim || !data || SDIO_REG(reg) + size > sizeof(sim->sdio_regs))
+		return -1;
+
+	sim_wire_delay((uint64_t)size * 8);
+
+	pthread_mutex_lock(&sim->lock);
+	if (reg == ESP_SLAVE_INT_CLR_REG) {
+		memcpy(&val, data, min(size, sizeof(val)));
+		sim->sdio_int_raw &= ~le32toh(val);
+		/* frames queued since host read the length raise it again */
+		if (sim->sdio_rx_len != sim->sdio_rx_len_read)
+			sim->sdio_int_raw |= BIT(SDIO_INT_NEW_PACKET);
+	} else {
+		/* scratch registers, including host to slave interrupts */
+		memcpy(&sim->sdio_regs[SDIO_REG(reg)], data, size);
+	}
+	pthread_mutex_unlock(&sim->lock);
+
+	return 0;
+}
+
+int sim_sdio_wait_intr(int timeout)
+{
+	struct timespec ts;
+	int ret = 0;
+
+	if (!sim)
+		return -1;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	ts.tv_sec += timeout;
+
+	pthread_mutex_lock(&sim->lock);
+	while (sim->running && !sim->sdio_int_raw && !ret) {
+		if (timeout < 0)
+			pthread_cond_wait(&sim->cond, &sim->lock);
+		else
+			ret = pthread_cond_timedwait(&sim->cond, &sim->lock, &ts);
+	}
+	ret = sim->sdio_int_raw ? 0 : -1;
+	pthread_mutex_unlock(&sim->lock);
+
+	return ret;
+}
+
+/* Host reads the byte count from PACKET_LEN, which covers whole frames only.
+ * Anything past that is block padding, sent as zeros */
+int sim_sdio_read_block(uint32_t addr, uint8_t *data, uint16_t size)
+{
+	struct sim_frame *frame = NULL;
+	uint32_t len = ESP_SLAVE_CMD53_END_ADDR - addr;
+	uint32_t copied = 0, chunk = 0;
+
+	if (!sim || !data || len > size)
+		return -1;
+
+	pthread_mutex_lock(&sim->lock);
+	while (copied < len && sim->txq_count) {
+		frame = &sim->txq[sim->txq_head];
+		chunk = min(len - copied, frame->len - frame->pos);
+		memcpy(data + copied, frame->buf + frame->pos, chunk);
+		frame->pos += chunk;
+		copied += chunk;
+
+		if (frame->pos == frame->len) {
+			sim->txq_head = (sim->txq_head + 1) % SIM_SLAVE_TXQ_LEN;
+			sim->txq_count--;
+		}
+	}
+	sim->stats.transfers++;
+	pthread_mutex_unlock(&sim->lock);
+
+	if (copied < size)
+		memset(data + copied, 0, size - copied);
+
+	sim_wire_delay((uint64_t)size * 8);
+
+	return 0;
+}
+
+/* One slave Rx buffer: a packet at the start, followed by more while
+ * FLAG_AGGR_NEXT_PKT is set */
+static void sim_sdio_rx_buf(uint8_t *buf, uint32_t buf_len)
+{
+	struct esp_payload_header *h = NULL;
+	uint32_t pos = 0;
+	uint8_t more = 0;
+
+	do {
+		h = (struct esp_payload_header *)(buf + pos);
+		more = h->flags & FLAG_AGGR_NEXT_PKT;
+		pos += sim_slave_rx_frame(buf + pos, buf_len - pos);
+		pos = H_AGGR_PKT_ALIGN(pos);
+	} while (more && pos + sizeof(*h) <= buf_len);
+}
+
+int sim_sdio_write_block(uint32_t addr, const uint8_t *data, uint16_t size)
+{
+	uint32_t len = ESP_SLAVE_CMD53_END_ADDR - addr;
+	uint32_t pos = 0, bufs = 0;
+
+	if (!sim || !data || len > size)
+		return -1;
+
+	sim_wire_delay((uint64_t)size * 8);
+
+	pthread_mutex_lock(&sim->lock);
+	sim->stats.transfers++;
+	pthread_mutex_unlock(&sim->lock);
+
+	for (pos = 0; pos < len; pos += ESP_RX_BUFFER_SIZE, bufs++)
+		sim_sdio_rx_buf((uint8_t *)data + pos, min(len - pos, ESP_RX_BUFFER_SIZE));
+
+	sim_delay_us(sim_cfg.slave_turnaround_us);
+
+	/* buffers go back to slave's Rx queue once processed */
+	pthread_mutex_lock(&sim->lock);
+	sim->sdio_token = (sim->sdio_token + bufs) & ESP_TX_BUFFER_MASK;
+	pthread_mutex_unlock(&sim->lock);
+
+	return 0;
+}
+#endif
+
+/* -------- Init ---------- */
+
+void * sim_bus_init(void)
+{
+	pthread_condattr_t attr;
+
+	if (sim)
+		return sim;
+
+	sim = calloc(1, sizeof(*sim));
+	if (!sim)
+		return NULL;
+
+	sim->txq = calloc(SIM_SLAVE_TXQ_LEN, sizeof(struct sim_frame));
+	if (!sim->txq) {
+		free(sim);
+		sim = NULL;
+		return NULL;
+	}
+
+	pthread_mutex_init(&sim->lock, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&sim->cond, &attr);
+	pthread_condattr_destroy(&attr);
+
+#ifdef __linux__
+	/* default 50us slack would swamp short bus delays */
+	prctl(PR_SET_TIMERSLACK, 1UL);
+#endif
+
+	sim->running = 1;
+	/* slave up and ready for first transfer */
+	sim->hs_active = 1;
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO
+	sim->sdio_token = SIM_SDIO_SLAVE_RX_BUFS;
+#endif
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+	if (pthread_create(&sim->bus_thread, NULL, sim_spi_bus_thread, NULL)) {
+		ESP_LOGE(TAG, "Failed to create sim bus thread\n");
+		sim_bus_deinit(sim);
+		return NULL;
+	}
+#endif
+
+	ESP_LOGI(TAG, "Simulated bus: %u bps, slave turnaround %u us, loopback %u, crc32 %u\n",
+			sim_cfg.bus_bps, sim_cfg.slave_turnaround_us,
+			sim_cfg.loopback, sim_cfg.crc32);
+
+	return sim;
+}
+
+int sim_bus_deinit(void *ctx)
+{
+	struct sim_bus_ctx *s = (struct sim_bus_ctx *)ctx;
+
+	if (!s || s != sim)
+		return -1;
+
+	pthread_mutex_lock(&s->lock);
+	s->running = 0;
+	pthread_cond_broadcast(&s->cond);
+	pthread_mutex_unlock(&s->lock);
+
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SPI
+	if (s->bus_thread)
+		pthread_join(s->bus_thread, NULL);
+#endif
+
+	pthread_cond_destroy(&s->cond);
+	pthread_mutex_destroy(&s->lock);
+	free(s->txq);
+	free(s);
+	sim = NULL;
+
+	return 0;
+}
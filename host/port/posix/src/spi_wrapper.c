@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "esp_log.h"
+#include "os_wrapper.h"
+#include "transport_drv.h"
+#include "spi_wrapper.h"
+#include "sim_bus.h"
+
+DEFINE_LOG_TAG(spi_wrapper);
+
+void * hosted_spi_init(void)
+{
+	ESP_LOGI(TAG, "Transport: SPI (simulated), Mode:%u Freq:%uMHz TxQ:%u RxQ:%u",
+			H_SPI_MODE, H_SPI_FD_CLK_MHZ, H_SPI_TX_Q, H_SPI_RX_Q);
+
+	return sim_bus_init();
+}
+
+int hosted_spi_deinit(void *handle)
+{
+	if (!handle) {
+		ESP_LOGE(TAG, "Invalid handle for SPI deinit");
+		return -1;
+	}
+
+	/* spi_drv.c clears its spi_handle itself */
+	if (sim_bus_deinit(handle))
+		return -1;
+
+	ESP_LOGI(TAG, "SPI deinitialized");
+	return 0;
+}
+
+int hosted_do_spi_transfer(void *trans)
+{
+	struct hosted_transport_context_t *spi_trans = trans;
+
+	return sim_spi_transfer(spi_trans->tx_buf, spi_trans->rx_buf,
+			spi_trans->tx_buf_size);
+}
+
+int hosted_queue_spi_transfer(void *trans)
+{
+	struct hosted_transport_context_t *spi_trans = trans;
+
+	return sim_spi_queue_transfer(spi_trans->tx_buf, spi_trans->rx_buf,
+			spi_trans->tx_buf_size);
+}
+
+int hosted_wait_spi_transfer(void)
+{
+	return sim_spi_wait_transfer();
+}
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "esp_log.h"
+#include "os_wrapper.h"
+#include "transport_drv.h"
+#include "uart_wrapper.h"
+#include "sim_bus.h"
+
+DEFINE_LOG_TAG(uart_wrapper);
+
+#define UART_FAIL_IF_NULL_CTX(x) do {                      \
+		if (!x) return ESP_FAIL;                           \
+	} while (0);
+
+int hosted_uart_read(void * ctx, uint8_t *data, uint16_t size)
+{
+	UART_FAIL_IF_NULL_CTX(ctx);
+
+	return sim_uart_read(data, size);
+}
+
+int hosted_uart_write(void * ctx, uint8_t *data, uint16_t size)
+{
+	UART_FAIL_IF_NULL_CTX(ctx);
+
+	return sim_uart_write(data, size);
+}
+
+void * hosted_uart_init(void)
+{
+	ESP_LOGI(TAG, "Transport: UART (simulated), Baud:%u TxQ:%u RxQ:%u",
+			H_UART_BAUD_RATE, H_UART_TX_QUEUE_SIZE, H_UART_RX_QUEUE_SIZE);
+
+	return sim_bus_init();
+}
+
+esp_err_t hosted_uart_deinit(void *ctx)
+{
+	UART_FAIL_IF_NULL_CTX(ctx);
+
+	if (sim_bus_deinit(ctx))
+		return ESP_FAIL;
+
+	ESP_LOGI(TAG, "UART deinitialized");
+	return ESP_OK;
+}
@@ -0,0 +1,430 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/* RPC transaction slots under concurrent sync and async requests
+ *
+ * rpc_core.c and rpc_slave_if.c run as is. Protobuf coding and the serial
+ * transport are replaced below by a loopback slave, answering each request
+ * with a response of the same uid after a short random delay.
+ *
+ * Sync tasks check they get the response to their own request, async
+ * tasks that their call returns nothing and that every callback comes
+ * back. The pool is kept small (see CMakeLists.txt), so slots are recycled
+ * all the time, and requests also fall back to the heap when it is empty.
+ *
+ * Async tasks are held up right after rpc_send_req() hands their request
+ * over (its last step posts the tx semaphore), so that the response and
+ * reuse of the slot by other tasks often win the race against the caller.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "rpc_core.h"
+#include "serial_if.h"
+
+#define TEST_SYNC_TASKS                  3
+#define TEST_ASYNC_TASKS                 3
+#define TEST_ITERATIONS                  2000
+#define TEST_SLAVE_MAX_DELAY_US          100
+#define TEST_RSP_TIMEOUT_SEC             2
+
+typedef ctrl_cmd_t * (*test_getter_t)(ctrl_cmd_t *req);
+
+static const struct {
+	test_getter_t fn;
+	uint16_t resp_id;
+} sync_getters[TEST_SYNC_TASKS] = {
+	{ rpc_slaveif_wifi_get_mode,         RPC_ID__Resp_GetWifiMode },
+	{ rpc_slaveif_wifi_get_ps,           RPC_ID__Resp_WifiGetPs },
+	{ rpc_slaveif_wifi_get_max_tx_power, RPC_ID__Resp_WifiGetMaxTxPower },
+};
+
+static int (*os_post_semaphore)(void *semaphore_handle);
+static __thread int in_async_send;
+static __thread unsigned int async_seed;
+
+static atomic_uint async_sent;
+static atomic_uint async_done;
+static atomic_uint failures;
+
+#define TEST_FAIL(fmt, ...) do {                                               \
+	printf("FAIL: " fmt "\n", ##__VA_ARGS__);                                  \
+	atomic_fetch_add(&failures, 1);                                            \
+} while (0)
+
+
+/* Message as seen on the loopback wire */
+typedef struct {
+	uint32_t msg_type;
+	uint32_t msg_id;
+	uint32_t uid;
+} test_wire_msg_t;
+
+typedef struct test_wire_item {
+	struct test_wire_item *next;
+	test_wire_msg_t msg;
+} test_wire_item_t;
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	test_wire_item_t *head;
+	test_wire_item_t *tail;
+} test_wire_q_t;
+
+static test_wire_q_t to_slave = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+static test_wire_q_t to_host = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+
+static void wire_put(test_wire_q_t *q, const test_wire_msg_t *msg)
+{
+	test_wire_item_t *item = calloc(1, sizeof(*item));
+
+	if (!item)
+		abort();
+	item->msg = *msg;
+
+	pthread_mutex_lock(&q->lock);
+	if (q->tail)
+		q->tail->next = item;
+	else
+		q->head = item;
+	q->tail = item;
+	pthread_cond_signal(&q->cond);
+	pthread_mutex_unlock(&q->lock);
+}
+
+/* Blocks until a message is queued. Returned item is freed by caller */
+static test_wire_item_t * wire_get(test_wire_q_t *q)
+{
+	test_wire_item_t *item = NULL;
+
+	pthread_mutex_lock(&q->lock);
+	while (!q->head)
+		pthread_cond_wait(&q->cond, &q->lock);
+	item = q->head;
+	q->head = item->next;
+	if (!q->head)
+		q->tail = NULL;
+	pthread_mutex_unlock(&q->lock);
+
+	return item;
+}
+
+static void * slave_task(void *arg)
+{
+	test_wire_item_t *item = NULL;
+	unsigned int seed = 1;
+
+	while (1) {
+		item = wire_get(&to_slave);
+		usleep(rand_r(&seed) % TEST_SLAVE_MAX_DELAY_US);
+
+		item->msg.msg_type = RPC_TYPE__Resp;
+		item->msg.msg_id = item->msg.msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base;
+		wire_put(&to_host, &item->msg);
+		free(item);
+	}
+	return NULL;
+}
+
+
+/* Serial transport, looped back to slave_task() */
+int transport_pserial_open(void)
+{
+	return 0;
+}
+
+int transport_pserial_close(void)
+{
+	return 0;
+}
+
+struct serial_drv_handle_t * serial_drv_open(const char *transport)
+{
+	static int handle;
+
+	return (struct serial_drv_handle_t *)&handle;
+}
+
+int transport_pserial_send_begin(serial_ll_tx_msg_t *msg, uint16_t data_length)
+{
+	memset(msg, 0, sizeof(*msg));
+	msg->frag[0] = malloc(data_length);
+	if (!msg->frag[0])
+		return -1;
+	msg->n_frags = 1;
+	msg->len = data_length;
+	return 0;
+}
+
+uint8_t * serial_ll_tx_msg_reserve(serial_ll_tx_msg_t *msg, uint16_t len)
+{
+	uint8_t *pos = NULL;
+
+	if (msg->pos + len > msg->len)
+		return NULL;
+	pos = msg->frag[0] + msg->pos;
+	msg->pos += len;
+	return pos;
+}
+
+int serial_ll_tx_msg_write(serial_ll_tx_msg_t *msg, const uint8_t *data, uint16_t len)
+{
+	uint8_t *pos = serial_ll_tx_msg_reserve(msg, len);
+
+	if (!pos)
+		return -1;
+	memcpy(pos, data, len);
+	return 0;
+}
+
+void serial_ll_tx_msg_free(serial_ll_tx_msg_t *msg)
+{
+	free(msg->frag[0]);
+	memset(msg, 0, sizeof(*msg));
+}
+
+int transport_pserial_send_end(serial_ll_tx_msg_t *msg)
+{
+	test_wire_msg_t wire = {0};
+	int ret = -1;
+
+	if (msg->pos == sizeof(wire)) {
+		memcpy(&wire, msg->frag[0], sizeof(wire));
+		wire_put(&to_slave, &wire);
+		ret = 0;
+	}
+	serial_ll_tx_msg_free(msg);
+	return ret;
+}
+
+int transport_pserial_read(serial_drv_rx_buf_t *rx)
+{
+	test_wire_item_t *item = wire_get(&to_host);
+
+	rx->buf = (uint8_t *)&item->msg;
+	rx->offset = 0;
+	rx->len = sizeof(item->msg);
+	rx->priv_buffer_handle = item;
+	rx->free_buf_handle = free;
+	return 0;
+}
+
+
+/* Protobuf coding, only the header fields matter here */
+void rpc__init(Rpc *message)
+{
+	memset(message, 0, sizeof(*message));
+}
+
+size_t rpc__get_packed_size(const Rpc *message)
+{
+	return sizeof(test_wire_msg_t);
+}
+
+size_t rpc__pack(const Rpc *message, uint8_t *out)
+{
+	test_wire_msg_t wire = {
+		.msg_type = message->msg_type,
+		.msg_id = message->msg_id,
+		.uid = message->uid,
+	};
+
+	memcpy(out, &wire, sizeof(wire));
+	return sizeof(wire);
+}
+
+size_t rpc__pack_to_buffer(const Rpc *message, ProtobufCBuffer *buffer)
+{
+	uint8_t out[sizeof(test_wire_msg_t)];
+
+	rpc__pack(message, out);
+	buffer->append(buffer, sizeof(out), out);
+	return sizeof(out);
+}
+
+Rpc * rpc__unpack(ProtobufCAllocator *allocator, size_t len, const uint8_t *data)
+{
+	test_wire_msg_t wire = {0};
+	Rpc *msg = NULL;
+
+	if (len != sizeof(wire))
+		return NULL;
+	memcpy(&wire, data, sizeof(wire));
+
+	msg = allocator->alloc(allocator->allocator_data, sizeof(Rpc));
+	if (!msg)
+		return NULL;
+	rpc__init(msg);
+	msg->msg_type = wire.msg_type;
+	msg->msg_id = wire.msg_id;
+	msg->uid = wire.uid;
+	return msg;
+}
+
+int compose_rpc_req(Rpc *req, ctrl_cmd_t *app_req,
+		esp_hosted_rpc_arena_t *arena, int32_t *failure_status)
+{
+	return 0;
+}
+
+int rpc_parse_rsp(Rpc *rpc_msg, ctrl_cmd_t *app_resp)
+{
+	app_resp->msg_type = rpc_msg->msg_type;
+	app_resp->msg_id = rpc_msg->msg_id;
+	app_resp->uid = rpc_msg->uid;
+	app_resp->resp_event_status = SUCCESS;
+	return 0;
+}
+
+int rpc_parse_evt(Rpc *rpc_msg, ctrl_cmd_t *app_ntfy)
+{
+	return -1;
+}
+
+
+static int test_post_semaphore(void *semaphore_handle)
+{
+	int ret = os_post_semaphore(semaphore_handle);
+
+	if (in_async_send)
+		usleep(rand_r(&async_seed) % (10 * TEST_SLAVE_MAX_DELAY_US));
+	return ret;
+}
+
+static int async_resp_cb(ctrl_cmd_t *resp)
+{
+	if (resp->msg_id != RPC_ID__Resp_GetMACAddress ||
+	    resp->resp_event_status != SUCCESS)
+		TEST_FAIL("async: got resp [0x%x] status %" PRId32,
+				resp->msg_id, resp->resp_event_status);
+
+	atomic_fetch_add(&async_done, 1);
+	HOSTED_FREE(resp);
+	return SUCCESS;
+}
+
+static void * sync_task(void *arg)
+{
+	uintptr_t k = (uintptr_t)arg;
+	ctrl_cmd_t *req = NULL;
+	ctrl_cmd_t *resp = NULL;
+	int i;
+
+	for (i = 0; i < TEST_ITERATIONS; i++) {
+		req = rpc_slaveif_alloc_req();
+		if (!req)
+			abort();
+		req->rsp_timeout_sec = TEST_RSP_TIMEOUT_SEC;
+
+		resp = sync_getters[k].fn(req);
+		if (!resp) {
+			TEST_FAIL("sync %u: no resp, iteration %d", (unsigned)k, i);
+			continue;
+		}
+		if (resp->msg_id != sync_getters[k].resp_id ||
+		    resp->resp_event_status != SUCCESS)
+			TEST_FAIL("sync %u: got resp [0x%x] status %" PRId32 ", expected [0x%x]",
+					(unsigned)k, resp->msg_id, resp->resp_event_status,
+					sync_getters[k].resp_id);
+		HOSTED_FREE(resp);
+	}
+	return NULL;
+}
+
+static void * async_task(void *arg)
+{
+	uintptr_t k = (uintptr_t)arg;
+	ctrl_cmd_t *req = NULL;
+	ctrl_cmd_t *resp = NULL;
+	int i;
+
+	async_seed = k + 1;
+
+	for (i = 0; i < TEST_ITERATIONS; i++) {
+		req = rpc_slaveif_alloc_req();
+		if (!req)
+			abort();
+		req->rsp_timeout_sec = TEST_RSP_TIMEOUT_SEC;
+		req->rpc_rsp_cb = async_resp_cb;
+
+		atomic_fetch_add(&async_sent, 1);
+		in_async_send = 1;
+		resp = rpc_slaveif_wifi_get_mac(req);
+		in_async_send = 0;
+		if (resp) {
+			TEST_FAIL("async %u: call returned resp [0x%x]",
+					(unsigned)k, resp->msg_id);
+			HOSTED_FREE(resp);
+		}
+	}
+	return NULL;
+}
+
+int main(void)
+{
+	pthread_t slave;
+	pthread_t tasks[TEST_SYNC_TASKS + TEST_ASYNC_TASKS];
+	uintptr_t k;
+	int wait_ms = 0;
+
+	os_post_semaphore = g_h.funcs->_h_post_semaphore;
+	g_h.funcs->_h_post_semaphore = test_post_semaphore;
+
+	if (rpc_slaveif_init() || rpc_slaveif_start() ||
+	    pthread_create(&slave, NULL, slave_task, NULL)) {
+		printf("rpc pool: init failed\n");
+		return 1;
+	}
+
+	printf("rpc pool: %d sync and %d async tasks, %d requests each, %d slots\n",
+			TEST_SYNC_TASKS, TEST_ASYNC_TASKS, TEST_ITERATIONS,
+			H_MAX_SYNC_RPC_REQUESTS + H_MAX_ASYNC_RPC_REQUESTS);
+
+	for (k = 0; k < TEST_SYNC_TASKS + TEST_ASYNC_TASKS; k++) {
+		if (pthread_create(&tasks[k], NULL,
+				k < TEST_SYNC_TASKS ? sync_task : async_task,
+				(void *)(k < TEST_SYNC_TASKS ? k : k - TEST_SYNC_TASKS))) {
+			printf("rpc pool: task create failed\n");
+			return 1;
+		}
+	}
+
+	for (k = 0; k < TEST_SYNC_TASKS + TEST_ASYNC_TASKS; k++)
+		pthread_join(tasks[k], NULL);
+
+	/* last async responses may still be on their way */
+	while (atomic_load(&async_done) < atomic_load(&async_sent) &&
+	       wait_ms < TEST_RSP_TIMEOUT_SEC * 1000) {
+		usleep(1000);
+		wait_ms++;
+	}
+	if (atomic_load(&async_done) != atomic_load(&async_sent))
+		TEST_FAIL("%u async requests sent, %u callbacks",
+				atomic_load(&async_sent), atomic_load(&async_done));
+
+	if (atomic_load(&failures)) {
+		printf("rpc pool: %u failures\n", atomic_load(&failures));
+		return 1;
+	}
+
+	printf("rpc pool: OK\n");
+	return 0;
+}
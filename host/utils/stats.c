@@ -216,6 +216,15 @@ void stats_timer_func(void * arg)
 			pkt_stats.sta_rx_in,pkt_stats.sta_rx_out,
 			pkt_stats.sta_tx_flowctrl_drop, pkt_stats.sta_tx_in_pass, pkt_stats.sta_tx_trans_in,  pkt_stats.sta_tx_out, pkt_stats.sta_tx_out_drop,
 			pkt_stats.sta_flow_ctrl_on, pkt_stats.sta_flow_ctrl_off);
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO && H_SDIO_TX_CREDIT
+	ESP_LOGI(TAG, "SDIO Tx credit: update[%lu] stall[%lu] reg_read[%lu]",
+			pkt_stats.sdio_tx_credit_update, pkt_stats.sdio_tx_credit_stall,
+			pkt_stats.sdio_tx_credit_reg_read);
+#endif
+#if H_TRANSPORT_IN_USE == H_TRANSPORT_SDIO && H_SDIO_TX_AGGREGATION
+	ESP_LOGI(TAG, "SDIO Tx aggregation: waits for slave buffers[%lu]",
+			pkt_stats.sdio_tx_aggr_wait);
+#endif
 	ESP_LOGI(TAG, "internal: free %d l-free %d min-free %d, psram: free %d l-free %d min-free %d",
 			heap_caps_get_free_size(MALLOC_CAP_8BIT) - heap_caps_get_free_size(MALLOC_CAP_SPIRAM),
 			heap_caps_get_largest_free_block(MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL),
@@ -156,6 +156,10 @@ struct pkt_stats_t {
 	uint32_t sta_tx_out_drop;
 	uint32_t sta_flow_ctrl_on;
 	uint32_t sta_flow_ctrl_off;
+	uint32_t sdio_tx_credit_update;
+	uint32_t sdio_tx_credit_stall;
+	uint32_t sdio_tx_credit_reg_read;
+	uint32_t sdio_tx_aggr_wait;
 };
 
 extern struct pkt_stats_t pkt_stats;
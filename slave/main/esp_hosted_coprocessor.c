@@ -25,6 +25,7 @@
 
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #if defined(CONFIG_BT_ENABLED) && defined(CONFIG_SOC_BT_SUPPORTED)
 #include "esp_bt.h"
 #endif
@@ -43,9 +44,9 @@
 #include "esp_hosted_coprocessor_fw_ver.h"
 #include "esp_hosted_cli.h"
 #include "host_power_save.h"
+#include "esp_hosted_rpc.pb-c.h"
 
 #if CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED
-	#include "esp_hosted_rpc.pb-c.h"
 	volatile uint8_t station_got_ip = 0;
 	#define H_SLAVE_LWIP_DHCP_AT_SLAVE       1
 #endif
@@ -54,12 +55,8 @@
 
 static const char *TAG = "co-pro-main";
 
-#define BYPASS_TX_PRIORITY_Q 1
-
 #define UNKNOWN_RPC_MSG_ID               0
 
-#define TO_HOST_QUEUE_SIZE               10
-
 #define ETH_DATA_LEN                     1500
 #define MAX_WIFI_STA_TX_RETRY            2
 
@@ -73,9 +70,22 @@ interface_handle_t *if_handle = NULL;
 slave_config_t slv_cfg_g;
 slave_state_t  slv_state_g;
 
-#if !BYPASS_TX_PRIORITY_Q
-static QueueHandle_t meta_to_host_queue = NULL;
-static QueueHandle_t to_host_queue[MAX_PRIORITY_QUEUES] = {NULL};
+#ifdef CONFIG_ESP_HOSTED_TX_SCHEDULER
+/* Slave to host Tx lanes, served in this order of priority.
+ * STA and AP lanes share the remaining bandwidth round robin.
+ */
+enum {
+	TX_LANE_SERIAL,
+	TX_LANE_HCI,
+	TX_LANE_STA,
+	TX_LANE_AP,
+	TX_LANE_MAX
+};
+
+#define TX_DATA_LANE_QUANTUM             4
+
+static QueueHandle_t tx_lane[TX_LANE_MAX];
+static SemaphoreHandle_t tx_lane_sem;
 #endif
 
 esp_netif_t *slave_sta_netif = NULL;
@@ -179,6 +189,13 @@ static uint32_t get_capabilities_ext(void)
 #ifdef CONFIG_BT_ENABLED
 	ext_cap |= get_bluetooth_ext_capabilities();
 #endif
+
+#if CONFIG_ESP_TRANSPORT_CRC32
+	ESP_LOGI(TAG, "- CRC32 frame integrity");
+	ext_cap |= ESP_TRANSPORT_CRC32_SUPPORT;
+#endif
+
+	ext_cap |= ESP_RPC_PACKED_RECORDS_SUPPORT;
 	ESP_LOGI(TAG, "extended capabilities: 0x%"PRIx32, ext_cap);
 
 	return ext_cap;
@@ -209,6 +226,84 @@ static inline esp_err_t populate_buff_handle(interface_buffer_handle_t *buf_hand
 #define populate_wifi_buffer_handle(Buf_hdL, TypE, BuF, LeN) \
 	populate_buff_handle(Buf_hdL, TypE, BuF, LeN, esp_wifi_internal_free_rx_buffer, eb, 0, 0, 0);
 
+#ifdef CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED
+/* Wi-Fi Rx buffers delivered to both slave lwIP and host (BOTH_LWIP_BRIDGE)
+ * are shared rather than copied. Each consumer holds a reference on the
+ * same eb and the last release returns it to the Wi-Fi driver. Slave lwIP
+ * releases through the netif driver free hook set in create_slave_sta_netif().
+ */
+#define SHARED_RX_SLOTS 16
+
+static struct {
+	void *eb;
+	uint8_t refs;
+} shared_rx[SHARED_RX_SLOTS];
+static uint8_t shared_rx_cnt;
+static portMUX_TYPE shared_rx_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool shared_rx_hold(void *eb, uint8_t refs)
+{
+	bool held = false;
+
+	portENTER_CRITICAL(&shared_rx_lock);
+	for (int i = 0; i < SHARED_RX_SLOTS; i++) {
+		if (!shared_rx[i].eb) {
+			shared_rx[i].eb = eb;
+			shared_rx[i].refs = refs;
+			shared_rx_cnt++;
+			held = true;
+			break;
+		}
+	}
+	portEXIT_CRITICAL(&shared_rx_lock);
+
+	return held;
+}
+
+static void shared_rx_release(void *eb)
+{
+	bool last = true;
+
+	portENTER_CRITICAL(&shared_rx_lock);
+	if (shared_rx_cnt) {
+		for (int i = 0; i < SHARED_RX_SLOTS; i++) {
+			if (shared_rx[i].eb == eb) {
+				if (--shared_rx[i].refs) {
+					last = false;
+				} else {
+					shared_rx[i].eb = NULL;
+					shared_rx_cnt--;
+				}
+				break;
+			}
+		}
+	}
+	portEXIT_CRITICAL(&shared_rx_lock);
+
+	if (last)
+		esp_wifi_internal_free_rx_buffer(eb);
+}
+
+static void slave_sta_free_rx_buffer(void *h, void *buffer)
+{
+	shared_rx_release(buffer);
+}
+
+static esp_err_t slave_sta_transmit(void *h, void *buffer, size_t len)
+{
+	return esp_wifi_internal_tx(ESP_IF_WIFI_STA, buffer, len);
+}
+
+static esp_err_t slave_sta_transmit_wrap(void *h, void *buffer, size_t len, void *netstack_buf)
+{
+#if CONFIG_SPIRAM
+	return esp_wifi_internal_tx_by_ref(ESP_IF_WIFI_STA, buffer, len, netstack_buf);
+#else
+	return esp_wifi_internal_tx(ESP_IF_WIFI_STA, buffer, len);
+#endif
+}
+#endif
+
 
 esp_err_t wlan_ap_rx_callback(void *buffer, uint16_t len, void *eb)
 {
@@ -309,22 +404,36 @@ esp_err_t wlan_sta_rx_callback(void *buffer, uint16_t len, void *eb)
 		case BOTH_LWIP_BRIDGE:
 			ESP_LOGV(TAG, "slave & host packet");
 
-			void * copy_buff = malloc(len);
-			assert(copy_buff);
-			memcpy(copy_buff, buffer, len);
-
-			/* slave LWIP */
-			esp_netif_receive(slave_sta_netif, buffer, len, eb);
-			//netif would free eb after processing
-
-			ESP_LOGV(TAG, "slave & host packet");
+			if (likely(shared_rx_hold(eb, 2))) {
+				/* Host LWIP, eb released once both sides are done */
+				populate_buff_handle(&buf_handle, ESP_STA_IF, buffer, len,
+						shared_rx_release, eb, 0, 0, 0);
+				if (unlikely(send_to_host_queue(&buf_handle, PRIO_Q_OTHERS))) {
+					/* Only slave LWIP left holding eb */
+					shared_rx_release(eb);
+					esp_netif_receive(slave_sta_netif, buffer, len, eb);
+					return ESP_OK;
+				}
 
-			/* Host LWIP, free up wifi buffers */
-			populate_buff_handle(&buf_handle, ESP_STA_IF, copy_buff, len, free, copy_buff, 0, 0, 0);
-			if (unlikely(send_to_host_queue(&buf_handle, PRIO_Q_OTHERS))) {
-				/* Free copy_buff since we couldn't queue it */
-				free(copy_buff);
-				return ESP_OK;
+				/* slave LWIP */
+				esp_netif_receive(slave_sta_netif, buffer, len, eb);
+			} else {
+				/* All shared slots busy, fall back to a copy for host */
+				void * copy_buff = malloc(len);
+				assert(copy_buff);
+				memcpy(copy_buff, buffer, len);
+
+				/* slave LWIP */
+				esp_netif_receive(slave_sta_netif, buffer, len, eb);
+				//netif would free eb after processing
+
+				/* Host LWIP, free up wifi buffers */
+				populate_buff_handle(&buf_handle, ESP_STA_IF, copy_buff, len, free, copy_buff, 0, 0, 0);
+				if (unlikely(send_to_host_queue(&buf_handle, PRIO_Q_OTHERS))) {
+					/* Free copy_buff since we couldn't queue it */
+					free(copy_buff);
+					return ESP_OK;
+				}
 			}
 
     #if ESP_PKT_STATS
@@ -408,11 +517,54 @@ static void process_tx_pkt(interface_buffer_handle_t *buf_handle)
 	}
 }
 
-#if !BYPASS_TX_PRIORITY_Q
+#ifdef CONFIG_ESP_HOSTED_TX_SCHEDULER
+static uint8_t tx_lane_for(interface_buffer_handle_t *buf_handle, uint8_t queue_type)
+{
+	if (queue_type == PRIO_Q_SERIAL)
+		return TX_LANE_SERIAL;
+	if (queue_type == PRIO_Q_BT)
+		return TX_LANE_HCI;
+	if (buf_handle->if_type == ESP_AP_IF)
+		return TX_LANE_AP;
+	return TX_LANE_STA;
+}
+
+/* Pick next buffer: serial, then HCI, then STA/AP alternating every
+ * TX_DATA_LANE_QUANTUM packets while both have data.
+ */
+static bool tx_lane_dequeue(interface_buffer_handle_t *buf_handle)
+{
+	static uint8_t data_lane = TX_LANE_STA;
+	static uint8_t data_served;
+	uint8_t other = 0;
+
+	if (xQueueReceive(tx_lane[TX_LANE_SERIAL], buf_handle, 0))
+		return true;
+	if (xQueueReceive(tx_lane[TX_LANE_HCI], buf_handle, 0))
+		return true;
+
+	other = (data_lane == TX_LANE_STA) ? TX_LANE_AP : TX_LANE_STA;
+	if (data_served >= TX_DATA_LANE_QUANTUM &&
+	    uxQueueMessagesWaiting(tx_lane[other])) {
+		data_lane = other;
+		data_served = 0;
+	}
+
+	if (xQueueReceive(tx_lane[data_lane], buf_handle, 0)) {
+		data_served++;
+		return true;
+	}
+	if (xQueueReceive(tx_lane[other], buf_handle, 0)) {
+		data_lane = other;
+		data_served = 1;
+		return true;
+	}
+	return false;
+}
+
 /* Send data to host */
 static void send_task(void* pvParameters)
 {
-	uint8_t queue_type = 0;
 	interface_buffer_handle_t buf_handle = {0};
 
 	while (1) {
@@ -422,9 +574,17 @@ static void send_task(void* pvParameters)
 			continue;
 		}
 
-		if (xQueueReceive(meta_to_host_queue, &queue_type, portMAX_DELAY))
-			if (xQueueReceive(to_host_queue[queue_type], &buf_handle, portMAX_DELAY))
-				process_tx_pkt(&buf_handle);
+		if (!xSemaphoreTake(tx_lane_sem, portMAX_DELAY))
+			continue;
+
+		/* Drain whatever is pending in one go, re-checking the
+		 * priority lanes before every write
+		 */
+		do {
+			if (!tx_lane_dequeue(&buf_handle))
+				break;
+			process_tx_pkt(&buf_handle);
+		} while (datapath && xSemaphoreTake(tx_lane_sem, 0));
 	}
 }
 #endif
@@ -461,20 +621,237 @@ static void parse_protobuf_req(void)
 		r.len, UNKNOWN_RPC_MSG_ID);
 }
 
-void send_event_to_host(int event_id)
+static void event_send(int event_id, void *data, int size)
 {
 #if ESP_PKT_STATS
 	pkt_stats.serial_tx_evt++;
 #endif
-	protocomm_pserial_data_ready(pc_pserial, NULL, 0, event_id);
+	protocomm_pserial_data_ready(pc_pserial, data, size, event_id);
+}
+
+#if CONFIG_ESP_HOSTED_EVENT_COALESCE_WINDOW_MS
+/* Event coalescing
+ *
+ * First event of a kind is sent at once and opens the window for it.
+ * Repeats of that kind within the window overwrite one pending copy,
+ * sent when that kind's window ends. Pending copies go out in order of
+ * their latest update and before any event sent at once, so host ends up
+ * in the same state as without coalescing. Expired windows are handled
+ * in own task, as sending may block on the protocomm queue.
+ */
+#define EVT_COALESCE_MAX_DATA            64
+#define EVT_COALESCE_KEY_LEN             6
+
+typedef struct {
+	int event_id;
+	uint8_t key[EVT_COALESCE_KEY_LEN];
+	uint8_t used;
+	uint8_t pending;
+	uint32_t seq;
+	TickType_t deadline;
+	int len;
+	uint8_t data[EVT_COALESCE_MAX_DATA];
+} evt_coalesce_slot_t;
+
+static struct {
+	SemaphoreHandle_t lock;
+	TaskHandle_t task;
+	uint32_t seq;
+	uint32_t merged;
+	evt_coalesce_slot_t slot[CONFIG_ESP_HOSTED_EVENT_COALESCE_SLOTS];
+} evt_cq;
+
+/* Returns 1 if event can be merged, with key telling kinds of same id apart */
+static int evt_coalesce_key(int event_id, const void *data, int size, uint8_t *key)
+{
+	memset(key, 0, EVT_COALESCE_KEY_LEN);
+
+	if (size > EVT_COALESCE_MAX_DATA)
+		return 0;
+
+	switch (event_id) {
+	case RPC_ID__Event_Heartbeat:
+	case RPC_ID__Event_StaConnected:
+	case RPC_ID__Event_StaDisconnected:
+		return 1;
+	case RPC_ID__Event_AP_StaConnected:
+	case RPC_ID__Event_AP_StaDisconnected:
+		/* per station, both event structs start with mac */
+		if (size < EVT_COALESCE_KEY_LEN)
+			return 0;
+		memcpy(key, data, EVT_COALESCE_KEY_LEN);
+		return 1;
+	case RPC_ID__Event_WifiEventNoArgs:
+		/* per wifi event id */
+		if (size < (int)sizeof(int32_t))
+			return 0;
+		memcpy(key, data, sizeof(int32_t));
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/* Send pending copies updated up to seq, oldest update first. Lock held */
+static void evt_coalesce_flush(uint32_t seq)
+{
+	evt_coalesce_slot_t *next = NULL;
+	int i = 0;
+
+	while (1) {
+		next = NULL;
+		for (i = 0; i < CONFIG_ESP_HOSTED_EVENT_COALESCE_SLOTS; i++) {
+			if (evt_cq.slot[i].pending &&
+			    (int32_t)(evt_cq.slot[i].seq - seq) <= 0 &&
+			    (!next || (int32_t)(evt_cq.slot[i].seq - next->seq) < 0))
+				next = &evt_cq.slot[i];
+		}
+		if (!next)
+			break;
+
+		next->pending = 0;
+		event_send(next->event_id, next->len ? next->data : NULL, next->len);
+	}
+}
+
+/* Close expired windows. Returns ticks till next window ends. Lock held */
+static TickType_t evt_coalesce_expire(void)
+{
+	TickType_t now = xTaskGetTickCount();
+	TickType_t wait = portMAX_DELAY;
+	TickType_t left = 0;
+	uint32_t seq = 0;
+	uint8_t found = 0;
+	int i = 0;
+
+	for (i = 0; i < CONFIG_ESP_HOSTED_EVENT_COALESCE_SLOTS; i++) {
+		evt_coalesce_slot_t *slot = &evt_cq.slot[i];
+
+		if (!slot->used || (int32_t)(slot->deadline - now) > 0)
+			continue;
+		/* older updates of other kinds must reach host first */
+		if (slot->pending && (!found || (int32_t)(slot->seq - seq) > 0)) {
+			seq = slot->seq;
+			found = 1;
+		}
+	}
+
+	if (found)
+		evt_coalesce_flush(seq);
+
+	for (i = 0; i < CONFIG_ESP_HOSTED_EVENT_COALESCE_SLOTS; i++) {
+		evt_coalesce_slot_t *slot = &evt_cq.slot[i];
+
+		if (!slot->used)
+			continue;
+		if ((int32_t)(slot->deadline - now) <= 0) {
+			memset(slot, 0, sizeof(*slot));
+			continue;
+		}
+		left = slot->deadline - now;
+		if (left < wait)
+			wait = left;
+	}
+
+	return wait;
+}
+
+static void evt_coalesce_task(void *pvParameters)
+{
+	TickType_t wait = 0;
+
+	while (1) {
+		xSemaphoreTake(evt_cq.lock, portMAX_DELAY);
+		wait = evt_coalesce_expire();
+		xSemaphoreGive(evt_cq.lock);
+
+		ESP_LOGD(TAG, "events merged so far: %" PRIu32, evt_cq.merged);
+
+		/* woken early when a new window opens */
+		ulTaskNotifyTake(pdTRUE, wait);
+	}
+}
+
+static esp_err_t evt_coalesce_init(void)
+{
+	evt_cq.lock = xSemaphoreCreateMutex();
+	if (!evt_cq.lock)
+		return ESP_ERR_NO_MEM;
+
+	if (xTaskCreate(evt_coalesce_task, "evt_coalesce_task", 3072, NULL,
+			CONFIG_ESP_HOSTED_DEFAULT_TASK_PRIORITY, &evt_cq.task) != pdTRUE) {
+		vSemaphoreDelete(evt_cq.lock);
+		evt_cq.lock = NULL;
+		return ESP_ERR_NO_MEM;
+	}
+
+	ESP_LOGI(TAG, "Coalescing events within %d ms",
+			CONFIG_ESP_HOSTED_EVENT_COALESCE_WINDOW_MS);
+	return ESP_OK;
+}
+#endif
+
+void send_event_to_host(int event_id)
+{
+	send_event_data_to_host(event_id, NULL, 0);
 }
 
 void send_event_data_to_host(int event_id, void *data, int size)
 {
-#if ESP_PKT_STATS
-	pkt_stats.serial_tx_evt++;
+#if CONFIG_ESP_HOSTED_EVENT_COALESCE_WINDOW_MS
+	uint8_t key[EVT_COALESCE_KEY_LEN];
+	evt_coalesce_slot_t *slot = NULL;
+	evt_coalesce_slot_t *free_slot = NULL;
+	int i = 0;
+
+	if (!evt_cq.lock) {
+		event_send(event_id, data, size);
+		return;
+	}
+
+	xSemaphoreTake(evt_cq.lock, portMAX_DELAY);
+
+	if (evt_coalesce_key(event_id, data, size, key)) {
+		for (i = 0; i < CONFIG_ESP_HOSTED_EVENT_COALESCE_SLOTS; i++) {
+			if (!evt_cq.slot[i].used) {
+				if (!free_slot)
+					free_slot = &evt_cq.slot[i];
+			} else if (evt_cq.slot[i].event_id == event_id &&
+			           !memcmp(evt_cq.slot[i].key, key, EVT_COALESCE_KEY_LEN)) {
+				slot = &evt_cq.slot[i];
+				break;
+			}
+		}
+
+		if (slot) {
+			/* window open: keep only the latest */
+			if (slot->pending)
+				evt_cq.merged++;
+			if (size)
+				memcpy(slot->data, data, size);
+			slot->len = size;
+			slot->pending = 1;
+			slot->seq = ++evt_cq.seq;
+			xSemaphoreGive(evt_cq.lock);
+			return;
+		}
+
+		if (free_slot) {
+			free_slot->used = 1;
+			free_slot->event_id = event_id;
+			memcpy(free_slot->key, key, EVT_COALESCE_KEY_LEN);
+			free_slot->deadline = xTaskGetTickCount() +
+				pdMS_TO_TICKS(CONFIG_ESP_HOSTED_EVENT_COALESCE_WINDOW_MS);
+			xTaskNotifyGive(evt_cq.task);
+		}
+	}
+
+	evt_coalesce_flush(evt_cq.seq);
+	event_send(event_id, data, size);
+	xSemaphoreGive(evt_cq.lock);
+#else
+	event_send(event_id, data, size);
 #endif
-	protocomm_pserial_data_ready(pc_pserial, data, size, event_id);
 }
 
 static void process_serial_rx_pkt(uint8_t *buf)
@@ -546,7 +923,10 @@ static int host_to_slave_reconfig(uint8_t *evt_buf, uint16_t len)
 
 		if (*pos == HOST_CAPABILITIES) {
 
-			ESP_LOGI(TAG, "Host capabilities: %2x", *pos);
+			slv_cfg_g.host_cap = *(pos + 2);
+			ESP_LOGI(TAG, "Host capabilities: %2x", slv_cfg_g.host_cap);
+			if (slv_cfg_g.host_cap & ESP_HOST_CAP_CRC32)
+				ESP_LOGI(TAG, "CRC32 frame integrity in use");
 
 		} else if (*pos == RCVD_ESP_FIRMWARE_CHIP_ID) {
 
@@ -746,26 +1126,30 @@ static ssize_t serial_read_data(uint8_t *data, ssize_t len)
 
 int send_to_host_queue(interface_buffer_handle_t *buf_handle, uint8_t queue_type)
 {
-#if BYPASS_TX_PRIORITY_Q
-	process_tx_pkt(buf_handle);
-	return ESP_OK;
-#else
-	int ret = xQueueSend(to_host_queue[queue_type], buf_handle, portMAX_DELAY);
-	if (ret != pdTRUE) {
-		ESP_LOGE(TAG, "Failed to send buffer into queue[%u]\n",queue_type);
-		return ESP_FAIL;
-	}
-
-	if (queue_type == PRIO_Q_SERIAL)
-		ret = xQueueSendToFront(meta_to_host_queue, &queue_type, portMAX_DELAY);
-	else
-		ret = xQueueSend(meta_to_host_queue, &queue_type, portMAX_DELAY);
+#ifdef CONFIG_ESP_HOSTED_TX_SCHEDULER
+	uint8_t lane = tx_lane_for(buf_handle, queue_type);
+	TickType_t wait = portMAX_DELAY;
+
+	/* Wi-Fi Rx is never blocked on a slow host. When its lane is full
+	 * the frame is dropped and the caller hands eb back to the Wi-Fi
+	 * driver. Buffers held in the lane keep the driver Rx pool under
+	 * pressure until the host catches up.
+	 */
+	if (buf_handle->if_type == ESP_STA_IF || buf_handle->if_type == ESP_AP_IF)
+		wait = 0;
 
-	if (ret != pdTRUE) {
-		ESP_LOGE(TAG, "Failed to send buffer into meta queue[%u]\n",queue_type);
+	if (xQueueSend(tx_lane[lane], buf_handle, wait) != pdTRUE) {
+  #if ESP_PKT_STATS
+		pkt_stats.sh_lane_drop++;
+  #endif
+		ESP_LOGV(TAG, "Tx lane[%u] full, drop", lane);
 		return ESP_FAIL;
 	}
+	xSemaphoreGive(tx_lane_sem);
 
+	return ESP_OK;
+#else
+	process_tx_pkt(buf_handle);
 	return ESP_OK;
 #endif
 }
@@ -943,6 +1327,15 @@ void create_slave_sta_netif(uint8_t dhcp_at_slave)
 	assert(netif_sta);
 
 	ESP_ERROR_CHECK(esp_netif_attach_wifi_station(netif_sta));
+
+	/* Same Wi-Fi driver, but Rx buffers freed through the shared refcount */
+	esp_netif_driver_ifconfig_t driver_ifconfig = {
+		.handle = esp_netif_get_io_driver(netif_sta),
+		.transmit = slave_sta_transmit,
+		.transmit_wrap = slave_sta_transmit_wrap,
+		.driver_free_rx_buffer = slave_sta_free_rx_buffer,
+	};
+	ESP_ERROR_CHECK(esp_netif_set_driver_config(netif_sta, &driver_ifconfig));
 	ESP_ERROR_CHECK(esp_wifi_set_default_wifi_sta_handlers());
 
 	if (!dhcp_at_slave) {
@@ -1125,6 +1518,20 @@ esp_err_t esp_hosted_coprocessor_init(void)
 		ESP_LOGE(TAG, "Failed to initialize driver\n");
 		return ESP_FAIL;
 	}
+
+#ifdef CONFIG_ESP_HOSTED_TX_SCHEDULER
+	tx_lane_sem = xSemaphoreCreateCounting(CONFIG_ESP_HOSTED_TX_LANE_DEPTH * TX_LANE_MAX, 0);
+	assert(tx_lane_sem);
+	for (uint8_t lane = 0; lane < TX_LANE_MAX; lane++) {
+		tx_lane[lane] = xQueueCreate(CONFIG_ESP_HOSTED_TX_LANE_DEPTH,
+				sizeof(interface_buffer_handle_t));
+		assert(tx_lane[lane]);
+	}
+	assert(xTaskCreate(send_task , "send_task" ,
+			CONFIG_ESP_HOSTED_DEFAULT_TASK_STACK_SIZE, NULL ,
+			CONFIG_ESP_HOSTED_DEFAULT_TASK_PRIORITY, NULL) == pdTRUE);
+#endif
+
 	assert(xTaskCreate(recv_task , "recv_task" ,
 			CONFIG_ESP_HOSTED_DEFAULT_TASK_STACK_SIZE, NULL ,
 			CONFIG_ESP_HOSTED_DEFAULT_TASK_PRIORITY, NULL) == pdTRUE);
@@ -1156,6 +1563,11 @@ esp_err_t esp_hosted_coprocessor_init(void)
 	initialise_bluetooth();
 #endif
 
+#if CONFIG_ESP_HOSTED_EVENT_COALESCE_WINDOW_MS
+	if (evt_coalesce_init())
+		ESP_LOGW(TAG, "Event coalescing disabled, no memory");
+#endif
+
 	pc_pserial = protocomm_new();
 	if (pc_pserial == NULL) {
 		ESP_LOGE(TAG,"Failed to allocate memory for new instance of protocomm ");
@@ -1178,19 +1590,6 @@ esp_err_t esp_hosted_coprocessor_init(void)
 
 	protocomm_pserial_start(pc_pserial, serial_write_data, serial_read_data);
 
-#if !BYPASS_TX_PRIORITY_Q
-	meta_to_host_queue = xQueueCreate(TO_HOST_QUEUE_SIZE*3, sizeof(uint8_t));
-	assert(meta_to_host_queue);
-	for (uint8_t prio_q_idx=0; prio_q_idx<MAX_PRIORITY_QUEUES; prio_q_idx++) {
-		to_host_queue[prio_q_idx] = xQueueCreate(TO_HOST_QUEUE_SIZE,
-				sizeof(interface_buffer_handle_t));
-		assert(to_host_queue[prio_q_idx]);
-	}
-	assert(xTaskCreate(send_task , "send_task" ,
-			CONFIG_ESP_HOSTED_DEFAULT_TASK_STACK_SIZE, NULL ,
-			CONFIG_ESP_HOSTED_DEFAULT_TASK_PRIORITY, NULL) == pdTRUE);
-#endif
-
 #ifdef CONFIG_ESP_HOSTED_CLI_ENABLED
 	esp_hosted_cli_start();
 #endif
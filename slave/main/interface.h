@@ -19,6 +19,7 @@
 #include "esp_err.h"
 #include "esp_hosted_log.h"
 #include "esp_hosted_transport.h"
+#include "esp_hosted_transport_init.h"
 
 #ifdef CONFIG_ESP_SDIO_HOST_INTERFACE
 
@@ -118,6 +119,7 @@ typedef struct {
 typedef struct {
 	uint8_t throttle_high_threshold;
 	uint8_t throttle_low_threshold;
+	uint8_t host_cap;
 } slave_config_t;
 
 typedef struct {
@@ -136,4 +138,10 @@ void send_dhcp_dns_info_to_host(uint8_t network_up, uint8_t send_wifi_connected)
 
 extern slave_config_t slv_cfg_g;
 extern slave_state_t  slv_state_g;
+
+/* Frames to host carry a CRC32 trailer, once host asked for it */
+static inline uint8_t is_tx_crc32_enabled(void)
+{
+	return (slv_cfg_g.host_cap & ESP_HOST_CAP_CRC32) ? 1 : 0;
+}
 #endif
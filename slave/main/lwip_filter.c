@@ -67,85 +67,123 @@ static struct {
 	uint16_t last_port;
 } udp_cache = {0};
 
-#define MAX_ALLOWED_TCP_SRC_PORTS 10
-#define MAX_ALLOWED_UDP_SRC_PORTS 10
-#define MAX_ALLOWED_TCP_DST_PORTS 10
-#define MAX_ALLOWED_UDP_DST_PORTS 10
-
-/* In the file-scope variables section */
-static uint16_t allowed_tcp_src_ports[MAX_ALLOWED_TCP_SRC_PORTS] = {0};
-static uint16_t allowed_udp_src_ports[MAX_ALLOWED_UDP_SRC_PORTS] = {0};
-static uint16_t allowed_tcp_dst_ports[MAX_ALLOWED_TCP_DST_PORTS] = {0};
-static uint16_t allowed_udp_dst_ports[MAX_ALLOWED_UDP_DST_PORTS] = {0};
-static int allowed_tcp_src_ports_count = 0;
-static int allowed_udp_src_ports_count = 0;
-static int allowed_tcp_dst_ports_count = 0;
-static int allowed_udp_dst_ports_count = 0;
-
-/* Parse a comma-separated list of ports into an array */
-static int init_allowed_ports(const char *ports_str, int *ports_count, uint16_t *ports_array, int max_ports, const char *port_type) {
+/* Allowed ports as sorted, non overlapping ranges */
+typedef struct {
+	uint16_t start;
+	uint16_t end;
+} port_range_t;
+
+typedef struct {
+	port_range_t *ranges;
+	int count;
+	bool initialized;
+} port_set_t;
+
+static port_set_t allowed_tcp_src_ports;
+static port_set_t allowed_udp_src_ports;
+static port_set_t allowed_tcp_dst_ports;
+static port_set_t allowed_udp_dst_ports;
+
+static int port_range_cmp(const void *a, const void *b)
+{
+	return (int)((const port_range_t *)a)->start - (int)((const port_range_t *)b)->start;
+}
+
+/* Parse one "port" or "first-last" token, returns 0 on success */
+static int parse_port_range(const char *tok, int len, port_range_t *range)
+{
+	long val[2] = {-1, -1};
+	int n = 0;
+
+	for (int i = 0; i < len; i++) {
+		if (isdigit((unsigned char)tok[i])) {
+			if (val[n] < 0)
+				val[n] = 0;
+			val[n] = val[n] * 10 + (tok[i] - '0');
+			if (val[n] > 0xffff)
+				return -1;
+		} else if (tok[i] == '-' && n == 0 && val[0] >= 0) {
+			n = 1;
+		} else if (!isspace((unsigned char)tok[i])) {
+			return -1;
+		}
+	}
+
+	if (val[0] < 0 || (n && val[1] < 0))
+		return -1;
+
+	range->start = val[0];
+	range->end = n ? val[1] : val[0];
+	if (range->start > range->end)
+		return -1;
+	return 0;
+}
+
+/* Parse a comma-separated list of ports and port ranges into a port set */
+static int init_allowed_ports(const char *ports_str, port_set_t *set, const char *port_type) {
+    port_range_t *ranges = NULL;
+    int num_tokens = 1;
+    int count = 0;
+
     /* Only initialize once */
-    static bool tcp_src_initialized = false;
-    static bool tcp_dst_initialized = false;
-    static bool udp_src_initialized = false;
-    static bool udp_dst_initialized = false;
-
-    /* Check if already initialized for this port type */
-    if ((strcmp(port_type, "tcp_src") == 0 && tcp_src_initialized) ||
-        (strcmp(port_type, "tcp_dst") == 0 && tcp_dst_initialized) ||
-        (strcmp(port_type, "udp_src") == 0 && udp_src_initialized) ||
-        (strcmp(port_type, "udp_dst") == 0 && udp_dst_initialized)) {
+    if (set->initialized) {
         return 0;
     }
 
-    /* Reset counter */
-    *ports_count = 0;
-
     /* If no ports string provided, return */
     if (!ports_str || !ports_str[0]) {
         ESP_LOGI(TAG, "No %s ports configured", port_type);
         return 0;
     }
 
-    char port_buf[6]; /* Max 5 digits for a port + null terminator */
-    int port_buf_idx = 0;
-
-    for (int i = 0; ports_str[i] != '\0' && *ports_count < max_ports; i++) {
-        if (isdigit((unsigned char)ports_str[i])) {  /* Fix: cast to unsigned char */
-            port_buf[port_buf_idx++] = ports_str[i];
-            if (port_buf_idx >= sizeof(port_buf) - 1) {
-                port_buf_idx = sizeof(port_buf) - 2; /* Prevent overflow */
-            }
-        } else if (ports_str[i] == ',') {
-            if (port_buf_idx > 0) {
-                port_buf[port_buf_idx] = '\0';
-                ports_array[(*ports_count)++] = atoi(port_buf);
-                port_buf_idx = 0;
-            }
-        }
+    for (const char *p = ports_str; *p; p++) {
+        if (*p == ',')
+            num_tokens++;
     }
 
-    /* Process the last port if there's no trailing comma */
-    if (port_buf_idx > 0) {
-        port_buf[port_buf_idx] = '\0';
-        ports_array[(*ports_count)++] = atoi(port_buf);
+    ranges = calloc(num_tokens, sizeof(port_range_t));
+    if (!ranges) {
+        ESP_LOGE(TAG, "No memory for %s ports", port_type);
+        return -1;
     }
 
-    /* Log the results */
-    ESP_LOGI(TAG, "Initialized %d allowed %s ports:", *ports_count, port_type);
-    for (int i = 0; i < *ports_count; i++) {
-        ESP_LOGI(TAG, "  - Port %d", ports_array[i]);
+    for (const char *tok = ports_str; *tok; ) {
+        const char *sep = strchr(tok, ',');
+        int len = sep ? (int)(sep - tok) : (int)strlen(tok);
+
+        if (parse_port_range(tok, len, &ranges[count]) == 0) {
+            count++;
+        } else if (len) {
+            ESP_LOGW(TAG, "Ignoring invalid %s port entry '%.*s'", port_type, len, tok);
+        }
+        tok += len + (sep ? 1 : 0);
     }
 
-    /* Mark as initialized */
-    if (strcmp(port_type, "tcp_src") == 0) {
-        tcp_src_initialized = true;
-    } else if (strcmp(port_type, "tcp_dst") == 0) {
-        tcp_dst_initialized = true;
-    } else if (strcmp(port_type, "udp_src") == 0) {
-        udp_src_initialized = true;
-    } else if (strcmp(port_type, "udp_dst") == 0) {
-        udp_dst_initialized = true;
+    /* Sort and merge overlapping or adjacent ranges */
+    qsort(ranges, count, sizeof(port_range_t), port_range_cmp);
+    int merged = 0;
+    for (int i = 1; i < count; i++) {
+        if ((uint32_t)ranges[i].start <= (uint32_t)ranges[merged].end + 1) {
+            if (ranges[i].end > ranges[merged].end)
+                ranges[merged].end = ranges[i].end;
+        } else {
+            ranges[++merged] = ranges[i];
+        }
+    }
+    if (count)
+        count = merged + 1;
+
+    set->ranges = ranges;
+    set->count = count;
+    set->initialized = true;
+
+    /* Log the results */
+    ESP_LOGI(TAG, "Initialized %d allowed %s port ranges:", count, port_type);
+    for (int i = 0; i < count; i++) {
+        if (ranges[i].start == ranges[i].end)
+            ESP_LOGI(TAG, "  - Port %u", ranges[i].start);
+        else
+            ESP_LOGI(TAG, "  - Ports %u-%u", ranges[i].start, ranges[i].end);
     }
 
     return 0;
@@ -157,14 +195,12 @@ static int init_allowed_tcp_ports(const char *ports_str_src, const char *ports_s
 
     if (ports_str_src && strlen(ports_str_src) > 0) {
         ESP_LOGI(TAG, "Host reserved TCP src ports: %s", ports_str_src);
-        ret1 = init_allowed_ports(ports_str_src, &allowed_tcp_src_ports_count,
-                                 allowed_tcp_src_ports, MAX_ALLOWED_TCP_SRC_PORTS, "tcp_src");
+        ret1 = init_allowed_ports(ports_str_src, &allowed_tcp_src_ports, "tcp_src");
     }
 
     if (ports_str_dst && strlen(ports_str_dst) > 0) {
         ESP_LOGI(TAG, "Host reserved TCP dst ports: %s", ports_str_dst);
-        ret2 = init_allowed_ports(ports_str_dst, &allowed_tcp_dst_ports_count,
-                                 allowed_tcp_dst_ports, MAX_ALLOWED_TCP_DST_PORTS, "tcp_dst");
+        ret2 = init_allowed_ports(ports_str_dst, &allowed_tcp_dst_ports, "tcp_dst");
     }
 
     if (ret1) {
@@ -182,11 +218,11 @@ static int init_allowed_udp_ports(const char *ports_str_src, const char *ports_s
     int ret1=0, ret2=0;
 	if (ports_str_src && strlen(ports_str_src) > 0) {
 		ESP_LOGI(TAG, "host reserved udp src ports: %s", ports_str_src);
-		ret1 = init_allowed_ports(ports_str_src, &allowed_udp_src_ports_count, allowed_udp_src_ports, MAX_ALLOWED_UDP_SRC_PORTS, "udp_src");
+		ret1 = init_allowed_ports(ports_str_src, &allowed_udp_src_ports, "udp_src");
 	}
 	if (ports_str_dst && strlen(ports_str_dst) > 0) {
 		ESP_LOGI(TAG, "host reserved udp dst ports: %s", ports_str_dst);
-		ret2 = init_allowed_ports(ports_str_dst, &allowed_udp_dst_ports_count, allowed_udp_dst_ports, MAX_ALLOWED_UDP_DST_PORTS, "udp_dst");
+		ret2 = init_allowed_ports(ports_str_dst, &allowed_udp_dst_ports, "udp_dst");
 	}
 
 	if (ret1) {
@@ -230,40 +266,37 @@ static int punch_hole_for_host_ports_from_config(const char *ports_str_tcp_src,
 }
 
 /* Port filtering functions */
-static inline bool is_tcp_src_port_allowed(uint16_t port) {
-    for (int i = 0; i < allowed_tcp_src_ports_count; i++) {
-        if (port == allowed_tcp_src_ports[i]) {
+static inline bool port_set_has(const port_set_t *set, uint16_t port) {
+    int lo = 0, hi = set->count - 1;
+
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+
+        if (port < set->ranges[mid].start) {
+            hi = mid - 1;
+        } else if (port > set->ranges[mid].end) {
+            lo = mid + 1;
+        } else {
             return true;
         }
     }
     return false;
 }
 
+static inline bool is_tcp_src_port_allowed(uint16_t port) {
+    return port_set_has(&allowed_tcp_src_ports, port);
+}
+
 static inline bool is_tcp_dst_port_allowed(uint16_t port) {
-    for (int i = 0; i < allowed_tcp_dst_ports_count; i++) {
-        if (port == allowed_tcp_dst_ports[i]) {
-            return true;
-        }
-    }
-    return false;
+    return port_set_has(&allowed_tcp_dst_ports, port);
 }
 
 static inline bool is_udp_src_port_allowed(uint16_t port) {
-    for (int i = 0; i < allowed_udp_src_ports_count; i++) {
-        if (port == allowed_udp_src_ports[i]) {
-            return true;
-        }
-    }
-    return false;
+    return port_set_has(&allowed_udp_src_ports, port);
 }
 
 static inline bool is_udp_dst_port_allowed(uint16_t port) {
-    for (int i = 0; i < allowed_udp_dst_ports_count; i++) {
-        if (port == allowed_udp_dst_ports[i]) {
-            return true;
-        }
-    }
-    return false;
+    return port_set_has(&allowed_udp_dst_ports, port);
 }
 
 static bool host_mqtt_wakeup_triggered(const void *payload, uint16_t payload_length)
@@ -346,6 +379,240 @@ static int is_local_udp_port_open(uint16_t port)
 	return found;
 }
 
+/* Flow cache
+ *
+ * Direct mapped on the 5-tuple, remembers TCP/UDP routing decisions so that
+ * allowed port lists and lwIP PCB lists are not looked up for every frame.
+ * All entries are dropped (generation bump) when port forwarding rules
+ * change or when a PCB shows up at the head of the lwIP listen or UDP list,
+ * which is where new ones are added. Decisions which looked at PCBs are
+ * also re-evaluated after FLOW_CACHE_PCB_TTL_MS, same as the port-open
+ * caches above, to catch closed PCBs. An entry is only used in the host
+ * power save state it was made in. Decisions on payload are not cached.
+ */
+#define FLOW_CACHE_SIZE                  32 /* power of 2 */
+#define FLOW_CACHE_PCB_TTL_MS            1000
+
+#define FLOW_NO_CACHE                    (1 << 0)
+#define FLOW_PCB_DEP                     (1 << 1)
+
+typedef struct {
+	uint32_t gen;
+	uint32_t src_ip;
+	uint32_t dst_ip;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t proto;
+	uint8_t result;
+	uint8_t host_ps;
+	uint8_t flags;
+	uint32_t stamp_ms;
+} flow_cache_entry_t;
+
+static struct {
+	flow_cache_entry_t entry[FLOW_CACHE_SIZE];
+	uint32_t gen;              /* entry valid only if same, never 0 */
+	void *tcp_listen_head;
+	void *udp_head;
+	uint32_t hits;
+	uint32_t misses;
+} flow_cache = { .gen = 1 };
+
+void lwip_filter_flow_cache_invalidate(void)
+{
+	if (!++flow_cache.gen)
+		flow_cache.gen = 1;
+}
+
+void lwip_filter_get_flow_cache_stats(uint32_t *hits, uint32_t *misses)
+{
+	if (hits)
+		*hits = flow_cache.hits;
+	if (misses)
+		*misses = flow_cache.misses;
+}
+
+static inline uint32_t flow_cache_now_ms(void)
+{
+	return (uint32_t)(esp_timer_get_time() >> 10); /* Approx ms */
+}
+
+static inline flow_cache_entry_t *flow_cache_slot(uint32_t src_ip, uint32_t dst_ip,
+		uint16_t src_port, uint16_t dst_port, uint8_t proto)
+{
+	uint32_t h = src_ip ^ (dst_ip * 0x9e3779b1) ^
+		((((uint32_t)src_port << 16) | dst_port) * 0x85ebca6b) ^ proto;
+
+	h ^= h >> 16;
+	return &flow_cache.entry[h & (FLOW_CACHE_SIZE - 1)];
+}
+
+static flow_cache_entry_t *flow_cache_lookup(uint32_t src_ip, uint32_t dst_ip,
+		uint16_t src_port, uint16_t dst_port, uint8_t proto)
+{
+	flow_cache_entry_t *e = NULL;
+
+	/* new listening/bound PCBs are pushed at the list head */
+	if (flow_cache.tcp_listen_head != (void *)tcp_listen_pcbs.pcbs ||
+	    flow_cache.udp_head != (void *)udp_pcbs) {
+		flow_cache.tcp_listen_head = tcp_listen_pcbs.pcbs;
+		flow_cache.udp_head = udp_pcbs;
+		lwip_filter_flow_cache_invalidate();
+	}
+
+	e = flow_cache_slot(src_ip, dst_ip, src_port, dst_port, proto);
+	if (e->gen != flow_cache.gen ||
+	    e->src_ip != src_ip || e->dst_ip != dst_ip ||
+	    e->src_port != src_port || e->dst_port != dst_port ||
+	    e->proto != proto ||
+	    e->host_ps != (uint8_t)is_host_power_saving())
+		return NULL;
+
+	if ((e->flags & FLOW_PCB_DEP) &&
+	    (uint32_t)(flow_cache_now_ms() - e->stamp_ms) >= FLOW_CACHE_PCB_TTL_MS)
+		return NULL;
+
+	return e;
+}
+
+static void flow_cache_insert(uint32_t src_ip, uint32_t dst_ip,
+		uint16_t src_port, uint16_t dst_port, uint8_t proto,
+		hosted_l2_bridge result, uint8_t flags)
+{
+	flow_cache_entry_t *e = NULL;
+
+	if (flags & FLOW_NO_CACHE)
+		return;
+
+	e = flow_cache_slot(src_ip, dst_ip, src_port, dst_port, proto);
+	e->src_ip = src_ip;
+	e->dst_ip = dst_ip;
+	e->src_port = src_port;
+	e->dst_port = dst_port;
+	e->proto = proto;
+	e->result = result;
+	e->host_ps = is_host_power_saving();
+	e->flags = flags;
+	e->stamp_ms = (flags & FLOW_PCB_DEP) ? flow_cache_now_ms() : 0;
+	e->gen = flow_cache.gen;
+}
+
+static hosted_l2_bridge route_tcp_packet(struct tcp_hdr *tcphdr,
+		u16_t src_port, u16_t dst_port, uint8_t *flags)
+{
+	hosted_l2_bridge result = DEFAULT_LWIP_TO_SEND;
+
+	ESP_LOGV(TAG, "dst_port: %u, src_port: %u", dst_port, src_port);
+
+	/* Check for allowed ports (SSH, RTSP, etc.) */
+	if (is_tcp_src_port_allowed(src_port) || is_tcp_dst_port_allowed(dst_port)) {
+		ESP_LOGV(TAG, "Priority tcp port traffic detected, forwarding to host");
+		result = HOST_LWIP_BRIDGE;
+		return result;
+	}
+
+	/* Check for iperf port */
+	if (dst_port == DEFAULT_IPERF_PORT) {
+		ESP_LOGV(TAG, "iperf pkt %u", DEFAULT_IPERF_PORT);
+		*flags |= FLOW_PCB_DEP;
+		if (is_local_tcp_port_open(dst_port)) {
+			result = SLAVE_LWIP_BRIDGE;
+			return result;
+		} else if (!is_host_power_saving()) {
+			result = HOST_LWIP_BRIDGE;
+			return result;
+		}
+	}
+
+	if (IS_REMOTE_TCP_PORT(dst_port)) {
+		if (is_host_power_saving()) {
+			/* filter host destined mqtt packet says 'wake-up-host' */
+			if (src_port == MQTT_PORT) {
+			#define TCP_HDR_LEN(tcphdr) ((TCPH_FLAGS(tcphdr) >> 12) * 4)
+
+				u16_t tcp_hdr_len = TCP_HDR_LEN(tcphdr);
+				u16_t mqtt_payload_length = lwip_ntohs(tcphdr->wnd);
+				u8_t *mqtt_payload = (u8_t *)tcphdr + tcp_hdr_len;
+
+				/* decided on payload */
+				*flags |= FLOW_NO_CACHE;
+				if (host_mqtt_wakeup_triggered(mqtt_payload, mqtt_payload_length)) {
+					ESP_LOGV(TAG, "Wakeup host: MQTT wakeup pkt");
+					result = HOST_LWIP_BRIDGE;
+					return result;
+				} else {
+					/* drop any other host destined mqtt packet */
+					result = INVALID_BRIDGE;
+					ESP_LOGW(TAG, "mqtt pkt DROPPED dst %u src %u => lwip %u", dst_port, src_port, result);
+					return result;
+				}
+			} else {
+				ESP_LOGV(TAG, "Wakeup host: TCP pkt");
+				result = INVALID_BRIDGE;
+				ESP_LOGW(TAG, "host pkt dropped in power save (dst %u src %u)", dst_port, src_port);
+				return result;
+			}
+		} else {
+			/* As host is not sleeping, send packets freely */
+			result = HOST_LWIP_BRIDGE;
+			return result;
+		}
+	} else if (IS_LOCAL_TCP_PORT(dst_port)) {
+		result = SLAVE_LWIP_BRIDGE;
+		return result;
+	}
+
+	return result;
+}
+
+static hosted_l2_bridge route_udp_packet(u16_t src_port, u16_t dst_port, uint8_t *flags)
+{
+	hosted_l2_bridge result = DEFAULT_LWIP_TO_SEND;
+
+	ESP_LOGV(TAG, "UDP dst_port: %u, src_port: %u", dst_port, src_port);
+
+	/* Check for allowed ports */
+	if (is_udp_src_port_allowed(src_port) || is_udp_dst_port_allowed(dst_port)) {
+		ESP_LOGV(TAG, "Priority udp port traffic detected, forwarding to host");
+		result = HOST_LWIP_BRIDGE;
+		return result;
+	}
+
+	/* Check for iperf UDP port */
+	if (dst_port == DEFAULT_IPERF_PORT) {
+		ESP_LOGV(TAG, "Detected iperf UDP packet on port %u", DEFAULT_IPERF_PORT);
+		*flags |= FLOW_PCB_DEP;
+		if (is_local_udp_port_open(dst_port)) {
+			result = SLAVE_LWIP_BRIDGE;
+			return result;
+		} else if (!is_host_power_saving()) {
+			result = HOST_LWIP_BRIDGE;
+			return result;
+		}
+	}
+
+	if (dst_port == LWIP_IANA_PORT_DHCP_CLIENT) {
+		result = DHCP_LWIP_BRIDGE;
+		return result;
+	}
+
+	if (IS_REMOTE_UDP_PORT(dst_port)) {
+		if (is_host_power_saving()) {
+			ESP_LOGW(TAG, "host pkt dropped in power save (dst %u src %u)", dst_port, src_port);
+			result = INVALID_BRIDGE;
+			return result;
+		} else {
+			result = HOST_LWIP_BRIDGE;
+			return result;
+		}
+	} else if (IS_LOCAL_UDP_PORT(dst_port)) {
+		result = SLAVE_LWIP_BRIDGE;
+		return result;
+	}
+
+	return result;
+}
+
 hosted_l2_bridge filter_and_route_packet(void *frame_data, uint16_t frame_length)
 {
 	hosted_l2_bridge result = DEFAULT_LWIP_TO_SEND;
@@ -371,113 +638,31 @@ hosted_l2_bridge filter_and_route_packet(void *frame_data, uint16_t frame_length
 		/* Get the protocol from the IP header */
 		proto = IPH_PROTO(iphdr);
 
-		if (proto == IP_PROTO_TCP) {
-			struct tcp_hdr *tcphdr = (struct tcp_hdr *)((u8_t *)iphdr + IPH_HL(iphdr) * 4);
-			dst_port = lwip_ntohs(tcphdr->dest);
-			src_port = lwip_ntohs(tcphdr->src);
+		if (proto == IP_PROTO_TCP || proto == IP_PROTO_UDP) {
+			/* TCP and UDP both start with src and dst port */
+			struct udp_hdr *l4hdr = (struct udp_hdr *)((u8_t *)iphdr + IPH_HL(iphdr) * 4);
+			flow_cache_entry_t *flow = NULL;
+			uint8_t flags = 0;
 
-			ESP_LOGV(TAG, "dst_port: %u, src_port: %u", dst_port, src_port);
+			dst_port = lwip_ntohs(l4hdr->dest);
+			src_port = lwip_ntohs(l4hdr->src);
 
-			/* Check for allowed ports (SSH, RTSP, etc.) */
-			if (is_tcp_src_port_allowed(src_port) || is_tcp_dst_port_allowed(dst_port)) {
-				ESP_LOGV(TAG, "Priority tcp port traffic detected, forwarding to host");
-				result = HOST_LWIP_BRIDGE;
-				return result;
+			flow = flow_cache_lookup(iphdr->src.addr, iphdr->dest.addr,
+					src_port, dst_port, proto);
+			if (flow) {
+				flow_cache.hits++;
+				return flow->result;
 			}
+			flow_cache.misses++;
 
-			/* Check for iperf port */
-			if (dst_port == DEFAULT_IPERF_PORT) {
-				ESP_LOGV(TAG, "iperf pkt %u", DEFAULT_IPERF_PORT);
-				if (is_local_tcp_port_open(dst_port)) {
-					result = SLAVE_LWIP_BRIDGE;
-					return result;
-				} else if (!is_host_power_saving()) {
-					result = HOST_LWIP_BRIDGE;
-					return result;
-				}
-			}
-
-			if (IS_REMOTE_TCP_PORT(dst_port)) {
-				if (is_host_power_saving()) {
-					/* filter host destined mqtt packet says 'wake-up-host' */
-					if (src_port == MQTT_PORT) {
-					#define TCP_HDR_LEN(tcphdr) ((TCPH_FLAGS(tcphdr) >> 12) * 4)
-
-						u16_t tcp_hdr_len = TCP_HDR_LEN(tcphdr);
-						u16_t mqtt_payload_length = lwip_ntohs(tcphdr->wnd);
-						u8_t *mqtt_payload = (u8_t *)tcphdr + tcp_hdr_len;
-
-						if (host_mqtt_wakeup_triggered(mqtt_payload, mqtt_payload_length)) {
-							ESP_LOGV(TAG, "Wakeup host: MQTT wakeup pkt");
-							result = HOST_LWIP_BRIDGE;
-							return result;
-						} else {
-							/* drop any other host destined mqtt packet */
-							result = INVALID_BRIDGE;
-							ESP_LOGW(TAG, "mqtt pkt DROPPED dst %u src %u => lwip %u", dst_port, src_port, result);
-							return result;
-						}
-					} else {
-						ESP_LOGV(TAG, "Wakeup host: TCP pkt");
-						result = INVALID_BRIDGE;
-						ESP_LOGW(TAG, "host pkt dropped in power save (dst %u src %u)", dst_port, src_port);
-						return result;
-					}
-				} else {
-					/* As host is not sleeping, send packets freely */
-					result = HOST_LWIP_BRIDGE;
-					return result;
-				}
-			} else if (IS_LOCAL_TCP_PORT(dst_port)) {
-				result = SLAVE_LWIP_BRIDGE;
-				return result;
-			}
-
-		} else if (proto == IP_PROTO_UDP) {
-			ESP_LOGV(TAG, "new udp packet");
-			struct udp_hdr *udphdr = (struct udp_hdr *)((u8_t *)iphdr + IPH_HL(iphdr) * 4);
-			dst_port = lwip_ntohs(udphdr->dest);
-			src_port = lwip_ntohs(udphdr->src);
-
-			ESP_LOGV(TAG, "UDP dst_port: %u, src_port: %u", dst_port, src_port);
-
-			/* Check for allowed ports */
-			if (is_udp_src_port_allowed(src_port) || is_udp_dst_port_allowed(dst_port)) {
-				ESP_LOGV(TAG, "Priority udp port traffic detected, forwarding to host");
-				result = HOST_LWIP_BRIDGE;
-				return result;
-			}
-
-			/* Check for iperf UDP port */
-			if (dst_port == DEFAULT_IPERF_PORT) {
-				ESP_LOGV(TAG, "Detected iperf UDP packet on port %u", DEFAULT_IPERF_PORT);
-				if (is_local_udp_port_open(dst_port)) {
-					result = SLAVE_LWIP_BRIDGE;
-					return result;
-				} else if (!is_host_power_saving()) {
-					result = HOST_LWIP_BRIDGE;
-					return result;
-				}
-			}
+			if (proto == IP_PROTO_TCP)
+				result = route_tcp_packet((struct tcp_hdr *)l4hdr, src_port, dst_port, &flags);
+			else
+				result = route_udp_packet(src_port, dst_port, &flags);
 
-			if (dst_port == LWIP_IANA_PORT_DHCP_CLIENT) {
-				result = DHCP_LWIP_BRIDGE;
-				return result;
-			}
-
-			if (IS_REMOTE_UDP_PORT(dst_port)) {
-				if (is_host_power_saving()) {
-					ESP_LOGW(TAG, "host pkt dropped in power save (dst %u src %u)", dst_port, src_port);
-					result = INVALID_BRIDGE;
-					return result;
-				} else {
-					result = HOST_LWIP_BRIDGE;
-					return result;
-				}
-			} else if (IS_LOCAL_UDP_PORT(dst_port)) {
-				result = SLAVE_LWIP_BRIDGE;
-				return result;
-			}
+			flow_cache_insert(iphdr->src.addr, iphdr->dest.addr,
+					src_port, dst_port, proto, result, flags);
+			return result;
 
 		} else if (proto == IP_PROTO_ICMP) {
 			ESP_LOGV(TAG, "new icmp packet");
@@ -522,6 +707,9 @@ hosted_l2_bridge filter_and_route_packet(void *frame_data, uint16_t frame_length
 }
 
 int configure_host_static_port_forwarding_rules(const char *ports_str_tcp_src, const char *ports_str_tcp_dst, const char *ports_str_udp_src, const char *ports_str_udp_dst) {
-    return punch_hole_for_host_ports_from_config(ports_str_tcp_src, ports_str_tcp_dst, ports_str_udp_src, ports_str_udp_dst);
+    int ret = punch_hole_for_host_ports_from_config(ports_str_tcp_src, ports_str_tcp_dst, ports_str_udp_src, ports_str_udp_dst);
+
+    lwip_filter_flow_cache_invalidate();
+    return ret;
 }
 #endif
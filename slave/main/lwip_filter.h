@@ -24,6 +24,12 @@ hosted_l2_bridge filter_and_route_packet(void *frame_data, uint16_t frame_length
 
 int configure_host_static_port_forwarding_rules(const char *ports_str_tcp_src, const char *ports_str_tcp_dst,
                                                 const char *ports_str_udp_src, const char *ports_str_udp_dst);
+
+/* Forget all cached per-flow routing decisions, e.g. after closing a socket
+ * on slave which should no longer receive its flow. Opened ones are noticed */
+void lwip_filter_flow_cache_invalidate(void);
+
+void lwip_filter_get_flow_cache_stats(uint32_t *hits, uint32_t *misses);
 #endif
 
 #endif
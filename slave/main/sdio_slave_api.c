@@ -18,6 +18,7 @@
 #include <string.h>
 #include <unistd.h>
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_hosted_log.h"
 #include "interface.h"
 #include "sdio_slave_api.h"
@@ -52,6 +53,61 @@ static uint8_t hosted_constructs_created = 0;
 static SemaphoreHandle_t sdio_rx_sem;
 static QueueHandle_t sdio_rx_queue[MAX_PRIORITY_QUEUES];
 static SemaphoreHandle_t sdio_send_queue_sem = NULL; // to count number of Tx bufs in IDF SDIO driver
+
+/* Host may pack multiple packets in one Rx buffer. Buffer is reloaded
+ * only once all packets in it are processed */
+static uint8_t sdio_rx_buf_refcnt[SDIO_NUM_RX_BUFFERS];
+static portMUX_TYPE sdio_rx_buf_lock = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+#if !SIMPLIFIED_SDIO_SLAVE && CONFIG_ESP_SDIO_TX_CREDIT
+  #define SDIO_TX_CREDIT                  1
+#else
+  #define SDIO_TX_CREDIT                  0
+#endif
+
+#if SDIO_TX_CREDIT
+/* Mirrors the SDIO token register: Rx buffers loaded so far. Piggybacked in
+ * headers to host, so host need not read the register to find free buffers.
+ * Guarded by sdio_rx_buf_lock */
+static uint32_t sdio_rx_buf_loaded;
+static uint32_t sdio_rx_buf_fetched;
+
+static inline void sdio_rx_buf_count_load(void)
+{
+	portENTER_CRITICAL(&sdio_rx_buf_lock);
+	sdio_rx_buf_loaded++;
+	portEXIT_CRITICAL(&sdio_rx_buf_lock);
+}
+#endif
+
+#if !SIMPLIFIED_SDIO_SLAVE && CONFIG_ESP_SDIO_TX_COALESCE
+  #define SDIO_TX_COALESCE                1
+#else
+  #define SDIO_TX_COALESCE                0
+#endif
+
+#if SDIO_TX_COALESCE
+/* Packets to host, queued within the coalescing window, are packed
+ * back-to-back in a burst buffer and sent as one SDIO packet. Host in
+ * streaming Rx mode splits them again, after a single read.
+ */
+#define SDIO_TX_BURST_NUM_BUFS           2
+#define SDIO_TX_BURST_MAX_LEN            CONFIG_ESP_SDIO_TX_COALESCE_MAX_BURST
+#define SDIO_TX_BURST_WINDOW_US          CONFIG_ESP_SDIO_TX_COALESCE_WINDOW_US
+
+static WORD_ALIGNED_ATTR uint8_t sdio_tx_burst_bufs[SDIO_TX_BURST_NUM_BUFS][SDIO_TX_BURST_MAX_LEN];
+static uint8_t sdio_tx_burst_buf_in_use[SDIO_TX_BURST_NUM_BUFS];
+static portMUX_TYPE sdio_tx_burst_buf_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static struct {
+	uint8_t *buf;
+	uint16_t len;
+} sdio_tx_burst;
+
+static SemaphoreHandle_t sdio_tx_burst_lock;
+static esp_timer_handle_t sdio_tx_burst_timer;
+static TaskHandle_t sdio_tx_burst_task_handle;
 #endif
 
 #define SDIO_SLAVE_TO_HOST_INT_BIT7     7
@@ -266,6 +322,20 @@ void generate_startup_event(uint8_t cap, uint32_t ext_cap)
 	*pos = LENGTH_1_BYTE;               pos++;len++;
 	*pos = raw_tp_cap;                  pos++;len++;
 
+#if !SIMPLIFIED_SDIO_SLAVE
+	ext_cap |= ESP_SDIO_RX_AGGREGATION_SUPPORT;
+#endif
+#if SDIO_TX_CREDIT
+	ext_cap |= ESP_SDIO_TX_CREDIT_SUPPORT;
+#endif
+	/* TLV - Extended Capability */
+	*pos = ESP_PRIV_CAP_EXT;            pos++;len++;
+	*pos = LENGTH_4_BYTE;               pos++;len++;
+	*pos = (ext_cap & 0xFF);            pos++;len++;
+	*pos = (ext_cap >> 8) & 0xFF;       pos++;len++;
+	*pos = (ext_cap >> 16) & 0xFF;      pos++;len++;
+	*pos = (ext_cap >> 24) & 0xFF;      pos++;len++;
+
 	*pos = ESP_PRIV_TX_Q_SIZE;          pos++;len++;
 	*pos = LENGTH_1_BYTE;               pos++;len++;
 	*pos = SDIO_DRIVER_TX_QUEUE_SIZE;   pos++;len++;
@@ -326,10 +396,47 @@ void generate_startup_event(uint8_t cap, uint32_t ext_cap)
 
 }
 
+#if !SIMPLIFIED_SDIO_SLAVE
+static inline uint8_t *sdio_rx_buf_refcnt_ptr(sdio_slave_buf_handle_t handle)
+{
+	size_t len = 0;
+	uint8_t *buf = sdio_slave_recv_get_buf(handle, &len);
+
+	return &sdio_rx_buf_refcnt[(buf - sdio_slave_rx_buffer[0]) / SDIO_RX_BUFFER_SIZE];
+}
+
+static inline void sdio_rx_buf_hold(sdio_slave_buf_handle_t handle)
+{
+	uint8_t *refcnt = sdio_rx_buf_refcnt_ptr(handle);
+
+	portENTER_CRITICAL(&sdio_rx_buf_lock);
+	(*refcnt)++;
+	portEXIT_CRITICAL(&sdio_rx_buf_lock);
+}
+#endif
+
 static void sdio_read_done(void *handle)
 {
+#if !SIMPLIFIED_SDIO_SLAVE
+	uint8_t *refcnt = sdio_rx_buf_refcnt_ptr((sdio_slave_buf_handle_t) handle);
+	uint8_t in_use = 0;
+
+	portENTER_CRITICAL(&sdio_rx_buf_lock);
+	if (*refcnt)
+		(*refcnt)--;
+	in_use = *refcnt;
+	portEXIT_CRITICAL(&sdio_rx_buf_lock);
+
+	if (in_use)
+		return;
+#endif
 	ESP_LOGV(TAG, "sdio_read_done, reloading buf");
+#if SDIO_TX_CREDIT
+	if (sdio_slave_recv_load_buf((sdio_slave_buf_handle_t) handle) == ESP_OK)
+		sdio_rx_buf_count_load();
+#else
 	sdio_slave_recv_load_buf((sdio_slave_buf_handle_t) handle);
+#endif
 }
 
 static interface_handle_t * sdio_init(void)
@@ -388,6 +495,9 @@ static interface_handle_t * sdio_init(void)
 			sdio_rx_queue[prio_q_idx] = xQueueCreate(SDIO_NUM_RX_BUFFERS, sizeof(interface_buffer_handle_t));
 			assert(sdio_rx_queue[prio_q_idx] != NULL);
 		}
+#if SDIO_TX_COALESCE
+		sdio_tx_coalesce_init();
+#endif
 	}
 #endif
 	ret = sdio_slave_initialize(&config);
@@ -396,6 +506,10 @@ static interface_handle_t * sdio_init(void)
 	}
 
 
+#if !SIMPLIFIED_SDIO_SLAVE
+	memset(sdio_rx_buf_refcnt, 0, sizeof(sdio_rx_buf_refcnt));
+#endif
+
 	for (int i = 0; i < SDIO_NUM_RX_BUFFERS; i++) {
 		handle = sdio_slave_recv_register_buf(sdio_slave_rx_buffer[i]);
 		assert(handle != NULL);
@@ -405,6 +519,9 @@ static interface_handle_t * sdio_init(void)
 			sdio_slave_deinit();
 			return NULL;
 		}
+#if SDIO_TX_CREDIT
+		sdio_rx_buf_count_load();
+#endif
 	}
 
 	/* ESP-Hosted uses bit6 and bit 7 internal use. Rest free for Users */
@@ -447,6 +564,104 @@ static interface_handle_t * sdio_init(void)
 	return &if_handle_g;
 }
 
+#if SDIO_TX_COALESCE
+static uint8_t *sdio_tx_burst_buf_get(void)
+{
+	uint8_t *buf = NULL;
+
+	portENTER_CRITICAL(&sdio_tx_burst_buf_lock);
+	for (int i = 0; i < SDIO_TX_BURST_NUM_BUFS; i++) {
+		if (!sdio_tx_burst_buf_in_use[i]) {
+			sdio_tx_burst_buf_in_use[i] = 1;
+			buf = sdio_tx_burst_bufs[i];
+			break;
+		}
+	}
+	portEXIT_CRITICAL(&sdio_tx_burst_buf_lock);
+
+	return buf;
+}
+
+/* Returns 1 if buf was a burst buffer */
+static uint8_t sdio_tx_burst_buf_put(uint8_t *buf)
+{
+	for (int i = 0; i < SDIO_TX_BURST_NUM_BUFS; i++) {
+		if (buf == sdio_tx_burst_bufs[i]) {
+			portENTER_CRITICAL(&sdio_tx_burst_buf_lock);
+			sdio_tx_burst_buf_in_use[i] = 0;
+			portEXIT_CRITICAL(&sdio_tx_burst_buf_lock);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* Coalescing needs host to parse multiple packets in one read */
+static inline uint8_t sdio_tx_coalesce_active(void)
+{
+	return (slv_cfg_g.host_cap & ESP_HOST_CAP_SDIO_RX_STREAM) ? 1 : 0;
+}
+
+/* To be called with sdio_tx_burst_lock held */
+static void sdio_tx_burst_flush(void)
+{
+	esp_err_t ret = ESP_OK;
+
+	if (!sdio_tx_burst.buf)
+		return;
+
+	esp_timer_stop(sdio_tx_burst_timer);
+
+	ESP_HEXLOGV("bus_tx_burst", sdio_tx_burst.buf, sdio_tx_burst.len, 32);
+
+	xSemaphoreTake(sdio_send_queue_sem, portMAX_DELAY);
+	ret = sdio_slave_send_queue(sdio_tx_burst.buf, sdio_tx_burst.len,
+			sdio_tx_burst.buf, portMAX_DELAY);
+	if (ret != ESP_OK) {
+		ESP_LOGE(TAG , "sdio slave burst transmit error, ret : 0x%x\r\n", ret);
+		xSemaphoreGive(sdio_send_queue_sem);
+		sdio_tx_burst_buf_put(sdio_tx_burst.buf);
+	}
+
+	sdio_tx_burst.buf = NULL;
+	sdio_tx_burst.len = 0;
+}
+
+static void sdio_tx_burst_timer_cb(void *arg)
+{
+	xTaskNotifyGive(sdio_tx_burst_task_handle);
+}
+
+/* flush the burst once coalescing window expires */
+static void sdio_tx_burst_task(void* pvParameters)
+{
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		xSemaphoreTake(sdio_tx_burst_lock, portMAX_DELAY);
+		sdio_tx_burst_flush();
+		xSemaphoreGive(sdio_tx_burst_lock);
+	}
+}
+
+static void sdio_tx_coalesce_init(void)
+{
+	esp_timer_create_args_t timer_args = {
+		.callback = &sdio_tx_burst_timer_cb,
+		.name = "sdio_tx_burst",
+	};
+
+	sdio_tx_burst_lock = xSemaphoreCreateMutex();
+	assert(sdio_tx_burst_lock);
+
+	ESP_ERROR_CHECK(esp_timer_create(&timer_args, &sdio_tx_burst_timer));
+
+	assert(xTaskCreate(sdio_tx_burst_task, "sdio_tx_burst_task",
+			CONFIG_ESP_HOSTED_DEFAULT_TASK_STACK_SIZE, NULL,
+			CONFIG_ESP_HOSTED_DEFAULT_TASK_PRIORITY, &sdio_tx_burst_task_handle) == pdTRUE);
+}
+#endif
+
 /* wait for sdio to finish tx, then free the buffer */
 #if !SIMPLIFIED_SDIO_SLAVE
 static void sdio_tx_done_task(void* pvParameters)
@@ -468,6 +683,10 @@ static void sdio_tx_done_task(void* pvParameters)
 			continue;
 		}
 		xSemaphoreGive(sdio_send_queue_sem);
+#if SDIO_TX_COALESCE
+		if (sdio_tx_burst_buf_put(sendbuf_p))
+			continue;
+#endif
 		sdio_buffer_tx_free(sendbuf_p);
 	}
 }
@@ -491,12 +710,21 @@ static inline struct esp_payload_header * update_tx_header(uint8_t* sendbuf,
 	header->offset = htole16(offset);
 	header->seq_num = htole16(buf_handle->seq_num);
 	header->flags = buf_handle->flag;
+	if (is_tx_crc32_enabled())
+		header->flags |= FLAG_CRC32;
 	//header->throttle_cmd = buf_handle->flow_ctl_en;
+#if SDIO_TX_CREDIT
+	if (H_HDR_CAN_CARRY_TX_CREDIT(header))
+		H_HDR_SET_TX_CREDIT(header, sdio_rx_buf_loaded & H_HDR_TX_CREDIT_MASK);
+#endif
 	UPDATE_HEADER_TX_PKT_NO(header);
 
+	if (header->flags & FLAG_CRC32)
+		esp_frame_crc32_fill(header);
 #if CONFIG_ESP_SDIO_CHECKSUM
-	header->checksum = htole16(compute_checksum(sendbuf,
-				offset+buf_handle->payload_len));
+	else
+		header->checksum = htole16(compute_checksum(sendbuf,
+					offset+buf_handle->payload_len));
 #endif
 
 	return header;
@@ -508,43 +736,24 @@ static inline esp_err_t copy_tx_payload(uint8_t *sendbuf, uint8_t* payload, uint
 	return ESP_OK;
 }
 
-static int32_t sdio_write(interface_handle_t *handle, interface_buffer_handle_t *buf_handle)
+static int sdio_send_pkt(interface_buffer_handle_t *buf_handle)
 {
 	int32_t total_len = 0;
 	uint8_t* sendbuf = NULL;
 	uint16_t offset = sizeof(struct esp_payload_header);
 	int ret = 0;
 
-	if (!handle || !buf_handle) {
-		ESP_LOGE(TAG , "Invalid arguments");
-		return ESP_FAIL;
-	}
-
-	if (handle->state < ACTIVE) {
-		ESP_LOGI(TAG, "Driver state not active, drop");
-		return ESP_FAIL;
-	}
-
-	if (is_host_power_saving()) {
-		ESP_LOGI(TAG, "Host sleeping, drop");
-		return ESP_FAIL;
-	}
-
-	if (!buf_handle->payload_len && !buf_handle->payload && !buf_handle->flag) {
-		ESP_LOGW(TAG , "Invalid arguments, len:%d, payload:%p, flag:%d, drop", buf_handle->payload_len, buf_handle->payload, buf_handle->flag);
-		return ESP_FAIL;
-	}
-
 	total_len = buf_handle->payload_len + offset;
 
-	sendbuf = sdio_buffer_tx_alloc(total_len, MEMSET_REQUIRED);
+	/* with room for CRC32 trailer */
+	sendbuf = sdio_buffer_tx_alloc(total_len + H_ESP_PAYLOAD_CRC32_LEN, MEMSET_REQUIRED);
 	if (sendbuf == NULL) {
 		ESP_LOGE(TAG, "send buffer[%"PRIu32"] malloc fail", total_len);
 		return ESP_FAIL;
 	}
 
 	copy_tx_payload(sendbuf, buf_handle->payload, buf_handle->payload_len);
-	update_tx_header(sendbuf, buf_handle);
+	total_len += esp_frame_trailer_len(update_tx_header(sendbuf, buf_handle));
 
 	ESP_HEXLOGV("bus_tx", sendbuf, total_len, 32);
 
@@ -570,6 +779,83 @@ static int32_t sdio_write(interface_handle_t *handle, interface_buffer_handle_t
 	sdio_buffer_tx_free(sendbuf);
 #endif
 
+	return ESP_OK;
+}
+
+#if SDIO_TX_COALESCE
+static int sdio_send_pkt_coalesced(interface_buffer_handle_t *buf_handle)
+{
+	/* including room for CRC32 trailer */
+	uint16_t total_len = buf_handle->payload_len + sizeof(struct esp_payload_header) +
+		H_ESP_PAYLOAD_CRC32_LEN;
+	uint8_t *pos = NULL;
+	int ret = ESP_OK;
+
+	xSemaphoreTake(sdio_tx_burst_lock, portMAX_DELAY);
+
+	if (sdio_tx_burst.buf && (sdio_tx_burst.len + total_len > SDIO_TX_BURST_MAX_LEN))
+		sdio_tx_burst_flush();
+
+	if (!sdio_tx_burst.buf && (total_len <= SDIO_TX_BURST_MAX_LEN)) {
+		sdio_tx_burst.buf = sdio_tx_burst_buf_get();
+		if (sdio_tx_burst.buf)
+			esp_timer_start_once(sdio_tx_burst_timer, SDIO_TX_BURST_WINDOW_US);
+	}
+
+	if (sdio_tx_burst.buf) {
+		pos = sdio_tx_burst.buf + sdio_tx_burst.len;
+		copy_tx_payload(pos, buf_handle->payload, buf_handle->payload_len);
+		sdio_tx_burst.len += buf_handle->payload_len + sizeof(struct esp_payload_header) +
+			esp_frame_trailer_len(update_tx_header(pos, buf_handle));
+
+		/* only data packets wait for the window to fill up */
+		if ((buf_handle->if_type != ESP_STA_IF) && (buf_handle->if_type != ESP_AP_IF))
+			sdio_tx_burst_flush();
+	} else {
+		/* all burst buffers in flight, send on its own */
+		ret = sdio_send_pkt(buf_handle);
+	}
+
+	xSemaphoreGive(sdio_tx_burst_lock);
+
+	return ret;
+}
+#endif
+
+static int32_t sdio_write(interface_handle_t *handle, interface_buffer_handle_t *buf_handle)
+{
+	int ret = 0;
+
+	if (!handle || !buf_handle) {
+		ESP_LOGE(TAG , "Invalid arguments");
+		return ESP_FAIL;
+	}
+
+	if (handle->state < ACTIVE) {
+		ESP_LOGI(TAG, "Driver state not active, drop");
+		return ESP_FAIL;
+	}
+
+	if (is_host_power_saving()) {
+		ESP_LOGI(TAG, "Host sleeping, drop");
+		return ESP_FAIL;
+	}
+
+	if (!buf_handle->payload_len && !buf_handle->payload && !buf_handle->flag) {
+		ESP_LOGW(TAG , "Invalid arguments, len:%d, payload:%p, flag:%d, drop", buf_handle->payload_len, buf_handle->payload, buf_handle->flag);
+		return ESP_FAIL;
+	}
+
+#if SDIO_TX_COALESCE
+	if (sdio_tx_coalesce_active())
+		ret = sdio_send_pkt_coalesced(buf_handle);
+	else
+#endif
+		ret = sdio_send_pkt(buf_handle);
+
+	if (ret)
+		return ESP_FAIL;
+
 #if ESP_PKT_STATS
 	if (buf_handle->if_type == ESP_STA_IF)
 		pkt_stats.sta_sh_out++;
@@ -610,11 +896,13 @@ static void sdio_rx_task(void* pvParameters)
   #if CONFIG_ESP_SDIO_CHECKSUM
 	uint16_t rx_checksum = 0, checksum = 0;
   #endif
-	uint16_t len = 0, offset = 0;
+	uint16_t len = 0, offset = 0, trailer_len = 0;
 	size_t sdio_read_len = 0;
 	interface_buffer_handle_t buf_handle = {0};
 	uint8_t flags = 0;
 	uint32_t recv_timeout = portMAX_DELAY;
+	uint8_t *rx_buf = NULL;
+	uint16_t pkt_pos = 0;
 
 	for(;;) {
 		/* Check if SDIO is deinitialized */
@@ -628,7 +916,7 @@ static void sdio_rx_task(void* pvParameters)
 		recv_timeout = pdMS_TO_TICKS(10);
 #endif
 
-		ret = sdio_slave_recv(&(buf_handle.sdio_buf_handle), &(buf_handle.payload),
+		ret = sdio_slave_recv(&(buf_handle.sdio_buf_handle), &rx_buf,
 				&(sdio_read_len), recv_timeout);
 		if (ret) {
 			/* Not an error if timed out, just return and let caller try again */
@@ -639,71 +927,100 @@ static void sdio_rx_task(void* pvParameters)
 			continue;
 		}
 
-		buf_handle.payload_len = sdio_read_len & 0xFFFF;
-
-		header = (struct esp_payload_header *) buf_handle.payload;
-		UPDATE_HEADER_RX_PKT_NO(header);
+		/* Reference held by this task, while packets are extracted */
+		sdio_rx_buf_hold(buf_handle.sdio_buf_handle);
+#if SDIO_TX_CREDIT
+		portENTER_CRITICAL(&sdio_rx_buf_lock);
+		sdio_rx_buf_fetched++;
+		portEXIT_CRITICAL(&sdio_rx_buf_lock);
+#endif
 
-		flags = header->flags;
-		if (flags & FLAG_POWER_SAVE_STARTED) {
-			if (context.event_handler) {
-				context.event_handler(ESP_POWER_SAVE_ON);
-			}
-		} else if (flags & FLAG_POWER_SAVE_STOPPED) {
-			if (context.event_handler) {
-				context.event_handler(ESP_POWER_SAVE_OFF);
+		/* Buffer holds one packet, or more if aggregated by host */
+		pkt_pos = 0;
+		do {
+			header = (struct esp_payload_header *) (rx_buf + pkt_pos);
+			UPDATE_HEADER_RX_PKT_NO(header);
+
+			flags = header->flags;
+			if (flags & FLAG_POWER_SAVE_STARTED) {
+				if (context.event_handler) {
+					context.event_handler(ESP_POWER_SAVE_ON);
+				}
+			} else if (flags & FLAG_POWER_SAVE_STOPPED) {
+				if (context.event_handler) {
+					context.event_handler(ESP_POWER_SAVE_OFF);
+				}
 			}
-		}
 
-		len = le16toh(header->len);
-		if (!len) {
-			ESP_LOGE(TAG, "sdio_slave_recv returned 0 len");
-			sdio_read_done(buf_handle.sdio_buf_handle);
-			continue;
-		}
+			len = le16toh(header->len);
+			offset = le16toh(header->offset);
+			trailer_len = esp_frame_trailer_len(header);
 
-		offset = le16toh(header->offset);
+			if (!len) {
+				if (!(flags & FLAG_AGGR_NEXT_PKT))
+					ESP_LOGE(TAG, "sdio_slave_recv returned 0 len");
+				goto next_pkt;
+			}
 
-		if (buf_handle.payload_len < len+offset) {
-			ESP_LOGE(TAG, "%s: err: read_len[%u] < len[%u]+offset[%u]", __func__,
-					buf_handle.payload_len, len, offset);
-			sdio_read_done(buf_handle.sdio_buf_handle);
-			continue;
-		}
+			if (sdio_read_len < pkt_pos + len + offset + trailer_len) {
+				ESP_LOGE(TAG, "%s: err: read_len[%u] < pos[%u]+len[%u]+offset[%u]+trailer[%u]", __func__,
+						(unsigned int)sdio_read_len, pkt_pos, len, offset, trailer_len);
+				break;
+			}
 
+			if (flags & FLAG_CRC32) {
+				if (esp_frame_crc32_verify(header)) {
+					ESP_LOGE(TAG, "sdio rx CRC32 mismatch, drop pkt");
+					break;
+				}
+			}
   #if CONFIG_ESP_SDIO_CHECKSUM
-		rx_checksum = le16toh(header->checksum);
-		header->checksum = 0;
+			else {
+				rx_checksum = le16toh(header->checksum);
+				header->checksum = 0;
 
-		checksum = compute_checksum(buf_handle.payload, len+offset);
+				checksum = compute_checksum((uint8_t *)header, len+offset);
 
-		if (checksum != rx_checksum) {
-			ESP_LOGE(TAG, "sdio rx calc_chksum[%u] != exp_chksum[%u], drop pkt", checksum, rx_checksum);
-			sdio_read_done(buf_handle.sdio_buf_handle);
-			continue;
-		}
+				if (checksum != rx_checksum) {
+					ESP_LOGE(TAG, "sdio rx calc_chksum[%u] != exp_chksum[%u], drop pkt", checksum, rx_checksum);
+					break;
+				}
+			}
   #endif
 
-		buf_handle.if_type = header->if_type;
-		buf_handle.if_num = header->if_num;
-		buf_handle.free_buf_handle = sdio_read_done;
+			buf_handle.payload = (uint8_t *)header;
+			buf_handle.payload_len = len + offset;
+			buf_handle.if_type = header->if_type;
+			buf_handle.if_num = header->if_num;
+			buf_handle.free_buf_handle = sdio_read_done;
 
   #if ESP_PKT_STATS
-		if (header->if_type == ESP_STA_IF)
-			pkt_stats.hs_bus_sta_in++;
+			if (header->if_type == ESP_STA_IF)
+				pkt_stats.hs_bus_sta_in++;
   #endif
-		start_rx_data_throttling_if_needed();
+			start_rx_data_throttling_if_needed();
 
+			/* Each queued packet holds a reference on the buffer */
+			sdio_rx_buf_hold(buf_handle.sdio_buf_handle);
 
-		if (header->if_type == ESP_SERIAL_IF) {
-			xQueueSend(sdio_rx_queue[PRIO_Q_SERIAL], &buf_handle, portMAX_DELAY);
-		} else if (header->if_type == ESP_HCI_IF) {
-			xQueueSend(sdio_rx_queue[PRIO_Q_BT], &buf_handle, portMAX_DELAY);
-		} else {
-			xQueueSend(sdio_rx_queue[PRIO_Q_OTHERS], &buf_handle, portMAX_DELAY);
-		}
+			if (header->if_type == ESP_SERIAL_IF) {
+				xQueueSend(sdio_rx_queue[PRIO_Q_SERIAL], &buf_handle, portMAX_DELAY);
+			} else if (header->if_type == ESP_HCI_IF) {
+				xQueueSend(sdio_rx_queue[PRIO_Q_BT], &buf_handle, portMAX_DELAY);
+			} else {
+				xQueueSend(sdio_rx_queue[PRIO_Q_OTHERS], &buf_handle, portMAX_DELAY);
+			}
+
+			xSemaphoreGive(sdio_rx_sem);
 
-		xSemaphoreGive(sdio_rx_sem);
+next_pkt:
+			pkt_pos = H_AGGR_PKT_ALIGN(pkt_pos + offset + len + trailer_len);
+		} while ((flags & FLAG_AGGR_NEXT_PKT) &&
+				(pkt_pos + sizeof(struct esp_payload_header) <= sdio_read_len));
+
+		/* Drop reference of this task. Buffer is reloaded once all
+		 * queued packets are also done */
+		sdio_read_done(buf_handle.sdio_buf_handle);
 	}
 }
 #else /* !SIMPLIFIED_SDIO_SLAVE */
@@ -759,16 +1076,26 @@ static int sdio_read(interface_handle_t *if_handle, interface_buffer_handle_t *b
 
 	len = le16toh(header->len) + le16toh(header->offset);
 
+	if (header->flags & FLAG_CRC32) {
+		if ((len + H_ESP_PAYLOAD_CRC32_LEN > sdio_read_len) ||
+		    esp_frame_crc32_verify(header)) {
+			ESP_LOGE(TAG, "sdio rx CRC32 mismatch, drop pkt");
+			sdio_read_done(buf_handle->sdio_buf_handle);
+			return ESP_FAIL;
+		}
+	}
   #if CONFIG_ESP_SDIO_CHECKSUM
-	rx_checksum = le16toh(header->checksum);
-	header->checksum = 0;
+	else {
+		rx_checksum = le16toh(header->checksum);
+		header->checksum = 0;
 
-	checksum = compute_checksum(buf_handle->payload, len);
+		checksum = compute_checksum(buf_handle->payload, len);
 
-	if (checksum != rx_checksum) {
-		ESP_LOGE(TAG, "sdio rx calc_chksum[%u] != exp_chksum[%u], drop pkt", checksum, rx_checksum);
-		sdio_read_done(buf_handle->sdio_buf_handle);
-		return ESP_FAIL;
+		if (checksum != rx_checksum) {
+			ESP_LOGE(TAG, "sdio rx calc_chksum[%u] != exp_chksum[%u], drop pkt", checksum, rx_checksum);
+			sdio_read_done(buf_handle->sdio_buf_handle);
+			return ESP_FAIL;
+		}
 	}
   #endif
 
@@ -797,6 +1124,14 @@ static void sdio_reset_task(void *pvParameters)
 		goto exit;
 	}
 
+#if SDIO_TX_CREDIT
+	/* Token register restarts from the buffers still loaded */
+	portENTER_CRITICAL(&sdio_rx_buf_lock);
+	sdio_rx_buf_loaded -= sdio_rx_buf_fetched;
+	sdio_rx_buf_fetched = 0;
+	portEXIT_CRITICAL(&sdio_rx_buf_lock);
+#endif
+
 	/* ESP-Hosted uses bit6 and bit 7 internal use, rest bits free */
 	sdio_slave_set_host_intena(SDIO_SLAVE_HOSTINT_SEND_NEW_PACKET |
 			SDIO_SLAVE_HOSTINT_BIT0 |
@@ -8,6 +8,8 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_private/wifi.h"
 #include "slave_control.h"
@@ -19,6 +21,8 @@
 #include "slave_wifi_config.h"
 #include "esp_hosted_log.h"
 #include "esp_hosted_coprocessor_fw_ver.h"
+#include "esp_hosted_rpc_arena.h"
+#include "esp_hosted_wifi_records.h"
 
 #if CONFIG_SOC_WIFI_HE_SUPPORT
 #include "esp_wifi_he.h"
@@ -52,6 +56,7 @@
 
 #define MIN_HEARTBEAT_INTERVAL      (10)
 #define MAX_HEARTBEAT_INTERVAL      (60*60)
+#define RPC_BATCH_MAX_REQS          16
 
 
 
@@ -67,6 +72,10 @@ typedef struct esp_rpc_cmd {
 
 
 static const char* TAG = "slave_rpc";
+
+/* Request being handled and its response. Requests are handled one at a
+ * time, by the pserial task */
+static esp_hosted_rpc_arena_t rpc_arena;
 static TimerHandle_t handle_heartbeat_task;
 static uint32_t hb_num;
 
@@ -83,6 +92,24 @@ static esp_ota_handle_t handle;
 const esp_partition_t* update_partition = NULL;
 static int ota_msg = 0;
 
+/* Windowed OTA: chunks are copied to a ring and written to flash by
+ * ota_writer_task, so next chunks are received meanwhile. A full ring
+ * blocks the RPC handler, which backpressures the host */
+#define OTA_WRITER_TASK_STACK       3072
+#define OTA_WRITER_TASK_PRIO        (tskIDLE_PRIORITY + 5)
+
+typedef struct {
+	uint8_t *data;     /* NULL: drain marker */
+	uint32_t len;
+	uint32_t seq_num;
+} ota_chunk_t;
+
+static QueueHandle_t ota_ring = NULL;
+static SemaphoreHandle_t ota_drained = NULL;
+static volatile uint32_t ota_written_seq = 0;
+static volatile esp_err_t ota_write_err = ESP_OK;
+static uint32_t ota_expected_seq = 1;
+
 extern esp_err_t wlan_sta_rx_callback(void *buffer, uint16_t len, void *eb);
 extern esp_err_t wlan_ap_rx_callback(void *buffer, uint16_t len, void *eb);
 
@@ -314,6 +341,74 @@ static esp_err_t req_wifi_get_ps(Rpc *req,
 	return ESP_OK;
 }
 
+static void ota_writer_task(void *arg)
+{
+	ota_chunk_t chunk = {0};
+	esp_err_t ret = ESP_OK;
+
+	while (1) {
+		if (xQueueReceive(ota_ring, &chunk, portMAX_DELAY) != pdTRUE)
+			continue;
+
+		if (!chunk.data) {
+			xSemaphoreGive(ota_drained);
+			continue;
+		}
+
+		/* after a failure, rest of the image is dropped */
+		if (!ota_write_err) {
+			ret = esp_ota_write(handle, chunk.data, chunk.len);
+			if (ret != ESP_OK) {
+				ESP_LOGE(TAG, "OTA write of chunk %" PRIu32 " failed with return code 0x%x",
+						chunk.seq_num, ret);
+				ota_write_err = ret;
+			} else {
+				ota_written_seq = chunk.seq_num;
+			}
+		}
+		free(chunk.data);
+	}
+}
+
+static esp_err_t ota_ring_init(void)
+{
+	if (ota_ring)
+		return ESP_OK;
+
+	ota_drained = xSemaphoreCreateBinary();
+	if (!ota_drained)
+		return ESP_ERR_NO_MEM;
+
+	ota_ring = xQueueCreate(CONFIG_ESP_HOSTED_OTA_RING_SIZE, sizeof(ota_chunk_t));
+	if (!ota_ring)
+		goto err;
+
+	if (xTaskCreate(ota_writer_task, "ota_writer", OTA_WRITER_TASK_STACK,
+			NULL, OTA_WRITER_TASK_PRIO, NULL) != pdPASS)
+		goto err;
+
+	return ESP_OK;
+err:
+	if (ota_ring)
+		vQueueDelete(ota_ring);
+	vSemaphoreDelete(ota_drained);
+	ota_ring = NULL;
+	ota_drained = NULL;
+	return ESP_ERR_NO_MEM;
+}
+
+/* Wait till all queued chunks are written */
+static void ota_ring_drain(void)
+{
+	ota_chunk_t marker = {0};
+
+	if (!ota_ring)
+		return;
+
+	xQueueSend(ota_ring, &marker, portMAX_DELAY);
+	xSemaphoreTake(ota_drained, portMAX_DELAY);
+}
+
 /* Function OTA begin */
 static esp_err_t req_ota_begin_handler (Rpc *req,
 		Rpc *resp, void *priv_data)
@@ -329,7 +424,7 @@ static esp_err_t req_ota_begin_handler (Rpc *req,
 	ESP_LOGI(TAG, "OTA update started");
 
 	resp_payload = (RpcRespOTABegin *)
-		calloc(1,sizeof(RpcRespOTABegin));
+		RPC_RESP_CALLOC(1,sizeof(RpcRespOTABegin));
 	if (!resp_payload) {
 		ESP_LOGE(TAG,"Failed to allocate memory");
 		return ESP_ERR_NO_MEM;
@@ -338,6 +433,17 @@ static esp_err_t req_ota_begin_handler (Rpc *req,
 	resp->payload_case = RPC__PAYLOAD_RESP_OTA_BEGIN;
 	resp->resp_ota_begin = resp_payload;
 
+	ret = ota_ring_init();
+	if (ret) {
+		ESP_LOGE(TAG, "Failed to create OTA ring");
+		goto err;
+	}
+	/* chunks of an aborted OTA */
+	ota_ring_drain();
+	ota_write_err = ESP_OK;
+	ota_written_seq = 0;
+	ota_expected_seq = 1;
+
 	/* Identify next OTA partition */
 	update_partition = esp_ota_get_next_update_partition(NULL);
 	if (update_partition == NULL) {
@@ -369,13 +475,15 @@ static esp_err_t req_ota_write_handler (Rpc *req,
 {
 	esp_err_t ret = ESP_OK;
 	RpcRespOTAWrite *resp_payload = NULL;
+	RpcReqOTAWrite *req_payload = NULL;
+	ota_chunk_t chunk = {0};
 
 	if (!req || !resp) {
 		ESP_LOGE(TAG, "Invalid parameters");
 		return ESP_FAIL;
 	}
 
-	resp_payload = (RpcRespOTAWrite *)calloc(1,sizeof(RpcRespOTAWrite));
+	resp_payload = (RpcRespOTAWrite *)RPC_RESP_CALLOC(1,sizeof(RpcRespOTAWrite));
 	if (!resp_payload) {
 		ESP_LOGE(TAG,"Failed to allocate memory");
 		return ESP_ERR_NO_MEM;
@@ -388,16 +496,53 @@ static esp_err_t req_ota_write_handler (Rpc *req,
 	rpc__resp__otawrite__init(resp_payload);
 	resp->payload_case = RPC__PAYLOAD_RESP_OTA_WRITE;
 	resp->resp_ota_write = resp_payload;
+	req_payload = req->req_ota_write;
 
-	ret = esp_ota_write( handle, (const void *)req->req_ota_write->ota_data.data,
-			req->req_ota_write->ota_data.len);
-	if (ret != ESP_OK) {
-		ESP_LOGE(TAG, "OTA write failed with return code 0x%x",ret);
-		resp_payload->resp = ret;
-		return ESP_OK;
+	if (!req_payload->seq_num) {
+		/* Legacy host: written before response */
+		ota_ring_drain();
+		ret = esp_ota_write( handle, (const void *)req_payload->ota_data.data,
+				req_payload->ota_data.len);
+		if (ret != ESP_OK) {
+			ESP_LOGE(TAG, "OTA write failed with return code 0x%x",ret);
+			goto err;
+		}
+		goto done;
+	}
+
+	if (ota_write_err) {
+		ret = ota_write_err;
+		goto err;
+	}
+
+	if (req_payload->seq_num != ota_expected_seq) {
+		ESP_LOGE(TAG, "OTA chunk %" PRIu32 " out of order, expected %" PRIu32,
+				req_payload->seq_num, ota_expected_seq);
+		ret = ESP_ERR_INVALID_STATE;
+		goto err;
 	}
+
+	/* RPC request is freed on return, keep a copy till written */
+	chunk.data = malloc(req_payload->ota_data.len);
+	if (!chunk.data) {
+		ret = ESP_ERR_NO_MEM;
+		goto err;
+	}
+	memcpy(chunk.data, req_payload->ota_data.data, req_payload->ota_data.len);
+	chunk.len = req_payload->ota_data.len;
+	chunk.seq_num = req_payload->seq_num;
+
+	xQueueSend(ota_ring, &chunk, portMAX_DELAY);
+	ota_expected_seq++;
+
+done:
+	resp_payload->written_seq_num = ota_written_seq;
 	resp_payload->resp = SUCCESS;
 	return ESP_OK;
+err:
+	resp_payload->written_seq_num = ota_written_seq;
+	resp_payload->resp = ret;
+	return ESP_OK;
 }
 
 /* Function OTA end */
@@ -413,7 +558,7 @@ static esp_err_t req_ota_end_handler (Rpc *req,
 		return ESP_FAIL;
 	}
 
-	resp_payload = (RpcRespOTAEnd *)calloc(1,sizeof(RpcRespOTAEnd));
+	resp_payload = (RpcRespOTAEnd *)RPC_RESP_CALLOC(1,sizeof(RpcRespOTAEnd));
 	if (!resp_payload) {
 		ESP_LOGE(TAG,"Failed to allocate memory");
 		return ESP_ERR_NO_MEM;
@@ -422,6 +567,14 @@ static esp_err_t req_ota_end_handler (Rpc *req,
 	resp->payload_case = RPC__PAYLOAD_RESP_OTA_END;
 	resp->resp_ota_end = resp_payload;
 
+	ota_ring_drain();
+	if (ota_write_err) {
+		ESP_LOGE(TAG, "OTA aborted, write failed earlier");
+		esp_ota_abort(handle);
+		ret = ota_write_err;
+		goto err;
+	}
+
 	ret = esp_ota_end(handle);
 	if (ret != ESP_OK) {
 		if (ret == ESP_ERR_OTA_VALIDATE_FAILED) {
@@ -509,7 +662,7 @@ static esp_err_t req_set_softap_vender_specific_ie_handler (Rpc *req,
 
 
 	resp_payload = (RpcRespSetSoftAPVendorSpecificIE *)
-		calloc(1,sizeof(RpcRespSetSoftAPVendorSpecificIE));
+		RPC_RESP_CALLOC(1,sizeof(RpcRespSetSoftAPVendorSpecificIE));
 	if (!resp_payload) {
 		ESP_LOGE(TAG,"Failed to allocate memory");
 		if (v_data)
@@ -1971,6 +2124,63 @@ static int copy_ap_record_to_rpc_struct(WifiApRecord *rpc, wifi_ap_record_t *sca
 	return 0;
 }
 
+static void copy_ap_record_to_packed(esp_hosted_ap_record_packed_t *p, const wifi_ap_record_t *scan)
+{
+	uint16_t bitmask = 0;
+	uint8_t he_bitmask = 0;
+
+	memcpy(p->bssid, scan->bssid, sizeof(p->bssid));
+	memcpy(p->ssid, scan->ssid, sizeof(p->ssid));
+	p->primary         = scan->primary;
+	p->second          = scan->second;
+	p->rssi            = scan->rssi;
+	p->authmode        = scan->authmode;
+	p->pairwise_cipher = scan->pairwise_cipher;
+	p->group_cipher    = scan->group_cipher;
+	p->ant             = scan->ant;
+
+	if (scan->phy_11b)
+		H_SET_BIT(WIFI_SCAN_AP_REC_phy_11b_BIT, bitmask);
+	if (scan->phy_11g)
+		H_SET_BIT(WIFI_SCAN_AP_REC_phy_11g_BIT, bitmask);
+	if (scan->phy_11n)
+		H_SET_BIT(WIFI_SCAN_AP_REC_phy_11n_BIT, bitmask);
+	if (scan->phy_lr)
+		H_SET_BIT(WIFI_SCAN_AP_REC_phy_lr_BIT, bitmask);
+	if (scan->phy_11a)
+		H_SET_BIT(WIFI_SCAN_AP_REC_phy_11a_BIT, bitmask);
+	if (scan->phy_11ac)
+		H_SET_BIT(WIFI_SCAN_AP_REC_phy_11ac_BIT, bitmask);
+	if (scan->phy_11ax)
+		H_SET_BIT(WIFI_SCAN_AP_REC_phy_11ax_BIT, bitmask);
+	if (scan->wps)
+		H_SET_BIT(WIFI_SCAN_AP_REC_wps_BIT, bitmask);
+	if (scan->ftm_responder)
+		H_SET_BIT(WIFI_SCAN_AP_REC_ftm_responder_BIT, bitmask);
+	if (scan->ftm_initiator)
+		H_SET_BIT(WIFI_SCAN_AP_REC_ftm_initiator_BIT, bitmask);
+	WIFI_SCAN_AP_SET_RESERVED_VAL(scan->reserved, bitmask);
+	p->bitmask = bitmask;
+
+	memcpy(p->country_cc, scan->country.cc, sizeof(p->country_cc));
+	p->country_schan        = scan->country.schan;
+	p->country_nchan        = scan->country.nchan;
+	p->country_max_tx_power = scan->country.max_tx_power;
+	p->country_policy       = scan->country.policy;
+
+	he_bitmask = scan->he_ap.bss_color & WIFI_HE_AP_INFO_BSS_COLOR_BITS;
+	if (scan->he_ap.partial_bss_color)
+		H_SET_BIT(WIFI_HE_AP_INFO_partial_bss_color_BIT, he_bitmask);
+	if (scan->he_ap.bss_color_disabled)
+		H_SET_BIT(WIFI_HE_AP_INFO_bss_color_disabled_BIT, he_bitmask);
+	p->he_ap_bitmask     = he_bitmask;
+	p->he_ap_bssid_index = scan->he_ap.bssid_index;
+
+	p->bandwidth    = scan->bandwidth;
+	p->vht_ch_freq1 = scan->vht_ch_freq1;
+	p->vht_ch_freq2 = scan->vht_ch_freq2;
+}
+
 static esp_err_t req_wifi_scan_get_ap_record(Rpc *req, Rpc *resp, void *priv_data)
 {
 	int ret = 0;
@@ -2040,7 +2250,26 @@ static esp_err_t req_wifi_scan_get_ap_records(Rpc *req, Rpc *resp, void *priv_da
 	}
 
 	resp_payload->number = number;
-	resp_payload->ap_records = (WifiApRecord**)calloc(number, sizeof(WifiApRecord *));
+
+	if (req->req_wifi_scan_get_ap_records->packed) {
+		esp_hosted_ap_record_packed_t *packed = NULL;
+
+		packed = RPC_RESP_CALLOC(number, sizeof(esp_hosted_ap_record_packed_t));
+		if (!packed) {
+			ESP_LOGE(TAG,"resp: malloc failed for packed ap records");
+			resp_payload->resp = RPC_ERR_MEMORY_FAILURE;
+			goto err;
+		}
+		for (i=0;i<number;i++)
+			copy_ap_record_to_packed(&packed[i], &p_a_ap_list[i]);
+
+		resp_payload->packed_records.data = (uint8_t *)packed;
+		resp_payload->packed_records.len = number * sizeof(esp_hosted_ap_record_packed_t);
+		resp_payload->packed_rec_len = sizeof(esp_hosted_ap_record_packed_t);
+		goto err;
+	}
+
+	resp_payload->ap_records = (WifiApRecord**)RPC_RESP_CALLOC(number, sizeof(WifiApRecord *));
 	if (!resp_payload->ap_records) {
 		ESP_LOGE(TAG,"resp: malloc failed for resp_payload->ap_records");
 		resp_payload->resp = RPC_ERR_MEMORY_FAILURE;
@@ -2278,10 +2507,44 @@ static esp_err_t req_wifi_ap_get_sta_list(Rpc *req, Rpc *resp, void *priv_data)
 	wifi_sta_list_t sta;
 	RPC_RET_FAIL_IF(esp_wifi_ap_get_sta_list(&sta));
 
+	if (req->req_wifi_ap_get_sta_list && req->req_wifi_ap_get_sta_list->packed) {
+		esp_hosted_sta_info_packed_t *packed = NULL;
+		uint16_t bitmask = 0;
+
+		packed = RPC_RESP_CALLOC(sta.num, sizeof(esp_hosted_sta_info_packed_t));
+		RPC_RET_FAIL_IF(!packed);
+
+		for (int i = 0; i < sta.num; i++) {
+			memcpy(packed[i].mac, sta.sta[i].mac, sizeof(packed[i].mac));
+			packed[i].rssi = sta.sta[i].rssi;
+
+			bitmask = 0;
+			if (sta.sta[i].phy_11b)
+				H_SET_BIT(WIFI_STA_INFO_phy_11b_BIT, bitmask);
+			if (sta.sta[i].phy_11g)
+				H_SET_BIT(WIFI_STA_INFO_phy_11g_BIT, bitmask);
+			if (sta.sta[i].phy_11n)
+				H_SET_BIT(WIFI_STA_INFO_phy_11n_BIT, bitmask);
+			if (sta.sta[i].phy_lr)
+				H_SET_BIT(WIFI_STA_INFO_phy_lr_BIT, bitmask);
+			if (sta.sta[i].phy_11ax)
+				H_SET_BIT(WIFI_STA_INFO_phy_11ax_BIT, bitmask);
+			if (sta.sta[i].is_mesh_child)
+				H_SET_BIT(WIFI_STA_INFO_is_mesh_child_BIT, bitmask);
+			WIFI_STA_INFO_SET_RESERVED_VAL(sta.sta[i].reserved, bitmask);
+			packed[i].bitmask = bitmask;
+		}
+
+		resp_payload->packed_sta.data = (uint8_t *)packed;
+		resp_payload->packed_sta.len = sta.num * sizeof(esp_hosted_sta_info_packed_t);
+		resp_payload->packed_rec_len = sizeof(esp_hosted_sta_info_packed_t);
+		return ESP_OK;
+	}
+
 	RPC_ALLOC_ELEMENT(WifiStaList, resp_payload->sta_list, wifi_sta_list__init);
 	WifiStaList * p_c_sta_list = resp_payload->sta_list;
 
-	resp_payload->sta_list->sta = (WifiStaInfo**)calloc(ESP_WIFI_MAX_CONN_NUM, sizeof(WifiStaInfo *));
+	resp_payload->sta_list->sta = (WifiStaInfo**)RPC_RESP_CALLOC(ESP_WIFI_MAX_CONN_NUM, sizeof(WifiStaInfo *));
 	if (!resp_payload->sta_list->sta) {
 		ESP_LOGE(TAG,"resp: malloc failed for resp_payload->sta_list->sta");
 		goto err;
@@ -2834,6 +3097,59 @@ static esp_err_t req_wifi_sta_itwt_set_target_wake_time_offset(Rpc *req, Rpc *re
 }
 #endif // CONFIG_SOC_WIFI_HE_SUPPORT
 
+static esp_err_t esp_rpc_command_dispatcher(Rpc *req, Rpc *resp, void *priv_data);
+
+/* Sub requests run in order, each answered as if sent alone.
+ * Nested batches are answered as not supported */
+static esp_err_t req_batch_handler(Rpc *req, Rpc *resp, void *priv_data)
+{
+	RPC_TEMPLATE(RpcRespBatch, resp_batch,
+			RpcReqBatch, req_batch,
+			rpc__resp__batch__init);
+
+	Rpc *sub_req = NULL;
+	Rpc *sub_resp = NULL;
+	size_t i = 0;
+
+	if (req_payload->n_reqs > RPC_BATCH_MAX_REQS) {
+		ESP_LOGE(TAG, "batch of %u reqs, max %u",
+				(unsigned)req_payload->n_reqs, RPC_BATCH_MAX_REQS);
+		resp_payload->resp = ESP_ERR_INVALID_SIZE;
+		return ESP_OK;
+	}
+	if (!req_payload->n_reqs)
+		return ESP_OK;
+
+	resp_payload->resps = (Rpc **)RPC_RESP_CALLOC(req_payload->n_reqs, sizeof(Rpc *));
+	if (!resp_payload->resps) {
+		resp_payload->resp = ESP_ERR_NO_MEM;
+		return ESP_OK;
+	}
+
+	for (i = 0; i < req_payload->n_reqs; i++) {
+		sub_req = req_payload->reqs[i];
+		sub_resp = (Rpc *)RPC_RESP_CALLOC(1, sizeof(Rpc));
+		if (!sub_resp) {
+			resp_payload->resp = ESP_ERR_NO_MEM;
+			break;
+		}
+		rpc__init(sub_resp);
+		sub_resp->msg_type = RPC_TYPE__Resp;
+		sub_resp->uid = sub_req->uid;
+		if (sub_req->msg_id == RPC_ID__Req_Batch) {
+			sub_resp->msg_id = RPC_ID__Resp_Base;
+		} else {
+			sub_resp->msg_id = sub_req->msg_id - RPC_ID__Req_Base + RPC_ID__Resp_Base;
+			sub_resp->payload_case = sub_resp->msg_id;
+			esp_rpc_command_dispatcher(sub_req, sub_resp, priv_data);
+		}
+		resp_payload->resps[i] = sub_resp;
+		resp_payload->n_resps = i + 1;
+	}
+
+	return ESP_OK;
+}
+
 static esp_rpc_req_t req_table[] = {
 	{
 		.req_num = RPC_ID__Req_GetMACAddress ,
@@ -3073,6 +3389,10 @@ static esp_rpc_req_t req_table[] = {
 		.req_num = RPC_ID__Req_GetDhcpDnsStatus,
 		.command_handler = req_get_dhcp_dns_status
 	},
+	{
+		.req_num = RPC_ID__Req_Batch,
+		.command_handler = req_batch_handler
+	},
 #if CONFIG_SOC_WIFI_HE_SUPPORT
 	{
 		.req_num = RPC_ID__Req_WifiStaTwtConfig,
@@ -3169,26 +3489,52 @@ static void esp_rpc_cleanup(Rpc *resp)
 	}
 }
 
+/* Drop request and response of the finished transaction at once.
+ * free_unpacked still walks the response for buffers a handler
+ * took from heap, arena memory is skipped */
+static void esp_rpc_arena_release(Rpc *resp)
+{
+	esp_hosted_rpc_arena_stats_t stats = {0};
+
+	if (resp)
+		rpc__free_unpacked(resp, &rpc_arena.allocator);
+
+	if (esp_hosted_rpc_arena_reset(&rpc_arena)) {
+		esp_hosted_rpc_arena_get_stats(&rpc_arena, &stats);
+		ESP_LOGD(TAG, "rpc arena high water %" PRIu32 "/%" PRIu32 " bytes, %" PRIu32 " of %" PRIu32 " msgs spilled to heap",
+				stats.high_water, stats.size, stats.overflows, stats.transactions);
+	}
+}
+
 esp_err_t data_transfer_handler(uint32_t session_id,const uint8_t *inbuf,
 		ssize_t inlen, uint8_t **outbuf, ssize_t *outlen, void *priv_data)
 {
 	Rpc *req = NULL;
+	Rpc *resp = NULL;
 	esp_err_t ret = ESP_OK;
 
-	Rpc *resp = (Rpc *)calloc(1, sizeof(Rpc)); // resp deallocated in esp_rpc_cleanup()
-	if (!resp) {
-		ESP_LOGE(TAG, "%s calloc failed", __func__);
+	if (!inbuf || !outbuf || !outlen) {
+		ESP_LOGE(TAG,"Buffers are NULL");
 		return ESP_FAIL;
 	}
 
-	if (!inbuf || !outbuf || !outlen) {
-		ESP_LOGE(TAG,"Buffers are NULL");
+	if (!rpc_arena.base &&
+	    esp_hosted_rpc_arena_init(&rpc_arena, CONFIG_ESP_HOSTED_RPC_ARENA_SIZE)) {
+		ESP_LOGE(TAG, "%s arena alloc failed", __func__);
+		return ESP_ERR_NO_MEM;
+	}
+
+	resp = (Rpc *)RPC_RESP_CALLOC(1, sizeof(Rpc)); // resp released in esp_rpc_arena_release()
+	if (!resp) {
+		ESP_LOGE(TAG, "%s calloc failed", __func__);
+		esp_rpc_arena_release(NULL);
 		return ESP_FAIL;
 	}
 
-	req = rpc__unpack(NULL, inlen, inbuf);
+	req = rpc__unpack(&rpc_arena.allocator, inlen, inbuf);
 	if (!req) {
 		ESP_LOGE(TAG, "Unable to unpack config data");
+		esp_rpc_arena_release(NULL);
 		return ESP_FAIL;
 	}
 
@@ -3204,8 +3550,6 @@ esp_err_t data_transfer_handler(uint32_t session_id,const uint8_t *inbuf,
 		goto err;
 	}
 
-	rpc__free_unpacked(req, NULL);
-
 	*outlen = rpc__get_packed_size (resp);
 	if (*outlen <= 0) {
 		ESP_LOGE(TAG, "Invalid encoding for response");
@@ -3217,7 +3561,7 @@ esp_err_t data_transfer_handler(uint32_t session_id,const uint8_t *inbuf,
 	*outbuf = (uint8_t *)calloc(1, *outlen);
 	if (!*outbuf) {
 		ESP_LOGE(TAG, "No memory allocated for outbuf");
-		esp_rpc_cleanup(resp);
+		esp_rpc_arena_release(resp);
 		return ESP_ERR_NO_MEM;
 	}
 
@@ -3226,11 +3570,11 @@ esp_err_t data_transfer_handler(uint32_t session_id,const uint8_t *inbuf,
 	//printf("Resp outbuf:\n");
 	//ESP_LOG_BUFFER_HEXDUMP("Resp outbuf", *outbuf, *outlen, ESP_LOG_INFO);
 
-	esp_rpc_cleanup(resp);
+	esp_rpc_arena_release(resp);
 	return ESP_OK;
 
 err:
-	esp_rpc_cleanup(resp);
+	esp_rpc_arena_release(resp);
 	return ESP_FAIL;
 }
 
@@ -40,6 +40,11 @@
         }
 
 
+/* Request handlers build the response in the rpc arena of slave_control.c,
+ * released as a whole once the response is packed. Events stay on heap */
+#define RPC_RESP_CALLOC(NuM, SizE)   esp_hosted_rpc_arena_calloc(&rpc_arena, NuM, SizE)
+#define RPC_RESP_STRNDUP(StR, MaX)   esp_hosted_rpc_arena_strndup(&rpc_arena, StR, MaX)
+
 #define NTFY_TEMPLATE(NtFy_MsgId, NtFy_TyPe, NtFy_StRuCt, InIt_FuN)           \
 	NtFy_TyPe *ntfy_payload = NULL;                                             \
 	ntfy_payload = (NtFy_TyPe*)calloc(1,sizeof(NtFy_TyPe));                     \
@@ -60,7 +65,7 @@
     return ESP_FAIL;                                                            \
   }                                                                             \
   req_payload = req->ReqStruct;                                                 \
-  resp_payload = (RspTyPe *)calloc(1, sizeof(RspTyPe));                         \
+  resp_payload = (RspTyPe *)RPC_RESP_CALLOC(1, sizeof(RspTyPe));                \
   if (!resp_payload) {                                                          \
       ESP_LOGE(TAG, "Failed to alloc mem for resp.%s\n",#RspStRuCt);            \
       return ESP_ERR_NO_MEM;                                                    \
@@ -77,7 +82,7 @@
     ESP_LOGE(TAG, "Invalid parameters");                                        \
     return ESP_FAIL;                                                            \
   }                                                                             \
-  resp_payload = (RspTyPe *)calloc(1, sizeof(RspTyPe));                         \
+  resp_payload = (RspTyPe *)RPC_RESP_CALLOC(1, sizeof(RspTyPe));                \
   if (!resp_payload) {                                                          \
       ESP_LOGE(TAG, "Failed to alloc mem for resp.%s\n",#RspStRuCt);            \
       return ESP_ERR_NO_MEM;                                                    \
@@ -100,7 +105,7 @@
 
 
 #define RPC_ALLOC_ELEMENT(TyPe,MsG_StRuCt,InIt_FuN) {                         \
-    TyPe *NeW_AllocN = (TyPe *)calloc(1, sizeof(TyPe));                       \
+    TyPe *NeW_AllocN = (TyPe *)RPC_RESP_CALLOC(1, sizeof(TyPe));              \
     if (!NeW_AllocN) {                                                        \
         ESP_LOGI(TAG,"Failed to allocate memory for req.%s\n",#MsG_StRuCt);   \
         resp_payload->resp = RPC_ERR_MEMORY_FAILURE;                          \
@@ -144,7 +149,7 @@
 
 #define RPC_RESP_COPY_STR(dest, src, max_len)                                   \
   if (src) {                                                                    \
-    dest.data = (uint8_t*)strndup((char*)src, max_len);                         \
+    dest.data = (uint8_t*)RPC_RESP_STRNDUP((char*)src, max_len);                \
     if (!dest.data) {                                                           \
       ESP_LOGE(TAG, "%s:%u Failed to duplicate bytes\n",__func__,__LINE__);     \
       resp_payload->resp = FAILURE;                                             \
@@ -156,7 +161,7 @@
 #define RPC_RESP_COPY_BYTES_SRC_UNCHECKED(dest, src, num)                       \
   do {                                                                          \
     if (num) {                                                                  \
-      dest.data = (uint8_t *)calloc(1, num);                                    \
+      dest.data = (uint8_t *)RPC_RESP_CALLOC(1, num);                           \
       if (!dest.data) {                                                         \
         ESP_LOGE(TAG, "%s:%u Failed to duplicate bytes\n",__func__,__LINE__);   \
         resp_payload->resp = FAILURE;                                           \
@@ -174,7 +179,7 @@
 
 #define RPC_COPY_STR(dest, src, max_len)                                        \
   if (src) {                                                                    \
-    dest.data = (uint8_t*)strndup((char*)src, max_len);                         \
+    dest.data = (uint8_t*)RPC_RESP_STRNDUP((char*)src, max_len);                \
     if (!dest.data) {                                                           \
       ESP_LOGE(TAG, "%s:%u Failed to duplicate bytes\n",__func__,__LINE__);     \
       return FAILURE;                                                           \
@@ -185,7 +190,7 @@
 #define RPC_COPY_BYTES(dest, src, num)                                          \
   do {                                                                          \
     if (num) {                                                                  \
-      dest.data = (uint8_t *)calloc(1, num);                                    \
+      dest.data = (uint8_t *)RPC_RESP_CALLOC(1, num);                           \
       if (!dest.data) {                                                         \
         ESP_LOGE(TAG, "%s:%u Failed to duplicate bytes\n",__func__,__LINE__);   \
         return FAILURE;                                                         \
@@ -409,7 +409,7 @@ static void spi_hd_rx_task(void* pvParameters)
 	spi_slave_hd_data_t *rx_trans = NULL;
 	spi_slave_hd_data_t *ret_trans = NULL;
 	esp_err_t res;
-	uint16_t len = 0, offset = 0;
+	uint16_t len = 0, offset = 0, trailer_len = 0;
 	uint8_t flags = 0;
 
 	struct esp_payload_header *header = NULL;
@@ -472,6 +472,7 @@ static void spi_hd_rx_task(void* pvParameters)
 		len = le16toh(header->len);
 		offset = le16toh(header->offset);
 		flags = header->flags;
+		trailer_len = esp_frame_trailer_len(header);
 
 		ESP_LOGV(TAG, "Received flags: 0x%02x", flags);
 
@@ -487,26 +488,37 @@ static void spi_hd_rx_task(void* pvParameters)
 				context.event_handler(ESP_POWER_SAVE_OFF);
 			}
 		}
-		if (buf_handle.payload_len < len+offset) {
-			ESP_LOGE(TAG, "%s: err: read_len[%u] < len[%u]+offset[%u]", __func__,
-					buf_handle.payload_len, len, offset);
+		if (buf_handle.payload_len < len+offset+trailer_len) {
+			ESP_LOGE(TAG, "%s: err: read_len[%u] < len[%u]+offset[%u]+trailer[%u]", __func__,
+					buf_handle.payload_len, len, offset, trailer_len);
 			// return the transaction back to the rx queue
 			spi_hd_read_done(ret_trans);
 			continue;
 		}
 
+		if (flags & FLAG_CRC32) {
+			if (esp_frame_crc32_verify(header)) {
+				ESP_LOGE(TAG, "%s: CRC32 mismatch, drop len[%u] offset[%u]",
+						 __func__, len, offset);
+				// return the transaction back to the rx queue
+				spi_hd_read_done(ret_trans);
+				continue;
+			}
+		}
 #if CONFIG_ESP_SPI_HD_CHECKSUM
-		rx_checksum = le16toh(header->checksum);
-		header->checksum = 0;
-
-		checksum = compute_checksum(buf_handle.payload, len+offset);
-
-		if (checksum != rx_checksum) {
-			ESP_LOGE(TAG, "%s: cal_chksum[%u] != exp_chksum[%u], drop len[%u] offset[%u]",
-					 __func__, checksum, rx_checksum, len, offset);
-			// return the transaction back to the rx queue
-			spi_hd_read_done(ret_trans);
-			continue;
+		else {
+			rx_checksum = le16toh(header->checksum);
+			header->checksum = 0;
+
+			checksum = compute_checksum(buf_handle.payload, len+offset);
+
+			if (checksum != rx_checksum) {
+				ESP_LOGE(TAG, "%s: cal_chksum[%u] != exp_chksum[%u], drop len[%u] offset[%u]",
+						 __func__, checksum, rx_checksum, len, offset);
+				// return the transaction back to the rx queue
+				spi_hd_read_done(ret_trans);
+				continue;
+			}
 		}
 #endif
 
@@ -723,6 +735,7 @@ static int32_t esp_spi_hd_write(interface_handle_t *handle, interface_buffer_han
 	int32_t total_len = 0;
 	uint8_t* sendbuf = NULL;
 	uint16_t offset = sizeof(struct esp_payload_header);
+	uint16_t trailer_len = 0;
 	struct esp_payload_header *header = NULL;
 	spi_slave_hd_data_t *tx_trans = NULL;
 
@@ -745,8 +758,13 @@ static int32_t esp_spi_hd_write(interface_handle_t *handle, interface_buffer_han
 
 	total_len = buf_handle->payload_len + offset;
 
+	/* CRC32 trailer, if in use and it fits in */
+	if (is_tx_crc32_enabled() &&
+	    (total_len + H_ESP_PAYLOAD_CRC32_LEN <= SPI_HD_BUFFER_SIZE))
+		trailer_len = H_ESP_PAYLOAD_CRC32_LEN;
+
 	xSemaphoreTake(mempool_tx_sem, portMAX_DELAY);
-	sendbuf = spi_hd_buffer_tx_alloc(total_len, MEMSET_REQUIRED);
+	sendbuf = spi_hd_buffer_tx_alloc(total_len + trailer_len, MEMSET_REQUIRED);
 	if (sendbuf == NULL) {
 		ESP_LOGE(TAG , "send buffer[%"PRIu32"] malloc fail", total_len);
 		MEM_DUMP("malloc failed");
@@ -764,12 +782,19 @@ static int32_t esp_spi_hd_write(interface_handle_t *handle, interface_buffer_han
 	header->flags = buf_handle->flag;
 	header->throttle_cmd = buf_handle->wifi_flow_ctrl_en;
 	header->flags = buf_handle->flag;
+	if (trailer_len)
+		header->flags |= FLAG_CRC32;
 
 	memcpy(sendbuf + offset, buf_handle->payload, buf_handle->payload_len);
 
+	if (trailer_len) {
+		esp_frame_crc32_fill(header);
+		total_len += trailer_len;
+	}
 #if CONFIG_ESP_SPI_HD_CHECKSUM
-	header->checksum = htole16(compute_checksum(sendbuf,
-				offset+buf_handle->payload_len));
+	else
+		header->checksum = htole16(compute_checksum(sendbuf,
+					offset+buf_handle->payload_len));
 #endif
 
 	ESP_LOGD(TAG, "sending %"PRIu32 " bytes, flag: 0x%02x", total_len, buf_handle->flag);
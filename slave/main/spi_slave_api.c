@@ -297,6 +297,14 @@ void generate_startup_event(uint8_t cap, uint32_t ext_cap)
 	*pos = LENGTH_1_BYTE;               pos++;len++;
 	*pos = raw_tp_cap;                  pos++;len++;
 
+	/* TLV - Extended Capability */
+	*pos = ESP_PRIV_CAP_EXT;            pos++;len++;
+	*pos = LENGTH_4_BYTE;               pos++;len++;
+	*pos = (ext_cap & 0xFF);            pos++;len++;
+	*pos = (ext_cap >> 8) & 0xFF;       pos++;len++;
+	*pos = (ext_cap >> 16) & 0xFF;      pos++;len++;
+	*pos = (ext_cap >> 24) & 0xFF;      pos++;len++;
+
 	*pos = ESP_PRIV_RX_Q_SIZE;          pos++;len++;
 	*pos = LENGTH_1_BYTE;               pos++;len++;
 	*pos = SPI_RX_QUEUE_SIZE;           pos++;len++;
@@ -428,6 +436,7 @@ static int process_spi_rx(interface_buffer_handle_t *buf_handle)
 	struct esp_payload_header *header = NULL;
 	uint16_t len = 0, offset = 0;
 	uint8_t flags = 0;
+	uint16_t trailer_len = 0;
 #if CONFIG_ESP_SPI_CHECKSUM
 	uint16_t rx_checksum = 0, checksum = 0;
 #endif
@@ -443,6 +452,7 @@ static int process_spi_rx(interface_buffer_handle_t *buf_handle)
 	len = le16toh(header->len);
 	offset = le16toh(header->offset);
 	flags = header->flags;
+	trailer_len = esp_frame_trailer_len(header);
 	ESP_LOGV(TAG, "process_spi_rx: flags[%u]", flags);
 
 	if (flags & FLAG_POWER_SAVE_STARTED) {
@@ -462,22 +472,31 @@ static int process_spi_rx(interface_buffer_handle_t *buf_handle)
 		return -1;
 	}
 
-	if ((len+offset) > SPI_BUFFER_SIZE) {
-		ESP_LOGE(TAG, "rx_pkt len+offset[%u]>max[%u], dropping it", len+offset, SPI_BUFFER_SIZE);
+	if ((len+offset+trailer_len) > SPI_BUFFER_SIZE) {
+		ESP_LOGE(TAG, "rx_pkt len+offset+trailer[%u]>max[%u], dropping it", len+offset+trailer_len, SPI_BUFFER_SIZE);
 
 		return -1;
 	}
 
+	if (flags & FLAG_CRC32) {
+		if (esp_frame_crc32_verify(header)) {
+			ESP_LOGE(TAG, "%s: CRC32 mismatch, drop len[%u] offset[%u]",
+					__func__, len, offset);
+			return -1;
+		}
+	}
 #if CONFIG_ESP_SPI_CHECKSUM
-	rx_checksum = le16toh(header->checksum);
-	header->checksum = 0;
+	else {
+		rx_checksum = le16toh(header->checksum);
+		header->checksum = 0;
 
-	checksum = compute_checksum(buf_handle->payload, len+offset);
+		checksum = compute_checksum(buf_handle->payload, len+offset);
 
-	if (checksum != rx_checksum) {
-		ESP_LOGE(TAG, "%s: cal_chksum[%u] != exp_chksum[%u], drop len[%u] offset[%u]",
-				__func__, checksum, rx_checksum, len, offset);
-		return -1;
+		if (checksum != rx_checksum) {
+			ESP_LOGE(TAG, "%s: cal_chksum[%u] != exp_chksum[%u], drop len[%u] offset[%u]",
+					__func__, checksum, rx_checksum, len, offset);
+			return -1;
+		}
 	}
 #endif
 	ESP_HEXLOGD("spi_rx", header, len, 32);
@@ -786,6 +805,7 @@ static int32_t esp_spi_write(interface_handle_t *handle, interface_buffer_handle
 {
 	int32_t total_len = 0;
 	uint16_t offset = 0;
+	uint8_t flags = 0;
 	struct esp_payload_header *header = NULL;
 	interface_buffer_handle_t tx_buf_handle = {0};
 
@@ -806,6 +826,13 @@ static int32_t esp_spi_write(interface_handle_t *handle, interface_buffer_handle
 
 	total_len = buf_handle->payload_len + sizeof (struct esp_payload_header);
 
+	/* CRC32 trailer, if in use and it fits in */
+	if (is_tx_crc32_enabled() &&
+	    (total_len + H_ESP_PAYLOAD_CRC32_LEN <= SPI_BUFFER_SIZE)) {
+		flags |= FLAG_CRC32;
+		total_len += H_ESP_PAYLOAD_CRC32_LEN;
+	}
+
 	/* make the adresses dma aligned */
 	if (!IS_SPI_DMA_ALIGNED(total_len)) {
 		MAKE_SPI_DMA_ALIGNED(total_len);
@@ -838,7 +865,7 @@ static int32_t esp_spi_write(interface_handle_t *handle, interface_buffer_handle
 	offset = sizeof(struct esp_payload_header);
 	header->offset = htole16(offset);
 	header->seq_num = htole16(buf_handle->seq_num);
-	header->flags = buf_handle->flag;
+	header->flags = buf_handle->flag | flags;
 
 	tx_buf_handle.wifi_flow_ctrl_en = find_wifi_tx_throttling_to_be_set();
 
@@ -846,9 +873,12 @@ static int32_t esp_spi_write(interface_handle_t *handle, interface_buffer_handle
 	memcpy(tx_buf_handle.payload + offset, buf_handle->payload, buf_handle->payload_len);
 
 
+	if (header->flags & FLAG_CRC32)
+		esp_frame_crc32_fill(header);
 #if CONFIG_ESP_SPI_CHECKSUM
-	header->checksum = htole16(compute_checksum(tx_buf_handle.payload,
-				offset+buf_handle->payload_len));
+	else
+		header->checksum = htole16(compute_checksum(tx_buf_handle.payload,
+					offset+buf_handle->payload_len));
 #endif
 
 	if (header->if_type == ESP_SERIAL_IF)
@@ -7,6 +7,7 @@
 #include "esp_log.h"
 #include "esp_hosted_transport_init.h"
 #include "esp_hosted_header.h"
+#include "lwip_filter.h"
 
 #if TEST_RAW_TP || ESP_PKT_STATS || CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
 static const char TAG[] = "stats";
@@ -280,14 +281,23 @@ static void stats_timer_func(void* arg)
 	test_raw_tp_rx_len = test_raw_tp_tx_len = 0;
 #endif
 #if ESP_PKT_STATS
-	ESP_LOGI(TAG, "STA: flw_ctrl(on[%lu] off[%lu]) H2S(in[%lu] out[%lu] fail[%lu]) S2H(in[%lu] out[%lu]) Ctrl: (in[%lu] rsp[%lu] evt[%lu])",
+	ESP_LOGI(TAG, "STA: flw_ctrl(on[%lu] off[%lu]) H2S(in[%lu] out[%lu] fail[%lu]) S2H(in[%lu] out[%lu] drop[%lu]) Ctrl: (in[%lu] rsp[%lu] evt[%lu])",
 			pkt_stats.sta_flowctrl_on, pkt_stats.sta_flowctrl_off,
 			pkt_stats.hs_bus_sta_in,pkt_stats.hs_bus_sta_out, pkt_stats.hs_bus_sta_fail,
-			pkt_stats.sta_sh_in,pkt_stats.sta_sh_out,
+			pkt_stats.sta_sh_in,pkt_stats.sta_sh_out, pkt_stats.sh_lane_drop,
 			pkt_stats.serial_rx, pkt_stats.serial_tx_total, pkt_stats.serial_tx_evt);
 	ESP_LOGI(TAG, "Lwip: in[%lu] slave_out[%lu] host_out[%lu] both_out[%lu]",
 			pkt_stats.sta_lwip_in, pkt_stats.sta_slave_lwip_out,
 			pkt_stats.sta_host_lwip_out, pkt_stats.sta_both_lwip_out);
+#if defined(CONFIG_ESP_HOSTED_NETWORK_SPLIT_ENABLED) && defined(CONFIG_LWIP_ENABLE)
+	{
+		uint32_t flow_hits = 0, flow_misses = 0;
+
+		lwip_filter_get_flow_cache_stats(&flow_hits, &flow_misses);
+		ESP_LOGI(TAG, "Lwip flow cache: hit[%" PRIu32 "] miss[%" PRIu32 "]",
+				flow_hits, flow_misses);
+	}
+#endif
 
 #ifdef ESP_FUNCTION_PROFILING
 	/* Print timing stats for all active entries */
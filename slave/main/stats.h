@@ -153,6 +153,7 @@ struct pkt_stats_t {
 	uint32_t sta_slave_lwip_out;
 	uint32_t sta_host_lwip_out;
 	uint32_t sta_both_lwip_out;
+	uint32_t sh_lane_drop;
 };
 
 extern struct pkt_stats_t pkt_stats;
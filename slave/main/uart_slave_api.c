@@ -232,6 +232,7 @@ static void uart_rx_task(void* pvParameters)
 #endif
 	int bytes_read;
 	int total_len;
+	uint16_t trailer_len = 0;
 	uint8_t flags = 0;
 
 	// delay for a while to let app main threads start and become ready
@@ -275,31 +276,41 @@ static void uart_rx_task(void* pvParameters)
 		}
 		len = le16toh(header->len);
 		offset = le16toh(header->offset);
+		trailer_len = esp_frame_trailer_len(header);
 		total_len = len + sizeof(struct esp_payload_header);
-		if (total_len > BUFFER_SIZE) {
-			ESP_LOGE(TAG, "incoming data too big: %d", total_len);
+		if (total_len + trailer_len > BUFFER_SIZE) {
+			ESP_LOGE(TAG, "incoming data too big: %d", total_len + trailer_len);
 			continue;
 		}
-		// get the data
+		// get the data, and CRC32 trailer if any
 		bytes_read = uart_read_bytes(HOSTED_UART, &uart_scratch_buf[offset],
-				len, portMAX_DELAY);
+				len + trailer_len, portMAX_DELAY);
 		ESP_LOGD(TAG, "Read %d bytes (payload)", bytes_read);
-		if (bytes_read < len) {
+		if (bytes_read < len + trailer_len) {
 			ESP_LOGE(TAG, "Failed to read payload");
 			continue;
 		}
 
+		if (flags & FLAG_CRC32) {
+			if (esp_frame_crc32_verify(header)) {
+				ESP_LOGE(TAG, "%s: CRC32 mismatch, drop len[%u] offset[%u]",
+						 __func__, len, offset);
+				continue;
+			}
+		}
 #if HOSTED_UART_CHECKSUM
-		// calculate checksum over data in scratch buffer
-		rx_checksum = le16toh(header->checksum);
-		header->checksum = 0;
+		else {
+			// calculate checksum over data in scratch buffer
+			rx_checksum = le16toh(header->checksum);
+			header->checksum = 0;
 
-		checksum = compute_checksum(uart_scratch_buf, total_len);
+			checksum = compute_checksum(uart_scratch_buf, total_len);
 
-		if (checksum != rx_checksum) {
-			ESP_LOGE(TAG, "%s: cal_chksum[%u] != exp_chksum[%u], drop len[%u] offset[%u]",
-					 __func__, checksum, rx_checksum, len, offset);
-			continue;
+			if (checksum != rx_checksum) {
+				ESP_LOGE(TAG, "%s: cal_chksum[%u] != exp_chksum[%u], drop len[%u] offset[%u]",
+						 __func__, checksum, rx_checksum, len, offset);
+				continue;
+			}
 		}
 #endif
 
@@ -366,6 +377,7 @@ static int32_t h_uart_write(interface_handle_t *handle, interface_buffer_handle_
 	int32_t total_len = 0;
 	uint8_t* sendbuf = NULL;
 	uint16_t offset = sizeof(struct esp_payload_header);
+	uint16_t trailer_len = 0;
 	struct esp_payload_header *header = NULL;
 	int tx_len;
 
@@ -388,7 +400,12 @@ static int32_t h_uart_write(interface_handle_t *handle, interface_buffer_handle_
 
 	total_len = buf_handle->payload_len + offset;
 
-	sendbuf = h_uart_buffer_tx_alloc(total_len, MEMSET_REQUIRED);
+	/* CRC32 trailer, if in use and it fits in */
+	if (is_tx_crc32_enabled() &&
+	    (total_len + H_ESP_PAYLOAD_CRC32_LEN <= BUFFER_SIZE))
+		trailer_len = H_ESP_PAYLOAD_CRC32_LEN;
+
+	sendbuf = h_uart_buffer_tx_alloc(total_len + trailer_len, MEMSET_REQUIRED);
 	if (sendbuf == NULL) {
 		ESP_LOGE(TAG , "send buffer[%"PRIu32"] malloc fail", total_len);
 		MEM_DUMP("malloc failed");
@@ -404,13 +421,20 @@ static int32_t h_uart_write(interface_handle_t *handle, interface_buffer_handle_
 	header->offset = htole16(offset);
 	header->seq_num = htole16(buf_handle->seq_num);
 	header->flags = buf_handle->flag;
+	if (trailer_len)
+		header->flags |= FLAG_CRC32;
 	header->throttle_cmd = buf_handle->wifi_flow_ctrl_en;
 
 	memcpy(sendbuf + offset, buf_handle->payload, buf_handle->payload_len);
 
+	if (trailer_len) {
+		esp_frame_crc32_fill(header);
+		total_len += trailer_len;
+	}
 #if HOSTED_UART_CHECKSUM
-	header->checksum = htole16(compute_checksum(sendbuf,
-				offset+buf_handle->payload_len));
+	else
+		header->checksum = htole16(compute_checksum(sendbuf,
+					offset+buf_handle->payload_len));
 #endif
 
 	ESP_LOGD(TAG, "sending %"PRIu32 " bytes", total_len);